@@ -16,6 +16,7 @@
 
 #include <dune/gdt/local/bilinear-forms/interfaces.hh>
 #include <dune/gdt/spaces/interface.hh>
+#include <dune/gdt/tools/matrix-scatter.hh>
 
 namespace Dune {
 namespace GDT {
@@ -38,6 +39,7 @@ class LocalElementBilinearFormAssembler : public XT::Grid::ElementFunctor<GridVi
 
   using ThisType = LocalElementBilinearFormAssembler;
   using BaseType = XT::Grid::ElementFunctor<GridView>;
+  using LocalMatrixScattererType = LocalMatrixScatterer<Matrix>;
 
 public:
   using typename BaseType::ElementType;
@@ -46,12 +48,18 @@ public:
   using TestSpaceType = SpaceInterface<TGV, t_r, t_rC, TR>;
   using AnsatzSpaceType = SpaceInterface<AGV, a_r, a_rC, AR>;
   using LocalBilinearFormType = LocalElementBilinearFormInterface<ElementType, t_r, t_rC, TR, FieldType, a_r, a_rC, AR>;
+  using LocalMatrixOffsetMapType = LocalMatrixOffsetMap<GridView>;
 
+  /**
+   * \note If local_matrix_offsets are given, they are used to add the local matrices directly to the values of
+   *       global_matrix (see LocalMatrixOffsetMap), the caller is responsible to validate() them before the grid walk.
+   */
   LocalElementBilinearFormAssembler(const TestSpaceType& test_space,
                                     const AnsatzSpaceType& ansatz_space,
                                     const LocalBilinearFormType& local_two_form,
                                     MatrixType& global_matrix,
-                                    const XT::Common::Parameter& param = {})
+                                    const XT::Common::Parameter& param = {},
+                                    std::shared_ptr<LocalMatrixOffsetMapType> local_matrix_offsets = nullptr)
     : BaseType()
     , test_space_(test_space.copy())
     , ansatz_space_(ansatz_space.copy())
@@ -64,6 +72,8 @@ public:
     , global_ansatz_indices_(ansatz_space_->mapper().max_local_size())
     , test_basis_(test_space_->basis().localize())
     , ansatz_basis_(ansatz_space_->basis().localize())
+    , scatterer_(global_matrix_, ansatz_space_->mapper().max_local_size())
+    , local_matrix_offsets_(LocalMatrixScattererType::supports_offsets ? local_matrix_offsets : nullptr)
   {
     DUNE_THROW_IF(global_matrix_.rows() != test_space_->mapper().size(),
                   XT::Common::Exceptions::shapes_do_not_match,
@@ -88,6 +98,8 @@ public:
     , global_ansatz_indices_(ansatz_space_->mapper().max_local_size())
     , test_basis_(test_space_->basis().localize())
     , ansatz_basis_(ansatz_space_->basis().localize())
+    , scatterer_(other.scatterer_)
+    , local_matrix_offsets_(other.local_matrix_offsets_)
   {}
 
   LocalElementBilinearFormAssembler(ThisType&& source) = default;
@@ -97,6 +109,11 @@ public:
     return new ThisType(*this);
   }
 
+  void prepare() override final
+  {
+    scatterer_.prepare();
+  }
+
   void apply_local(const ElementType& element) override final
   {
     // apply bilinear form
@@ -106,12 +123,20 @@ public:
     // copy local matrix to global matrix
     test_space_->mapper().global_indices(element, global_test_indices_);
     ansatz_space_->mapper().global_indices(element, global_ansatz_indices_);
-    for (size_t ii = 0; ii < test_basis_->size(param_); ++ii)
-      for (size_t jj = 0; jj < ansatz_basis_->size(param_); ++jj)
-        global_matrix_.add_to_entry(
-            global_test_indices_[ii], global_ansatz_indices_[jj], scaling_ * local_matrix_[ii][jj]);
+    scatterer_.add_local_matrix(global_test_indices_,
+                                test_basis_->size(param_),
+                                global_ansatz_indices_,
+                                ansatz_basis_->size(param_),
+                                local_matrix_,
+                                scaling_,
+                                local_matrix_offsets_ ? &(local_matrix_offsets_->element_offsets(element)) : nullptr);
   } // ... apply_local(...)
 
+  void finalize() override final
+  {
+    scatterer_.scatter_buffers();
+  }
+
 private:
   const std::unique_ptr<TestSpaceType> test_space_;
   const std::unique_ptr<AnsatzSpaceType> ansatz_space_;
@@ -124,6 +149,8 @@ private:
   DynamicVector<size_t> global_ansatz_indices_;
   mutable std::unique_ptr<typename TestSpaceType::GlobalBasisType::LocalizedType> test_basis_;
   mutable std::unique_ptr<typename AnsatzSpaceType::GlobalBasisType::LocalizedType> ansatz_basis_;
+  LocalMatrixScattererType scatterer_;
+  std::shared_ptr<LocalMatrixOffsetMapType> local_matrix_offsets_;
 }; // class LocalElementBilinearFormAssembler
 
 
@@ -144,6 +171,7 @@ class LocalIntersectionBilinearFormAssembler : public XT::Grid::IntersectionFunc
 
   using ThisType = LocalIntersectionBilinearFormAssembler;
   using BaseType = XT::Grid::IntersectionFunctor<GridView>;
+  using LocalMatrixScattererType = LocalMatrixScatterer<Matrix>;
 
 public:
   using typename BaseType::ElementType;
@@ -154,12 +182,17 @@ public:
   using TestSpaceType = SpaceInterface<TGV, t_r, t_rC, TR>;
   using AnsatzSpaceType = SpaceInterface<AGV, a_r, a_rC, AR>;
   using LocalBilinearFormType = LocalIntersectionBilinearFormInterface<I, t_r, t_rC, TR, FieldType, a_r, a_rC, AR>;
+  using LocalMatrixOffsetMapType = LocalMatrixOffsetMap<GridView>;
 
+  /**
+   * \note See LocalElementBilinearFormAssembler for local_matrix_offsets.
+   */
   LocalIntersectionBilinearFormAssembler(const TestSpaceType& test_space,
                                          const AnsatzSpaceType& ansatz_space,
                                          const LocalBilinearFormType& local_two_form,
                                          MatrixType& global_matrix,
-                                         const XT::Common::Parameter& param = {})
+                                         const XT::Common::Parameter& param = {},
+                                         std::shared_ptr<LocalMatrixOffsetMapType> local_matrix_offsets = nullptr)
     : BaseType()
     , test_space_(test_space.copy())
     , ansatz_space_(ansatz_space.copy())
@@ -179,6 +212,8 @@ public:
     , test_basis_outside_(test_space_->basis().localize())
     , ansatz_basis_inside_(ansatz_space_->basis().localize())
     , ansatz_basis_outside_(ansatz_space_->basis().localize())
+    , scatterer_(global_matrix_, ansatz_space_->mapper().max_local_size())
+    , local_matrix_offsets_(LocalMatrixScattererType::supports_offsets ? local_matrix_offsets : nullptr)
   {
     DUNE_THROW_IF(global_matrix_.rows() != test_space_->mapper().size(),
                   XT::Common::Exceptions::shapes_do_not_match,
@@ -210,6 +245,8 @@ public:
     , test_basis_outside_(test_space_->basis().localize())
     , ansatz_basis_inside_(ansatz_space_->basis().localize())
     , ansatz_basis_outside_(ansatz_space_->basis().localize())
+    , scatterer_(other.scatterer_)
+    , local_matrix_offsets_(other.local_matrix_offsets_)
   {}
 
   LocalIntersectionBilinearFormAssembler(ThisType&& source) = default;
@@ -219,6 +256,11 @@ public:
     return new ThisType(*this);
   }
 
+  void prepare() override final
+  {
+    scatterer_.prepare();
+  }
+
   void apply_local(const IntersectionType& intersection,
                    const ElementType& inside_element,
                    const ElementType& outside_element) override final
@@ -243,24 +285,50 @@ public:
     test_space_->mapper().global_indices(outside_element, global_test_indices_out_);
     ansatz_space_->mapper().global_indices(inside_element, global_ansatz_indices_in_);
     ansatz_space_->mapper().global_indices(outside_element, global_ansatz_indices_out_);
-    for (size_t ii = 0; ii < test_basis_inside_->size(param_); ++ii) {
-      for (size_t jj = 0; jj < ansatz_basis_inside_->size(param_); ++jj)
-        global_matrix_.add_to_entry(
-            global_test_indices_in_[ii], global_ansatz_indices_in_[jj], scaling_ * local_matrix_in_in_[ii][jj]);
-      for (size_t jj = 0; jj < ansatz_basis_outside_->size(param_); ++jj)
-        global_matrix_.add_to_entry(
-            global_test_indices_in_[ii], global_ansatz_indices_out_[jj], scaling_ * local_matrix_in_out_[ii][jj]);
-    }
-    for (size_t ii = 0; ii < test_basis_outside_->size(param_); ++ii) {
-      for (size_t jj = 0; jj < ansatz_basis_inside_->size(param_); ++jj)
-        global_matrix_.add_to_entry(
-            global_test_indices_out_[ii], global_ansatz_indices_in_[jj], scaling_ * local_matrix_out_in_[ii][jj]);
-      for (size_t jj = 0; jj < ansatz_basis_outside_->size(param_); ++jj)
-        global_matrix_.add_to_entry(
-            global_test_indices_out_[ii], global_ansatz_indices_out_[jj], scaling_ * local_matrix_out_out_[ii][jj]);
-    }
+    const auto offsets = [&](const size_t block) -> typename LocalMatrixOffsetMapType::OffsetsType* {
+      if (!local_matrix_offsets_)
+        return nullptr;
+      return &(local_matrix_offsets_->intersection_offsets(intersection, inside_element, outside_element, block));
+    };
+    const size_t test_size_in = test_basis_inside_->size(param_);
+    const size_t test_size_out = test_basis_outside_->size(param_);
+    const size_t ansatz_size_in = ansatz_basis_inside_->size(param_);
+    const size_t ansatz_size_out = ansatz_basis_outside_->size(param_);
+    scatterer_.add_local_matrix(global_test_indices_in_,
+                                test_size_in,
+                                global_ansatz_indices_in_,
+                                ansatz_size_in,
+                                local_matrix_in_in_,
+                                scaling_,
+                                offsets(0));
+    scatterer_.add_local_matrix(global_test_indices_in_,
+                                test_size_in,
+                                global_ansatz_indices_out_,
+                                ansatz_size_out,
+                                local_matrix_in_out_,
+                                scaling_,
+                                offsets(1));
+    scatterer_.add_local_matrix(global_test_indices_out_,
+                                test_size_out,
+                                global_ansatz_indices_in_,
+                                ansatz_size_in,
+                                local_matrix_out_in_,
+                                scaling_,
+                                offsets(2));
+    scatterer_.add_local_matrix(global_test_indices_out_,
+                                test_size_out,
+                                global_ansatz_indices_out_,
+                                ansatz_size_out,
+                                local_matrix_out_out_,
+                                scaling_,
+                                offsets(3));
   } // ... apply_local(...)
 
+  void finalize() override final
+  {
+    scatterer_.scatter_buffers();
+  }
+
 private:
   const std::unique_ptr<TestSpaceType> test_space_;
   const std::unique_ptr<AnsatzSpaceType> ansatz_space_;
@@ -280,6 +348,8 @@ private:
   mutable std::unique_ptr<typename TestSpaceType::GlobalBasisType::LocalizedType> test_basis_outside_;
   mutable std::unique_ptr<typename AnsatzSpaceType::GlobalBasisType::LocalizedType> ansatz_basis_inside_;
   mutable std::unique_ptr<typename AnsatzSpaceType::GlobalBasisType::LocalizedType> ansatz_basis_outside_;
+  LocalMatrixScattererType scatterer_;
+  std::shared_ptr<LocalMatrixOffsetMapType> local_matrix_offsets_;
 }; // class LocalIntersectionBilinearFormAssembler
 
 
@@ -11,18 +11,314 @@
 #ifndef DUNE_GDT_LOCAL_ASSEMBLER_OPERATOR_APPLICATORS_HH
 #define DUNE_GDT_LOCAL_ASSEMBLER_OPERATOR_APPLICATORS_HH
 
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <vector>
 
+#include <dune/common/dynvector.hh>
+
+#include <dune/xt/common/unused.hh>
 #include <dune/xt/la/type_traits.hh>
 #include <dune/xt/grid/functors/interfaces.hh>
 #include <dune/xt/grid/type_traits.hh>
 
+#include <dune/gdt/discretefunction/dof-vector.hh>
+#include <dune/gdt/exceptions.hh>
 #include <dune/gdt/local/operators/interfaces.hh>
+#include <dune/gdt/spaces/mapper/interfaces.hh>
 
 namespace Dune {
 namespace GDT {
 
 
+/**
+ * \brief Gathers the contributions of local operator applicators to a range vector, to add them in a race-free manner.
+ *
+ * Applicators given a reduction apply their local operator to a thread-private range, instead of writing into the
+ * (shared) range directly, where two threads could update the same DoF (e.g., inside and outside of an intersection,
+ * or DoFs shared between elements of a continuous space).
+ *
+ * - non-deterministic: reduce() adds each thread-private range vector to the range.
+ * - deterministic: each contribution is stored along with a key identifying the local application (index of the
+ *   (inside) element, position of the intersection within the element, local operator) and reduce() adds all
+ *   contributions in the order of their keys, which coincides with the order of a sequential grid walk. The result is
+ *   thus bit-identical, regardless of the number of threads and the partitioning of the grid.
+ *
+ * The thread-private range vectors are kept (and zeroed) by reduce(), so a reduction which is reset() and reused for
+ * several grid walks (as in LocalizableOperator::apply) only allocates them once. In the deterministic mode, no
+ * thread-private range vectors are required: the applicators apply their local operators to element-local storage (see
+ * internal::ElementLocalRangeStorage), from which the contributions are taken.
+ *
+ * \note reduce() has to be called after the grid walk, LocalizableDiscreteOperatorApplicator::assemble takes care of
+ *       that.
+ */
+template <class V>
+class LocalOperatorApplicationReduction
+{
+  static_assert(XT::LA::is_vector<V>::value, "");
+
+public:
+  using VectorType = V;
+  using ScalarType = typename V::ScalarType;
+  using KeyType = std::array<size_t, 3>;
+
+  struct Contribution
+  {
+    KeyType key;
+    size_t global_index;
+    ScalarType value;
+  };
+
+  LocalOperatorApplicationReduction(VectorType& range, const bool deterministic)
+    : range_(&range)
+    , deterministic_(deterministic)
+    , num_local_operators_(0)
+    , num_acquired_(0)
+  {}
+
+  /// \brief Prepares the next grid walk, keeps the thread-private range vectors if their size fits, not thread safe.
+  void reset(VectorType& range, const bool deterministic)
+  {
+    // discard the contributions of an aborted grid walk
+    for (size_t kk = 0; kk < num_acquired_; ++kk)
+      private_ranges_[kk]->set_all(0.);
+    num_acquired_ = 0;
+    contributions_.clear();
+    if (deterministic || (!private_ranges_.empty() && private_ranges_.front()->size() != range.size()))
+      private_ranges_.clear();
+    range_ = &range;
+    deterministic_ = deterministic;
+    num_local_operators_ = 0;
+  } // ... reset(...)
+
+  bool deterministic() const
+  {
+    return deterministic_;
+  }
+
+  /// \brief Returns a unique id to be used as last entry of the keys of all contributions of one local operator.
+  size_t register_local_operator()
+  {
+    return num_local_operators_++;
+  }
+
+  /// \brief Returns a zero vector to be used as thread-private range by one applicator until reduce(), thread safe.
+  VectorType& acquire_private_range()
+  {
+    DUNE_THROW_IF(deterministic_,
+                  Exceptions::operator_error,
+                  "Thread-private ranges are not used in the deterministic mode, use the contributions instead!");
+    std::lock_guard<std::mutex> DXTC_UNUSED(guard)(mutex_);
+    if (num_acquired_ == private_ranges_.size())
+      private_ranges_.emplace_back(std::make_unique<VectorType>(range_->size(), 0.)); // This is a full vector!
+    return *private_ranges_[num_acquired_++];
+  }
+
+  /// \brief Stores the contributions of one thread for reduce(), thread safe.
+  void add(std::vector<Contribution>&& contributions)
+  {
+    std::lock_guard<std::mutex> DXTC_UNUSED(guard)(mutex_);
+    contributions_.insert(contributions_.end(),
+                          std::make_move_iterator(contributions.begin()),
+                          std::make_move_iterator(contributions.end()));
+  }
+
+  /// \brief Adds all thread-private ranges or stored contributions to the range, not thread safe.
+  void reduce()
+  {
+    if (deterministic_) {
+      // the contributions of one key stem from one thread, thus stable sorting keeps their relative order
+      std::stable_sort(contributions_.begin(),
+                       contributions_.end(),
+                       [](const Contribution& lhs, const Contribution& rhs) { return lhs.key < rhs.key; });
+      for (const auto& contribution : contributions_)
+        range_->add_to_entry(contribution.global_index, contribution.value);
+      contributions_.clear();
+    } else {
+      for (size_t kk = 0; kk < num_acquired_; ++kk) {
+        range_->axpy(1., *private_ranges_[kk]);
+        private_ranges_[kk]->set_all(0.);
+      }
+    }
+    num_acquired_ = 0;
+  } // ... reduce(...)
+
+private:
+  VectorType* range_;
+  bool deterministic_;
+  size_t num_local_operators_;
+  std::vector<std::unique_ptr<VectorType>> private_ranges_;
+  size_t num_acquired_;
+  std::vector<Contribution> contributions_;
+  std::mutex mutex_;
+}; // class LocalOperatorApplicationReduction
+
+
+namespace internal {
+
+
+/**
+ * \brief Moves the DoFs of a local range, which is bound to element, into contributions (and sets them to zero).
+ */
+template <class LocalRangeType, class ElementType, class KeyType, class ContributionsType>
+void move_local_dofs_to_contributions(LocalRangeType& local_range,
+                                      const ElementType& element,
+                                      const KeyType& key,
+                                      DynamicVector<size_t>& global_indices,
+                                      ContributionsType& contributions)
+{
+  auto& local_dofs = local_range.dofs();
+  local_range.space().mapper().global_indices(element, global_indices);
+  for (size_t ii = 0; ii < local_dofs.size(); ++ii) {
+    contributions.push_back({key, global_indices[ii], local_dofs[ii]});
+    local_dofs[ii] = 0;
+  }
+} // ... move_local_dofs_to_contributions(...)
+
+
+/**
+ * \brief Maps the DoFs of each element to 0, ..., local_size - 1, to store them in a vector of length max_local_size.
+ */
+template <class GV>
+class ElementLocalMapper : public MapperInterface<GV>
+{
+  using BaseType = MapperInterface<GV>;
+
+public:
+  using typename BaseType::D;
+  using BaseType::d;
+  using typename BaseType::ElementType;
+  using typename BaseType::GridViewType;
+
+  ElementLocalMapper(const BaseType& mapper)
+    : mapper_(mapper)
+  {}
+
+  const GridViewType& grid_view() const override final
+  {
+    return mapper_.grid_view();
+  }
+
+  const LocalFiniteElementCoefficientsInterface<D, d>&
+  local_coefficients(const GeometryType& geometry_type) const override final
+  {
+    return mapper_.local_coefficients(geometry_type);
+  }
+
+  size_t size() const override final
+  {
+    return mapper_.max_local_size();
+  }
+
+  size_t max_local_size() const override final
+  {
+    return mapper_.max_local_size();
+  }
+
+  size_t local_size(const ElementType& element) const override final
+  {
+    return mapper_.local_size(element);
+  }
+
+  size_t global_index(const ElementType& element, const size_t local_index) const override final
+  {
+    DUNE_THROW_IF(local_index >= mapper_.local_size(element),
+                  Exceptions::mapper_error,
+                  "local_size(element) = " << mapper_.local_size(element) << "\n   local_index = " << local_index);
+    return local_index;
+  }
+
+  using BaseType::global_indices;
+
+  void global_indices(const ElementType& element, DynamicVector<size_t>& indices) const override final
+  {
+    const size_t local_size = mapper_.local_size(element);
+    if (indices.size() < local_size)
+      indices.resize(local_size);
+    for (size_t ii = 0; ii < local_size; ++ii)
+      indices[ii] = ii;
+  }
+
+  bool element_indices_are_contiguous() const override final
+  {
+    return true;
+  }
+
+private:
+  const BaseType& mapper_;
+}; // class ElementLocalMapper
+
+
+/**
+ * \brief Holds the DoFs of a range restricted to one element, to be used as thread-private local range (e.g., in the
+ *        deterministic mode of LocalOperatorApplicationReduction or in the finite-difference jacobian assemblers).
+ *
+ * Since local operators add to the local range, the DoFs have to be zeroed after each local application (as done by
+ * move_local_dofs_to_contributions).
+ */
+template <class RangeType>
+class ElementLocalRangeStorage
+{
+public:
+  using VectorType = typename RangeType::VectorType;
+  using GridViewType = typename RangeType::SpaceType::GridViewType;
+  using LocalDiscreteFunctionType = typename RangeType::LocalDiscreteFunctionType;
+
+  ElementLocalRangeStorage(const typename RangeType::SpaceType& space)
+    : space_(space)
+    , mapper_(space_.mapper())
+    , vector_(mapper_.size(), 0.)
+    , dof_vector_(mapper_, vector_)
+  {}
+
+  ElementLocalRangeStorage(const ElementLocalRangeStorage&) = delete;
+
+  std::unique_ptr<LocalDiscreteFunctionType> local_discrete_function()
+  {
+    return std::make_unique<LocalDiscreteFunctionType>(space_, dof_vector_);
+  }
+
+private:
+  const typename RangeType::SpaceType& space_;
+  const ElementLocalMapper<GridViewType> mapper_;
+  VectorType vector_;
+  DofVector<VectorType, GridViewType> dof_vector_;
+}; // class ElementLocalRangeStorage
+
+
+/**
+ * \brief Creates a thread-private outside range which shares the vector of the thread-private inside range.
+ *
+ * Thread-private ranges are only used if the inside and outside range coincide, see
+ * LocalIntersectionOperatorApplicator.
+ */
+template <class InsideRangeType, class OutsideRangeType>
+struct PrivateOutsideRange
+{
+  static std::unique_ptr<OutsideRangeType> create(InsideRangeType& /*private_range_inside*/)
+  {
+    DUNE_THROW(Exceptions::operator_error, "Thread-private ranges require the inside and outside range to coincide!");
+    return nullptr;
+  }
+};
+
+template <class RangeType>
+struct PrivateOutsideRange<RangeType, RangeType>
+{
+  static std::unique_ptr<RangeType> create(RangeType& private_range_inside)
+  {
+    return std::make_unique<RangeType>(private_range_inside.space(), private_range_inside.dofs().vector());
+  }
+};
+
+
+} // namespace internal
+
+
 /**
  * \note See also LocalElementOperatorInterface for a description of the template arguments.
  *
@@ -60,18 +356,32 @@ public:
   using SourceType = ConstDiscreteFunction<SV, SGV, s_r, s_rC, SF>;
   using RangeType = DiscreteFunction<RV, RGV, r_r, r_rC, RF>;
   using LocalOperatorType = LocalElementOperatorInterface<SV, SGV, s_r, s_rC, SF, r_r, r_rC, RF, RGV, RV>;
+  using ReductionType = LocalOperatorApplicationReduction<RV>;
 
+  /**
+   * \param reduction If given, the local operator is applied to a thread-private range and the contributions are
+   *                  handed over to the reduction, see LocalOperatorApplicationReduction.
+   */
   LocalElementOperatorApplicator(const LocalOperatorType& local_operator,
                                  RangeType& range,
-                                 const XT::Common::Parameter& param = {})
+                                 const XT::Common::Parameter& param = {},
+                                 ReductionType* reduction = nullptr)
     : local_operator_(local_operator.copy())
     , range_(range)
     , param_(param)
+    , reduction_(reduction)
+    , id_(reduction_ ? reduction_->register_local_operator() : 0)
     , local_range_(range_.local_discrete_function())
   {}
 
   LocalElementOperatorApplicator(const ThisType& other)
-    : LocalElementOperatorApplicator(*other.local_operator_, other.range_, other.param_)
+    : BaseType(other)
+    , local_operator_(other.local_operator_->copy())
+    , range_(other.range_)
+    , param_(other.param_)
+    , reduction_(other.reduction_)
+    , id_(other.id_)
+    , local_range_(range_.local_discrete_function())
   {}
 
   BaseType* copy() override final
@@ -81,16 +391,42 @@ public:
 
   void apply_local(const ElementType& element) override final
   {
+    if (reduction_ && reduction_->deterministic() && !local_storage_) {
+      local_storage_ = std::make_unique<internal::ElementLocalRangeStorage<RangeType>>(range_.space());
+      local_range_ = local_storage_->local_discrete_function();
+    } else if (reduction_ && !reduction_->deterministic() && !private_range_) {
+      private_range_ = std::make_unique<RangeType>(range_.space(), reduction_->acquire_private_range());
+      local_range_ = private_range_->local_discrete_function();
+    }
     local_range_->bind(element);
     local_operator_->bind(element);
     local_operator_->apply(*local_range_, param_);
+    if (reduction_ && reduction_->deterministic())
+      internal::move_local_dofs_to_contributions(
+          *local_range_,
+          element,
+          typename ReductionType::KeyType{{range_.space().grid_view().indexSet().index(element), 0, id_}},
+          global_indices_,
+          contributions_);
+  } // ... apply_local(...)
+
+  void finalize() override final
+  {
+    if (local_storage_)
+      reduction_->add(std::move(contributions_));
   }
 
 private:
   const std::unique_ptr<LocalOperatorType> local_operator_;
   RangeType& range_;
   const XT::Common::Parameter param_;
+  ReductionType* reduction_;
+  const size_t id_;
+  std::unique_ptr<RangeType> private_range_;
+  std::unique_ptr<internal::ElementLocalRangeStorage<RangeType>> local_storage_;
   std::unique_ptr<typename RangeType::LocalDiscreteFunctionType> local_range_;
+  DynamicVector<size_t> global_indices_;
+  std::vector<typename ReductionType::Contribution> contributions_;
 }; // class LocalElementOperatorApplicator
 
 
@@ -193,22 +529,47 @@ public:
   using OutsideRangeType = DiscreteFunction<ORV, ORGV, r_r, r_rC, RF>;
   using LocalOperatorType =
       LocalIntersectionOperatorInterface<IntersectionType, SV, SGV, s_r, s_rC, SF, r_r, r_rC, RF, IRGV, IRV, ORGV, ORV>;
+  using ReductionType = LocalOperatorApplicationReduction<IRV>;
 
+  /**
+   * \param reduction If given, the local operator is applied to a thread-private range and the contributions are
+   *                  handed over to the reduction, see LocalOperatorApplicationReduction. Requires range_inside and
+   *                  range_outside to coincide.
+   */
   LocalIntersectionOperatorApplicator(const LocalOperatorType& local_operator,
                                       InsideRangeType& range_inside,
                                       OutsideRangeType& range_outside,
-                                      const XT::Common::Parameter& param = {})
+                                      const XT::Common::Parameter& param = {},
+                                      ReductionType* reduction = nullptr)
     : local_operator_(local_operator.copy())
     , range_inside_(range_inside)
     , range_outside_(range_outside)
     , param_(param)
+    , reduction_(reduction)
+    , id_(reduction_ ? reduction_->register_local_operator() : 0)
     , local_range_inside_(range_inside_.local_discrete_function())
     , local_range_outside_(range_outside_.local_discrete_function())
-  {}
+    , last_inside_index_(std::numeric_limits<size_t>::max())
+    , intersection_counter_(0)
+  {
+    DUNE_THROW_IF(reduction_
+                      && static_cast<const void*>(&range_inside_) != static_cast<const void*>(&range_outside_),
+                  Exceptions::operator_error,
+                  "Thread-private ranges require the inside and outside range to coincide!");
+  }
 
   LocalIntersectionOperatorApplicator(const ThisType& other)
-    : LocalIntersectionOperatorApplicator(
-          *other.local_operator_, other.range_inside_, other.range_outside_, other.param_)
+    : BaseType(other)
+    , local_operator_(other.local_operator_->copy())
+    , range_inside_(other.range_inside_)
+    , range_outside_(other.range_outside_)
+    , param_(other.param_)
+    , reduction_(other.reduction_)
+    , id_(other.id_)
+    , local_range_inside_(range_inside_.local_discrete_function())
+    , local_range_outside_(range_outside_.local_discrete_function())
+    , last_inside_index_(std::numeric_limits<size_t>::max())
+    , intersection_counter_(0)
   {}
 
   BaseType* copy() override final
@@ -220,10 +581,46 @@ public:
                    const ElementType& inside_element,
                    const ElementType& outside_element) override final
   {
+    if (reduction_ && reduction_->deterministic() && !local_storage_inside_) {
+      // separate storage for the outside element, the DoFs of both elements are moved to contributions individually
+      local_storage_inside_ =
+          std::make_unique<internal::ElementLocalRangeStorage<InsideRangeType>>(range_inside_.space());
+      local_storage_outside_ =
+          std::make_unique<internal::ElementLocalRangeStorage<OutsideRangeType>>(range_outside_.space());
+      local_range_inside_ = local_storage_inside_->local_discrete_function();
+      local_range_outside_ = local_storage_outside_->local_discrete_function();
+    } else if (reduction_ && !reduction_->deterministic() && !private_range_inside_) {
+      private_range_inside_ =
+          std::make_unique<InsideRangeType>(range_inside_.space(), reduction_->acquire_private_range());
+      private_range_outside_ =
+          internal::PrivateOutsideRange<InsideRangeType, OutsideRangeType>::create(*private_range_inside_);
+      local_range_inside_ = private_range_inside_->local_discrete_function();
+      local_range_outside_ = private_range_outside_->local_discrete_function();
+    }
     local_range_inside_->bind(inside_element);
     local_range_outside_->bind(outside_element);
     local_operator_->bind(intersection);
     local_operator_->apply(*local_range_inside_, *local_range_outside_, param_);
+    if (reduction_ && reduction_->deterministic()) {
+      // all intersections of an element are visited consecutively by the same thread, thus counting them yields a
+      // unique and deterministic key (even for nonconforming grids, where indexInInside() is not unique)
+      const size_t inside_index = range_inside_.space().grid_view().indexSet().index(inside_element);
+      if (inside_index != last_inside_index_) {
+        last_inside_index_ = inside_index;
+        intersection_counter_ = 0;
+      }
+      const typename ReductionType::KeyType key{{inside_index, ++intersection_counter_, id_}};
+      internal::move_local_dofs_to_contributions(
+          *local_range_inside_, inside_element, key, global_indices_, contributions_);
+      internal::move_local_dofs_to_contributions(
+          *local_range_outside_, outside_element, key, global_indices_, contributions_);
+    }
+  } // ... apply_local(...)
+
+  void finalize() override final
+  {
+    if (local_storage_inside_)
+      reduction_->add(std::move(contributions_));
   }
 
 private:
@@ -231,8 +628,18 @@ private:
   InsideRangeType& range_inside_;
   OutsideRangeType& range_outside_;
   const XT::Common::Parameter param_;
+  ReductionType* reduction_;
+  const size_t id_;
+  std::unique_ptr<InsideRangeType> private_range_inside_;
+  std::unique_ptr<OutsideRangeType> private_range_outside_;
+  std::unique_ptr<internal::ElementLocalRangeStorage<InsideRangeType>> local_storage_inside_;
+  std::unique_ptr<internal::ElementLocalRangeStorage<OutsideRangeType>> local_storage_outside_;
   std::unique_ptr<typename InsideRangeType::LocalDiscreteFunctionType> local_range_inside_;
   std::unique_ptr<typename OutsideRangeType::LocalDiscreteFunctionType> local_range_outside_;
+  size_t last_inside_index_;
+  size_t intersection_counter_;
+  DynamicVector<size_t> global_indices_;
+  std::vector<typename ReductionType::Contribution> contributions_;
 }; // class LocalIntersectionOperatorApplicator
 
 
@@ -13,21 +13,143 @@
 #define DUNE_GDT_LOCAL_ASSEMBLER_OPERATOR_FD_JACOBIAN_ASSEMBLERS_HH
 
 #include <cmath>
+#include <limits>
 #include <memory>
 
 #include <dune/common/dynvector.hh>
 
 #include <dune/xt/common/float_cmp.hh>
 #include <dune/xt/common/parameter.hh>
+#include <dune/xt/la/container/vector-interface.hh>
 #include <dune/xt/la/type_traits.hh>
 #include <dune/xt/grid/functors/interfaces.hh>
 #include <dune/xt/grid/type_traits.hh>
 
+#include <dune/gdt/discretefunction/default.hh>
+#include <dune/gdt/exceptions.hh>
+#include <dune/gdt/local/assembler/operator-applicators.hh>
 #include <dune/gdt/local/discretefunction.hh>
 #include <dune/gdt/local/operators/interfaces.hh>
 
 namespace Dune {
 namespace GDT {
+namespace internal {
+
+
+// forward, required for the traits
+template <class Vector>
+class LocallyPerturbedVector;
+
+
+template <class Vector>
+class LocallyPerturbedVectorTraits
+{
+  static_assert(XT::LA::is_vector<Vector>::value, "");
+
+public:
+  static constexpr XT::LA::Backends dense_matrix_type = XT::LA::Backends::common_dense;
+  static constexpr XT::LA::Backends sparse_matrix_type = XT::LA::Backends::common_sparse;
+  using derived_type = LocallyPerturbedVector<Vector>;
+  using ScalarType = typename Vector::ScalarType;
+  using RealType = typename Vector::RealType;
+};
+
+
+/**
+ * \brief Read-only view on a vector, which overlays a perturbation of a single entry.
+ *
+ * Allows to perturb the source of an operator without copying (and modifying) the full source vector.
+ */
+template <class Vector>
+class LocallyPerturbedVector : public XT::LA::VectorInterface<LocallyPerturbedVectorTraits<Vector>>
+{
+  using ThisType = LocallyPerturbedVector;
+  using BaseType = XT::LA::VectorInterface<LocallyPerturbedVectorTraits<Vector>>;
+
+public:
+  using typename BaseType::ScalarType;
+  using VectorType = Vector;
+
+  LocallyPerturbedVector(const VectorType& vector)
+    : vector_(vector)
+    , perturbed_index_(std::numeric_limits<size_t>::max())
+    , perturbed_value_(0)
+  {}
+
+  LocallyPerturbedVector(const ThisType& other) = default;
+
+  /// \brief Overlays vector[ii] + eps as the ii-th entry.
+  void perturb(const size_t ii, const ScalarType& eps)
+  {
+    perturbed_value_ = vector_[ii] + eps;
+    perturbed_index_ = ii;
+  }
+
+  /// \brief Removes the perturbation.
+  void restore()
+  {
+    perturbed_index_ = std::numeric_limits<size_t>::max();
+  }
+
+  size_t size() const
+  {
+    return vector_.size();
+  }
+
+  void resize(const size_t new_size)
+  {
+    DUNE_THROW_IF(this->size() != new_size, Exceptions::operator_error, "this does not make sense!");
+  }
+
+  void add_to_entry(const size_t /*ii*/, const ScalarType& /*value*/)
+  {
+    DUNE_THROW(Exceptions::operator_error, "a LocallyPerturbedVector is not mutable!");
+  }
+
+  void set_entry(const size_t /*ii*/, const ScalarType& /*value*/)
+  {
+    DUNE_THROW(Exceptions::operator_error, "a LocallyPerturbedVector is not mutable!");
+  }
+
+  ScalarType get_entry(const size_t ii) const
+  {
+    return (ii == perturbed_index_) ? perturbed_value_ : vector_.get_entry(ii);
+  }
+
+protected:
+  ScalarType& get_unchecked_ref(const size_t /*ii*/)
+  {
+    DUNE_THROW(Exceptions::operator_error, "a LocallyPerturbedVector is not mutable!");
+    return perturbed_value_;
+  }
+
+  const ScalarType& get_unchecked_ref(const size_t ii) const
+  {
+    return (*this)[ii];
+  }
+
+public:
+  ScalarType& operator[](const size_t /*ii*/)
+  {
+    DUNE_THROW(Exceptions::operator_error, "a LocallyPerturbedVector is not mutable!");
+    return perturbed_value_;
+  }
+
+  const ScalarType& operator[](const size_t ii) const
+  {
+    return (ii == perturbed_index_) ? perturbed_value_ : vector_[ii];
+  }
+
+private:
+  friend BaseType; // To allow access to get_unchecked_ref().
+
+  const VectorType& vector_;
+  size_t perturbed_index_;
+  ScalarType perturbed_value_;
+}; // class LocallyPerturbedVector
+
+
+} // namespace internal
 
 
 /**
@@ -36,8 +158,10 @@ namespace GDT {
  * \note Presumes that the nonlinearity in the first argument of the operator does not suffer from restriction to the
  *       neighborhood.
  *
- * \note This implementation is not optimal, since it requires a full source and range vector. This can only be fixed
- *       after refactoring local discrete functions and local dof vectors.
+ * \note The source DoFs are perturbed one at a time by overlaying the perturbation on the given source vector (see
+ *       internal::LocallyPerturbedVector), so no copy of the source vector is required. The local operator is applied
+ *       to element-local range storage (see internal::ElementLocalRangeStorage), so no global range vector is
+ *       required either.
  *
  * See also LocalElementOperatorInterface for a description of the template arguments.
  *
@@ -87,14 +211,12 @@ public:
     , scaling_(param_.has_key("matrixoperator.scaling") ? param_.get("matrixoperator.scaling").at(0) : 1.)
     , eps_(param_.has_key("finite-difference-jacobians.eps") ? param_.get("finite-difference-jacobians.eps").at(0)
                                                              : 1e-7)
-    , source_(*source_space_) // This is a full vector, and intended!
-    , range_(*range_space_) // This is a full vector, and intended!
-    , local_source_(source_.local_discrete_function())
-    , local_range_(range_.local_discrete_function())
+    , perturbed_source_vector_(source_vector_)
+    , source_(*source_space_, perturbed_source_vector_)
+    , range_storage_(*range_space_)
+    , local_range_(range_storage_.local_discrete_function())
     , local_op_(local_operator.with_source(source_))
-  {
-    source_.dofs().vector() = source_vector_;
-  }
+  {}
 
   LocalElementOperatorFiniteDifferenceJacobianAssembler(const ThisType& other)
     : BaseType(other)
@@ -105,14 +227,12 @@ public:
     , param_(other.param_)
     , scaling_(other.scaling_)
     , eps_(other.eps_)
-    , source_(*source_space_) // This is a full vector, and intended!
-    , range_(*range_space_) // This is a full vector, and intended!
-    , local_source_(source_.local_discrete_function())
-    , local_range_(range_.local_discrete_function())
+    , perturbed_source_vector_(source_vector_)
+    , source_(*source_space_, perturbed_source_vector_)
+    , range_storage_(*range_space_)
+    , local_range_(range_storage_.local_discrete_function())
     , local_op_(other.local_op_->with_source(source_))
-  {
-    source_.dofs().vector() = source_vector_;
-  }
+  {}
 
   BaseType* copy() override final
   {
@@ -123,7 +243,6 @@ public:
   {
     // some preparations
     local_op_->bind(element);
-    local_source_->bind(element);
     local_range_->bind(element);
     source_space_->mapper().global_indices(element, global_source_indices_);
     range_space_->mapper().global_indices(element, global_range_indices_);
@@ -140,9 +259,9 @@ public:
     // loop over all source DoFs
     for (size_t jj = 0; jj < local_source_size; ++jj) {
       // perturb source DoF
-      const auto jjth_source_DoF = local_source_->dofs()[jj];
+      const auto jjth_source_DoF = source_vector_[global_source_indices_[jj]];
       const auto eps = eps_ * (1. + std::abs(jjth_source_DoF));
-      local_source_->dofs()[jj] += eps;
+      perturbed_source_vector_.perturb(global_source_indices_[jj], eps);
       // apply op with perturbed source DoF
       local_op_->apply(*local_range_, param_);
       // observe perturbation in range DoFs
@@ -152,8 +271,9 @@ public:
           derivative = 0;
         matrix_.add_to_entry(global_range_indices_[ii], global_source_indices_[jj], scaling_ * derivative);
       }
-      // restore source
-      local_source_->dofs()[jj] = jjth_source_DoF;
+      // restore source, clear local range
+      perturbed_source_vector_.restore();
+      local_range_->dofs().set_all(0);
     }
   } // ... apply_local(...)
 
@@ -165,9 +285,9 @@ private:
   const XT::Common::Parameter param_;
   const double scaling_;
   const real_t<F> eps_;
-  DiscreteFunction<V, SGV, s_r, s_rC, F> source_;
-  DiscreteFunction<V, RGV, r_r, r_rC, F> range_;
-  std::unique_ptr<LocalDiscreteFunction<V, SGV, s_r, s_rC, F>> local_source_;
+  internal::LocallyPerturbedVector<V> perturbed_source_vector_;
+  const ConstDiscreteFunction<internal::LocallyPerturbedVector<V>, SGV, s_r, s_rC, F> source_;
+  internal::ElementLocalRangeStorage<DiscreteFunction<V, RGV, r_r, r_rC, F>> range_storage_;
   std::unique_ptr<LocalDiscreteFunction<V, RGV, r_r, r_rC, F>> local_range_;
   DynamicVector<size_t> global_source_indices_;
   DynamicVector<size_t> global_range_indices_;
@@ -183,8 +303,10 @@ private:
  * \note Presumes that the nonlinearity in the first argument of the operator does not suffer from restriction to the
  *       neighborhood.
  *
- * \note This implementation is not optimal, since it requires a full source and range vector. This can only be fixed
- *       after refactoring local discrete functions and local dof vectors.
+ * \note The source DoFs are perturbed one at a time by overlaying the perturbation on the given source vector (see
+ *       internal::LocallyPerturbedVector), so no copy of the source vector is required. The local operator is applied
+ *       to element-local range storage (see internal::ElementLocalRangeStorage), so no global range vector is
+ *       required either.
  *
  * See also LocalIntersectionOperatorInterface for a description of the template arguments.
  *
@@ -235,16 +357,14 @@ public:
     , param_(param)
     , scaling_(param_.has_key("matrixoperator.scaling") ? param_.get("matrixoperator.scaling").at(0) : 1.)
     , eps_(eps)
-    , source_(*source_space_) // This is a full vector, and intended!
-    , range_(*range_space_) // This is a full vector, and intended!
-    , local_source_inside_(source_.local_discrete_function())
-    , local_source_outside_(source_.local_discrete_function())
-    , local_range_inside_(range_.local_discrete_function())
-    , local_range_outside_(range_.local_discrete_function())
+    , perturbed_source_vector_(source_vector_)
+    , source_(*source_space_, perturbed_source_vector_)
+    , range_storage_inside_(*range_space_)
+    , range_storage_outside_(*range_space_)
+    , local_range_inside_(range_storage_inside_.local_discrete_function())
+    , local_range_outside_(range_storage_outside_.local_discrete_function())
     , local_op_(local_operator.with_source(source_))
-  {
-    source_.dofs().vector() = source_vector_;
-  }
+  {}
 
   LocalIntersectionOperatorFiniteDifferenceJacobianAssembler(const ThisType& other)
     : BaseType(other)
@@ -255,16 +375,14 @@ public:
     , param_(other.param_)
     , scaling_(other.scaling_)
     , eps_(other.eps_)
-    , source_(*source_space_) // This is a full vector, and intended!
-    , range_(*range_space_) // This is a full vector, and intended!
-    , local_source_inside_(source_.local_discrete_function())
-    , local_source_outside_(source_.local_discrete_function())
-    , local_range_inside_(range_.local_discrete_function())
-    , local_range_outside_(range_.local_discrete_function())
+    , perturbed_source_vector_(source_vector_)
+    , source_(*source_space_, perturbed_source_vector_)
+    , range_storage_inside_(*range_space_)
+    , range_storage_outside_(*range_space_)
+    , local_range_inside_(range_storage_inside_.local_discrete_function())
+    , local_range_outside_(range_storage_outside_.local_discrete_function())
     , local_op_(other.local_op_->with_source(source_))
-  {
-    source_.dofs().vector() = source_vector_;
-  }
+  {}
 
   BaseType* copy() override final
   {
@@ -278,7 +396,6 @@ public:
     const bool treat_outside = intersection.neighbor();
     // some preparations
     local_op_->bind(intersection);
-    local_source_inside_->bind(inside_element);
     local_range_inside_->bind(inside_element);
     source_space_->mapper().global_indices(inside_element, global_source_indices_inside_);
     range_space_->mapper().global_indices(inside_element, global_range_indices_inside_);
@@ -290,7 +407,6 @@ public:
       range_DoFs_inside_.resize(local_range_inside_size, 0);
     local_range_inside_->dofs().set_all(0);
     if (treat_outside) {
-      local_source_outside_->bind(outside_element);
       local_range_outside_->bind(outside_element);
       source_space_->mapper().global_indices(outside_element, global_source_indices_outside_);
       range_space_->mapper().global_indices(outside_element, global_range_indices_outside_);
@@ -311,9 +427,9 @@ public:
     // loop over all inside source DoFs
     for (size_t jj = 0; jj < local_source_inside_size; ++jj) {
       // perturb source DoF
-      const auto jjth_source_DoF = local_source_inside_->dofs()[jj];
+      const auto jjth_source_DoF = source_vector_[global_source_indices_inside_[jj]];
       const auto eps = eps_ * (1. + std::abs(jjth_source_DoF));
-      local_source_inside_->dofs()[jj] += eps;
+      perturbed_source_vector_.perturb(global_source_indices_inside_[jj], eps);
       // apply op with perturbed source DoF
       local_op_->apply(*local_range_inside_, *local_range_outside_, param_);
       // observe perturbation in inside range DoFs
@@ -334,8 +450,11 @@ public:
               global_range_indices_outside_[ii], global_source_indices_inside_[jj], scaling_ * derivative);
         }
       }
-      // restore source
-      local_source_inside_->dofs()[jj] = jjth_source_DoF;
+      // restore source, clear local range
+      perturbed_source_vector_.restore();
+      local_range_inside_->dofs().set_all(0);
+      if (treat_outside)
+        local_range_outside_->dofs().set_all(0);
     }
     if (treat_outside) {
       // clear local range
@@ -344,9 +463,9 @@ public:
       // loop over all outside source DoFs
       for (size_t jj = 0; jj < local_source_outside_size; ++jj) {
         // perturb source DoF
-        const auto jjth_source_DoF = local_source_outside_->dofs()[jj];
+        const auto jjth_source_DoF = source_vector_[global_source_indices_outside_[jj]];
         const auto eps = eps_ * (1. + std::abs(jjth_source_DoF));
-        local_source_outside_->dofs()[jj] += eps;
+        perturbed_source_vector_.perturb(global_source_indices_outside_[jj], eps);
         // apply op with perturbed source DoF
         local_op_->apply(*local_range_inside_, *local_range_outside_, param_);
         // observe perturbation in inside range DoFs
@@ -365,8 +484,10 @@ public:
           matrix_.add_to_entry(
               global_range_indices_outside_[ii], global_source_indices_outside_[jj], scaling_ * derivative);
         }
-        // restore source
-        local_source_outside_->dofs()[jj] = jjth_source_DoF;
+        // restore source, clear local range
+        perturbed_source_vector_.restore();
+        local_range_inside_->dofs().set_all(0);
+        local_range_outside_->dofs().set_all(0);
       }
     }
   } // ... apply_local(...)
@@ -379,10 +500,10 @@ private:
   const XT::Common::Parameter param_;
   const double scaling_;
   const real_t<F> eps_;
-  DiscreteFunction<V, SGV, s_r, s_rC, F> source_;
-  DiscreteFunction<V, RGV, r_r, r_rC, F> range_;
-  std::unique_ptr<LocalDiscreteFunction<V, SGV, s_r, s_rC, F>> local_source_inside_;
-  std::unique_ptr<LocalDiscreteFunction<V, SGV, s_r, s_rC, F>> local_source_outside_;
+  internal::LocallyPerturbedVector<V> perturbed_source_vector_;
+  const ConstDiscreteFunction<internal::LocallyPerturbedVector<V>, SGV, s_r, s_rC, F> source_;
+  internal::ElementLocalRangeStorage<DiscreteFunction<V, RGV, r_r, r_rC, F>> range_storage_inside_;
+  internal::ElementLocalRangeStorage<DiscreteFunction<V, RGV, r_r, r_rC, F>> range_storage_outside_;
   std::unique_ptr<LocalDiscreteFunction<V, RGV, r_r, r_rC, F>> local_range_inside_;
   std::unique_ptr<LocalDiscreteFunction<V, RGV, r_r, r_rC, F>> local_range_outside_;
   DynamicVector<size_t> global_source_indices_inside_;
@@ -396,6 +517,18 @@ private:
 
 
 } // namespace GDT
+namespace XT {
+namespace Common {
+
+
+template <class Vector>
+struct VectorAbstraction<GDT::internal::LocallyPerturbedVector<Vector>>
+  : public LA::internal::VectorAbstractionBase<GDT::internal::LocallyPerturbedVector<Vector>>
+{};
+
+
+} // namespace Common
+} // namespace XT
 } // namespace Dune
 
 #endif // DUNE_GDT_LOCAL_ASSEMBLER_OPERATOR_FD_JACOBIAN_ASSEMBLERS_HH
@@ -0,0 +1,338 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_LOCAL_ASSEMBLER_OPERATOR_JACOBIAN_ASSEMBLERS_HH
+#define DUNE_GDT_LOCAL_ASSEMBLER_OPERATOR_JACOBIAN_ASSEMBLERS_HH
+
+#include <memory>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+
+#include <dune/xt/common/parameter.hh>
+#include <dune/xt/la/type_traits.hh>
+#include <dune/xt/grid/functors/interfaces.hh>
+#include <dune/xt/grid/type_traits.hh>
+
+#include <dune/gdt/discretefunction/default.hh>
+#include <dune/gdt/exceptions.hh>
+#include <dune/gdt/local/operators/interfaces.hh>
+#include <dune/gdt/tools/matrix-scatter.hh>
+
+namespace Dune {
+namespace GDT {
+
+
+/**
+ * \brief Assembles the exact jacobian of an operator induced by a local element operator, which provides one.
+ *
+ * In contrast to LocalElementOperatorFiniteDifferenceJacobianAssembler, the local jacobian is computed in one pass per
+ * element and no copy of the source vector is required.
+ *
+ * See also LocalElementOperatorInterface for a description of the template arguments.
+ *
+ * \sa LocalElementOperatorInterface::jacobian
+ */
+template <class M,
+          class SGV,
+          size_t s_r = 1,
+          size_t s_rC = 1,
+          class F = double,
+          size_t r_r = s_r,
+          size_t r_rC = s_rC,
+          class RGV = SGV>
+class LocalElementOperatorJacobianAssembler : public XT::Grid::ElementFunctor<SGV>
+{
+  static_assert(XT::LA::is_matrix<M>::value, "");
+  static_assert(XT::Grid::is_view<SGV>::value, "");
+  static_assert(XT::Grid::is_view<RGV>::value, "");
+  static_assert(std::is_same<XT::Grid::extract_entity_t<SGV>, XT::Grid::extract_entity_t<RGV>>::value, "");
+
+  using BaseType = XT::Grid::ElementFunctor<SGV>;
+  using ThisType = LocalElementOperatorJacobianAssembler;
+  using LocalMatrixScattererType = LocalMatrixScatterer<M>;
+
+public:
+  using typename BaseType::ElementType;
+
+  using MatrixType = M;
+  using VectorType = XT::LA::vector_t<M>;
+  using V = VectorType;
+
+  using LocalElementOperatorType = LocalElementOperatorInterface<V, SGV, s_r, s_rC, F, r_r, r_rC, F, RGV>;
+  using SourceSpaceType = typename LocalElementOperatorType::DiscreteSourceType::SpaceType;
+  using RangeSpaceType = typename LocalElementOperatorType::LocalRangeType::SpaceType;
+
+  LocalElementOperatorJacobianAssembler(const SourceSpaceType& source_space,
+                                        const RangeSpaceType& range_space,
+                                        MatrixType& matrix,
+                                        const VectorType& source_vector,
+                                        const LocalElementOperatorType& local_operator,
+                                        const XT::Common::Parameter& param = {})
+    : BaseType()
+    , source_space_(source_space.copy())
+    , range_space_(range_space.copy())
+    , matrix_(matrix)
+    , param_(param)
+    , scaling_(param_.has_key("matrixoperator.scaling") ? param_.get("matrixoperator.scaling").at(0) : 1.)
+    , source_(*source_space_, source_vector)
+    , local_op_(local_operator.with_source(source_))
+    , source_basis_(source_space_->basis().localize())
+    , range_basis_(range_space_->basis().localize())
+    , scatterer_(matrix_, source_space_->mapper().max_local_size())
+  {
+    DUNE_THROW_IF(!local_op_->provides_jacobian(),
+                  Exceptions::operator_error,
+                  "The local operator does not provide a jacobian, use finite differences instead!");
+  }
+
+  LocalElementOperatorJacobianAssembler(const ThisType& other)
+    : BaseType(other)
+    , source_space_(other.source_space_->copy())
+    , range_space_(other.range_space_->copy())
+    , matrix_(other.matrix_)
+    , param_(other.param_)
+    , scaling_(other.scaling_)
+    , source_(*source_space_, other.source_.dofs().vector())
+    , local_op_(other.local_op_->with_source(source_))
+    , source_basis_(source_space_->basis().localize())
+    , range_basis_(range_space_->basis().localize())
+    , scatterer_(other.scatterer_)
+  {}
+
+  BaseType* copy() override final
+  {
+    return new ThisType(*this);
+  }
+
+  void prepare() override final
+  {
+    scatterer_.prepare();
+  }
+
+  void apply_local(const ElementType& element) override final
+  {
+    local_op_->bind(element);
+    source_basis_->bind(element);
+    range_basis_->bind(element);
+    local_op_->jacobian(*source_basis_, *range_basis_, local_jacobian_, param_);
+    source_space_->mapper().global_indices(element, global_source_indices_);
+    range_space_->mapper().global_indices(element, global_range_indices_);
+    scatterer_.add_local_matrix(global_range_indices_,
+                                range_basis_->size(param_),
+                                global_source_indices_,
+                                source_basis_->size(param_),
+                                local_jacobian_,
+                                scaling_);
+  } // ... apply_local(...)
+
+  void finalize() override final
+  {
+    scatterer_.scatter_buffers();
+  }
+
+private:
+  std::unique_ptr<const SourceSpaceType> source_space_;
+  std::unique_ptr<const RangeSpaceType> range_space_;
+  MatrixType& matrix_;
+  const XT::Common::Parameter param_;
+  const double scaling_;
+  const ConstDiscreteFunction<V, SGV, s_r, s_rC, F> source_;
+  const std::unique_ptr<LocalElementOperatorType> local_op_;
+  std::unique_ptr<typename LocalElementOperatorType::LocalSourceBasisType> source_basis_;
+  std::unique_ptr<typename LocalElementOperatorType::LocalRangeBasisType> range_basis_;
+  DynamicMatrix<F> local_jacobian_;
+  DynamicVector<size_t> global_source_indices_;
+  DynamicVector<size_t> global_range_indices_;
+  LocalMatrixScattererType scatterer_;
+}; // class LocalElementOperatorJacobianAssembler
+
+
+/**
+ * \brief Assembles the exact jacobian of an operator induced by a local intersection operator, which provides one.
+ *
+ * On boundary intersections, the outside bases are bound to the inside element (in accordance with
+ * LocalIntersectionOperatorInterface::post_bind), thus the outside source contributions are added to the inside
+ * source DoFs and the outside range contributions are dropped (as in
+ * LocalIntersectionOperatorFiniteDifferenceJacobianAssembler).
+ *
+ * See also LocalIntersectionOperatorInterface for a description of the template arguments.
+ *
+ * \sa LocalIntersectionOperatorInterface::jacobian
+ */
+template <class M,
+          class SGV,
+          size_t s_r = 1,
+          size_t s_rC = 1,
+          class F = double,
+          size_t r_r = s_r,
+          size_t r_rC = s_rC,
+          class RGV = SGV>
+class LocalIntersectionOperatorJacobianAssembler : public XT::Grid::IntersectionFunctor<SGV>
+{
+  static_assert(XT::LA::is_matrix<M>::value, "");
+  static_assert(XT::Grid::is_view<SGV>::value, "");
+  static_assert(XT::Grid::is_view<RGV>::value, "");
+  static_assert(std::is_same<XT::Grid::extract_entity_t<SGV>, XT::Grid::extract_entity_t<RGV>>::value, "");
+
+  using BaseType = XT::Grid::IntersectionFunctor<SGV>;
+  using ThisType = LocalIntersectionOperatorJacobianAssembler;
+  using LocalMatrixScattererType = LocalMatrixScatterer<M>;
+
+public:
+  using typename BaseType::ElementType;
+  using typename BaseType::I;
+  using typename BaseType::IntersectionType;
+
+  using MatrixType = M;
+  using VectorType = XT::LA::vector_t<M>;
+  using V = VectorType;
+
+  using LocalIntersectionOperatorType = LocalIntersectionOperatorInterface<I, V, SGV, s_r, s_rC, F, r_r, r_rC, F, RGV>;
+  using SourceSpaceType = typename LocalIntersectionOperatorType::DiscreteSourceType::SpaceType;
+  using RangeSpaceType = typename LocalIntersectionOperatorType::LocalInsideRangeType::SpaceType;
+
+  LocalIntersectionOperatorJacobianAssembler(const SourceSpaceType& source_space,
+                                             const RangeSpaceType& range_space,
+                                             MatrixType& matrix,
+                                             const VectorType& source_vector,
+                                             const LocalIntersectionOperatorType& local_operator,
+                                             const XT::Common::Parameter& param = {})
+    : BaseType()
+    , source_space_(source_space.copy())
+    , range_space_(range_space.copy())
+    , matrix_(matrix)
+    , param_(param)
+    , scaling_(param_.has_key("matrixoperator.scaling") ? param_.get("matrixoperator.scaling").at(0) : 1.)
+    , source_(*source_space_, source_vector)
+    , local_op_(local_operator.with_source(source_))
+    , source_basis_inside_(source_space_->basis().localize())
+    , source_basis_outside_(source_space_->basis().localize())
+    , range_basis_inside_(range_space_->basis().localize())
+    , range_basis_outside_(range_space_->basis().localize())
+    , scatterer_(matrix_, source_space_->mapper().max_local_size())
+  {
+    DUNE_THROW_IF(!local_op_->provides_jacobian(),
+                  Exceptions::operator_error,
+                  "The local operator does not provide a jacobian, use finite differences instead!");
+  }
+
+  LocalIntersectionOperatorJacobianAssembler(const ThisType& other)
+    : BaseType(other)
+    , source_space_(other.source_space_->copy())
+    , range_space_(other.range_space_->copy())
+    , matrix_(other.matrix_)
+    , param_(other.param_)
+    , scaling_(other.scaling_)
+    , source_(*source_space_, other.source_.dofs().vector())
+    , local_op_(other.local_op_->with_source(source_))
+    , source_basis_inside_(source_space_->basis().localize())
+    , source_basis_outside_(source_space_->basis().localize())
+    , range_basis_inside_(range_space_->basis().localize())
+    , range_basis_outside_(range_space_->basis().localize())
+    , scatterer_(other.scatterer_)
+  {}
+
+  BaseType* copy() override final
+  {
+    return new ThisType(*this);
+  }
+
+  void prepare() override final
+  {
+    scatterer_.prepare();
+  }
+
+  void apply_local(const IntersectionType& intersection,
+                   const ElementType& inside_element,
+                   const ElementType& outside_element) override final
+  {
+    const bool treat_outside = intersection.neighbor();
+    const auto& outside = treat_outside ? outside_element : inside_element;
+    local_op_->bind(intersection);
+    source_basis_inside_->bind(inside_element);
+    source_basis_outside_->bind(outside);
+    range_basis_inside_->bind(inside_element);
+    range_basis_outside_->bind(outside);
+    local_op_->jacobian(*source_basis_inside_,
+                        *source_basis_outside_,
+                        *range_basis_inside_,
+                        *range_basis_outside_,
+                        local_jacobian_in_in_,
+                        local_jacobian_in_out_,
+                        local_jacobian_out_in_,
+                        local_jacobian_out_out_,
+                        param_);
+    source_space_->mapper().global_indices(inside_element, global_source_indices_inside_);
+    source_space_->mapper().global_indices(outside, global_source_indices_outside_);
+    range_space_->mapper().global_indices(inside_element, global_range_indices_inside_);
+    const size_t source_size_inside = source_basis_inside_->size(param_);
+    const size_t source_size_outside = source_basis_outside_->size(param_);
+    const size_t range_size_inside = range_basis_inside_->size(param_);
+    scatterer_.add_local_matrix(global_range_indices_inside_,
+                                range_size_inside,
+                                global_source_indices_inside_,
+                                source_size_inside,
+                                local_jacobian_in_in_,
+                                scaling_);
+    scatterer_.add_local_matrix(global_range_indices_inside_,
+                                range_size_inside,
+                                global_source_indices_outside_,
+                                source_size_outside,
+                                local_jacobian_in_out_,
+                                scaling_);
+    if (treat_outside) {
+      range_space_->mapper().global_indices(outside_element, global_range_indices_outside_);
+      const size_t range_size_outside = range_basis_outside_->size(param_);
+      scatterer_.add_local_matrix(global_range_indices_outside_,
+                                  range_size_outside,
+                                  global_source_indices_inside_,
+                                  source_size_inside,
+                                  local_jacobian_out_in_,
+                                  scaling_);
+      scatterer_.add_local_matrix(global_range_indices_outside_,
+                                  range_size_outside,
+                                  global_source_indices_outside_,
+                                  source_size_outside,
+                                  local_jacobian_out_out_,
+                                  scaling_);
+    }
+  } // ... apply_local(...)
+
+  void finalize() override final
+  {
+    scatterer_.scatter_buffers();
+  }
+
+private:
+  std::unique_ptr<const SourceSpaceType> source_space_;
+  std::unique_ptr<const RangeSpaceType> range_space_;
+  MatrixType& matrix_;
+  const XT::Common::Parameter param_;
+  const double scaling_;
+  const ConstDiscreteFunction<V, SGV, s_r, s_rC, F> source_;
+  const std::unique_ptr<LocalIntersectionOperatorType> local_op_;
+  std::unique_ptr<typename LocalIntersectionOperatorType::LocalSourceBasisType> source_basis_inside_;
+  std::unique_ptr<typename LocalIntersectionOperatorType::LocalSourceBasisType> source_basis_outside_;
+  std::unique_ptr<typename LocalIntersectionOperatorType::LocalInsideRangeBasisType> range_basis_inside_;
+  std::unique_ptr<typename LocalIntersectionOperatorType::LocalOutsideRangeBasisType> range_basis_outside_;
+  DynamicMatrix<F> local_jacobian_in_in_;
+  DynamicMatrix<F> local_jacobian_in_out_;
+  DynamicMatrix<F> local_jacobian_out_in_;
+  DynamicMatrix<F> local_jacobian_out_out_;
+  DynamicVector<size_t> global_source_indices_inside_;
+  DynamicVector<size_t> global_source_indices_outside_;
+  DynamicVector<size_t> global_range_indices_inside_;
+  DynamicVector<size_t> global_range_indices_outside_;
+  LocalMatrixScattererType scatterer_;
+}; // class LocalIntersectionOperatorJacobianAssembler
+
+
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_LOCAL_ASSEMBLER_OPERATOR_JACOBIAN_ASSEMBLERS_HH
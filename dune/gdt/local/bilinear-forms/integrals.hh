@@ -93,28 +93,18 @@ public:
     if (result.rows() < rows || result.cols() < cols)
       result.resize(rows, cols);
     result *= 0;
-    // loop over all quadrature points
+    // integrate over all quadrature points at once
     const auto integrand_order = integrand_->order(test_basis, ansatz_basis) + over_integrate_;
-    for (const auto& quadrature_point : QuadratureRules<D, d>::rule(element.geometry().type(), integrand_order)) {
-      const auto point_in_reference_element = quadrature_point.position();
-      // integration factors
-      const auto integration_factor = element.geometry().integrationElement(point_in_reference_element);
-      const auto quadrature_weight = quadrature_point.weight();
-      // evaluate the integrand
-      integrand_->evaluate(test_basis, ansatz_basis, point_in_reference_element, integrand_values_, param);
-      assert(integrand_values_.rows() >= rows && "This must not happen!");
-      assert(integrand_values_.cols() >= cols && "This must not happen!");
-      // compute integral
-      for (size_t ii = 0; ii < rows; ++ii)
-        for (size_t jj = 0; jj < cols; ++jj)
-          result[ii][jj] += integrand_values_[ii][jj] * integration_factor * quadrature_weight;
-    } // loop over all quadrature points
+    integrand_->integrate(test_basis,
+                          ansatz_basis,
+                          QuadratureRules<D, d>::rule(element.geometry().type(), integrand_order),
+                          result,
+                          param);
   } // ... apply(...)
 
 private:
   mutable std::unique_ptr<IntegrandType> integrand_;
   const int over_integrate_;
-  mutable DynamicMatrix<F> integrand_values_;
 }; // class LocalElementIntegralBilinearForm
 
 
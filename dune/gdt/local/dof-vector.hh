@@ -75,12 +75,43 @@ public:
 };
 
 
+/**
+ * \brief Determines if the entries of Vector are stored in one contiguous array, i.e., if &vector[ii] + jj equals
+ *        &vector[ii + jj] (true for the dense backends).
+ */
+template <class Vector>
+struct has_contiguous_storage
+{
+  template <class V>
+  static constexpr bool check(int, decltype(V::Traits::backend_type)* = nullptr)
+  {
+    return V::Traits::backend_type == XT::LA::Backends::common_dense
+           || V::Traits::backend_type == XT::LA::Backends::istl_dense
+           || V::Traits::backend_type == XT::LA::Backends::eigen_dense;
+  }
+
+  template <class V>
+  static constexpr bool check(long)
+  {
+    return false;
+  }
+
+  static const constexpr bool value = check<Vector>(0);
+}; // struct has_contiguous_storage
+
+
 } // namespace internal
 
 
 /**
  * \note Since all implementations of XT::LA::VectorInterface are assumed to be thread safe, no special care needs to be
- *       taken here.
+ *       taken here: add_to_entry() and set_entry() always go through the global vector (and its locking).
+ *
+ * \note If the DoFs of each element are contiguous (see MapperInterface::element_indices_are_contiguous(), e.g. for
+ *       finite volume and discontinuous spaces) and the global vector is dense, the DoFs are read directly from the
+ *       storage of the global vector after bind(), instead of indirectly via the global DoF indices. Modifying the
+ *       global vector while bound in a way that reallocates its storage (e.g. resizing it or writing to a copy sharing
+ *       its data) thus requires to bind again.
  */
 template <class Vector, class GridView, class Traits>
 class ConstLocalDofVector
@@ -100,21 +131,24 @@ public:
   ConstLocalDofVector(const MapperType& mapper, const VectorType& global_vector)
     : mapper_(mapper)
     , global_vector_(global_vector)
+    , contiguous_(internal::has_contiguous_storage<Vector>::value && mapper_.element_indices_are_contiguous())
     , global_DoF_indices_(mapper_.max_local_size())
     , size_(0)
+    , data_(nullptr)
   {}
 
   ConstLocalDofVector(const ThisType& other) = default;
   ConstLocalDofVector(ThisType&& source) = default;
 
 protected:
-  void post_bind(const ElementType& ele) override final
+  void post_bind(const ElementType& ele) override
   {
     mapper_.global_indices(ele, global_DoF_indices_);
     size_ = mapper_.local_size(ele);
     DUNE_THROW_IF(global_DoF_indices_.size() < size_,
                   Exceptions::dof_vector_error,
                   "This must not happen, the mapper is broken!");
+    data_ = (contiguous_ && size_ > 0) ? &global_vector_[global_DoF_indices_[0]] : nullptr;
   }
 
 public:
@@ -143,7 +177,7 @@ public:
   {
     DUNE_THROW_IF(!this->is_bound_, Exceptions::not_bound_to_an_element_yet, "");
     assert(ii < size_);
-    return global_vector_.get_entry(global_DoF_indices_[ii]);
+    return data_ ? data_[ii] : global_vector_.get_entry(global_DoF_indices_[ii]);
   }
 
 protected:
@@ -158,7 +192,7 @@ protected:
     DUNE_THROW_IF(!this->is_bound_, Exceptions::not_bound_to_an_element_yet, "");
     assert(ii < size_);
     // This is not optimal, but global_vector_.get_unchecked_ref is protected.
-    return global_vector_[global_DoF_indices_[ii]];
+    return data_ ? data_[ii] : global_vector_[global_DoF_indices_[ii]];
   }
 
 public:
@@ -172,7 +206,7 @@ public:
   {
     DUNE_THROW_IF(!this->is_bound_, Exceptions::not_bound_to_an_element_yet, "");
     assert(ii < size_);
-    return global_vector_[global_DoF_indices_[ii]];
+    return data_ ? data_[ii] : global_vector_[global_DoF_indices_[ii]];
   }
 
 protected:
@@ -184,8 +218,11 @@ private:
   const VectorType& global_vector_;
 
 protected:
+  const bool contiguous_;
   DynamicVector<size_t> global_DoF_indices_;
   size_t size_;
+  // the DoFs of the bound element in the storage of global_vector_, if contiguous_
+  const ScalarType* data_;
 
 private:
   ScalarType dummy_scalar_to_silence_the_warning_;
@@ -203,6 +240,7 @@ public:
   using typename BaseType::ScalarType;
   using VectorType = Vector;
   using MapperType = MapperInterface<GridView>;
+  using typename BaseType::ElementType;
 
   LocalDofVector(const MapperType& mapper, VectorType& global_vector)
     : BaseType(mapper, global_vector)
@@ -212,6 +250,16 @@ public:
   LocalDofVector(const ThisType&) = default;
   LocalDofVector(ThisType&&) = default;
 
+protected:
+  void post_bind(const ElementType& ele) override final
+  {
+    BaseType::post_bind(ele);
+    // the non-const access ensures that global_vector_ does not share its data with a copy, which would be detached
+    // (and data_ would be dangling) on the next write
+    data_ = data_ ? &global_vector_[global_DoF_indices_[0]] : nullptr;
+  }
+
+public:
   void add_to_entry(const size_t ii, const ScalarType& value)
   {
     DUNE_THROW_IF(!this->is_bound_, Exceptions::not_bound_to_an_element_yet, "");
@@ -230,7 +278,7 @@ public:
   {
     DUNE_THROW_IF(!this->is_bound_, Exceptions::not_bound_to_an_element_yet, "");
     assert(ii < size_);
-    return global_vector_.get_entry(global_DoF_indices_[ii]);
+    return data_ ? data_[ii] : global_vector_.get_entry(global_DoF_indices_[ii]);
   }
 
 protected:
@@ -245,7 +293,7 @@ protected:
   {
     DUNE_THROW_IF(!this->is_bound_, Exceptions::not_bound_to_an_element_yet, "");
     assert(ii < size_);
-    return global_vector_[global_DoF_indices_[ii]];
+    return data_ ? data_[ii] : global_vector_[global_DoF_indices_[ii]];
   }
 
 public:
@@ -260,7 +308,7 @@ public:
   {
     DUNE_THROW_IF(!this->is_bound_, Exceptions::not_bound_to_an_element_yet, "");
     assert(ii < size_);
-    return global_vector_[global_DoF_indices_[ii]];
+    return data_ ? data_[ii] : global_vector_[global_DoF_indices_[ii]];
   }
 
 private:
@@ -271,6 +319,7 @@ private:
   VectorType& global_vector_;
   using BaseType::global_DoF_indices_;
   using BaseType::size_;
+  using BaseType::data_;
 }; // class LocalDofVector
 
 
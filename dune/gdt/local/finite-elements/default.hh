@@ -11,6 +11,11 @@
 #ifndef DUNE_GDT_LOCAL_FINITE_ELEMENTS_DEFAULT_HH
 #define DUNE_GDT_LOCAL_FINITE_ELEMENTS_DEFAULT_HH
 
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
+
 #include <dune/geometry/quadraturerules.hh>
 
 #include <dune/xt/common/memory.hh>
@@ -147,6 +152,15 @@ private:
 }; // class LocalFiniteElementDefault
 
 
+/**
+ * \brief Creates local finite elements on demand and serves them wait-free afterwards.
+ *
+ * All finite elements with order < max_indexed_order are published in a flat table of atomic pointers, indexed by the
+ * topology of the geometry type and the order, such that get() amounts to a single (acquire) load once the element
+ * exists. Since spaces request the finite elements of all geometry types of their grid view in update_after_adapt(),
+ * the table is usually fully populated before any grid walk starts. Missing or higher order finite elements are
+ * created (or looked up) under a lock.
+ */
 template <class D, size_t d, class R = double, size_t r = 1, size_t rC = 1>
 class ThreadSafeDefaultLocalFiniteElementFamily : public LocalFiniteElementFamilyInterface<D, d, R, r, rC>
 {
@@ -156,41 +170,76 @@ class ThreadSafeDefaultLocalFiniteElementFamily : public LocalFiniteElementFamil
 public:
   using typename BaseType::LocalFiniteElementType;
 
+  static const constexpr int max_indexed_order = 16;
+
+private:
+  // all topology ids of dimension d are below 2^d, plus one for the none geometry type
+  static const constexpr size_t num_indexed_topologies = (size_t(1) << d) + 1;
+  static const constexpr size_t table_size = num_indexed_topologies * max_indexed_order;
+
+public:
   ThreadSafeDefaultLocalFiniteElementFamily(
       std::function<std::unique_ptr<LocalFiniteElementType>(const GeometryType&, const int&)> factory)
     : factory_(factory)
-  {}
+  {
+    clear_table();
+  }
 
   ThreadSafeDefaultLocalFiniteElementFamily(const ThisType& other)
     : factory_(other.factory_)
   {
-    // we do not even try to create the FEs in a thread safe way, they will just be recreated when required
+    // we do not even try to copy the FEs in a thread safe way, they will just be recreated when required
+    clear_table();
   }
 
   ThreadSafeDefaultLocalFiniteElementFamily(ThisType&& source)
     : factory_(std::move(source.factory_))
     , fes_(std::move(source.fes_))
-  {}
+  {
+    // the FEs themselves are not moved, so the pointers stay valid
+    for (size_t ii = 0; ii < table_size; ++ii)
+      table_[ii].store(source.table_[ii].load(std::memory_order_acquire), std::memory_order_relaxed);
+  }
 
   const LocalFiniteElementType& get(const GeometryType& geometry_type, const int order) const override final
   {
-    const auto key = std::make_pair(geometry_type, order);
-    // if the FE already exists, no need to lock since at() is thread safe and we are returning the object reference,
-    // not a map iterator which might get invalidated
-    // TODO: Double checked locking pattern is not thread-safe without memory barriers.
-    if (fes_.count(key) == 0) {
-      // the FE needs to be created, we need to lock
-      std::lock_guard<std::mutex> DXTC_UNUSED(guard)(mutex_);
-      // and to check again if someone else created the FE while we were waiting to acquire the lock
-      if (fes_.count(key) == 0)
-        fes_[key] = factory_(geometry_type, order);
+    const size_t index = table_index(geometry_type, order);
+    if (index < table_size) {
+      const auto* fe = table_[index].load(std::memory_order_acquire);
+      if (fe != nullptr)
+        return *fe;
     }
-    return *fes_.at(key);
+    // the FE needs to be created (or is not indexed), we need to lock
+    std::lock_guard<std::mutex> DXTC_UNUSED(guard)(mutex_);
+    auto& fe = fes_[std::make_pair(geometry_type, order)];
+    if (!fe)
+      fe = factory_(geometry_type, order);
+    // the release store publishes the fully constructed FE to all subsequent acquire loads
+    if (index < table_size)
+      table_[index].store(fe.get(), std::memory_order_release);
+    return *fe;
   } // ... get(...)
 
 private:
+  static size_t table_index(const GeometryType& geometry_type, const int order)
+  {
+    if (order < 0 || order >= max_indexed_order || geometry_type.dim() != d)
+      return table_size;
+    const size_t topology = geometry_type.isNone() ? (num_indexed_topologies - 1) : geometry_type.id();
+    if (topology >= num_indexed_topologies)
+      return table_size;
+    return static_cast<size_t>(order) * num_indexed_topologies + topology;
+  }
+
+  void clear_table()
+  {
+    for (size_t ii = 0; ii < table_size; ++ii)
+      table_[ii].store(nullptr, std::memory_order_relaxed);
+  }
+
   const std::function<std::unique_ptr<LocalFiniteElementType>(const GeometryType&, const int&)> factory_;
   mutable std::map<std::pair<GeometryType, int>, std::unique_ptr<LocalFiniteElementType>> fes_;
+  mutable std::array<std::atomic<const LocalFiniteElementType*>, table_size> table_;
   mutable std::mutex mutex_;
 }; // class ThreadSafeDefaultLocalFiniteElementFamily
 
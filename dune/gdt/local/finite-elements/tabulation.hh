@@ -0,0 +1,159 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_LOCAL_FINITE_ELEMENTS_TABULATION_HH
+#define DUNE_GDT_LOCAL_FINITE_ELEMENTS_TABULATION_HH
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+#include <dune/common/hash.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/type.hh>
+
+#include "interfaces.hh"
+
+namespace Dune {
+namespace GDT {
+
+
+/**
+ * \brief Values and reference jacobians of the basis of a local finite element at all points of a quadrature.
+ *
+ * Immutable once created, thus safe to be shared between threads.
+ *
+ * \sa LocalFiniteElementTabulationCache
+ */
+template <class D, size_t d, class R, size_t r = 1, size_t rC = 1>
+class LocalFiniteElementTabulation
+{
+public:
+  using LocalFiniteElementType = LocalFiniteElementInterface<D, d, R, r, rC>;
+  using RangeType = typename LocalFiniteElementType::BasisType::RangeType;
+  using DerivativeRangeType = typename LocalFiniteElementType::BasisType::DerivativeRangeType;
+
+  LocalFiniteElementTabulation(const LocalFiniteElementType& finite_element, const QuadratureRule<D, d>& quadrature)
+    : geometry_type_(finite_element.geometry_type())
+    , fe_order_(finite_element.order())
+    , quadrature_type_(quadrature.type())
+    , quadrature_order_(quadrature.order())
+    , points_(quadrature.size())
+    , values_(quadrature.size())
+    , jacobians_(quadrature.size())
+  {
+    for (size_t qq = 0; qq < quadrature.size(); ++qq) {
+      points_[qq] = quadrature[qq].position();
+      finite_element.basis().evaluate(quadrature[qq].position(), values_[qq]);
+      finite_element.basis().jacobian(quadrature[qq].position(), jacobians_[qq]);
+    }
+  }
+
+  /**
+   * \brief Checks if this tabulation was created for the given finite element and quadrature, comparing the quadrature
+   *        points exactly (quadratures of the same size may differ, e.g. face quadratures of different faces).
+   */
+  bool matches(const LocalFiniteElementType& finite_element, const QuadratureRule<D, d>& quadrature) const
+  {
+    if (finite_element.geometry_type() != geometry_type_ || finite_element.order() != fe_order_
+        || quadrature.type() != quadrature_type_ || quadrature.order() != quadrature_order_
+        || quadrature.size() != points_.size())
+      return false;
+    for (size_t qq = 0; qq < points_.size(); ++qq)
+      if (quadrature[qq].position() != points_[qq])
+        return false;
+    return true;
+  }
+
+  /// \brief values()[qq][ii] is the value of the ii-th basis function in the qq-th quadrature point
+  const std::vector<std::vector<RangeType>>& values() const
+  {
+    return values_;
+  }
+
+  /// \brief jacobians()[qq][ii] is the jacobian of the ii-th basis function in the qq-th quadrature point
+  const std::vector<std::vector<DerivativeRangeType>>& jacobians() const
+  {
+    return jacobians_;
+  }
+
+private:
+  const GeometryType geometry_type_;
+  const int fe_order_;
+  const GeometryType quadrature_type_;
+  const int quadrature_order_;
+  std::vector<FieldVector<D, d>> points_;
+  std::vector<std::vector<RangeType>> values_;
+  std::vector<std::vector<DerivativeRangeType>> jacobians_;
+}; // class LocalFiniteElementTabulation
+
+
+/**
+ * \brief Thread safe cache of LocalFiniteElementTabulation, keyed on geometry type and order of the finite element and
+ *        on geometry type, order, size and a hash of the points of the quadrature.
+ *
+ * Tabulations with colliding keys are told apart by LocalFiniteElementTabulation::matches.
+ *
+ * Since all elements of one geometry type share the reference values and jacobians, a global basis may hold one cache
+ * shared by all its localized bases, which then only need to apply the element transformation.
+ */
+template <class D, size_t d, class R, size_t r = 1, size_t rC = 1>
+class LocalFiniteElementTabulationCache
+{
+public:
+  using TabulationType = LocalFiniteElementTabulation<D, d, R, r, rC>;
+  using LocalFiniteElementType = typename TabulationType::LocalFiniteElementType;
+
+  std::shared_ptr<const TabulationType> get(const LocalFiniteElementType& finite_element,
+                                            const QuadratureRule<D, d>& quadrature) const
+  {
+    const auto key = std::make_tuple(finite_element.geometry_type(),
+                                     finite_element.order(),
+                                     quadrature.type(),
+                                     quadrature.order(),
+                                     quadrature.size(),
+                                     hash(quadrature));
+    std::lock_guard<std::mutex> DXTC_UNUSED(guard)(mutex_);
+    auto& tabulations = tabulations_[key];
+    for (const auto& tabulation : tabulations)
+      if (tabulation->matches(finite_element, quadrature))
+        return tabulation;
+    tabulations.emplace_back(std::make_shared<const TabulationType>(finite_element, quadrature));
+    return tabulations.back();
+  }
+
+  void clear()
+  {
+    std::lock_guard<std::mutex> DXTC_UNUSED(guard)(mutex_);
+    tabulations_.clear();
+  }
+
+private:
+  static size_t hash(const QuadratureRule<D, d>& quadrature)
+  {
+    size_t seed = 0;
+    for (const auto& quadrature_point : quadrature)
+      for (size_t ii = 0; ii < d; ++ii)
+        hash_combine(seed, quadrature_point.position()[ii]);
+    return seed;
+  }
+
+  mutable std::map<std::tuple<GeometryType, int, GeometryType, int, size_t, size_t>,
+                   std::vector<std::shared_ptr<const TabulationType>>>
+      tabulations_;
+  mutable std::mutex mutex_;
+}; // class LocalFiniteElementTabulationCache
+
+
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_LOCAL_FINITE_ELEMENTS_TABULATION_HH
@@ -80,26 +80,15 @@ public:
     if (result.size() < size)
       result.resize(size);
     result *= 0;
-    // loop over all quadrature points
+    // integrate over all quadrature points at once
     const auto integrand_order = integrand_->order(basis, param) + over_integrate_;
-    for (auto&& quadrature_point : QuadratureRules<D, d>::rule(element.geometry().type(), integrand_order)) {
-      const auto point_in_reference_element = quadrature_point.position();
-      // integration factors
-      const auto integration_factor = element.geometry().integrationElement(point_in_reference_element);
-      const auto quadrature_weight = quadrature_point.weight();
-      // evaluate the integrand
-      integrand_->evaluate(basis, point_in_reference_element, integrand_values_, param);
-      assert(integrand_values_.size() >= size && "This must not happen!");
-      // compute integral
-      for (size_t ii = 0; ii < size; ++ii)
-        result[ii] += integrand_values_[ii] * integration_factor * quadrature_weight;
-    } // loop over all quadrature points
+    integrand_->integrate(
+        basis, QuadratureRules<D, d>::rule(element.geometry().type(), integrand_order), result, param);
   } // ... apply(...)
 
 private:
   mutable std::unique_ptr<IntegrandType> integrand_;
   const int over_integrate_;
-  mutable DynamicVector<F> integrand_values_;
 }; // class LocalElementIntegralFunctional
 
 
@@ -43,6 +43,8 @@ class LocalBinaryToUnaryElementIntegrand : public LocalUnaryElementIntegrandInte
   using BaseType = LocalUnaryElementIntegrandInterface<E, a_r, a_rC, AF, F>;
 
 public:
+  using BaseType::d;
+  using typename BaseType::D;
   using typename BaseType::DomainType;
   using typename BaseType::ElementType;
   using typename BaseType::LocalBasisType;
@@ -100,6 +102,24 @@ public:
     result = local_binary_integrand_result_[0];
   } // ... evaluate(...)
 
+  void integrate(const LocalBasisType& basis,
+                 const QuadratureRule<D, d>& quadrature,
+                 DynamicVector<F>& result,
+                 const XT::Common::Parameter& param = {}) const override final
+  {
+    // prepare storage
+    const auto size = basis.size(param);
+    if (result.size() < size)
+      result.resize(size, 0.);
+    // integrate, the inducing function is the only test function
+    local_binary_integrand_result_.resize(1, size);
+    local_binary_integrand_result_ *= 0.;
+    local_binary_integrand_->integrate(*local_function_, basis, quadrature, local_binary_integrand_result_, param);
+    // extract result
+    for (size_t ii = 0; ii < size; ++ii)
+      result[ii] += local_binary_integrand_result_[0][ii];
+  } // ... integrate(...)
+
 private:
   const LocalizableFunctionType& inducing_function_as_test_basis_;
   std::unique_ptr<typename LocalizableFunctionType::LocalFunctionType> local_function_;
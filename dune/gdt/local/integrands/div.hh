@@ -61,6 +61,46 @@ protected:
         result[ii][jj] = (function_value * div_ii) * values[jj];
     }
   }
+
+  /// Stores `w_q |det(J(x_q))| f(x_q) div(psi_ii(x_q))` in div_rows and `phi_jj(x_q)` in value_rows (one per point).
+  template <class DivBasis,
+            class SecondBasis,
+            class Quadrature,
+            class Geometry,
+            class LocalFunction,
+            class Jacobians,
+            class Values,
+            class F>
+  void integrate(const DivBasis& div_basis,
+                 const SecondBasis& second_basis,
+                 const Quadrature& quadrature,
+                 const Geometry& geometry,
+                 const XT::Common::Parameter param,
+                 const LocalFunction& local_function,
+                 Jacobians& jacobians,
+                 Values& values,
+                 std::vector<F*>& div_rows,
+                 std::vector<F*>& value_rows) const
+  {
+    static const size_t d = DivBasis::d;
+    const size_t rows = div_basis.size(param);
+    const size_t cols = second_basis.size(param);
+    const auto& div_basis_jacobians = jacobians_at_quadrature(div_basis, quadrature, jacobians, param);
+    const auto& second_basis_values = evaluate_at_quadrature(second_basis, quadrature, values, param);
+    for (size_t qq = 0; qq < quadrature.size(); ++qq) {
+      const auto reference_point = quadrature[qq].position();
+      const auto factor = geometry.integrationElement(reference_point) * quadrature[qq].weight();
+      const auto function_value = local_function.evaluate(reference_point, param);
+      for (size_t ii = 0; ii < rows; ++ii) {
+        typename DivBasis::R div_ii = 0;
+        for (size_t dd = 0; dd < d; ++dd)
+          div_ii += div_basis_jacobians[qq][ii][dd][dd];
+        div_rows[ii][qq] = factor * function_value[0] * div_ii;
+      }
+      for (size_t jj = 0; jj < cols; ++jj)
+        value_rows[jj][qq] = second_basis_values[qq][jj][0];
+    }
+  } // ... integrate(...)
 };
 
 
@@ -86,6 +126,7 @@ class LocalElementAnsatzValueTestDivProductIntegrand
 
 public:
   using BaseType::d;
+  using typename BaseType::D;
   using typename BaseType::DomainType;
   using typename BaseType::ElementType;
   using typename BaseType::LocalAnsatzBasisType;
@@ -160,11 +201,44 @@ public:
                           ansatz_basis_values_);
   } // ... evaluate(...)
 
+  void integrate(const LocalTestBasisType& test_basis,
+                 const LocalAnsatzBasisType& ansatz_basis,
+                 const QuadratureRule<D, d>& quadrature,
+                 DynamicMatrix<F>& result,
+                 const XT::Common::Parameter& param = {}) const override final
+  {
+    const size_t rows = test_basis.size(param);
+    const size_t cols = ansatz_basis.size(param);
+    batch_.resize(rows, cols, quadrature.size());
+    test_rows_.resize(rows);
+    for (size_t ii = 0; ii < rows; ++ii)
+      test_rows_[ii] = batch_.test(ii);
+    ansatz_rows_.resize(cols);
+    for (size_t jj = 0; jj < cols; ++jj)
+      ansatz_rows_[jj] = batch_.ansatz(jj);
+    DivBaseType::integrate(test_basis,
+                           ansatz_basis,
+                           quadrature,
+                           this->element().geometry(),
+                           param,
+                           *local_function_,
+                           test_jacobians_at_quadrature_,
+                           ansatz_values_at_quadrature_,
+                           test_rows_,
+                           ansatz_rows_);
+    batch_.add_to(result);
+  } // ... integrate(...)
+
 private:
   const XT::Common::ConstStorageProvider<GridFunctionType> inducing_function_;
   std::unique_ptr<typename GridFunctionType::LocalFunctionType> local_function_;
   mutable std::vector<typename LocalTestBasisType::DerivativeRangeType> test_basis_jacobians_;
   mutable std::vector<typename LocalAnsatzBasisType::RangeType> ansatz_basis_values_;
+  mutable std::vector<std::vector<typename LocalTestBasisType::DerivativeRangeType>> test_jacobians_at_quadrature_;
+  mutable std::vector<std::vector<typename LocalAnsatzBasisType::RangeType>> ansatz_values_at_quadrature_;
+  mutable internal::LocalBinaryIntegrandBatch<F> batch_;
+  mutable std::vector<F*> test_rows_;
+  mutable std::vector<F*> ansatz_rows_;
 }; // class LocalElementAnsatzValueTestDivProductIntegrand
 
 
@@ -185,6 +259,7 @@ class LocalElementAnsatzDivTestValueProductIntegrand
 
 public:
   using BaseType::d;
+  using typename BaseType::D;
   using typename BaseType::DomainType;
   using typename BaseType::ElementType;
   using typename BaseType::LocalAnsatzBasisType;
@@ -257,11 +332,45 @@ public:
     result = XT::Common::transposed(result);
   } // ... evaluate(...)
 
+  void integrate(const LocalTestBasisType& test_basis,
+                 const LocalAnsatzBasisType& ansatz_basis,
+                 const QuadratureRule<D, d>& quadrature,
+                 DynamicMatrix<F>& result,
+                 const XT::Common::Parameter& param = {}) const override final
+  {
+    const size_t rows = test_basis.size(param);
+    const size_t cols = ansatz_basis.size(param);
+    batch_.resize(rows, cols, quadrature.size());
+    test_rows_.resize(rows);
+    for (size_t ii = 0; ii < rows; ++ii)
+      test_rows_[ii] = batch_.test(ii);
+    ansatz_rows_.resize(cols);
+    for (size_t jj = 0; jj < cols; ++jj)
+      ansatz_rows_[jj] = batch_.ansatz(jj);
+    // the roles are swapped: the divergence is taken of the ansatz basis
+    DivBaseType::integrate(ansatz_basis,
+                           test_basis,
+                           quadrature,
+                           this->element().geometry(),
+                           param,
+                           *local_function_,
+                           ansatz_jacobians_at_quadrature_,
+                           test_values_at_quadrature_,
+                           ansatz_rows_,
+                           test_rows_);
+    batch_.add_to(result);
+  } // ... integrate(...)
+
 private:
   const XT::Common::ConstStorageProvider<GridFunctionType> inducing_function_;
   std::unique_ptr<typename GridFunctionType::LocalFunctionType> local_function_;
   mutable std::vector<typename LocalTestBasisType::RangeType> test_basis_values_;
   mutable std::vector<typename LocalAnsatzBasisType::DerivativeRangeType> ansatz_basis_jacobians_;
+  mutable std::vector<std::vector<typename LocalTestBasisType::RangeType>> test_values_at_quadrature_;
+  mutable std::vector<std::vector<typename LocalAnsatzBasisType::DerivativeRangeType>> ansatz_jacobians_at_quadrature_;
+  mutable internal::LocalBinaryIntegrandBatch<F> batch_;
+  mutable std::vector<F*> test_rows_;
+  mutable std::vector<F*> ansatz_rows_;
 }; // class LocalElementAnsatzDivTestValueProductIntegrand
 
 
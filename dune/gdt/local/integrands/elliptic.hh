@@ -46,6 +46,7 @@ class DXT_DEPRECATED_MSG("Use LocalLaplaceIntegrand instead (10.08.2019)!") Loca
 
 public:
   using BaseType::d;
+  using typename BaseType::D;
   using typename BaseType::DomainType;
   using typename BaseType::ElementType;
   using typename BaseType::LocalAnsatzBasisType;
@@ -142,6 +143,47 @@ public:
           result[ii][jj] += (diffusion * ansatz_basis_grads_[jj][rr]) * test_basis_grads_[ii][rr];
   } // ... evaluate(...)
 
+  void integrate(const LocalTestBasisType& test_basis,
+                 const LocalAnsatzBasisType& ansatz_basis,
+                 const QuadratureRule<D, d>& quadrature,
+                 DynamicMatrix<F>& result,
+                 const XT::Common::Parameter& param = {}) const override final
+  {
+    const size_t rows = test_basis.size(param);
+    const size_t cols = ansatz_basis.size(param);
+    batch_.resize(rows, cols, quadrature.size() * r * d);
+    const auto& geometry = this->element().geometry();
+    const auto& test_basis_grads =
+        internal::jacobians_at_quadrature(test_basis, quadrature, test_grads_at_quadrature_, param);
+    const auto& ansatz_basis_grads =
+        internal::jacobians_at_quadrature(ansatz_basis, quadrature, ansatz_grads_at_quadrature_, param);
+    size_t offset = 0;
+    for (size_t qq = 0; qq < quadrature.size(); ++qq) {
+      const auto& quadrature_point = quadrature[qq];
+      const auto point_in_reference_element = quadrature_point.position();
+      const auto factor = geometry.integrationElement(point_in_reference_element) * quadrature_point.weight();
+      const auto diffusion = local_diffusion_tensor_->evaluate(point_in_reference_element, param)
+                             * local_diffusion_factor_->evaluate(point_in_reference_element, param);
+      // store the test gradients and the weighted ansatz gradients contiguously
+      for (size_t ii = 0; ii < rows; ++ii) {
+        auto* test_values = batch_.test(ii) + offset;
+        for (size_t rr = 0; rr < r; ++rr)
+          for (size_t dd = 0; dd < d; ++dd)
+            test_values[rr * d + dd] = test_basis_grads[qq][ii][rr][dd];
+      }
+      for (size_t jj = 0; jj < cols; ++jj) {
+        auto* ansatz_values = batch_.ansatz(jj) + offset;
+        for (size_t rr = 0; rr < r; ++rr) {
+          const auto weighted_grad = diffusion * ansatz_basis_grads[qq][jj][rr];
+          for (size_t dd = 0; dd < d; ++dd)
+            ansatz_values[rr * d + dd] = factor * weighted_grad[dd];
+        }
+      }
+      offset += r * d;
+    }
+    batch_.add_to(result);
+  } // ... integrate(...)
+
 private:
   const XT::Common::ConstStorageProvider<DiffusionFactorType> diffusion_factor_;
   const XT::Common::ConstStorageProvider<DiffusionTensorType> diffusion_tensor_;
@@ -149,6 +191,9 @@ private:
   std::unique_ptr<typename DiffusionTensorType::LocalFunctionType> local_diffusion_tensor_;
   mutable std::vector<typename LocalTestBasisType::DerivativeRangeType> test_basis_grads_;
   mutable std::vector<typename LocalAnsatzBasisType::DerivativeRangeType> ansatz_basis_grads_;
+  mutable std::vector<std::vector<typename LocalTestBasisType::DerivativeRangeType>> test_grads_at_quadrature_;
+  mutable std::vector<std::vector<typename LocalAnsatzBasisType::DerivativeRangeType>> ansatz_grads_at_quadrature_;
+  mutable internal::LocalBinaryIntegrandBatch<F> batch_;
 }; // class LocalEllipticIntegrand
 
 
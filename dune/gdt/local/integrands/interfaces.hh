@@ -13,14 +13,20 @@
 #ifndef DUNE_GDT_LOCAL_INTEGRANDS_INTERFACES_HH
 #define DUNE_GDT_LOCAL_INTEGRANDS_INTERFACES_HH
 
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
 #include <dune/common/dynvector.hh>
 
+#include <dune/geometry/quadraturerules.hh>
+
 #include <dune/xt/common/parameter.hh>
 #include <dune/xt/grid/bound-object.hh>
 #include <dune/xt/grid/type_traits.hh>
 #include <dune/xt/functions/interfaces/element-functions.hh>
 
 #include <dune/gdt/exceptions.hh>
+#include <dune/gdt/spaces/basis/interface.hh>
 
 namespace Dune {
 namespace GDT {
@@ -39,6 +45,122 @@ class LocalBinaryIntersectionIntegrandSum;
 template <class I, size_t t_r, size_t t_rC, class TF, class F, size_t a_r, size_t a_rC, class AF>
 class LocalQuaternaryIntersectionIntegrandSum;
 
+namespace internal {
+
+
+/**
+ * \brief Contiguous storage for the evaluation of a binary integrand at all points of a quadrature.
+ *
+ * Holds one row of length size() per test and per ansatz function, such that
+ *
+ *   result[ii][jj] += \sum_p test(ii)[p] * ansatz(jj)[p]
+ *
+ * computes the integral, where p runs over all quadrature points (and the components of the integrand at each point).
+ * Usually, the quadrature weights, the integration element and the data functions are multiplied into one of the two
+ * buffers, such that add_to() amounts to a small dense product B_test^T W B_ansatz.
+ */
+template <class F>
+class LocalBinaryIntegrandBatch
+{
+public:
+  void resize(const size_t rows, const size_t cols, const size_t sz)
+  {
+    rows_ = rows;
+    cols_ = cols;
+    size_ = sz;
+    if (test_.size() < rows_ * size_)
+      test_.resize(rows_ * size_);
+    if (ansatz_.size() < cols_ * size_)
+      ansatz_.resize(cols_ * size_);
+  }
+
+  size_t size() const
+  {
+    return size_;
+  }
+
+  F* test(const size_t ii)
+  {
+    return test_.data() + ii * size_;
+  }
+
+  F* ansatz(const size_t jj)
+  {
+    return ansatz_.data() + jj * size_;
+  }
+
+  void add_to(DynamicMatrix<F>& result) const
+  {
+    if (result.rows() < rows_ || result.cols() < cols_)
+      result.resize(rows_, cols_, 0.);
+    for (size_t ii = 0; ii < rows_; ++ii) {
+      const F* test_row = test_.data() + ii * size_;
+      auto& result_row = result[ii];
+      for (size_t jj = 0; jj < cols_; ++jj) {
+        const F* ansatz_row = ansatz_.data() + jj * size_;
+        F sum = 0.;
+        for (size_t pp = 0; pp < size_; ++pp)
+          sum += test_row[pp] * ansatz_row[pp];
+        result_row[jj] += sum;
+      }
+    }
+  } // ... add_to(...)
+
+private:
+  size_t rows_ = 0;
+  size_t cols_ = 0;
+  size_t size_ = 0;
+  std::vector<F> test_;
+  std::vector<F> ansatz_;
+}; // class LocalBinaryIntegrandBatch
+
+
+/**
+ * \brief Values of all functions of the basis at all points of the quadrature, i.e. result[qq][ii].
+ *
+ * Uses the tabulated values if basis is a LocalizedGlobalFiniteElementInterface, otherwise evaluates the basis at each
+ * point and stores the values in storage.
+ */
+template <class E, size_t r, size_t rC, class R, class D, int d>
+const std::vector<std::vector<typename XT::Functions::ElementFunctionSetInterface<E, r, rC, R>::RangeType>>&
+evaluate_at_quadrature(
+    const XT::Functions::ElementFunctionSetInterface<E, r, rC, R>& basis,
+    const QuadratureRule<D, d>& quadrature,
+    std::vector<std::vector<typename XT::Functions::ElementFunctionSetInterface<E, r, rC, R>::RangeType>>& storage,
+    const XT::Common::Parameter& param = {})
+{
+  const auto* localized_basis = dynamic_cast<const LocalizedGlobalFiniteElementInterface<E, r, rC, R>*>(&basis);
+  if (localized_basis != nullptr)
+    return localized_basis->evaluate_at_quadrature(quadrature, param);
+  storage.resize(quadrature.size());
+  for (size_t qq = 0; qq < quadrature.size(); ++qq)
+    basis.evaluate(quadrature[qq].position(), storage[qq], param);
+  return storage;
+} // ... evaluate_at_quadrature(...)
+
+
+/// \brief Jacobians of all functions of the basis at all points of the quadrature, \sa evaluate_at_quadrature
+template <class E, size_t r, size_t rC, class R, class D, int d>
+const std::vector<std::vector<typename XT::Functions::ElementFunctionSetInterface<E, r, rC, R>::DerivativeRangeType>>&
+jacobians_at_quadrature(
+    const XT::Functions::ElementFunctionSetInterface<E, r, rC, R>& basis,
+    const QuadratureRule<D, d>& quadrature,
+    std::vector<std::vector<typename XT::Functions::ElementFunctionSetInterface<E, r, rC, R>::DerivativeRangeType>>&
+        storage,
+    const XT::Common::Parameter& param = {})
+{
+  const auto* localized_basis = dynamic_cast<const LocalizedGlobalFiniteElementInterface<E, r, rC, R>*>(&basis);
+  if (localized_basis != nullptr)
+    return localized_basis->jacobians_at_quadrature(quadrature, param);
+  storage.resize(quadrature.size());
+  for (size_t qq = 0; qq < quadrature.size(); ++qq)
+    basis.jacobians(quadrature[qq].position(), storage[qq], param);
+  return storage;
+} // ... jacobians_at_quadrature(...)
+
+
+} // namespace internal
+
 
 /**
  * Interface for integrands in integrals over grid elements, which depend on one argument only (usually the test basis
@@ -113,6 +235,35 @@ public:
     evaluate(basis, point_in_reference_element, result, param);
     return result;
   }
+
+  /**
+   * Adds the integral of this integrand w.r.t. the given quadrature to result for each function in the basis, i.e.
+   * `result[ii] += \sum_q w_q |det(J(x_q))| evaluate(x_q)[ii]`.
+   *
+   * The default implementation calls evaluate() for each quadrature point, integrands may override this to evaluate
+   * all quadrature points at once.
+   *
+   * \note Will throw Exceptions::not_bound_to_an_element_yet error if not bound yet!
+   **/
+  virtual void integrate(const LocalBasisType& basis,
+                         const QuadratureRule<D, d>& quadrature,
+                         DynamicVector<F>& result,
+                         const XT::Common::Parameter& param = {}) const
+  {
+    const size_t size = basis.size(param);
+    if (result.size() < size)
+      result.resize(size, 0.);
+    const auto& geometry = this->element().geometry();
+    DynamicVector<F> point_values(size, 0.);
+    for (const auto& quadrature_point : quadrature) {
+      const auto point_in_reference_element = quadrature_point.position();
+      const auto factor = geometry.integrationElement(point_in_reference_element) * quadrature_point.weight();
+      evaluate(basis, point_in_reference_element, point_values, param);
+      assert(point_values.size() >= size && "This must not happen!");
+      for (size_t ii = 0; ii < size; ++ii)
+        result[ii] += point_values[ii] * factor;
+    }
+  } // ... integrate(...)
 }; // class LocalUnaryElementIntegrandInterface
 
 
@@ -201,6 +352,39 @@ public:
     evaluate(test_basis, ansatz_basis, point_in_reference_element, result, param);
     return result;
   }
+
+  /**
+   * Adds the integral of this integrand w.r.t. the given quadrature to result for each combination of functions from
+   * the two bases, i.e. `result[ii][jj] += \sum_q w_q |det(J(x_q))| evaluate(x_q)[ii][jj]`.
+   *
+   * The default implementation calls evaluate() for each quadrature point. Integrands may override this to evaluate
+   * all quadrature points at once into contiguous buffers, see internal::LocalBinaryIntegrandBatch.
+   *
+   * \note Will throw Exceptions::not_bound_to_an_element_yet error if not bound yet!
+   **/
+  virtual void integrate(const LocalTestBasisType& test_basis,
+                         const LocalAnsatzBasisType& ansatz_basis,
+                         const QuadratureRule<D, d>& quadrature,
+                         DynamicMatrix<F>& result,
+                         const XT::Common::Parameter& param = {}) const
+  {
+    const size_t rows = test_basis.size(param);
+    const size_t cols = ansatz_basis.size(param);
+    if (result.rows() < rows || result.cols() < cols)
+      result.resize(rows, cols, 0.);
+    const auto& geometry = this->element().geometry();
+    DynamicMatrix<F> point_values(rows, cols, 0.);
+    for (const auto& quadrature_point : quadrature) {
+      const auto point_in_reference_element = quadrature_point.position();
+      const auto factor = geometry.integrationElement(point_in_reference_element) * quadrature_point.weight();
+      evaluate(test_basis, ansatz_basis, point_in_reference_element, point_values, param);
+      assert(point_values.rows() >= rows && "This must not happen!");
+      assert(point_values.cols() >= cols && "This must not happen!");
+      for (size_t ii = 0; ii < rows; ++ii)
+        for (size_t jj = 0; jj < cols; ++jj)
+          result[ii][jj] += point_values[ii][jj] * factor;
+    }
+  } // ... integrate(...)
 }; // class LocalBinaryElementIntegrandInterface
 
 
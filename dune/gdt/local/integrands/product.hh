@@ -44,6 +44,7 @@ class LocalElementProductIntegrand : public LocalBinaryElementIntegrandInterface
 
 public:
   using BaseType::d;
+  using typename BaseType::D;
   using typename BaseType::DomainType;
   using typename BaseType::ElementType;
   using typename BaseType::LocalAnsatzBasisType;
@@ -105,11 +106,51 @@ public:
         result[ii][jj] = (weight * test_basis_values_[ii]) * ansatz_basis_values_[jj];
   } // ... evaluate(...)
 
+  void integrate(const LocalTestBasisType& test_basis,
+                 const LocalAnsatzBasisType& ansatz_basis,
+                 const QuadratureRule<D, d>& quadrature,
+                 DynamicMatrix<F>& result,
+                 const XT::Common::Parameter& param = {}) const override final
+  {
+    const size_t rows = test_basis.size(param);
+    const size_t cols = ansatz_basis.size(param);
+    batch_.resize(rows, cols, quadrature.size() * r);
+    const auto& geometry = this->element().geometry();
+    const auto& test_basis_values =
+        internal::evaluate_at_quadrature(test_basis, quadrature, test_basis_values_at_quadrature_, param);
+    const auto& ansatz_basis_values =
+        internal::evaluate_at_quadrature(ansatz_basis, quadrature, ansatz_basis_values_at_quadrature_, param);
+    size_t offset = 0;
+    for (size_t qq = 0; qq < quadrature.size(); ++qq) {
+      const auto& quadrature_point = quadrature[qq];
+      const auto point_in_reference_element = quadrature_point.position();
+      const auto factor = geometry.integrationElement(point_in_reference_element) * quadrature_point.weight();
+      const auto weight = local_weight_->evaluate(point_in_reference_element, param);
+      // store the weighted test values and the ansatz values contiguously
+      for (size_t ii = 0; ii < rows; ++ii) {
+        auto* test_values = batch_.test(ii) + offset;
+        const auto weighted_value = weight * test_basis_values[qq][ii];
+        for (size_t rr = 0; rr < r; ++rr)
+          test_values[rr] = factor * weighted_value[rr];
+      }
+      for (size_t jj = 0; jj < cols; ++jj) {
+        auto* ansatz_values = batch_.ansatz(jj) + offset;
+        for (size_t rr = 0; rr < r; ++rr)
+          ansatz_values[rr] = ansatz_basis_values[qq][jj][rr];
+      }
+      offset += r;
+    }
+    batch_.add_to(result);
+  } // ... integrate(...)
+
 private:
   XT::Functions::GridFunction<E, r, r, F> weight_;
   std::unique_ptr<typename XT::Functions::GridFunction<E, r, r, F>::LocalFunctionType> local_weight_;
   mutable std::vector<typename LocalTestBasisType::RangeType> test_basis_values_;
   mutable std::vector<typename LocalAnsatzBasisType::RangeType> ansatz_basis_values_;
+  mutable std::vector<std::vector<typename LocalTestBasisType::RangeType>> test_basis_values_at_quadrature_;
+  mutable std::vector<std::vector<typename LocalAnsatzBasisType::RangeType>> ansatz_basis_values_at_quadrature_;
+  mutable internal::LocalBinaryIntegrandBatch<F> batch_;
 }; // class LocalElementProductIntegrand
 
 
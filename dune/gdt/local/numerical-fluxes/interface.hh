@@ -11,6 +11,10 @@
 #ifndef DUNE_GDT_LOCAL_NUMERICAL_FLUXES_INTERFACE_HH
 #define DUNE_GDT_LOCAL_NUMERICAL_FLUXES_INTERFACE_HH
 
+#include <algorithm>
+#include <cmath>
+
+#include <dune/xt/common/fmatrix.hh>
 #include <dune/xt/common/parameter.hh>
 #include <dune/xt/common/memory.hh>
 #include <dune/xt/la/container/vector-interface.hh>
@@ -47,6 +51,7 @@ public:
   using PhysicalDomainType = typename FluxType::DomainType;
   using LocalIntersectionCoords = FieldVector<typename I::ctype, d - 1>;
   using StateType = typename FluxType::StateType;
+  using StateJacobianType = XT::Common::FieldMatrix<R, m, m>;
 
   NumericalFluxInterface(const FluxType& flx, const XT::Common::ParameterType& param_type = {})
     : XT::Common::ParametricInterface(param_type + flx.parameter_type())
@@ -107,6 +112,66 @@ public:
                           const PhysicalDomainType& n,
                           const XT::Common::Parameter& param = {}) const = 0;
 
+  /**
+   * \brief Computes the derivatives of apply() w.r.t. u and v, i.e. dg_du[ii][jj] = \partial_{u_jj} g_ii(x, u, v, n).
+   *
+   * The default implementation uses forward finite differences in state space, requiring 2m + 1 evaluations of
+   * apply(). Numerical fluxes should override this, if their derivatives are available analytically.
+   */
+  virtual void jacobians(const LocalIntersectionCoords& x_in_local_intersection_coords,
+                         const StateType& u,
+                         const StateType& v,
+                         const PhysicalDomainType& n,
+                         StateJacobianType& dg_du,
+                         StateJacobianType& dg_dv,
+                         const XT::Common::Parameter& param = {}) const
+  {
+    const auto g = this->apply(x_in_local_intersection_coords, u, v, n, param);
+    StateType perturbed_state = u;
+    for (size_t jj = 0; jj < m; ++jj) {
+      const auto eps = 1e-7 * (1. + std::abs(u[jj]));
+      perturbed_state[jj] += eps;
+      const auto perturbed_g = this->apply(x_in_local_intersection_coords, perturbed_state, v, n, param);
+      for (size_t ii = 0; ii < m; ++ii)
+        dg_du[ii][jj] = (perturbed_g[ii] - g[ii]) / eps;
+      perturbed_state[jj] = u[jj];
+    }
+    perturbed_state = v;
+    for (size_t jj = 0; jj < m; ++jj) {
+      const auto eps = 1e-7 * (1. + std::abs(v[jj]));
+      perturbed_state[jj] += eps;
+      const auto perturbed_g = this->apply(x_in_local_intersection_coords, u, perturbed_state, n, param);
+      for (size_t ii = 0; ii < m; ++ii)
+        dg_dv[ii][jj] = (perturbed_g[ii] - g[ii]) / eps;
+      perturbed_state[jj] = v[jj];
+    }
+  } // ... jacobians(...)
+
+  /**
+   * \brief Returns an upper bound for the absolute values of the wave speeds in direction n at the states u and v (used
+   *        for CFL estimates, see WaveSpeedAccumulator).
+   *
+   * The default implementation uses the infinity norms of \sum_s n_s \partial_u f_s at u and v, which bound the
+   * spectral radii. Requires the numerical flux to be bound to an intersection.
+   */
+  virtual R max_wave_speed(const LocalIntersectionCoords& x_in_local_intersection_coords,
+                           const StateType& u,
+                           const StateType& v,
+                           const PhysicalDomainType& n,
+                           const XT::Common::Parameter& param = {}) const
+  {
+    this->compute_entity_coords(x_in_local_intersection_coords);
+    const auto df_u = local_flux_inside_->jacobian(x_in_inside_coords_, u, param);
+    const auto df_v = local_flux_outside_->jacobian(x_in_outside_coords_, v, param);
+    StateJacobianType df_u_n;
+    StateJacobianType df_v_n;
+    for (size_t ss = 0; ss < d; ++ss) {
+      df_u_n.axpy(n[ss], df_u[ss]);
+      df_v_n.axpy(n[ss], df_v[ss]);
+    }
+    return std::max(df_u_n.infinity_norm(), df_v_n.infinity_norm());
+  } // ... max_wave_speed(...)
+
   template <class V>
   StateType apply(const LocalIntersectionCoords x_in_local_intersection_coords,
                   const StateType& u,
@@ -29,6 +29,7 @@ public:
   using typename BaseType::FluxType;
   using typename BaseType::LocalIntersectionCoords;
   using typename BaseType::PhysicalDomainType;
+  using typename BaseType::StateJacobianType;
   using typename BaseType::StateType;
   using typename BaseType::XIndependentFluxType;
   using FluxJacobianType = XT::Common::FieldVector<XT::Common::FieldMatrix<R, m, m>, d>;
@@ -67,6 +68,50 @@ public:
     // prepare
     this->compute_entity_coords(x);
     // evaluate
+    const R lambda = compute_lambda(u, v, param);
+    const auto f_u = local_flux_inside_->evaluate(x_in_inside_coords_, u, param);
+    const auto f_v = local_flux_outside_->evaluate(x_in_outside_coords_, v, param);
+    StateType ret(0.);
+    for (size_t dd = 0; dd < d; ++dd)
+      ret += (f_u[dd] + f_v[dd]) * (n[dd] * 0.5);
+    ret += (u - v) * (0.5 / lambda);
+    return ret;
+  }
+
+  /**
+   * \note If lambda is computed from the flux jacobians, it is treated as a constant.
+   */
+  void jacobians(const LocalIntersectionCoords& x,
+                 const StateType& u,
+                 const StateType& v,
+                 const PhysicalDomainType& n,
+                 StateJacobianType& dg_du,
+                 StateJacobianType& dg_dv,
+                 const XT::Common::Parameter& param = {}) const override final
+  {
+    // prepare
+    this->compute_entity_coords(x);
+    // evaluate
+    const R lambda = compute_lambda(u, v, param);
+    const auto df_u = local_flux_inside_->jacobian(x_in_inside_coords_, u, param);
+    const auto df_v = local_flux_outside_->jacobian(x_in_outside_coords_, v, param);
+    for (size_t ii = 0; ii < m; ++ii) {
+      for (size_t jj = 0; jj < m; ++jj) {
+        dg_du[ii][jj] = 0.;
+        dg_dv[ii][jj] = 0.;
+        for (size_t dd = 0; dd < d; ++dd) {
+          dg_du[ii][jj] += df_u[dd][ii][jj] * (n[dd] * 0.5);
+          dg_dv[ii][jj] += df_v[dd][ii][jj] * (n[dd] * 0.5);
+        }
+      }
+      dg_du[ii][ii] += 0.5 / lambda;
+      dg_dv[ii][ii] -= 0.5 / lambda;
+    }
+  } // ... jacobians(...)
+
+private:
+  R compute_lambda(const StateType& u, const StateType& v, const XT::Common::Parameter& param) const
+  {
     R lambda = lambda_;
     if (XT::Common::is_zero(lambda)) {
       const auto df_u = local_flux_inside_->jacobian(x_in_inside_coords_, u, param);
@@ -77,16 +122,10 @@ public:
       }
       lambda = 1. / lambda;
     }
-    const auto f_u = local_flux_inside_->evaluate(x_in_inside_coords_, u, param);
-    const auto f_v = local_flux_outside_->evaluate(x_in_outside_coords_, v, param);
-    StateType ret(0.);
-    for (size_t dd = 0; dd < d; ++dd)
-      ret += (f_u[dd] + f_v[dd]) * (n[dd] * 0.5);
-    ret += (u - v) * (0.5 / lambda);
-    return ret;
-  }
+    return lambda;
+  } // ... compute_lambda(...)
+
 
-private:
   using BaseType::local_flux_inside_;
   using BaseType::local_flux_outside_;
   using BaseType::x_in_inside_coords_;
@@ -107,28 +107,42 @@ public:
                   const PhysicalDomainType& n,
                   const XT::Common::Parameter& param = {}) const override final
   {
-    // compute decomposition
     this->compute_entity_coords(x);
-    const auto eigendecomposition = flux_eigen_decomposition_(*local_flux_inside_, 0.5 * (u + v), n, param);
-    const auto& evs = std::get<0>(eigendecomposition);
-    const auto& T = std::get<1>(eigendecomposition);
-    const auto& T_inv = std::get<2>(eigendecomposition);
-    // compute numerical flux [DF2016, p. 428, (8.108)]
-    auto lambda_plus = XT::Common::zeros_like(T);
-    auto lambda_minus = XT::Common::zeros_like(T);
-    for (size_t ii = 0; ii < m; ++ii) {
-      const auto& real_ev = evs[ii];
-      XT::Common::set_matrix_entry(lambda_plus, ii, ii, XT::Common::max(real_ev, 0.));
-      XT::Common::set_matrix_entry(lambda_minus, ii, ii, XT::Common::min(real_ev, 0.));
+    const StateType w = 0.5 * (u + v);
+    // P_plus and P_minus only depend on w and n, which often coincide for consecutive intersections (e.g. in regions of
+    // constant state on structured grids), so we reuse them in that case
+    if (!(has_cached_matrices_ && w == cached_w_ && n == cached_n_)) {
+      // compute decomposition
+      const auto eigendecomposition = flux_eigen_decomposition_(*local_flux_inside_, w, n, param);
+      const auto& evs = std::get<0>(eigendecomposition);
+      const auto& T = std::get<1>(eigendecomposition);
+      const auto& T_inv = std::get<2>(eigendecomposition);
+      // compute numerical flux [DF2016, p. 428, (8.108)]
+      auto lambda_plus = XT::Common::zeros_like(T);
+      auto lambda_minus = XT::Common::zeros_like(T);
+      for (size_t ii = 0; ii < m; ++ii) {
+        const auto& real_ev = evs[ii];
+        XT::Common::set_matrix_entry(lambda_plus, ii, ii, XT::Common::max(real_ev, 0.));
+        XT::Common::set_matrix_entry(lambda_minus, ii, ii, XT::Common::min(real_ev, 0.));
+      }
+      P_plus_ = T * lambda_plus * T_inv;
+      P_minus_ = T * lambda_minus * T_inv;
+      cached_w_ = w;
+      cached_n_ = n;
+      // the decomposition might depend on the parameter
+      has_cached_matrices_ = this->parameter_type().empty();
     }
-    const auto P_plus = T * lambda_plus * T_inv;
-    const auto P_minus = T * lambda_minus * T_inv;
-    return P_plus * u + P_minus * v;
+    return P_plus_ * u + P_minus_ * v;
   } // ... apply(...)
 
 private:
   using BaseType::local_flux_inside_;
   const FluxEigenDecompositionLambdaType flux_eigen_decomposition_;
+  mutable bool has_cached_matrices_ = false;
+  mutable StateType cached_w_;
+  mutable PhysicalDomainType cached_n_;
+  mutable XT::Common::FieldMatrix<XT::Common::real_t<R>, m, m> P_plus_;
+  mutable XT::Common::FieldMatrix<XT::Common::real_t<R>, m, m> P_minus_;
 }; // class NumericalVijayasundaramFlux
 
 
@@ -12,6 +12,9 @@
 #define DUNE_GDT_LOCAL_OPERATORS_ADVECTION_DG_HH
 
 #include <functional>
+#include <memory>
+
+#include <dune/common/dynmatrix.hh>
 
 #include <dune/geometry/quadraturerules.hh>
 #include <dune/grid/common/rangegenerators.hh>
@@ -26,11 +29,32 @@
 
 #include <dune/gdt/local/numerical-fluxes/interface.hh>
 #include <dune/gdt/tools/local-mass-matrix.hh>
+#include <dune/gdt/tools/wave-speeds.hh>
 
 #include "interfaces.hh"
 
 namespace Dune {
 namespace GDT {
+namespace internal {
+
+
+/// \brief Computes result = local_mass_matrix_inverse * result, using tmp as storage.
+template <class M, class F>
+void left_multiply_by_local_mass_matrix_inverse(const M& local_mass_matrix_inverse,
+                                                DynamicMatrix<F>& result,
+                                                DynamicMatrix<F>& tmp)
+{
+  tmp = result;
+  for (size_t ii = 0; ii < result.rows(); ++ii)
+    for (size_t jj = 0; jj < result.cols(); ++jj) {
+      result[ii][jj] = 0.;
+      for (size_t kk = 0; kk < tmp.rows(); ++kk)
+        result[ii][jj] += local_mass_matrix_inverse.get_entry(ii, kk) * tmp[kk][jj];
+    }
+} // ... left_multiply_by_local_mass_matrix_inverse(...)
+
+
+} // namespace internal
 
 
 /**
@@ -48,7 +72,9 @@ public:
   using BaseType::d;
   using typename BaseType::D;
   using typename BaseType::E;
+  using typename BaseType::LocalRangeBasisType;
   using typename BaseType::LocalRangeType;
+  using typename BaseType::LocalSourceBasisType;
   using typename BaseType::LocalSourceType;
   using typename BaseType::SourceSpaceType;
   using typename BaseType::SourceType;
@@ -149,6 +175,53 @@ public:
       local_range.dofs()[ii] += local_dofs_[ii];
   } // ... apply(...)
 
+  bool provides_jacobian() const override final
+  {
+    return true;
+  }
+
+  void jacobian(const LocalSourceBasisType& source_basis,
+                const LocalRangeBasisType& range_basis,
+                DynamicMatrix<RF>& result,
+                const XT::Common::Parameter& param = {}) const override final
+  {
+    const auto& u_ = local_sources_[0];
+    const size_t rows = range_basis.size(param);
+    const size_t cols = source_basis.size(param);
+    if (result.rows() != rows || result.cols() != cols)
+      result.resize(rows, cols);
+    result *= 0.;
+    const auto integrand_order = local_flux_->order(param) * u_->order(param)
+                                 + std::max(range_basis.order(param) - 1, 0) + source_basis.order(param);
+    for (const auto& quadrature_point : QuadratureRules<D, d>::rule(element().geometry().type(), integrand_order)) {
+      // prepare
+      const auto point_in_reference_element = quadrature_point.position();
+      const auto factor =
+          -1. * element().geometry().integrationElement(point_in_reference_element) * quadrature_point.weight();
+      // evaluate
+      range_basis.jacobians(point_in_reference_element, basis_jacobians_, param);
+      source_basis.evaluate(point_in_reference_element, source_basis_values_, param);
+      const auto source_value = u_->evaluate(point_in_reference_element, param);
+      const auto df = local_flux_->jacobian(point_in_reference_element, source_value, param);
+      // compute, df[dd][ss][kk] is the derivative of the ss-th component of the dd-th flux w.r.t. u_kk
+      for (size_t jj = 0; jj < cols; ++jj) {
+        for (size_t dd = 0; dd < d; ++dd) {
+          for (size_t ss = 0; ss < m; ++ss) {
+            RF df_phi = 0.;
+            for (size_t kk = 0; kk < m; ++kk)
+              df_phi += df[dd][ss][kk] * source_basis_values_[jj][kk];
+            for (size_t ii = 0; ii < rows; ++ii)
+              result[ii][jj] += factor * df_phi * basis_jacobians_[ii][ss][dd];
+          }
+        }
+      }
+    }
+    // apply local mass matrix, if required
+    if (local_mass_matrices_.valid())
+      internal::left_multiply_by_local_mass_matrix_inverse(
+          local_mass_matrices_.access().local_mass_matrix_inverse(element()), result, tmp_matrix_);
+  } // ... jacobian(...)
+
 protected:
   void post_bind(const E& ele) override final
   {
@@ -162,7 +235,9 @@ private:
   std::unique_ptr<typename FluxType::LocalFunctionType> local_flux_;
   const XT::Common::ConstStorageProvider<LocalMassMatrixProviderType> local_mass_matrices_;
   mutable std::vector<typename LocalRangeType::LocalBasisType::DerivativeRangeType> basis_jacobians_;
+  mutable std::vector<typename LocalSourceBasisType::RangeType> source_basis_values_;
   mutable XT::LA::CommonDenseVector<RF> local_dofs_;
+  mutable DynamicMatrix<RF> tmp_matrix_;
 }; // class LocalAdvectionDgVolumeOperator
 
 
@@ -192,8 +267,11 @@ public:
   using BaseType::d;
   using typename BaseType::D;
   using typename BaseType::IntersectionType;
+  using typename BaseType::LocalInsideRangeBasisType;
   using typename BaseType::LocalInsideRangeType;
+  using typename BaseType::LocalOutsideRangeBasisType;
   using typename BaseType::LocalOutsideRangeType;
+  using typename BaseType::LocalSourceBasisType;
   using typename BaseType::LocalSourceType;
   using typename BaseType::SourceSpaceType;
   using typename BaseType::SourceType;
@@ -267,6 +345,7 @@ public:
     , local_flux_outside_(numerical_flux_->flux().local_function())
     , compute_outside_(other.compute_outside_)
     , local_mass_matrices_(other.local_mass_matrices_)
+    , wave_speeds_(other.wave_speeds_)
   {}
 
   std::unique_ptr<BaseType> copy() const override final
@@ -279,6 +358,16 @@ public:
     return numerical_flux_->linear();
   }
 
+  /**
+   * \brief Records the maximal wave speed over the quadrature points of each intersection in apply(), if wave_speeds
+   *        is enabled (shared by all copies of this operator).
+   */
+  ThisType& collect_wave_speeds(std::shared_ptr<WaveSpeedAccumulator<IRR>> wave_speeds)
+  {
+    wave_speeds_ = wave_speeds;
+    return *this;
+  }
+
   using BaseType::intersection;
 
   void apply(LocalInsideRangeType& local_range_inside,
@@ -300,6 +389,8 @@ public:
     const auto v_order = v_->order(param);
     const auto integrand_order = std::max(inside_basis.order(param), outside_basis.order(param))
                                  + std::max(inside_flux_order * u_order, outside_flux_order * v_order);
+    const bool collect_wave_speeds = wave_speeds_ && wave_speeds_->enabled();
+    IRR max_wave_speed = 0.;
     for (const auto& quadrature_point :
          QuadratureRules<D, d - 1>::rule(intersection().geometry().type(), integrand_order)) {
       // prepare
@@ -318,6 +409,10 @@ public:
       const auto u_val = u_->evaluate(point_in_inside_reference_element);
       const auto v_val = v_->evaluate(point_in_outside_reference_element);
       const auto g = numerical_flux_->apply(point_in_reference_intersection, u_val, v_val, normal, param);
+      if (collect_wave_speeds)
+        max_wave_speed = std::max(
+            max_wave_speed,
+            numerical_flux_->max_wave_speed(point_in_reference_intersection, u_val, v_val, normal, param));
       // compute
       for (size_t ii = 0; ii < inside_basis.size(param); ++ii)
         inside_local_dofs_[ii] += integration_factor * quadrature_weight * (g * inside_basis_values_[ii]);
@@ -338,8 +433,108 @@ public:
     if (compute_outside_)
       for (size_t ii = 0; ii < outside_basis.size(param); ++ii)
         local_range_outside.dofs()[ii] += outside_local_dofs_[ii];
+    if (collect_wave_speeds) {
+      const auto h_intersection = intersection().geometry().volume();
+      const auto& inside_element = intersection().inside();
+      wave_speeds_->add(
+          max_wave_speed, h_intersection, inside_element.geometry().volume(), inside_element.subEntities(1));
+      if (compute_outside_ && intersection().neighbor()) {
+        const auto& outside_element = local_range_outside.element();
+        wave_speeds_->add(
+            max_wave_speed, h_intersection, outside_element.geometry().volume(), outside_element.subEntities(1));
+      }
+    }
   } // ... apply(...)
 
+  bool provides_jacobian() const override final
+  {
+    return true;
+  }
+
+  void jacobian(const LocalSourceBasisType& source_basis_inside,
+                const LocalSourceBasisType& source_basis_outside,
+                const LocalInsideRangeBasisType& range_basis_inside,
+                const LocalOutsideRangeBasisType& range_basis_outside,
+                DynamicMatrix<IRR>& result_in_in,
+                DynamicMatrix<IRR>& result_in_out,
+                DynamicMatrix<IRR>& result_out_in,
+                DynamicMatrix<IRR>& result_out_out,
+                const XT::Common::Parameter& param = {}) const override final
+  {
+    const auto& u_ = local_sources_[0];
+    const auto& v_ = local_sources_[1];
+    const size_t rows_in = range_basis_inside.size(param);
+    const size_t rows_out = range_basis_outside.size(param);
+    const size_t cols_in = source_basis_inside.size(param);
+    const size_t cols_out = source_basis_outside.size(param);
+    const auto resize_and_clear = [](auto& matrix, const size_t rows, const size_t cols) {
+      if (matrix.rows() != rows || matrix.cols() != cols)
+        matrix.resize(rows, cols);
+      matrix *= 0.;
+    };
+    resize_and_clear(result_in_in, rows_in, cols_in);
+    resize_and_clear(result_in_out, rows_in, cols_out);
+    resize_and_clear(result_out_in, rows_out, cols_in);
+    resize_and_clear(result_out_out, rows_out, cols_out);
+    numerical_flux_->bind(intersection());
+    const auto integrand_order =
+        std::max(range_basis_inside.order(param), range_basis_outside.order(param))
+        + std::max(local_flux_inside_->order(param) * u_->order(param),
+                   local_flux_outside_->order(param) * v_->order(param))
+        + std::max(source_basis_inside.order(param), source_basis_outside.order(param));
+    for (const auto& quadrature_point :
+         QuadratureRules<D, d - 1>::rule(intersection().geometry().type(), integrand_order)) {
+      // prepare
+      const auto point_in_reference_intersection = quadrature_point.position();
+      const auto factor =
+          intersection().geometry().integrationElement(point_in_reference_intersection) * quadrature_point.weight();
+      const auto normal = intersection().unitOuterNormal(point_in_reference_intersection);
+      const auto point_in_inside_reference_element =
+          intersection().geometryInInside().global(point_in_reference_intersection);
+      const auto point_in_outside_reference_element =
+          intersection().geometryInOutside().global(point_in_reference_intersection);
+      // evaluate
+      range_basis_inside.evaluate(point_in_inside_reference_element, inside_basis_values_);
+      if (compute_outside_)
+        range_basis_outside.evaluate(point_in_outside_reference_element, outside_basis_values_);
+      source_basis_inside.evaluate(point_in_inside_reference_element, inside_source_basis_values_);
+      source_basis_outside.evaluate(point_in_outside_reference_element, outside_source_basis_values_);
+      const auto u_val = u_->evaluate(point_in_inside_reference_element);
+      const auto v_val = v_->evaluate(point_in_outside_reference_element);
+      numerical_flux_->jacobians(point_in_reference_intersection, u_val, v_val, normal, dg_du_, dg_dv_, param);
+      // compute, the derivative of g w.r.t. a source DoF is dg_du (or dg_dv) times the respective basis function
+      for (size_t jj = 0; jj < cols_in; ++jj) {
+        dg_du_.mv(inside_source_basis_values_[jj], dg_);
+        for (size_t ii = 0; ii < rows_in; ++ii)
+          result_in_in[ii][jj] += factor * (dg_ * inside_basis_values_[ii]);
+        if (compute_outside_)
+          for (size_t ii = 0; ii < rows_out; ++ii)
+            result_out_in[ii][jj] -= factor * (dg_ * outside_basis_values_[ii]);
+      }
+      for (size_t jj = 0; jj < cols_out; ++jj) {
+        dg_dv_.mv(outside_source_basis_values_[jj], dg_);
+        for (size_t ii = 0; ii < rows_in; ++ii)
+          result_in_out[ii][jj] += factor * (dg_ * inside_basis_values_[ii]);
+        if (compute_outside_)
+          for (size_t ii = 0; ii < rows_out; ++ii)
+            result_out_out[ii][jj] -= factor * (dg_ * outside_basis_values_[ii]);
+      }
+    }
+    // apply local mass matrices, if required
+    if (local_mass_matrices_.valid()) {
+      const auto& inside_mass_matrix_inverse =
+          local_mass_matrices_.access().local_mass_matrix_inverse(intersection().inside());
+      internal::left_multiply_by_local_mass_matrix_inverse(inside_mass_matrix_inverse, result_in_in, tmp_matrix_);
+      internal::left_multiply_by_local_mass_matrix_inverse(inside_mass_matrix_inverse, result_in_out, tmp_matrix_);
+      if (compute_outside_ && intersection().neighbor()) {
+        const auto& outside_mass_matrix_inverse =
+            local_mass_matrices_.access().local_mass_matrix_inverse(intersection().outside());
+        internal::left_multiply_by_local_mass_matrix_inverse(outside_mass_matrix_inverse, result_out_in, tmp_matrix_);
+        internal::left_multiply_by_local_mass_matrix_inverse(outside_mass_matrix_inverse, result_out_out, tmp_matrix_);
+      }
+    }
+  } // ... jacobian(...)
+
 protected:
   void post_bind(const I& inter) override final
   {
@@ -356,10 +551,17 @@ private:
   std::unique_ptr<typename NumericalFluxType::FluxType::LocalFunctionType> local_flux_outside_;
   const bool compute_outside_;
   const XT::Common::ConstStorageProvider<LocalMassMatrixProviderType> local_mass_matrices_;
+  std::shared_ptr<WaveSpeedAccumulator<IRR>> wave_speeds_;
   mutable std::vector<typename LocalInsideRangeType::LocalBasisType::RangeType> inside_basis_values_;
   mutable std::vector<typename LocalOutsideRangeType::LocalBasisType::RangeType> outside_basis_values_;
+  mutable std::vector<typename LocalSourceBasisType::RangeType> inside_source_basis_values_;
+  mutable std::vector<typename LocalSourceBasisType::RangeType> outside_source_basis_values_;
+  mutable typename NumericalFluxType::StateJacobianType dg_du_;
+  mutable typename NumericalFluxType::StateJacobianType dg_dv_;
+  mutable typename NumericalFluxType::StateType dg_;
   mutable XT::LA::CommonDenseVector<IRR> inside_local_dofs_;
   mutable XT::LA::CommonDenseVector<ORR> outside_local_dofs_;
+  mutable DynamicMatrix<IRR> tmp_matrix_;
 }; // class LocalAdvectionDgCouplingOperator
 
 
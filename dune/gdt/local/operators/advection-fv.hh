@@ -12,6 +12,7 @@
 #define DUNE_GDT_LOCAL_OPERATORS_ADVECTION_FV_HH
 
 #include <functional>
+#include <memory>
 
 #include <dune/xt/common/parameter.hh>
 
@@ -20,6 +21,7 @@
 #include <dune/gdt/type_traits.hh>
 
 #include <dune/gdt/local/numerical-fluxes/interface.hh>
+#include <dune/gdt/tools/wave-speeds.hh>
 
 #include "interfaces.hh"
 
@@ -98,6 +100,7 @@ public:
     : BaseType(other)
     , numerical_flux_(other.numerical_flux_->copy())
     , source_is_elementwise_constant_(other.source_is_elementwise_constant_)
+    , wave_speeds_(other.wave_speeds_)
   {}
 
   std::unique_ptr<BaseType> copy() const override final
@@ -110,6 +113,16 @@ public:
     return numerical_flux_->linear();
   }
 
+  /**
+   * \brief Records the maximal wave speed on each intersection in apply(), if wave_speeds is enabled (shared by all
+   *        copies of this operator).
+   */
+  ThisType& collect_wave_speeds(std::shared_ptr<WaveSpeedAccumulator<RR>> wave_speeds)
+  {
+    wave_speeds_ = wave_speeds;
+    return *this;
+  }
+
   using BaseType::intersection;
 
   void apply(LocalInsideRangeType& local_range_inside,
@@ -135,6 +148,11 @@ public:
       local_range_inside.dofs()[ii] += (g[ii] * h_intersection) / h_inside_element;
       local_range_outside.dofs()[ii] -= (g[ii] * h_intersection) / h_outside_element;
     }
+    if (wave_speeds_ && wave_speeds_->enabled()) {
+      const auto wave_speed = numerical_flux_->max_wave_speed(x_in_intersection_coords_, u_, v_, normal, param);
+      wave_speeds_->add(wave_speed, h_intersection, h_inside_element, intersection().inside().subEntities(1));
+      wave_speeds_->add(wave_speed, h_intersection, h_outside_element, intersection().outside().subEntities(1));
+    }
   } // ... apply(...)
 
 protected:
@@ -148,6 +166,7 @@ private:
   using BaseType::local_sources_;
   std::unique_ptr<NumericalFluxType> numerical_flux_;
   const bool source_is_elementwise_constant_;
+  std::shared_ptr<WaveSpeedAccumulator<RR>> wave_speeds_;
   mutable LocalIntersectionCoords x_in_intersection_coords_;
   mutable StateType u_;
   mutable StateType v_;
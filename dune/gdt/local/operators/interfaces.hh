@@ -25,6 +25,7 @@
 #include <dune/xt/grid/type_traits.hh>
 #include <dune/xt/grid/bound-object.hh>
 
+#include <dune/gdt/exceptions.hh>
 #include <dune/gdt/local/discretefunction.hh>
 #include <dune/gdt/discretefunction/default.hh>
 
@@ -71,6 +72,8 @@ public:
   using LocalSourceType = typename SourceType::LocalFunctionType;
   using DiscreteSourceType = ConstDiscreteFunction<SV, SGV, s_r, s_rC, SR>;
   using SourceSpaceType = typename DiscreteSourceType::SpaceType;
+  using LocalSourceBasisType = typename SourceSpaceType::GlobalBasisType::LocalizedType;
+  using LocalRangeBasisType = typename LocalRangeType::LocalBasisType;
 
   using ThisType = LocalElementOperatorInterface;
 
@@ -128,6 +131,30 @@ public:
 
   virtual void apply(LocalRangeType& local_range, const XT::Common::Parameter& param = {}) const = 0;
 
+  /**
+   * \brief Returns true, if this operator implements jacobian(), i.e. can compute its exact local jacobian.
+   */
+  virtual bool provides_jacobian() const
+  {
+    return false;
+  }
+
+  /**
+   * \brief Computes the derivative of apply() w.r.t. the source DoFs, linearized around the current source.
+   *
+   * Afterwards, result[ii][jj] contains the derivative of the ii-th range DoF w.r.t. the jj-th source DoF.
+   *
+   * \note Presumes that source_basis and range_basis are already bound to element()!
+   **/
+  virtual void jacobian(const LocalSourceBasisType& /*source_basis*/,
+                        const LocalRangeBasisType& /*range_basis*/,
+                        DynamicMatrix<RR>& /*result*/,
+                        const XT::Common::Parameter& /*param*/ = {}) const
+  {
+    DUNE_THROW(Exceptions::operator_error,
+               "This local operator does not provide a jacobian, check provides_jacobian() first!");
+  }
+
   virtual std::unique_ptr<ThisType> with_source(const SourceType& src) const
   {
     auto ret = copy();
@@ -201,6 +228,7 @@ public:
   using LocalSourceType = typename SourceType::LocalFunctionType;
   using DiscreteSourceType = ConstDiscreteFunction<SV, SGV, s_r, s_rC, SF>;
   using SourceSpaceType = typename DiscreteSourceType::SpaceType;
+  using LocalSourceBasisType = typename SourceSpaceType::GlobalBasisType::LocalizedType;
 
   using IRV = InsideRangeVector;
   using IRGV = InsideRangeGridView;
@@ -212,6 +240,8 @@ public:
   using ORV = OutsideRangeVector;
   using ORGV = OutsideRangeGridView;
   using LocalOutsideRangeType = LocalDiscreteFunction<ORV, ORGV, r_r, r_rC, RF>;
+  using LocalInsideRangeBasisType = typename LocalInsideRangeType::LocalBasisType;
+  using LocalOutsideRangeBasisType = typename LocalOutsideRangeType::LocalBasisType;
 
   // Allows construction without source, source has to be set by a call to with_source before calling apply
   LocalIntersectionOperatorInterface(const size_t num_local_sources = 2,
@@ -274,6 +304,39 @@ public:
                      LocalOutsideRangeType& local_range_outside,
                      const XT::Common::Parameter& param = {}) const = 0;
 
+  /**
+   * \brief Returns true, if this operator implements jacobian(), i.e. can compute its exact local jacobians.
+   */
+  virtual bool provides_jacobian() const
+  {
+    return false;
+  }
+
+  /**
+   * \brief Computes the derivatives of apply() w.r.t. the inside and outside source DoFs, linearized around the
+   *        current source.
+   *
+   * Afterwards, result_in_out[ii][jj] contains the derivative of the ii-th inside range DoF w.r.t. the jj-th outside
+   * source DoF (and accordingly for the other results).
+   *
+   * \note Presumes that the inside bases are already bound to intersection().inside() and the outside bases are
+   *       already bound to intersection().outside() (or to intersection().inside() on the boundary, in accordance with
+   *       post_bind())!
+   **/
+  virtual void jacobian(const LocalSourceBasisType& /*source_basis_inside*/,
+                        const LocalSourceBasisType& /*source_basis_outside*/,
+                        const LocalInsideRangeBasisType& /*range_basis_inside*/,
+                        const LocalOutsideRangeBasisType& /*range_basis_outside*/,
+                        DynamicMatrix<RF>& /*result_in_in*/,
+                        DynamicMatrix<RF>& /*result_in_out*/,
+                        DynamicMatrix<RF>& /*result_out_in*/,
+                        DynamicMatrix<RF>& /*result_out_out*/,
+                        const XT::Common::Parameter& /*param*/ = {}) const
+  {
+    DUNE_THROW(Exceptions::operator_error,
+               "This local operator does not provide a jacobian, check provides_jacobian() first!");
+  }
+
   virtual std::unique_ptr<ThisType> with_source(const SourceType& src) const
   {
     auto ret = copy();
@@ -0,0 +1,677 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_LOCAL_OPERATORS_SUM_FACTORIZED_HH
+#define DUNE_GDT_LOCAL_OPERATORS_SUM_FACTORIZED_HH
+
+#include <array>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/xt/common/parameter.hh>
+#include <dune/xt/la/container/eye-matrix.hh>
+#include <dune/xt/functions/grid-function.hh>
+
+#include <dune/gdt/exceptions.hh>
+#include <dune/gdt/local/discretefunction.hh>
+
+#include "interfaces.hh"
+
+namespace Dune {
+namespace GDT {
+namespace internal {
+
+
+/**
+ * \brief One-dimensional ingredients of a sum-factorized Q_k Lagrange basis on [0, 1].
+ *
+ * Holds the values and derivatives of the 1d Lagrange polynomials associated with the equidistant nodes j/k (or the
+ * midpoint for k = 0) in the points of a 1d Gauss quadrature, both as (num_points x num_nodes) and as transposed
+ * matrices, stored row-major.
+ */
+template <class F>
+class TensorProductLagrangeShapes1d
+{
+public:
+  TensorProductLagrangeShapes1d(const int order = 0, const std::vector<F>& points = {})
+    : order_(order)
+    , num_nodes_(static_cast<size_t>(order) + 1)
+    , num_points_(points.size())
+    , values_(num_points_ * num_nodes_, 0.)
+    , derivatives_(num_points_ * num_nodes_, 0.)
+    , transposed_values_(num_points_ * num_nodes_, 0.)
+    , transposed_derivatives_(num_points_ * num_nodes_, 0.)
+  {
+    std::vector<F> nodes(num_nodes_, 0.5);
+    for (size_t jj = 0; jj < num_nodes_ && order_ > 0; ++jj)
+      nodes[jj] = F(jj) / F(order_);
+    for (size_t qq = 0; qq < num_points_; ++qq) {
+      const auto& x = points[qq];
+      for (size_t jj = 0; jj < num_nodes_; ++jj) {
+        F value = 1.;
+        F derivative = 0.;
+        for (size_t mm = 0; mm < num_nodes_; ++mm) {
+          if (mm == jj)
+            continue;
+          const F denominator = nodes[jj] - nodes[mm];
+          derivative = derivative * (x - nodes[mm]) / denominator + value / denominator;
+          value *= (x - nodes[mm]) / denominator;
+        }
+        values_[qq * num_nodes_ + jj] = transposed_values_[jj * num_points_ + qq] = value;
+        derivatives_[qq * num_nodes_ + jj] = transposed_derivatives_[jj * num_points_ + qq] = derivative;
+      }
+    }
+  } // TensorProductLagrangeShapes1d(...)
+
+  int order() const
+  {
+    return order_;
+  }
+
+  size_t num_nodes() const
+  {
+    return num_nodes_;
+  }
+
+  size_t num_points() const
+  {
+    return num_points_;
+  }
+
+  const std::vector<F>& values(const bool transposed = false) const
+  {
+    return transposed ? transposed_values_ : values_;
+  }
+
+  const std::vector<F>& derivatives(const bool transposed = false) const
+  {
+    return transposed ? transposed_derivatives_ : derivatives_;
+  }
+
+private:
+  int order_;
+  size_t num_nodes_;
+  size_t num_points_;
+  std::vector<F> values_;
+  std::vector<F> derivatives_;
+  std::vector<F> transposed_values_;
+  std::vector<F> transposed_derivatives_;
+}; // class TensorProductLagrangeShapes1d
+
+
+/**
+ * \brief Applies a (rows x cols) matrix along direction dir of a tensor (of shape shape, first direction fastest).
+ *
+ * The result is written into out and shape[dir] is updated to rows, at a cost of O(rows * size(in)).
+ */
+template <class F, size_t d>
+void contract_tensor_direction(const std::vector<F>& matrix,
+                               const size_t rows,
+                               const size_t cols,
+                               const size_t dir,
+                               std::array<size_t, d>& shape,
+                               const std::vector<F>& in,
+                               std::vector<F>& out)
+{
+  assert(shape[dir] == cols);
+  size_t inner = 1;
+  for (size_t ii = 0; ii < dir; ++ii)
+    inner *= shape[ii];
+  size_t outer = 1;
+  for (size_t ii = dir + 1; ii < d; ++ii)
+    outer *= shape[ii];
+  out.assign(inner * rows * outer, 0.);
+  for (size_t oo = 0; oo < outer; ++oo)
+    for (size_t aa = 0; aa < rows; ++aa) {
+      F* target = out.data() + (oo * rows + aa) * inner;
+      for (size_t bb = 0; bb < cols; ++bb) {
+        const F factor = matrix[aa * cols + bb];
+        if (factor == 0.)
+          continue;
+        const F* source = in.data() + (oo * cols + bb) * inner;
+        for (size_t ii = 0; ii < inner; ++ii)
+          target[ii] += factor * source[ii];
+      }
+    }
+  shape[dir] = rows;
+} // ... contract_tensor_direction(...)
+
+
+/**
+ * \brief Applies the Kronecker product of one 1d matrix per direction, where the 1d matrix of direction derivative_dir
+ *        is a derivative matrix (pass d to use values in all directions).
+ *
+ * \note tmp is used as scratch space, in and tmp may not alias out.
+ */
+template <class F, size_t d>
+void apply_tensor_product(const TensorProductLagrangeShapes1d<F>& shapes,
+                          const bool transposed,
+                          const size_t derivative_dir,
+                          const std::vector<F>& in,
+                          std::vector<F>& out,
+                          std::vector<F>& tmp)
+{
+  const size_t rows = transposed ? shapes.num_nodes() : shapes.num_points();
+  const size_t cols = transposed ? shapes.num_points() : shapes.num_nodes();
+  std::array<size_t, d> shape;
+  shape.fill(cols);
+  // ping-pong between out and tmp such that the last contraction writes into out
+  const std::vector<F>* source = &in;
+  for (size_t dd = 0; dd < d; ++dd) {
+    auto& target = ((d - dd) % 2 == 1) ? out : tmp;
+    const auto& matrix = (dd == derivative_dir) ? shapes.derivatives(transposed) : shapes.values(transposed);
+    contract_tensor_direction<F, d>(matrix, rows, cols, dd, shape, *source, target);
+    source = &target;
+  }
+} // ... apply_tensor_product(...)
+
+
+} // namespace internal
+
+
+/**
+ * \brief Base class of matrix-free element operators, which use sum factorization for Q_k Lagrange bases on cubes.
+ *
+ * Given a discrete source u (with a scalar Lagrange source space) and a scalar Lagrange range space, computes
+ *
+ *   `\int_T [kappa(x) \nabla u(x)] * \nabla psi(x) + c(x) u(x) psi(x) dx`
+ *
+ * for all basis functions psi of the range space on an element T, where kappa and c are provided by the derived
+ * classes. This is the action of the operator given by appending a LocalElementIntegralBilinearForm with the
+ * respective integrand(s) to a MatrixOperator, but without assembling a matrix.
+ *
+ * On cubes, where both source and range basis are tensor products of the 1d Lagrange polynomials in the equidistant
+ * nodes j/k (i.e., for the DiscontinuousLagrangeSpace and the ContinuousLagrangeSpace), the source DoFs are
+ * interpolated to a tensor-product Gauss quadrature and tested back by one-dimensional contractions along each
+ * direction, which costs O(d^2 k^{d + 1}) operations per element instead of the O(k^{2d}) of a quadrature loop over all
+ * basis functions. Since the element transformation is evaluated pointwise, non-affine cubes are supported as well.
+ * On all other elements (or if the source is not discrete) we fall back to a standard quadrature.
+ *
+ * Use this by appending one of the derived operators to a LocalizableOperator, e.g.
+\code
+auto op = make_localizable_operator<M>(grid_view, space, space);
+op.append(LocalSumFactorizedLaplaceOperator<V, GV>(diffusion));
+op.apply(source_vector, range_vector);
+\endcode
+ *
+ * \note See also LocalElementOperatorInterface for a description of the template arguments.
+ *
+ * \sa LocalElementOperatorInterface
+ * \sa LocalLaplaceIntegrand
+ * \sa LocalEllipticIntegrand
+ * \sa LocalElementProductIntegrand
+ */
+template <class SV, class SGV, class SF = double, class RF = SF, class RGV = SGV, class RV = SV>
+class LocalSumFactorizedElementOperatorBase : public LocalElementOperatorInterface<SV, SGV, 1, 1, SF, 1, 1, RF, RGV, RV>
+{
+  using ThisType = LocalSumFactorizedElementOperatorBase;
+  using BaseType = LocalElementOperatorInterface<SV, SGV, 1, 1, SF, 1, 1, RF, RGV, RV>;
+
+public:
+  using BaseType::d;
+  using typename BaseType::D;
+  using typename BaseType::E;
+  using typename BaseType::LocalRangeType;
+  using typename BaseType::LocalSourceType;
+  using typename BaseType::SourceType;
+
+  using DomainType = FieldVector<D, d>;
+  using DiffusionType = FieldMatrix<RF, d, d>;
+  using LocalDiscreteSourceType = ConstLocalDiscreteFunction<SV, SGV, 1, 1, SF>;
+
+  LocalSumFactorizedElementOperatorBase(const bool with_diffusion,
+                                        const bool with_reaction,
+                                        const int over_integrate = 0,
+                                        const XT::Common::ParameterType& param_type = {})
+    : BaseType(1, param_type)
+    , with_diffusion_(with_diffusion)
+    , with_reaction_(with_reaction)
+    , over_integrate_(over_integrate)
+  {}
+
+  LocalSumFactorizedElementOperatorBase(const ThisType& other)
+    : BaseType(other)
+    , with_diffusion_(other.with_diffusion_)
+    , with_reaction_(other.with_reaction_)
+    , over_integrate_(other.over_integrate_)
+  {}
+
+  virtual ~LocalSumFactorizedElementOperatorBase() = default;
+
+  bool linear() const override final
+  {
+    return true;
+  }
+
+  using BaseType::element;
+
+  void apply(LocalRangeType& local_range, const XT::Common::Parameter& param = {}) const override final
+  {
+    const auto& basis = local_range.basis();
+    const auto* local_discrete_source = dynamic_cast<const LocalDiscreteSourceType*>(local_sources_[0].get());
+    if (local_discrete_source != nullptr && element().geometry().type().isCube()
+        && compute_tensor_indices(basis.finite_element(), range_fe_, range_indices_)
+        && compute_tensor_indices(local_discrete_source->basis().finite_element(), source_fe_, source_indices_))
+      apply_sum_factorized(*local_discrete_source, local_range, param);
+    else
+      apply_quadrature(local_range, param);
+  } // ... apply(...)
+
+protected:
+  /// \brief Order of the coefficients, used to determine the quadrature.
+  virtual int coefficient_order(const XT::Common::Parameter& param) const = 0;
+
+  /// \brief Evaluates kappa (if with_diffusion) and c (if with_reaction) at the given point.
+  virtual void evaluate_coefficients(const DomainType& point_in_reference_element,
+                                     DiffusionType& diffusion,
+                                     RF& reaction,
+                                     const XT::Common::Parameter& param) const = 0;
+
+private:
+  template <class FiniteElementType>
+  static bool compute_tensor_indices(const FiniteElementType& finite_element,
+                                     const void*& cached_finite_element,
+                                     std::vector<size_t>& tensor_indices)
+  {
+    // all elements of the same geometry type share the same finite element, thus we compare pointers
+    if (cached_finite_element == &finite_element)
+      return !tensor_indices.empty();
+    cached_finite_element = &finite_element;
+    tensor_indices.clear();
+    if (!finite_element.is_lagrangian() || !finite_element.geometry_type().isCube())
+      return false;
+    const int order = finite_element.order();
+    const size_t num_nodes = static_cast<size_t>(order) + 1;
+    size_t expected_size = 1;
+    for (size_t dd = 0; dd < d; ++dd)
+      expected_size *= num_nodes;
+    const auto& lagrange_points = finite_element.lagrange_points();
+    if (order < 0 || lagrange_points.size() != expected_size || finite_element.size() != expected_size)
+      return false;
+    std::vector<size_t> indices(expected_size);
+    std::vector<bool> visited(expected_size, false);
+    for (size_t ii = 0; ii < expected_size; ++ii) {
+      size_t tensor_index = 0;
+      size_t stride = 1;
+      for (size_t dd = 0; dd < d; ++dd) {
+        const D scaled = (order == 0) ? D(2) * lagrange_points[ii][dd] - D(1) : lagrange_points[ii][dd] * D(order);
+        const auto node = std::lround(scaled);
+        if (std::abs(scaled - D(node)) > 1e-10 || node < 0 || node > order)
+          return false;
+        tensor_index += stride * static_cast<size_t>(node);
+        stride *= num_nodes;
+      }
+      if (visited[tensor_index])
+        return false;
+      visited[tensor_index] = true;
+      indices[ii] = tensor_index;
+    }
+    tensor_indices = std::move(indices);
+    return true;
+  } // ... compute_tensor_indices(...)
+
+  void update_shapes(const int source_order, const int range_order, const int integration_order) const
+  {
+    if (source_shapes_ && source_shapes_->order() == source_order && range_shapes_->order() == range_order
+        && integration_order_ == integration_order)
+      return;
+    integration_order_ = integration_order;
+    const auto& rule = QuadratureRules<D, 1>::rule(GeometryTypes::line, integration_order);
+    points_1d_.resize(rule.size());
+    weights_1d_.resize(rule.size());
+    for (size_t qq = 0; qq < rule.size(); ++qq) {
+      points_1d_[qq] = rule[qq].position()[0];
+      weights_1d_[qq] = rule[qq].weight();
+    }
+    source_shapes_ = std::make_unique<internal::TensorProductLagrangeShapes1d<RF>>(source_order, points_1d_);
+    range_shapes_ = std::make_unique<internal::TensorProductLagrangeShapes1d<RF>>(range_order, points_1d_);
+  } // ... update_shapes(...)
+
+  void apply_sum_factorized(const LocalDiscreteSourceType& local_source,
+                            LocalRangeType& local_range,
+                            const XT::Common::Parameter& param) const
+  {
+    const int source_order = local_source.basis().finite_element().order();
+    const int range_order = local_range.basis().finite_element().order();
+    update_shapes(source_order,
+                  range_order,
+                  std::max(source_order + range_order + coefficient_order(param) + over_integrate_, 0));
+    const size_t num_points_1d = points_1d_.size();
+    size_t num_points = 1;
+    for (size_t dd = 0; dd < d; ++dd)
+      num_points *= num_points_1d;
+    // gather the source DoFs in tensor order
+    const auto& source_dofs = local_source.dofs();
+    source_tensor_.resize(source_indices_.size());
+    for (size_t ii = 0; ii < source_indices_.size(); ++ii)
+      source_tensor_[source_indices_[ii]] = source_dofs[ii];
+    // interpolate values and reference gradients to the quadrature points
+    if (with_reaction_)
+      internal::apply_tensor_product<RF, d>(*source_shapes_, false, d, source_tensor_, values_, tmp_);
+    if (with_diffusion_)
+      for (size_t dd = 0; dd < d; ++dd)
+        internal::apply_tensor_product<RF, d>(*source_shapes_, false, dd, source_tensor_, gradients_[dd], tmp_);
+    // apply the coefficients and the transformation pointwise
+    const auto& geometry = element().geometry();
+    const bool affine = geometry.affine();
+    DomainType point_in_reference_element;
+    DiffusionType diffusion(0.);
+    RF reaction = 0.;
+    DomainType reference_gradient, gradient, flux, reference_flux;
+    auto jacobian_inverse_transposed = geometry.jacobianInverseTransposed(point_in_reference_element);
+    auto integration_element = geometry.integrationElement(point_in_reference_element);
+    for (size_t qq = 0; qq < num_points; ++qq) {
+      RF weight = 1.;
+      size_t remainder = qq;
+      for (size_t dd = 0; dd < d; ++dd) {
+        point_in_reference_element[dd] = points_1d_[remainder % num_points_1d];
+        weight *= weights_1d_[remainder % num_points_1d];
+        remainder /= num_points_1d;
+      }
+      if (!affine) {
+        jacobian_inverse_transposed = geometry.jacobianInverseTransposed(point_in_reference_element);
+        integration_element = geometry.integrationElement(point_in_reference_element);
+      }
+      weight *= integration_element;
+      evaluate_coefficients(point_in_reference_element, diffusion, reaction, param);
+      if (with_reaction_)
+        values_[qq] *= weight * reaction;
+      if (with_diffusion_) {
+        // (J^{-T})^T kappa J^{-T} \hat{\nabla} u, to be tested against \hat{\nabla} psi
+        for (size_t dd = 0; dd < d; ++dd)
+          reference_gradient[dd] = gradients_[dd][qq];
+        jacobian_inverse_transposed.mv(reference_gradient, gradient);
+        diffusion.mv(gradient, flux);
+        jacobian_inverse_transposed.mtv(flux, reference_flux);
+        for (size_t dd = 0; dd < d; ++dd)
+          gradients_[dd][qq] = weight * reference_flux[dd];
+      }
+    }
+    // test against the range basis
+    range_tensor_.assign(range_indices_.size(), 0.);
+    if (with_reaction_) {
+      internal::apply_tensor_product<RF, d>(*range_shapes_, true, d, values_, result_, tmp_);
+      for (size_t ii = 0; ii < range_tensor_.size(); ++ii)
+        range_tensor_[ii] += result_[ii];
+    }
+    if (with_diffusion_)
+      for (size_t dd = 0; dd < d; ++dd) {
+        internal::apply_tensor_product<RF, d>(*range_shapes_, true, dd, gradients_[dd], result_, tmp_);
+        for (size_t ii = 0; ii < range_tensor_.size(); ++ii)
+          range_tensor_[ii] += result_[ii];
+      }
+    // scatter to the local range in basis order
+    for (size_t ii = 0; ii < range_indices_.size(); ++ii)
+      local_range.dofs()[ii] += range_tensor_[range_indices_[ii]];
+  } // ... apply_sum_factorized(...)
+
+  void apply_quadrature(LocalRangeType& local_range, const XT::Common::Parameter& param) const
+  {
+    const auto& u = local_sources_[0];
+    const auto& basis = local_range.basis();
+    const size_t size = basis.size(param);
+    const auto integrand_order = u->order(param) + basis.order(param) + coefficient_order(param) + over_integrate_;
+    DiffusionType diffusion(0.);
+    RF reaction = 0.;
+    DomainType flux;
+    for (const auto& quadrature_point : QuadratureRules<D, d>::rule(element().geometry().type(), integrand_order)) {
+      const auto point_in_reference_element = quadrature_point.position();
+      const auto factor =
+          element().geometry().integrationElement(point_in_reference_element) * quadrature_point.weight();
+      evaluate_coefficients(point_in_reference_element, diffusion, reaction, param);
+      if (with_reaction_) {
+        const auto source_value = u->evaluate(point_in_reference_element, param)[0];
+        basis.evaluate(point_in_reference_element, basis_values_, param);
+        for (size_t ii = 0; ii < size; ++ii)
+          local_range.dofs()[ii] += factor * reaction * source_value * basis_values_[ii][0];
+      }
+      if (with_diffusion_) {
+        const auto source_jacobian = u->jacobian(point_in_reference_element, param);
+        diffusion.mv(source_jacobian[0], flux);
+        basis.jacobians(point_in_reference_element, basis_jacobians_, param);
+        for (size_t ii = 0; ii < size; ++ii)
+          local_range.dofs()[ii] += factor * (flux * basis_jacobians_[ii][0]);
+      }
+    }
+  } // ... apply_quadrature(...)
+
+  using BaseType::local_sources_;
+  const bool with_diffusion_;
+  const bool with_reaction_;
+  const int over_integrate_;
+  mutable const void* source_fe_ = nullptr;
+  mutable const void* range_fe_ = nullptr;
+  mutable std::vector<size_t> source_indices_;
+  mutable std::vector<size_t> range_indices_;
+  mutable int integration_order_ = -1;
+  mutable std::vector<D> points_1d_;
+  mutable std::vector<RF> weights_1d_;
+  mutable std::unique_ptr<internal::TensorProductLagrangeShapes1d<RF>> source_shapes_;
+  mutable std::unique_ptr<internal::TensorProductLagrangeShapes1d<RF>> range_shapes_;
+  mutable std::vector<RF> source_tensor_;
+  mutable std::vector<RF> range_tensor_;
+  mutable std::vector<RF> values_;
+  mutable std::array<std::vector<RF>, d> gradients_;
+  mutable std::vector<RF> result_;
+  mutable std::vector<RF> tmp_;
+  mutable std::vector<typename LocalRangeType::LocalBasisType::RangeType> basis_values_;
+  mutable std::vector<typename LocalRangeType::LocalBasisType::DerivativeRangeType> basis_jacobians_;
+}; // class LocalSumFactorizedElementOperatorBase
+
+
+/**
+ * \brief Matrix-free counterpart of LocalLaplaceIntegrand, computes `\int_T [kappa(x) \nabla u(x)] * \nabla psi(x)`.
+ *
+ * \sa LocalSumFactorizedElementOperatorBase
+ * \sa LocalLaplaceIntegrand
+ */
+template <class SV, class SGV, class SF = double, class RF = SF, class RGV = SGV, class RV = SV>
+class LocalSumFactorizedLaplaceOperator : public LocalSumFactorizedElementOperatorBase<SV, SGV, SF, RF, RGV, RV>
+{
+  using ThisType = LocalSumFactorizedLaplaceOperator;
+  using BaseType = LocalSumFactorizedElementOperatorBase<SV, SGV, SF, RF, RGV, RV>;
+
+public:
+  using BaseType::d;
+  using typename BaseType::DiffusionType;
+  using typename BaseType::DomainType;
+  using typename BaseType::E;
+  using InterfaceType = LocalElementOperatorInterface<SV, SGV, 1, 1, SF, 1, 1, RF, RGV, RV>;
+
+  explicit LocalSumFactorizedLaplaceOperator(
+      XT::Functions::GridFunction<E, d, d, RF> diffusion = XT::LA::eye_matrix<FieldMatrix<RF, d, d>>(d, d),
+      const int over_integrate = 0)
+    : BaseType(true, false, over_integrate)
+    , diffusion_(diffusion)
+    , local_diffusion_(diffusion_.local_function())
+  {}
+
+  LocalSumFactorizedLaplaceOperator(const ThisType& other)
+    : BaseType(other)
+    , diffusion_(other.diffusion_)
+    , local_diffusion_(diffusion_.local_function())
+  {}
+
+  std::unique_ptr<InterfaceType> copy() const override final
+  {
+    return std::make_unique<ThisType>(*this);
+  }
+
+protected:
+  void post_bind(const E& ele) override final
+  {
+    BaseType::post_bind(ele);
+    local_diffusion_->bind(ele);
+  }
+
+  int coefficient_order(const XT::Common::Parameter& param) const override final
+  {
+    return local_diffusion_->order(param);
+  }
+
+  void evaluate_coefficients(const DomainType& point_in_reference_element,
+                             DiffusionType& diffusion,
+                             RF& /*reaction*/,
+                             const XT::Common::Parameter& param) const override final
+  {
+    diffusion = local_diffusion_->evaluate(point_in_reference_element, param);
+  }
+
+private:
+  XT::Functions::GridFunction<E, d, d, RF> diffusion_;
+  std::unique_ptr<typename XT::Functions::GridFunction<E, d, d, RF>::LocalFunctionType> local_diffusion_;
+}; // class LocalSumFactorizedLaplaceOperator
+
+
+/**
+ * \brief Matrix-free counterpart of LocalEllipticIntegrand, computes
+ *        `\int_T lambda(x) [kappa(x) \nabla u(x)] * \nabla psi(x)`.
+ *
+ * \sa LocalSumFactorizedElementOperatorBase
+ * \sa LocalEllipticIntegrand
+ */
+template <class SV, class SGV, class SF = double, class RF = SF, class RGV = SGV, class RV = SV>
+class LocalSumFactorizedEllipticOperator : public LocalSumFactorizedElementOperatorBase<SV, SGV, SF, RF, RGV, RV>
+{
+  using ThisType = LocalSumFactorizedEllipticOperator;
+  using BaseType = LocalSumFactorizedElementOperatorBase<SV, SGV, SF, RF, RGV, RV>;
+
+public:
+  using BaseType::d;
+  using typename BaseType::DiffusionType;
+  using typename BaseType::DomainType;
+  using typename BaseType::E;
+  using InterfaceType = LocalElementOperatorInterface<SV, SGV, 1, 1, SF, 1, 1, RF, RGV, RV>;
+
+  LocalSumFactorizedEllipticOperator(
+      XT::Functions::GridFunction<E, 1, 1, RF> diffusion_factor = 1.,
+      XT::Functions::GridFunction<E, d, d, RF> diffusion_tensor = XT::LA::eye_matrix<FieldMatrix<RF, d, d>>(d, d),
+      const int over_integrate = 0)
+    : BaseType(true, false, over_integrate)
+    , diffusion_factor_(diffusion_factor)
+    , diffusion_tensor_(diffusion_tensor)
+    , local_diffusion_factor_(diffusion_factor_.local_function())
+    , local_diffusion_tensor_(diffusion_tensor_.local_function())
+  {}
+
+  LocalSumFactorizedEllipticOperator(const ThisType& other)
+    : BaseType(other)
+    , diffusion_factor_(other.diffusion_factor_)
+    , diffusion_tensor_(other.diffusion_tensor_)
+    , local_diffusion_factor_(diffusion_factor_.local_function())
+    , local_diffusion_tensor_(diffusion_tensor_.local_function())
+  {}
+
+  std::unique_ptr<InterfaceType> copy() const override final
+  {
+    return std::make_unique<ThisType>(*this);
+  }
+
+protected:
+  void post_bind(const E& ele) override final
+  {
+    BaseType::post_bind(ele);
+    local_diffusion_factor_->bind(ele);
+    local_diffusion_tensor_->bind(ele);
+  }
+
+  int coefficient_order(const XT::Common::Parameter& param) const override final
+  {
+    return local_diffusion_factor_->order(param) + local_diffusion_tensor_->order(param);
+  }
+
+  void evaluate_coefficients(const DomainType& point_in_reference_element,
+                             DiffusionType& diffusion,
+                             RF& /*reaction*/,
+                             const XT::Common::Parameter& param) const override final
+  {
+    diffusion = local_diffusion_tensor_->evaluate(point_in_reference_element, param);
+    diffusion *= local_diffusion_factor_->evaluate(point_in_reference_element, param)[0][0];
+  }
+
+private:
+  XT::Functions::GridFunction<E, 1, 1, RF> diffusion_factor_;
+  XT::Functions::GridFunction<E, d, d, RF> diffusion_tensor_;
+  std::unique_ptr<typename XT::Functions::GridFunction<E, 1, 1, RF>::LocalFunctionType> local_diffusion_factor_;
+  std::unique_ptr<typename XT::Functions::GridFunction<E, d, d, RF>::LocalFunctionType> local_diffusion_tensor_;
+}; // class LocalSumFactorizedEllipticOperator
+
+
+/**
+ * \brief Matrix-free counterpart of LocalElementProductIntegrand, computes `\int_T c(x) u(x) psi(x)`.
+ *
+ * \sa LocalSumFactorizedElementOperatorBase
+ * \sa LocalElementProductIntegrand
+ */
+template <class SV, class SGV, class SF = double, class RF = SF, class RGV = SGV, class RV = SV>
+class LocalSumFactorizedProductOperator : public LocalSumFactorizedElementOperatorBase<SV, SGV, SF, RF, RGV, RV>
+{
+  using ThisType = LocalSumFactorizedProductOperator;
+  using BaseType = LocalSumFactorizedElementOperatorBase<SV, SGV, SF, RF, RGV, RV>;
+
+public:
+  using BaseType::d;
+  using typename BaseType::DiffusionType;
+  using typename BaseType::DomainType;
+  using typename BaseType::E;
+  using InterfaceType = LocalElementOperatorInterface<SV, SGV, 1, 1, SF, 1, 1, RF, RGV, RV>;
+
+  explicit LocalSumFactorizedProductOperator(XT::Functions::GridFunction<E, 1, 1, RF> weight = 1.,
+                                             const int over_integrate = 0)
+    : BaseType(false, true, over_integrate)
+    , weight_(weight)
+    , local_weight_(weight_.local_function())
+  {}
+
+  LocalSumFactorizedProductOperator(const ThisType& other)
+    : BaseType(other)
+    , weight_(other.weight_)
+    , local_weight_(weight_.local_function())
+  {}
+
+  std::unique_ptr<InterfaceType> copy() const override final
+  {
+    return std::make_unique<ThisType>(*this);
+  }
+
+protected:
+  void post_bind(const E& ele) override final
+  {
+    BaseType::post_bind(ele);
+    local_weight_->bind(ele);
+  }
+
+  int coefficient_order(const XT::Common::Parameter& param) const override final
+  {
+    return local_weight_->order(param);
+  }
+
+  void evaluate_coefficients(const DomainType& point_in_reference_element,
+                             DiffusionType& /*diffusion*/,
+                             RF& reaction,
+                             const XT::Common::Parameter& param) const override final
+  {
+    reaction = local_weight_->evaluate(point_in_reference_element, param)[0][0];
+  }
+
+private:
+  XT::Functions::GridFunction<E, 1, 1, RF> weight_;
+  std::unique_ptr<typename XT::Functions::GridFunction<E, 1, 1, RF>::LocalFunctionType> local_weight_;
+}; // class LocalSumFactorizedProductOperator
+
+
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_LOCAL_OPERATORS_SUM_FACTORIZED_HH
@@ -30,6 +30,7 @@
 #include <dune/gdt/local/operators/advection-dg.hh>
 #include <dune/gdt/spaces/l2/finite-volume.hh>
 #include <dune/gdt/tools/local-mass-matrix.hh>
+#include <dune/gdt/tools/wave-speeds.hh>
 
 #include "interfaces.hh"
 #include "localizable-operator.hh"
@@ -83,6 +84,7 @@ public:
   using typename BaseType::MatrixOperatorType;
   using typename BaseType::RangeFunctionType;
   using typename BaseType::RangeSpaceType;
+  using typename BaseType::SourceFunctionInterfaceType;
   using typename BaseType::SourceSpaceType;
   using typename BaseType::VectorType;
 
@@ -102,6 +104,7 @@ public:
     , artificial_viscosity_nu_1_(artificial_viscosity_nu_1)
     , artificial_viscosity_alpha_1_(artificial_viscosity_alpha_1)
     , artificial_viscosity_component_(artificial_viscosity_component)
+    , wave_speeds_(std::make_shared<WaveSpeedAccumulator<F>>())
   {
     // we assemble these once, to be used in each apply later on
     auto walker = XT::Grid::make_walker(assembly_grid_view);
@@ -110,13 +113,13 @@ public:
     // element contributions
     this->append(
         LocalAdvectionDgVolumeOperator<V, SGV, m, F, F, RGV, V>(local_mass_matrix_provider_, numerical_flux_->flux()));
+    LocalAdvectionDgCouplingOperator<I, V, SGV, m, F, F, RGV, V> coupling_operator(
+        local_mass_matrix_provider_, *numerical_flux_, /*compute_outside=*/false);
+    coupling_operator.collect_wave_speeds(wave_speeds_);
     // contributions from inner intersections
-    this->append(LocalAdvectionDgCouplingOperator<I, V, SGV, m, F, F, RGV, V>(
-                     local_mass_matrix_provider_, *numerical_flux_, /*compute_outside=*/false),
-                 XT::Grid::ApplyOn::InnerIntersections<SGV>());
+    this->append(coupling_operator, XT::Grid::ApplyOn::InnerIntersections<SGV>());
     // contributions from periodic boundaries
-    this->append(LocalAdvectionDgCouplingOperator<I, V, SGV, m, F, F, RGV, V>(
-                     local_mass_matrix_provider_, *numerical_flux_, /*compute_outside=*/false),
+    this->append(coupling_operator,
                  *(XT::Grid::ApplyOn::PeriodicBoundaryIntersections<SGV>() && !(*periodicity_exception_)));
     // artificial viscosity by shock capturing [DF2015, Sec. 8.5]
     this->append(LocalAdvectionDgArtificialViscosityShockCapturingOperator<V, SGV, m, F, F, RGV, V>(
@@ -130,6 +133,67 @@ public:
   AdvectionDgOperator(ThisType&& source) = default;
 
   using BaseType::append;
+  using BaseType::apply;
+
+  void apply(const SourceFunctionInterfaceType& source_function,
+             VectorType& range,
+             const XT::Common::Parameter& param = {}) const
+  {
+    wave_speeds_->reset();
+    BaseType::apply(source_function, range, param);
+  }
+
+  void apply(const VectorType& source, VectorType& range, const XT::Common::Parameter& param = {}) const override
+  {
+    wave_speeds_->reset();
+    BaseType::apply(source, range, param);
+  }
+
+  void apply_and_communicate(const SourceFunctionInterfaceType& source_function,
+                             VectorType& range,
+                             const XT::Common::Parameter& param = {}) const
+  {
+    wave_speeds_->reset();
+    BaseType::apply_and_communicate(source_function, range, param);
+  }
+
+  void apply_and_communicate(const VectorType& source, VectorType& range, const XT::Common::Parameter& param = {}) const
+  {
+    wave_speeds_->reset();
+    BaseType::apply_and_communicate(source, range, param);
+  }
+
+  /// \name CFL estimate
+  /// \{
+
+  /**
+   * \brief If enabled, the maximal wave speeds at the quadrature points of all inner and periodic intersections are
+   *        collected during each apply(), at the cost of evaluating NumericalFluxInterface::max_wave_speed once per
+   *        quadrature point.
+   *
+   * \note Non-periodic boundary intersections are not taken into account.
+   */
+  ThisType& collect_wave_speeds(const bool enable = true)
+  {
+    wave_speeds_->enable(enable);
+    return *this;
+  }
+
+  const WaveSpeedAccumulator<F>& wave_speeds() const
+  {
+    return *wave_speeds_;
+  }
+
+  /**
+   * \brief Returns cfl times the stable time step length of an explicit Euler finite volume step for the source of the
+   *        last call to apply(), reduced over all ranks (see WaveSpeedAccumulator, use cfl <= 1 / (2p + 1)).
+   */
+  F estimate_dt(const F& cfl) const
+  {
+    return wave_speeds_->estimate_dt(this->assembly_grid_view_.comm(), cfl);
+  }
+
+  /// \}
 
   /// \name Non-periodic boundary treatment
   /// \{
@@ -167,6 +231,7 @@ protected:
   const double artificial_viscosity_nu_1_;
   const double artificial_viscosity_alpha_1_;
   const size_t artificial_viscosity_component_;
+  std::shared_ptr<WaveSpeedAccumulator<F>> wave_speeds_;
 }; // class AdvectionDgOperator
 
 
@@ -60,6 +60,19 @@ public:
     inverse_hessian_operator_.apply_inverse_hessian(source, u_update, range, param);
   }
 
+  /**
+   * \brief Variant of apply() which uses the split-phase application of the wrapped operator, if available.
+   *
+   * The inverse Hessian is applied elementwise on all elements, so only the wrapped operator has to communicate.
+   */
+  void apply_and_communicate(const VectorType& source, VectorType& range, const XT::Common::Parameter& param) const
+  {
+    VectorType u_update = range;
+    std::fill(u_update.begin(), u_update.end(), 0.);
+    internal::apply_and_communicate(operator_, source, u_update, range_space(), param);
+    inverse_hessian_operator_.apply_inverse_hessian(source, u_update, range, param);
+  }
+
   const OperatorType& operator_;
   const InverseHessianOperatorType& inverse_hessian_operator_;
 }; // class EntropicCoordinatesOperator<...>
@@ -122,6 +135,25 @@ public:
     inverse_hessian_operator_.apply_inverse_hessian(source, u_update, range, param);
   }
 
+  /**
+   * \brief Variant of apply() which uses the split-phase application of the advection operator, if available.
+   *
+   * The density, right hand side and inverse Hessian operators act elementwise on all elements, so only the advection
+   * operator has to communicate.
+   */
+  void apply_and_communicate(const VectorType& source, VectorType& range, const XT::Common::Parameter& param) const
+  {
+    density_op_.apply(source, range, param);
+    VectorType u_update = range;
+    VectorType rhs_update = range;
+    std::fill(u_update.begin(), u_update.end(), 0.);
+    internal::apply_and_communicate(advection_op_, source, u_update, range_space(), param);
+    u_update *= -1.;
+    rhs_op_.apply(source, rhs_update, param);
+    u_update += rhs_update;
+    inverse_hessian_operator_.apply_inverse_hessian(source, u_update, range, param);
+  }
+
   const DensityOperatorType& density_op_;
   const AdvectionOperatorType& advection_op_;
   const RhsOperatorType& rhs_op_;
@@ -147,9 +179,13 @@ public:
   using AdvectionOperatorType = AdvectionOperatorImp;
   using EntropySolverType = EntropySolverImp;
 
-  EntropyBasedMomentFvOperator(const AdvectionOperatorType& advection_operator, const EntropySolverType& entropy_solver)
+  EntropyBasedMomentFvOperator(const AdvectionOperatorType& advection_operator,
+                               const EntropySolverType& entropy_solver,
+                               const bool warm_start = false)
     : advection_operator_(advection_operator)
     , entropy_solver_(entropy_solver)
+    , warm_start_(warm_start)
+    , has_previous_solution_(false)
   {}
 
   bool linear() const override final
@@ -167,18 +203,74 @@ public:
     return advection_operator_.range_space();
   }
 
+  /**
+   * \brief Solves the optimization problems (regularizing if necessary) and applies the advection operator to the
+   *        resulting moments.
+   *
+   * If warm_start is true, the regularized moments and the alphas of each call are kept and used as starting points in
+   * the next call (i.e., the next Runge-Kutta stage or time step), where the moments usually differ only slightly.
+   *
+   * \note With warm_start, apply() modifies the stored solution and must not be called concurrently.
+   */
   void apply(const VectorType& source, VectorType& range, const XT::Common::Parameter& param) const override final
   {
-    // solve optimization problems and regularize if necessary
-    VectorType regularized = range;
-    entropy_solver_.apply(source, regularized, param);
+    apply_to_regularized(source, range, param, [&](const VectorType& regularized) {
+      advection_operator_.apply(regularized, range, param);
+    });
+  } // ... apply(...)
+
+  /**
+   * \brief Variant of apply() which uses the split-phase application of the advection operator, if available.
+   *
+   * The optimization problems are solved on all elements (as in apply()), so only the advection operator has to
+   * communicate.
+   */
+  void apply_and_communicate(const VectorType& source, VectorType& range, const XT::Common::Parameter& param) const
+  {
+    apply_to_regularized(source, range, param, [&](const VectorType& regularized) {
+      internal::apply_and_communicate(advection_operator_, regularized, range, range_space(), param);
+    });
+  } // ... apply_and_communicate(...)
 
-    std::fill(range.begin(), range.end(), 0.);
-    advection_operator_.apply(regularized, range, param);
+  // Drops the stored solution, e.g., if the next call to apply is not related to the last one.
+  void reset_warm_start() const
+  {
+    has_previous_solution_ = false;
   }
 
+private:
+  // solves the optimization problems and regularizes if necessary, then zeroes range and calls apply_advection with the
+  // regularized moments
+  template <class ApplyAdvectionType>
+  void apply_to_regularized(const VectorType& source,
+                            VectorType& range,
+                            const XT::Common::Parameter& param,
+                            const ApplyAdvectionType& apply_advection) const
+  {
+    if (warm_start_) {
+      if (regularized_.size() != source.size()) {
+        regularized_ = source;
+        alphas_ = source;
+        has_previous_solution_ = false;
+      }
+      entropy_solver_.apply_with_warm_start(source, regularized_, alphas_, has_previous_solution_, param);
+      has_previous_solution_ = true;
+      std::fill(range.begin(), range.end(), 0.);
+      apply_advection(regularized_);
+    } else {
+      VectorType regularized = range;
+      entropy_solver_.apply(source, regularized, param);
+      std::fill(range.begin(), range.end(), 0.);
+      apply_advection(regularized);
+    }
+  } // ... apply_to_regularized(...)
+
   const AdvectionOperatorType& advection_operator_;
   const EntropySolverType& entropy_solver_;
+  const bool warm_start_;
+  mutable VectorType regularized_;
+  mutable VectorType alphas_;
+  mutable bool has_previous_solution_;
 }; // class EntropyBasedMomentFvOperator<...>
 
 
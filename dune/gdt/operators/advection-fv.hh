@@ -21,6 +21,7 @@
 
 #include <dune/gdt/local/assembler/operator-fd-jacobian-assemblers.hh>
 #include <dune/gdt/local/operators/advection-fv.hh>
+#include <dune/gdt/tools/wave-speeds.hh>
 
 #include "interfaces.hh"
 #include "localizable-operator.hh"
@@ -61,6 +62,7 @@ public:
 
   using typename BaseType::MatrixOperatorType;
   using typename BaseType::RangeSpaceType;
+  using typename BaseType::SourceFunctionInterfaceType;
   using typename BaseType::SourceSpaceType;
   using typename BaseType::VectorType;
 
@@ -73,12 +75,14 @@ public:
     : BaseType(assembly_grid_view, source_space, range_space)
     , numerical_flux_(numerical_flux.copy())
     , periodicity_exception_(periodicity_exception.copy())
+    , wave_speeds_(std::make_shared<WaveSpeedAccumulator<F>>())
   {
+    LocalAdvectionFvCouplingOperator<I, V, SGV, m, F, F, RGV, V> coupling_operator(*numerical_flux_);
+    coupling_operator.collect_wave_speeds(wave_speeds_);
     // contributions from inner intersections
-    this->append(LocalAdvectionFvCouplingOperator<I, V, SGV, m, F, F, RGV, V>(*numerical_flux_),
-                 XT::Grid::ApplyOn::InnerIntersectionsOnce<SGV>());
+    this->append(coupling_operator, XT::Grid::ApplyOn::InnerIntersectionsOnce<SGV>());
     // contributions from periodic boundaries
-    this->append(LocalAdvectionFvCouplingOperator<I, V, SGV, m, F, F, RGV, V>(*numerical_flux_),
+    this->append(coupling_operator,
                  *(XT::Grid::ApplyOn::PeriodicBoundaryIntersectionsOnce<SGV>() && !(*periodicity_exception_)));
   }
 
@@ -86,9 +90,70 @@ public:
     : BaseType(std::move(source))
     , numerical_flux_(std::move(source.numerical_flux_))
     , periodicity_exception_(std::move(source.periodicity_exception_))
+    , wave_speeds_(std::move(source.wave_speeds_))
   {}
 
   using BaseType::append;
+  using BaseType::apply;
+
+  void apply(const SourceFunctionInterfaceType& source_function,
+             VectorType& range,
+             const XT::Common::Parameter& param = {}) const
+  {
+    wave_speeds_->reset();
+    BaseType::apply(source_function, range, param);
+  }
+
+  void apply(const VectorType& source, VectorType& range, const XT::Common::Parameter& param = {}) const override
+  {
+    wave_speeds_->reset();
+    BaseType::apply(source, range, param);
+  }
+
+  void apply_and_communicate(const SourceFunctionInterfaceType& source_function,
+                             VectorType& range,
+                             const XT::Common::Parameter& param = {}) const
+  {
+    wave_speeds_->reset();
+    BaseType::apply_and_communicate(source_function, range, param);
+  }
+
+  void apply_and_communicate(const VectorType& source, VectorType& range, const XT::Common::Parameter& param = {}) const
+  {
+    wave_speeds_->reset();
+    BaseType::apply_and_communicate(source, range, param);
+  }
+
+  /// \name CFL estimate
+  /// \{
+
+  /**
+   * \brief If enabled, the maximal wave speeds on all inner and periodic intersections are collected during each
+   *        apply(), at the cost of evaluating NumericalFluxInterface::max_wave_speed once per intersection.
+   *
+   * \note Non-periodic boundary intersections are not taken into account.
+   */
+  ThisType& collect_wave_speeds(const bool enable = true)
+  {
+    wave_speeds_->enable(enable);
+    return *this;
+  }
+
+  const WaveSpeedAccumulator<F>& wave_speeds() const
+  {
+    return *wave_speeds_;
+  }
+
+  /**
+   * \brief Returns a stable time step length (for an explicit Euler step, scaled by cfl) for the source of the last
+   *        call to apply(), reduced over all ranks (see WaveSpeedAccumulator).
+   */
+  F estimate_dt(const F& cfl = 1.) const
+  {
+    return wave_speeds_->estimate_dt(this->assembly_grid_view_.comm(), cfl);
+  }
+
+  /// \}
 
   /// \name Non-periodic boundary treatment
   /// \{
@@ -119,6 +184,7 @@ public:
 private:
   std::unique_ptr<const NumericalFluxType> numerical_flux_;
   std::unique_ptr<XT::Grid::IntersectionFilter<SGV>> periodicity_exception_;
+  std::shared_ptr<WaveSpeedAccumulator<F>> wave_speeds_;
 }; // class AdvectionFvOperator
 
 
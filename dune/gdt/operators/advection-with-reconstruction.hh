@@ -71,6 +71,14 @@ public:
     advection_operator_.apply(reconstruction_, range, param);
   }
 
+  /// \brief Variant of apply() which uses the split-phase application of the advection operator, if available.
+  void apply_and_communicate(const VectorType& source, VectorType& range, const XT::Common::Parameter& param) const
+  {
+    reconstruction_operator_.apply(source, reconstruction_, param);
+    std::fill(range.begin(), range.end(), 0.);
+    internal::apply_and_communicate(advection_operator_, reconstruction_, range, range_space(), param);
+  }
+
   const AdvectionOperatorType& advection_operator_;
   const ReconstructionOperatorType& reconstruction_operator_;
   mutable VectorType reconstruction_;
@@ -131,6 +139,18 @@ public:
     advection_operator_.apply(reconstructed_function, range, param);
   }
 
+  /// \brief Variant of apply() which uses the split-phase application of the advection operator, if available.
+  void apply_and_communicate(const VectorType& source, VectorType& range, const XT::Common::Parameter& param) const
+  {
+    typename ReconstructionOperatorType::ReconstructedValuesType reconstructed_values(
+        source_space().grid_view().indexSet().size(0));
+    typename ReconstructionOperatorType::ReconstructedFunctionType reconstructed_function(source_space().grid_view(),
+                                                                                          reconstructed_values);
+    reconstruction_operator_.apply(source, reconstructed_function, param);
+    std::fill(range.begin(), range.end(), 0.);
+    internal::apply_and_communicate(advection_operator_, reconstructed_function, range, range_space(), param);
+  }
+
   const AdvectionOperatorType& advection_operator_;
   const ReconstructionOperatorType& reconstruction_operator_;
 }; // class AdvectionWithReconstructionOperator<...>
@@ -12,6 +12,7 @@
 #ifndef DUNE_GDT_OPERATORS_INTERFACES_HH
 #define DUNE_GDT_OPERATORS_INTERFACES_HH
 
+#include <algorithm>
 #include <cmath>
 #include <type_traits>
 
@@ -373,12 +374,20 @@ invert_options(some_type).get<std::string>("type") == some_type
 \endcode
    * and possibly other key/value pairs.
    *
+   * For "newton", the jacobian is reassembled every "jacobian_update_frequency" iterations (the default of 1 yields the
+   * classical Newton scheme, 0 freezes the jacobian of the initial guess). A stale jacobian is always reassembled, if
+   * the resulting update does not decrease the residual without dampening.
+   *
    * \todo Allow to pass jacobian options as subcfg in newton.
    */
   virtual XT::Common::Configuration invert_options(const std::string& type) const
   {
     if (type == "newton") {
-      return {{"type", type}, {"precision", "1e-7"}, {"max_iter", "100"}, {"max_dampening_iter", "1000"}};
+      return {{"type", type},
+              {"precision", "1e-7"},
+              {"max_iter", "100"},
+              {"max_dampening_iter", "1000"},
+              {"jacobian_update_frequency", "1"}};
     } else
       DUNE_THROW(Exceptions::operator_error, "type = " << type);
   } // ... invert_options(...)
@@ -403,7 +412,7 @@ invert_options(some_type).get<std::string>("type") == some_type
       auto residual = range.copy();
       auto update = source.copy();
       auto candidate = source.copy();
-      // one matrix for all jacobians
+      // one pattern, matrix and linear solver for all jacobians, only the values are refilled in place
       MatrixOperatorType jacobian_op(this->source_space().grid_view(),
                                      this->source_space(),
                                      this->range_space(),
@@ -413,6 +422,12 @@ invert_options(some_type).get<std::string>("type") == some_type
       const auto precision = opts.get("precision", default_opts.get<double>("precision"));
       const auto max_iter = opts.get("max_iter", default_opts.get<size_t>("max_iter"));
       const auto max_dampening_iter = opts.get("max_dampening_iter", default_opts.get<size_t>("max_iter"));
+      const auto jacobian_update_frequency =
+          opts.get("jacobian_update_frequency", default_opts.get<size_t>("jacobian_update_frequency"));
+      // the linear solver which succeeded last is tried first
+      auto linear_solver_types = jacobian_solver.types();
+      bool jacobian_is_assembled = false;
+      size_t jacobian_age = 0;
       size_t l = 0;
       Timer timer;
       while (true) {
@@ -429,20 +444,26 @@ invert_options(some_type).get<std::string>("type") == some_type
                       Exceptions::operator_error,
                       "max iterations reached!\n|residual|_l2 = " << res << "\nopts:\n"
                                                                   << opts);
-        logger.debug() << "       computing jacobi matrix ... " << std::flush;
-        timer.reset();
-        jacobian_op.matrix() *= 0.;
-        residual_op.jacobian(source, jacobian_op, {{"type", residual_op.jacobian_options().at(0)}}, param);
-        jacobian_op.walk(/*use_tbb=*/true);
-        logger.debug() << "took " << timer.elapsed() << "s"
-                       << "\n"
-                       << "       solving for defect ... " << std::flush;
+        if (!jacobian_is_assembled
+            || (jacobian_update_frequency > 0 && jacobian_age >= jacobian_update_frequency)) {
+          logger.debug() << "       computing jacobi matrix ... " << std::flush;
+          timer.reset();
+          jacobian_op.matrix() *= 0.;
+          residual_op.jacobian(source, jacobian_op, {{"type", residual_op.jacobian_options().at(0)}}, param);
+          jacobian_op.walk(/*use_tbb=*/true);
+          jacobian_is_assembled = true;
+          jacobian_age = 0;
+          logger.debug() << "took " << timer.elapsed() << "s" << std::endl;
+        } else
+          logger.debug() << "       reusing jacobi matrix of age " << jacobian_age << std::endl;
+        logger.debug() << "       solving for defect ... " << std::flush;
         timer.reset();
         residual *= -1.;
         update = source; // <- initial guess for the linear solver
         bool linear_solve_succeeded = false;
         std::vector<std::string> tried_linear_solvers;
-        for (const auto& linear_solver_type : jacobian_solver.types()) {
+        for (size_t ii = 0; ii < linear_solver_types.size(); ++ii) {
+          const auto linear_solver_type = linear_solver_types[ii];
           try {
             tried_linear_solvers.push_back(linear_solver_type);
             jacobian_solver.apply(
@@ -450,6 +471,8 @@ invert_options(some_type).get<std::string>("type") == some_type
                 update,
                 {{"type", linear_solver_type}, {"precision", XT::Common::to_string(0.1 * precision)}});
             linear_solve_succeeded = true;
+            std::rotate(linear_solver_types.begin(), linear_solver_types.begin() + ii, linear_solver_types.end());
+            break;
           } catch (const XT::LA::Exceptions::linear_solver_failed&) {
           }
         }
@@ -467,7 +490,13 @@ invert_options(some_type).get<std::string>("type") == some_type
         size_t k = 0;
         auto candidate_res = 2 * res; // any number such that we enter the while loop at least once
         double lambda = 1;
+        bool jacobian_is_stale = false;
         while (!(candidate_res / res < 1)) {
+          if (k == 1 && jacobian_age > 0) {
+            // the update of an old jacobian needs dampening, rather recompute the jacobian
+            jacobian_is_stale = true;
+            break;
+          }
           DUNE_THROW_IF(k >= max_dampening_iter,
                         Exceptions::operator_error,
                         "max iterations reached when trying to compute automatic dampening!\n|residual|_l2 = "
@@ -479,8 +508,14 @@ invert_options(some_type).get<std::string>("type") == some_type
           lambda /= 2;
           k += 1;
         }
+        if (jacobian_is_stale) {
+          logger.debug() << "took " << timer.elapsed() << "s, discarding update of stale jacobian" << std::endl;
+          jacobian_is_assembled = false;
+          continue;
+        }
         source = candidate;
         logger.debug() << "took " << timer.elapsed() << "s and a dampening of " << 2 * lambda << std::endl;
+        jacobian_age += 1;
         l += 1;
       }
     } else
@@ -847,6 +882,55 @@ invert_options(some_type).get<std::string>("type") == some_type
 }; // class OperatorInterface
 
 
+namespace internal {
+
+
+template <class OperatorType, class SourceType, class VectorType, class RangeSpaceType>
+auto apply_and_communicate(const OperatorType& op,
+                           const SourceType& source,
+                           VectorType& range,
+                           const RangeSpaceType& /*range_space*/,
+                           const XT::Common::Parameter& param,
+                           int) -> decltype(op.apply_and_communicate(source, range, param), void())
+{
+  op.apply_and_communicate(source, range, param);
+}
+
+template <class OperatorType, class SourceType, class VectorType, class RangeSpaceType>
+void apply_and_communicate(const OperatorType& op,
+                           const SourceType& source,
+                           VectorType& range,
+                           const RangeSpaceType& range_space,
+                           const XT::Common::Parameter& param,
+                           long)
+{
+  op.apply(source, range, param);
+  range_space.dof_halo_exchange().communicate(range);
+}
+
+/**
+ * \brief Computes range = op(source) and communicates the DoFs of range to all ranks holding copies of them.
+ *
+ * Uses the split-phase op.apply_and_communicate() if the operator provides it (see
+ * LocalizableOperator::apply_and_communicate), which overlaps the communication with the computation on interior
+ * elements, and op.apply() followed by a communication via the DofHaloExchange of range_space otherwise. Operators
+ * wrapping another operator (e.g., AdvectionWithReconstructionOperator) forward to this function to pass the
+ * split-phase application of the wrapped operator on.
+ */
+template <class OperatorType, class SourceType, class VectorType, class RangeSpaceType>
+void apply_and_communicate(const OperatorType& op,
+                           const SourceType& source,
+                           VectorType& range,
+                           const RangeSpaceType& range_space,
+                           const XT::Common::Parameter& param)
+{
+  apply_and_communicate(op, source, range, range_space, param, 0);
+}
+
+
+} // namespace internal
+
+
 } // namespace GDT
 } // namespace Dune
 
@@ -11,9 +11,17 @@
 #ifndef DUNE_GDT_OPERATORS_LOCALIZABLE_OPERATOR_HH
 #define DUNE_GDT_OPERATORS_LOCALIZABLE_OPERATOR_HH
 
+#include <algorithm>
+#include <functional>
 #include <list>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 #include <dune/xt/common/deprecated.hh>
+#include <dune/xt/common/parallel/threadmanager.hh>
+#include <dune/xt/common/string.hh>
 #include <dune/xt/la/type_traits.hh>
 #include <dune/xt/grid/type_traits.hh>
 #include <dune/xt/grid/walker.hh>
@@ -99,11 +107,19 @@ public:
       GenericLocalIntersectionOperator<I, SV, SGV, s_r, s_rC, SF, r_r, r_rC, RF, RGV, RV>;
   using GenericLocalIntersectionFunctionType = typename GenericLocalIntersectionOperatorType::GenericFunctionType;
 
+  using ReductionType = LocalOperatorApplicationReduction<RV>;
+  using LocalElementOperatorApplicatorType =
+      LocalElementOperatorApplicator<AGV, SV, s_r, s_rC, SF, SGV, r_r, r_rC, RF, RGV, RV>;
+  using LocalIntersectionOperatorApplicatorType =
+      LocalIntersectionOperatorApplicator<AGV, SV, s_r, s_rC, SF, SGV, r_r, r_rC, RF, RGV, RV, RGV, RV>;
+
   LocalizableDiscreteOperatorApplicator(AssemblyGridViewType assembly_grid_view, const SourceType& src, RangeType& rng)
     : BaseType(assembly_grid_view)
     , source_(src)
     , range_(rng)
     , assembled_(false)
+    , num_appended_local_operators_(0)
+    , reduction_(nullptr)
   {
     // to detect assembly
     this->append(
@@ -125,13 +141,46 @@ public:
     return range_;
   }
 
+  /**
+   * \brief Lets all local operators appended afterwards write into thread-private ranges, the contributions of which
+   *        are added to the range in assemble(), see LocalOperatorApplicationReduction.
+   *
+   * Use this if two threads could otherwise update the same range DoF (as for intersection operators or continuous
+   * range spaces). If deterministic is true, the result is bit-identical regardless of the number of threads.
+   */
+  ThisType& use_thread_private_ranges(const bool deterministic = false)
+  {
+    DUNE_THROW_IF(num_appended_local_operators_ > 0,
+                  Exceptions::operator_error,
+                  "Call use_thread_private_ranges() before appending local operators!");
+    own_reduction_ = std::make_unique<ReductionType>(range_.dofs().vector(), deterministic);
+    reduction_ = own_reduction_.get();
+    return *this;
+  }
+
+  /**
+   * \brief Variant of use_thread_private_ranges(), which uses (and resets) the given reduction, to reuse its
+   *        thread-private ranges in repeated grid walks. The reduction has to outlive assemble().
+   */
+  ThisType& use_thread_private_ranges(ReductionType& reduction, const bool deterministic = false)
+  {
+    DUNE_THROW_IF(num_appended_local_operators_ > 0,
+                  Exceptions::operator_error,
+                  "Call use_thread_private_ranges() before appending local operators!");
+    reduction.reset(range_.dofs().vector(), deterministic);
+    own_reduction_.reset();
+    reduction_ = &reduction;
+    return *this;
+  }
+
   using BaseType::append;
 
   ThisType& append(const LocalElementOperatorInterface<SV, SGV, s_r, s_rC, SF, r_r, r_rC, RF, RGV, RV>& local_operator,
                    const XT::Common::Parameter& param = {},
                    const ElementFilterType& filter = ApplyOnAllElements())
   {
-    this->append(make_local_element_operator_applicator(local_operator, range_, param).release(), filter);
+    this->append(new LocalElementOperatorApplicatorType(local_operator, range_, param, reduction_), filter);
+    ++num_appended_local_operators_;
     return *this;
   }
 
@@ -148,7 +197,9 @@ public:
          const XT::Common::Parameter& param = {},
          const IntersectionFilterType& filter = ApplyOnAllIntersections())
   {
-    this->append(make_local_intersection_operator_applicator(local_operator, range_, param).release(), filter);
+    this->append(new LocalIntersectionOperatorApplicatorType(local_operator, range_, range_, param, reduction_),
+                 filter);
+    ++num_appended_local_operators_;
     return *this;
   }
 
@@ -166,13 +217,45 @@ public:
       return;
     // This clears all appended operators, which is ok, since we are done after assembling once!
     this->walk(use_tbb);
+    if (reduction_)
+      reduction_->reduce();
     assembled_ = true;
   }
 
+  /**
+   * \brief Sequential variant of assemble(), which visits the elements in the given order (e.g.,
+   *        MapperInterface::element_order() of the range space) instead of the iteration order of the grid view.
+   */
+  template <class ElementSeedType>
+  void assemble(const std::vector<ElementSeedType>& element_order)
+  {
+    if (assembled_)
+      return;
+    const auto& grid_view = this->grid_view();
+    this->prepare();
+    for (const auto& seed : element_order) {
+      const auto element = grid_view.grid().entity(seed);
+      this->apply_local(element);
+      for (auto&& intersection : intersections(grid_view, element)) {
+        if (intersection.neighbor())
+          this->apply_local(intersection, element, intersection.outside());
+        else
+          this->apply_local(intersection, element, element);
+      }
+    }
+    this->finalize();
+    if (reduction_)
+      reduction_->reduce();
+    assembled_ = true;
+  } // ... assemble(...)
+
 protected:
   const SourceType& source_;
   RangeType& range_;
   bool assembled_;
+  size_t num_appended_local_operators_;
+  std::unique_ptr<ReductionType> own_reduction_;
+  ReductionType* reduction_;
 }; // class LocalizableDiscreteOperatorApplicator
 
 
@@ -300,6 +383,7 @@ public:
 
   using LocalElementOperatorType = LocalElementOperatorInterface<V, SGV, s, sC, F, r, rC, F, RGV, V>;
   using LocalIntersectionOperatorType = LocalIntersectionOperatorInterface<I, V, SGV, s, sC, F, r, rC, F, RGV, V>;
+  using ReductionType = LocalOperatorApplicationReduction<V>;
 
   LocalizableOperator(const AGV& assembly_grid_view,
                       const SourceSpaceType& source_space,
@@ -309,10 +393,48 @@ public:
     , source_space_(source_space)
     , range_space_(range_space)
     , linear_(true)
+    , apply_mode_("direct")
   {}
 
   LocalizableOperator(ThisType&& source) = default;
 
+  /**
+   * Determines how the contributions of the local operators are added to the range in apply() (which walks the grid in
+   * parallel):
+   * - "direct" (the default): all local operators write into the range directly, which is only race-free if no two
+   *             elements share range DoFs and no intersection operators are present;
+   * - "buffered": all local operators write into thread-private ranges, which are summed up after the grid walk;
+   * - "deterministic": all local operators write into element-local storage, the contributions of which are summed
+   *                    up in the order of a sequential grid walk, rendering the result bit-identical regardless of the
+   *                    number of threads (no thread-private ranges are allocated);
+   * - "automatic": "direct" if this is race-free, "buffered" otherwise.
+   *
+   * The thread-private ranges of the "buffered" mode are full vectors, which are allocated in each call of apply() and
+   * reused for both grid walks of apply_and_communicate().
+   *
+   * \sa LocalOperatorApplicationReduction
+   */
+  std::vector<std::string> apply_modes() const
+  {
+    return {"automatic", "direct", "buffered", "deterministic"};
+  }
+
+  const std::string& apply_mode() const
+  {
+    return apply_mode_;
+  }
+
+  /// \sa apply_modes
+  ThisType& apply_mode(const std::string& mode)
+  {
+    const auto modes = apply_modes();
+    DUNE_THROW_IF(std::find(modes.begin(), modes.end(), mode) == modes.end(),
+                  Exceptions::operator_error,
+                  "mode = " << mode << "\n   apply_modes() = " << XT::Common::to_string(modes));
+    apply_mode_ = mode;
+    return *this;
+  }
+
   bool linear() const override final
   {
     return linear_;
@@ -356,24 +478,8 @@ public:
                   Exceptions::operator_error,
                   "this->parameter_type() = " << this->parameter_type() << "\n   param.type() = " << param.type());
     range.set_all(0);
-    auto range_function = make_discrete_function(this->range_space_, range);
-    // set up the actual operator
-    auto localizable_op =
-        make_localizable_operator_applicator(this->assembly_grid_view_, source_function, range_function);
-    // - element contributions
-    for (const auto& op_and_filter : local_element_operators_) {
-      const auto local_op = op_and_filter.first->with_source(source_function);
-      const auto& filter = *op_and_filter.second;
-      localizable_op.append(*local_op, param, filter);
-    }
-    // - intersection contributions
-    for (const auto& op_and_filter : local_intersection_operators_) {
-      const auto local_op = op_and_filter.first->with_source(source_function);
-      const auto& filter = *op_and_filter.second;
-      localizable_op.append(*local_op, param, filter);
-    }
-    // and apply it in a grid walk
-    localizable_op.assemble(/*use_tbb=*/true);
+    auto reduction = make_reduction(range);
+    walk(source_function, range, param, reduction.get());
     DUNE_THROW_IF(!range.valid(), Exceptions::operator_error, "range contains inf or nan!");
   } // ... apply(...)
 
@@ -384,14 +490,71 @@ public:
     apply(source_function, range, param);
   } // ... apply(...)
 
+  /**
+   * \brief Split-phase variant of apply(), which additionally communicates the range DoFs of all elements to the ranks
+   *        holding copies of them (as a DiscreteFunctionDataHandle with Dune::InteriorBorder_All_Interface would).
+   *
+   * The border elements of the range space's element_halo_partition() are computed first, then their DoFs are sent
+   * (see DofHaloExchange) while the remaining elements are computed, and the received DoFs are written to range in
+   * the end.
+   *
+   * \note In the "buffered" and "deterministic" apply modes, the contributions of both phases are summed up
+   *       separately, so the result may differ from apply() in the order of summation.
+   * \note The border elements only contain the face neighbours of the sent elements. For continuous range spaces,
+   *       elements sharing only a vertex or an edge with a sent element also contribute to its DoFs, so apply() is
+   *       followed by a blocking communication instead.
+   */
+  void apply_and_communicate(const SourceFunctionInterfaceType& source_function,
+                             VectorType& range,
+                             const XT::Common::Parameter& param = {}) const
+  {
+    auto& exchange = range_space_.dof_halo_exchange();
+    if (!exchange.required()) {
+      apply(source_function, range, param);
+      return;
+    }
+    if (range_space_.continuous(0)) {
+      apply(source_function, range, param);
+      exchange.communicate(range);
+      return;
+    }
+    DUNE_THROW_IF(!(this->parameter_type() <= param.type()),
+                  Exceptions::operator_error,
+                  "this->parameter_type() = " << this->parameter_type() << "\n   param.type() = " << param.type());
+    const auto& partition = range_space_.element_halo_partition();
+    range.set_all(0);
+    auto reduction = make_reduction(range);
+    walk(source_function, range, param, reduction.get(), [&](const auto& element) {
+      return partition.border(element);
+    });
+    exchange.begin(range);
+    walk(source_function, range, param, reduction.get(), [&](const auto& element) {
+      return !partition.border(element);
+    });
+    exchange.finish(range);
+    DUNE_THROW_IF(!range.valid(), Exceptions::operator_error, "range contains inf or nan!");
+  } // ... apply_and_communicate(...)
+
+  void apply_and_communicate(const VectorType& source, VectorType& range, const XT::Common::Parameter& param = {}) const
+  {
+    DUNE_THROW_IF(!source.valid(), Exceptions::operator_error, "source contains inf or nan!");
+    const auto source_function = make_discrete_function(this->source_space_, source);
+    apply_and_communicate(source_function, range, param);
+  } // ... apply_and_communicate(...)
+
+  /**
+   * "finite-differences" (the default) uses finite differences for all local operators, while "analytic" assembles the
+   * exact local jacobians of all local operators which provide one (see LocalElementOperatorInterface::jacobian), and
+   * falls back to finite differences for all others.
+   */
   std::vector<std::string> jacobian_options() const override final
   {
-    return {"finite-differences"};
+    return {"finite-differences", "analytic"};
   }
 
   XT::Common::Configuration jacobian_options(const std::string& type) const override final
   {
-    DUNE_THROW_IF(type != this->jacobian_options().at(0), Exceptions::operator_error, "type = " << type);
+    DUNE_THROW_IF(type != "analytic" && type != "finite-differences", Exceptions::operator_error, "type = " << type);
     return {{"type", type}, {"eps", "1e-7"}};
   }
 
@@ -408,8 +571,9 @@ public:
                   Exceptions::operator_error,
                   "this->parameter_type() = " << this->parameter_type() << "\n   param.type() = " << param.type());
     DUNE_THROW_IF(!opts.has_key("type"), Exceptions::operator_error, opts);
-    DUNE_THROW_IF(opts.get<std::string>("type") != jacobian_options().at(0), Exceptions::operator_error, opts);
-    const auto default_opts = jacobian_options(jacobian_options().at(0));
+    const auto type = opts.get<std::string>("type");
+    const auto default_opts = jacobian_options(type);
+    const bool analytic = (type == "analytic");
     const auto eps = opts.get("eps", default_opts.template get<double>("eps"));
     const auto parameter = param + XT::Common::Parameter({"finite-difference-jacobians.eps", eps});
     // append the same local ops with the same filters as in apply() above
@@ -418,21 +582,110 @@ public:
     for (const auto& op_and_filter : local_element_operators_) {
       const auto local_op = op_and_filter.first->with_source(source_function);
       const auto& filter = *op_and_filter.second;
-      jacobian_op.append(*local_op, source, parameter, filter);
+      if (analytic && local_op->provides_jacobian())
+        jacobian_op.append_jacobian(*local_op, source, param, filter);
+      else
+        jacobian_op.append(*local_op, source, parameter, filter);
     }
     // - intersection contributions
     for (const auto& op_and_filter : local_intersection_operators_) {
       const auto local_op = op_and_filter.first->with_source(source_function);
       const auto& filter = *op_and_filter.second;
-      jacobian_op.append(*local_op, source, parameter, filter);
+      if (analytic && local_op->provides_jacobian())
+        jacobian_op.append_jacobian(*local_op, source, param, filter);
+      else
+        jacobian_op.append(*local_op, source, parameter, filter);
     }
   } // ... jacobian(...)
 
 protected:
+  using AssemblyElementType = XT::Grid::extract_entity_t<AGV>;
+  using AssemblyIntersectionType = XT::Grid::extract_intersection_t<AGV>;
+
+  /// \brief The reduction required by the apply mode (if any), to be passed to all grid walks of one application.
+  std::unique_ptr<ReductionType> make_reduction(VectorType& range) const
+  {
+    const bool deterministic = (apply_mode_ == "deterministic");
+    if (deterministic || apply_mode_ == "buffered" || (apply_mode_ == "automatic" && !direct_apply_is_race_free()))
+      return std::make_unique<ReductionType>(range, deterministic);
+    return nullptr;
+  }
+
+  /**
+   * \brief Adds the contributions of all local operators to range in one grid walk, using reduction (if given). If
+   *        given, only elements for which element_selector returns true (and intersections of which these are the
+   *        inside) are visited.
+   */
+  void walk(const SourceFunctionInterfaceType& source_function,
+            VectorType& range,
+            const XT::Common::Parameter& param,
+            ReductionType* reduction,
+            const std::function<bool(const AssemblyElementType&)>& element_selector = nullptr) const
+  {
+    auto range_function = make_discrete_function(this->range_space_, range);
+    // set up the actual operator
+    auto localizable_op =
+        make_localizable_operator_applicator(this->assembly_grid_view_, source_function, range_function);
+    if (reduction)
+      localizable_op.use_thread_private_ranges(*reduction, reduction->deterministic());
+    const XT::Grid::ApplyOn::GenericFilteredElements<AGV> selected_elements(
+        [&](const AGV& /*grid_view*/, const AssemblyElementType& element) { return element_selector(element); });
+    const XT::Grid::ApplyOn::GenericFilteredIntersections<AGV> selected_intersections(
+        [&](const AGV& /*grid_view*/, const AssemblyIntersectionType& intersection) {
+          return element_selector(intersection.inside());
+        });
+    // - element contributions
+    for (const auto& op_and_filter : local_element_operators_) {
+      const auto local_op = op_and_filter.first->with_source(source_function);
+      const auto& filter = *op_and_filter.second;
+      if (element_selector)
+        localizable_op.append(*local_op, param, *(filter && selected_elements));
+      else
+        localizable_op.append(*local_op, param, filter);
+    }
+    // - intersection contributions
+    for (const auto& op_and_filter : local_intersection_operators_) {
+      const auto local_op = op_and_filter.first->with_source(source_function);
+      const auto& filter = *op_and_filter.second;
+      if (element_selector)
+        localizable_op.append(*local_op, param, *(filter && selected_intersections));
+      else
+        localizable_op.append(*local_op, param, filter);
+    }
+    // and apply it in a grid walk
+    assemble_applicator(localizable_op, std::is_same<AssemblyElementType, XT::Grid::extract_entity_t<RGV>>());
+  } // ... walk(...)
+
+  /// \brief Walks sequentially in the order of the range DoFs, if these were renumbered (see ElementOrdering).
+  template <class LocalizableOperatorApplicatorType>
+  void assemble_applicator(LocalizableOperatorApplicatorType& localizable_op, std::true_type) const
+  {
+    const auto& element_order = range_space_.mapper().element_order();
+    if (!element_order.empty() && element_order.size() == size_t(assembly_grid_view_.size(0))
+        && XT::Common::threadManager().max_threads() == 1)
+      localizable_op.assemble(element_order);
+    else
+      localizable_op.assemble(/*use_tbb=*/true);
+  }
+
+  template <class LocalizableOperatorApplicatorType>
+  void assemble_applicator(LocalizableOperatorApplicatorType& localizable_op, std::false_type) const
+  {
+    localizable_op.assemble(/*use_tbb=*/true);
+  }
+
+  /// \brief Elements of discontinuous range spaces do not share DoFs, intersections always couple two elements.
+  bool direct_apply_is_race_free() const
+  {
+    return local_intersection_operators_.empty() && !range_space_.continuous(0)
+           && !range_space_.continuous_normal_components();
+  }
+
   const AGV assembly_grid_view_;
   const SourceSpaceType& source_space_;
   const RangeSpaceType& range_space_;
   bool linear_;
+  std::string apply_mode_;
   std::list<std::pair<std::unique_ptr<LocalElementOperatorType>, std::unique_ptr<XT::Grid::ElementFilter<AGV>>>>
       local_element_operators_;
   std::list<
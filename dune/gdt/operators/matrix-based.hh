@@ -25,9 +25,11 @@
 #include <dune/gdt/exceptions.hh>
 #include <dune/gdt/local/assembler/bilinear-form-assemblers.hh>
 #include <dune/gdt/local/assembler/operator-fd-jacobian-assemblers.hh>
+#include <dune/gdt/local/assembler/operator-jacobian-assemblers.hh>
 #include <dune/gdt/local/bilinear-forms/interfaces.hh>
 #include <dune/gdt/local/operators/interfaces.hh>
 #include <dune/gdt/operators/interfaces.hh>
+#include <dune/gdt/tools/matrix-scatter.hh>
 #include <dune/gdt/tools/sparsity-pattern.hh>
 #include <dune/gdt/type_traits.hh>
 
@@ -209,6 +211,11 @@ make_matrix_operator(const SpaceInterface<GV, r, rC, F>& space, const XT::LA::Ma
  * assembly_grid_view, if you want to assemble an operator only on a smaller grid view, consider to append this operator
  * to another walker or provide appropriate filters.
  *
+ * If enabled by enable_offset_recording() (and supported by the matrix backend), the positions of all local matrices in
+ * the matrix values are recorded during the first assembly and reused by all subsequent assemblies (e.g. after clear(),
+ * for a new parameter), see local_matrix_offsets(). Since this requires one offset per entry of each local matrix, it
+ * only pays off if the operator (or its offsets) is assembled repeatedly.
+ *
  * \note See ConstMatrixOperator and OperatorInterface for a description of the template arguments.
  *
  * \sa OperatorInterface
@@ -247,6 +254,8 @@ public:
   using typename WalkerBaseType::E;
   using typename WalkerBaseType::I;
 
+  using LocalMatrixOffsetMapType = LocalMatrixOffsetMap<SGV>;
+
   /**
    * Ctor which accept an existing matrix into which to assemble.
    */
@@ -259,6 +268,7 @@ public:
     , WalkerBaseType(assembly_grid_view)
     , scaling(1.)
     , assembled_(false)
+    , local_matrix_offsets_(nullptr)
   {
     // to detect assembly
     this->append(
@@ -278,6 +288,7 @@ public:
     , WalkerBaseType(assembly_grid_view)
     , scaling(1.)
     , assembled_(false)
+    , local_matrix_offsets_(nullptr)
   {
     // to detect assembly
     this->append(
@@ -293,6 +304,32 @@ public:
 
   FieldType scaling;
 
+  /**
+   * \brief Lets all local bilinear forms appended afterwards record the positions of their local matrices in the matrix
+   *        values during the first assembly, to add the local matrices directly in all subsequent assemblies.
+   *
+   * \note Does nothing if not supported by the matrix backend.
+   */
+  ThisType& enable_offset_recording()
+  {
+    if (LocalMatrixScatterer<M>::supports_offsets && !local_matrix_offsets_)
+      local_matrix_offsets_ = std::make_shared<LocalMatrixOffsetMapType>(this->grid_view());
+    return *this;
+  }
+
+  /**
+   * \brief Positions of the local matrices in the matrix values, shared by all appended local bilinear forms.
+   *
+   * May be shared with another MatrixOperator with the same sparsity pattern (or kept across operators), to reuse the
+   * positions across operators. Has to be set before appending local bilinear forms.
+   *
+   * \note Is nullptr, unless enable_offset_recording() was called or the offsets were set.
+   */
+  std::shared_ptr<LocalMatrixOffsetMapType>& local_matrix_offsets()
+  {
+    return local_matrix_offsets_;
+  }
+
   void clear()
   {
     WalkerBaseType::clear();
@@ -310,7 +347,8 @@ public:
                                         this->source_space(),
                                         local_bilinear_form,
                                         MatrixStorage::access(),
-                                        param + XT::Common::Parameter("matrixoperator.scaling", scaling)),
+                                        param + XT::Common::Parameter("matrixoperator.scaling", scaling),
+                                        local_matrix_offsets_),
                  filter);
     return *this;
   }
@@ -325,7 +363,8 @@ public:
                                         this->source_space(),
                                         local_bilinear_form,
                                         MatrixStorage::access(),
-                                        param + XT::Common::Parameter("matrixoperator.scaling", scaling)),
+                                        param + XT::Common::Parameter("matrixoperator.scaling", scaling),
+                                        local_matrix_offsets_),
                  filter);
     return *this;
   } // ... append(...)
@@ -365,11 +404,50 @@ public:
     return *this;
   }
 
+  /// \}
+  /// \{
+  /// \name Variants to assemble the exact jacobian of the appended local operator, which has to provide one.
+
+  ThisType& append_jacobian(const LocalElementOperatorInterface<V, SGV, s_r, s_rC, F, r_r, r_rC>& local_operator,
+                            const VectorType& source,
+                            const XT::Common::Parameter& param = {},
+                            const ElementFilterType& filter = ApplyOnAllElements())
+  {
+    this->append(new LocalElementOperatorJacobianAssembler<M, SGV, s_r, s_rC, F, r_r, r_rC>(
+                     this->source_space(),
+                     this->range_space(),
+                     MatrixStorage::access(),
+                     source,
+                     local_operator,
+                     param + XT::Common::Parameter("matrixoperator.scaling", scaling)),
+                 filter);
+    return *this;
+  }
+
+  ThisType&
+  append_jacobian(const LocalIntersectionOperatorInterface<I, V, SGV, s_r, s_rC, F, r_r, r_rC>& local_operator,
+                  const VectorType& source,
+                  const XT::Common::Parameter& param = {},
+                  const IntersectionFilterType& filter = ApplyOnAllIntersections())
+  {
+    this->append(new LocalIntersectionOperatorJacobianAssembler<M, SGV, s_r, s_rC, F, r_r, r_rC>(
+                     this->source_space(),
+                     this->range_space(),
+                     MatrixStorage::access(),
+                     source,
+                     local_operator,
+                     param + XT::Common::Parameter("matrixoperator.scaling", scaling)),
+                 filter);
+    return *this;
+  }
+
   /// \}
 
   ThisType& assemble(const bool use_tbb = false) override final
   {
     if (!assembled_) {
+      if (local_matrix_offsets_)
+        local_matrix_offsets_->validate(internal::MatrixRowAccumulator<M>(MatrixStorage::access()).pattern_hash());
       // This clears all appended operators, which is ok, since we are done after assembling once!
       this->walk(use_tbb);
       assembled_ = true;
@@ -391,6 +469,7 @@ public:
 
 private:
   bool assembled_;
+  std::shared_ptr<LocalMatrixOffsetMapType> local_matrix_offsets_;
 }; // class MatrixOperator
 
 
@@ -197,6 +197,7 @@ public:
     , eigenvalues_(std::vector<RangeFieldType>(dimRange))
     , QR_(std::make_unique<JacobianType>(dimDomain, MatrixType(dimRange, dimRange, 0., 0)))
     , tau_(V::create(dimRange))
+    , last_u_(V::create(dimRange))
   {
 #if HAVE_MKL || HAVE_LAPACKE
     int ilo, ihi;
@@ -238,6 +239,12 @@ public:
                                          const VectorType& u,
                                          const XT::Common::Parameter& param) override final
   {
+    // the eigenvectors only depend on u for x-independent, non-parametric fluxes, and neighboring elements often share
+    // the same state (e.g. in regions of constant state), so we reuse the last decomposition in that case
+    const bool reusable = !analytical_flux_.x_dependent() && analytical_flux_.parameter_type().empty();
+    if (reusable && computed_ && same_state(u, last_u_))
+      return;
+    last_u_ = u;
     local_flux_->bind(entity);
     try {
       local_flux_->jacobian(x_local, u, *jacobian_, param);
@@ -327,6 +334,15 @@ public:
   }
 
 protected:
+  static bool same_state(const VectorType& u, const VectorType& v)
+  {
+    for (size_t ii = 0; ii < dimRange; ++ii)
+      if (u[ii] != v[ii])
+        return false;
+    return true;
+  }
+
+  using BaseType::analytical_flux_;
   using BaseType::computed_;
   using BaseType::flux_is_affine_;
   using BaseType::local_flux_;
@@ -340,6 +356,7 @@ protected:
   std::unique_ptr<JacobianType> QR_;
   FieldVector<VectorType, dimDomain> tau_;
   FieldVector<FieldVector<int, dimRange>, dimDomain> permutations_;
+  VectorType last_u_;
 }; // class EigenvectorWrapper<...>
 
 
@@ -17,6 +17,7 @@
 
 #include <dune/gdt/exceptions.hh>
 #include <dune/gdt/local/finite-elements/interfaces.hh>
+#include <dune/gdt/local/finite-elements/tabulation.hh>
 
 #include "interface.hh"
 
@@ -27,6 +28,10 @@ namespace GDT {
 /**
  * Applies no transformation in evaluate, but left-multiplication by the geometry transformations jacobian inverse
  * transpose in jacobian.
+ *
+ * The values and reference jacobians of the local finite elements at quadrature points are tabulated once per geometry
+ * type, finite element order and quadrature (points), and shared by all localized bases (and copies of this basis), see
+ * evaluate_at_quadrature() and jacobians_at_quadrature().
  */
 template <class GV, size_t r = 1, size_t rC = 1, class R = double>
 class DefaultGlobalBasis : public GlobalBasisInterface<GV, r, rC, R>
@@ -42,6 +47,7 @@ public:
   using typename BaseType::GridViewType;
   using typename BaseType::LocalizedType;
   using FiniteElementFamilyType = LocalFiniteElementFamilyInterface<D, d, R, r, rC>;
+  using TabulationCacheType = LocalFiniteElementTabulationCache<D, d, R, r, rC>;
 
   DefaultGlobalBasis(const ThisType&) = default;
   DefaultGlobalBasis(ThisType&&) = default;
@@ -56,6 +62,7 @@ public:
     , local_finite_elements_(local_finite_elements)
     , fe_order_(order)
     , max_size_(0)
+    , tabulations_(std::make_shared<TabulationCacheType>())
   {}
 
   size_t max_size() const override final
@@ -92,6 +99,7 @@ private:
     using typename BaseType::ElementType;
     using typename BaseType::LocalFiniteElementType;
     using typename BaseType::RangeType;
+    using TabulationType = typename TabulationCacheType::TabulationType;
 
     LocalizedDefaultGlobalBasis(const DefaultGlobalBasis<GV, r, rC, R>& self)
       : BaseType()
@@ -167,6 +175,42 @@ private:
         }
     } // ... jacobian(...)
 
+    // overrides of LocalizedGlobalFiniteElementInterface, using the tabulated values
+
+    const std::vector<std::vector<RangeType>>&
+    evaluate_at_quadrature(const QuadratureRule<D, d>& quadrature,
+                           const XT::Common::Parameter& /*param*/ = {}) const override final
+    {
+      DUNE_THROW_IF(!current_local_fe_.valid(), Exceptions::not_bound_to_an_element_yet, "");
+      return tabulation(quadrature).values();
+    }
+
+    const std::vector<std::vector<DerivativeRangeType>>&
+    jacobians_at_quadrature(const QuadratureRule<D, d>& quadrature,
+                            const XT::Common::Parameter& /*param*/ = {}) const override final
+    {
+      DUNE_THROW_IF(!current_local_fe_.valid(), Exceptions::not_bound_to_an_element_yet, "");
+      const auto& reference_jacobians = tabulation(quadrature).jacobians();
+      jacobians_.resize(quadrature.size());
+      if (quadrature.size() == 0)
+        return jacobians_;
+      // see jacobians() above for the transformation, which is constant on affine elements
+      const auto& geometry = this->element().geometry();
+      const bool affine = geometry.affine();
+      auto J_inv_T = geometry.jacobianInverseTransposed(quadrature[0].position());
+      for (size_t qq = 0; qq < quadrature.size(); ++qq) {
+        if (!affine && qq > 0)
+          J_inv_T = geometry.jacobianInverseTransposed(quadrature[qq].position());
+        const auto& reference_jacobians_qq = reference_jacobians[qq];
+        auto& jacobians_qq = jacobians_[qq];
+        jacobians_qq.resize(reference_jacobians_qq.size());
+        for (size_t ii = 0; ii < reference_jacobians_qq.size(); ++ii)
+          for (size_t rr = 0; rr < r; ++rr)
+            J_inv_T.mv(reference_jacobians_qq[ii][rr], jacobians_qq[ii][rr]);
+      }
+      return jacobians_;
+    } // ... jacobians_at_quadrature(...)
+
     // required by LocalizedGlobalFiniteElementInterface
 
     const LocalFiniteElementType& finite_element() const override final
@@ -200,14 +244,26 @@ private:
     }
 
   private:
+    const TabulationType& tabulation(const QuadratureRule<D, d>& quadrature) const
+    {
+      // only lock the shared cache if the geometry type or the quadrature changed
+      const auto& finite_element = current_local_fe_.access();
+      if (!current_tabulation_ || !current_tabulation_->matches(finite_element, quadrature))
+        current_tabulation_ = self_.tabulations_->get(finite_element, quadrature);
+      return *current_tabulation_;
+    }
+
     const DefaultGlobalBasis<GV, r, rC, R>& self_;
     XT::Common::ConstStorageProvider<LocalFiniteElementInterface<D, d, R, r, rC>> current_local_fe_;
+    mutable std::shared_ptr<const TabulationType> current_tabulation_;
+    mutable std::vector<std::vector<DerivativeRangeType>> jacobians_;
   }; // class LocalizedDefaultGlobalBasis
 
   const GridViewType& grid_view_;
   const FiniteElementFamilyType& local_finite_elements_;
   const int fe_order_;
   size_t max_size_;
+  std::shared_ptr<TabulationCacheType> tabulations_;
 }; // class DefaultGlobalBasis
 
 
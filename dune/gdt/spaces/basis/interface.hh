@@ -13,6 +13,10 @@
 #ifndef DUNE_GDT_SPACES_BASIS_INTERFACE_HH
 #define DUNE_GDT_SPACES_BASIS_INTERFACE_HH
 
+#include <vector>
+
+#include <dune/geometry/quadraturerules.hh>
+
 #include <dune/xt/grid/type_traits.hh>
 #include <dune/xt/functions/interfaces/element-functions.hh>
 
@@ -30,6 +34,7 @@ class LocalizedGlobalFiniteElementInterface : public XT::Functions::ElementFunct
 public:
   using BaseType::d;
   using typename BaseType::D;
+  using typename BaseType::DerivativeRangeType;
   using typename BaseType::DomainType;
   using typename BaseType::ElementType;
   using typename BaseType::RangeType;
@@ -90,6 +95,38 @@ public:
       dofs[ii] = dofs_[ii];
   } // ... interpolate(...)
 
+  /**
+   * \brief Evaluates all basis functions at all points of the given quadrature, result[qq][ii] is the value of the
+   *        ii-th basis function in the qq-th quadrature point.
+   *
+   * The default implementation calls evaluate() for each point, implementations may provide tabulated values instead.
+   *
+   * \note The returned reference is only valid until the next call of this method or the next bind().
+   */
+  virtual const std::vector<std::vector<RangeType>>&
+  evaluate_at_quadrature(const QuadratureRule<D, d>& quadrature, const XT::Common::Parameter& param = {}) const
+  {
+    values_at_quadrature_.resize(quadrature.size());
+    for (size_t qq = 0; qq < quadrature.size(); ++qq)
+      this->evaluate(quadrature[qq].position(), values_at_quadrature_[qq], param);
+    return values_at_quadrature_;
+  }
+
+  /**
+   * \brief Computes the jacobians of all basis functions at all points of the given quadrature, analogously to
+   *        evaluate_at_quadrature().
+   *
+   * \note The returned reference is only valid until the next call of this method or the next bind().
+   */
+  virtual const std::vector<std::vector<DerivativeRangeType>>&
+  jacobians_at_quadrature(const QuadratureRule<D, d>& quadrature, const XT::Common::Parameter& param = {}) const
+  {
+    jacobians_at_quadrature_.resize(quadrature.size());
+    for (size_t qq = 0; qq < quadrature.size(); ++qq)
+      this->jacobians(quadrature[qq].position(), jacobians_at_quadrature_[qq], param);
+    return jacobians_at_quadrature_;
+  }
+
   /// \}
   /// \name ``These methods are provided for convenience and should not be used within library code.''
   /// \{
@@ -105,6 +142,8 @@ public:
   /// \}
 private:
   mutable DynamicVector<R> dofs_;
+  mutable std::vector<std::vector<RangeType>> values_at_quadrature_;
+  mutable std::vector<std::vector<DerivativeRangeType>> jacobians_at_quadrature_;
 }; // class LocalizedGlobalFiniteElementInterface
 
 
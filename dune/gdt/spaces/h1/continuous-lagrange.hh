@@ -65,9 +65,13 @@ private:
   using GlobalBasisImplementation = DefaultGlobalBasis<GridViewType, r, 1, R>;
 
 public:
-  ContinuousLagrangeSpace(GridViewType grd_vw, const int order)
+  /// \param element_ordering Determines the numbering of the DoFs, see ElementOrdering.
+  ContinuousLagrangeSpace(GridViewType grd_vw,
+                          const int order,
+                          const ElementOrdering element_ordering = ElementOrdering::grid)
     : grid_view_(grd_vw)
     , fe_order_(order)
+    , element_ordering_(element_ordering)
     , local_finite_elements_(std::make_unique<LocalLagrangeFiniteElementFamily<D, d, R, r>>())
     , mapper_(nullptr)
     , basis_(nullptr)
@@ -78,6 +82,7 @@ public:
   ContinuousLagrangeSpace(const ThisType& other)
     : grid_view_(other.grid_view_)
     , fe_order_(other.fe_order_)
+    , element_ordering_(other.element_ordering_)
     , local_finite_elements_(std::make_unique<LocalLagrangeFiniteElementFamily<D, d, R, r>>())
     , mapper_(nullptr)
     , basis_(nullptr)
@@ -158,7 +163,8 @@ public:
     if (mapper_)
       mapper_->update_after_adapt();
     else
-      mapper_ = std::make_unique<MapperImplementation>(grid_view_, *local_finite_elements_, fe_order_);
+      mapper_ =
+          std::make_unique<MapperImplementation>(grid_view_, *local_finite_elements_, fe_order_, element_ordering_);
     // ... and basis
     if (basis_)
       basis_->update_after_adapt();
@@ -170,6 +176,7 @@ public:
 private:
   const GridViewType grid_view_;
   const int fe_order_;
+  const ElementOrdering element_ordering_;
   int min_polorder_;
   int max_polorder_;
   std::unique_ptr<const LocalLagrangeFiniteElementFamily<D, d, R, r>> local_finite_elements_;
@@ -182,9 +189,10 @@ private:
  * \sa ContinuousLagrangeSpace
  */
 template <size_t r, class GV, class R = double>
-ContinuousLagrangeSpace<GV, r, R> make_continuous_lagrange_space(GV grid_view, const int order)
+ContinuousLagrangeSpace<GV, r, R> make_continuous_lagrange_space(
+    GV grid_view, const int order, const ElementOrdering element_ordering = ElementOrdering::grid)
 {
-  return ContinuousLagrangeSpace<GV, r, R>(grid_view, order);
+  return ContinuousLagrangeSpace<GV, r, R>(grid_view, order, element_ordering);
 }
 
 
@@ -192,9 +200,10 @@ ContinuousLagrangeSpace<GV, r, R> make_continuous_lagrange_space(GV grid_view, c
  * \sa ContinuousLagrangeSpace
  */
 template <class GV, class R = double>
-ContinuousLagrangeSpace<GV, 1, R> make_continuous_lagrange_space(GV grid_view, const int order)
+ContinuousLagrangeSpace<GV, 1, R> make_continuous_lagrange_space(
+    GV grid_view, const int order, const ElementOrdering element_ordering = ElementOrdering::grid)
 {
-  return ContinuousLagrangeSpace<GV, 1, R>(grid_view, order);
+  return ContinuousLagrangeSpace<GV, 1, R>(grid_view, order, element_ordering);
 }
 
 
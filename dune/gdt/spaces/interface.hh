@@ -33,6 +33,7 @@
 #include <dune/gdt/spaces/basis/interface.hh>
 #include <dune/gdt/spaces/mapper/interfaces.hh>
 #include <dune/gdt/spaces/parallel/communication.hh>
+#include <dune/gdt/spaces/parallel/halo.hh>
 #include <dune/gdt/type_traits.hh>
 
 namespace Dune {
@@ -68,6 +69,9 @@ public:
   using MapperType = MapperInterface<GridViewType>;
 
   using DofCommunicatorType = typename DofCommunicationChooser<GridViewType>::Type;
+  using ElementHaloPartitionType = ElementHaloPartition<GridViewType>;
+  using DofHaloPlanType = DofHaloPlan<GridViewType>;
+  using DofHaloExchangeType = DofHaloExchange<GridViewType, R>;
 
   SpaceInterface()
     : dof_communicator_(nullptr)
@@ -208,6 +212,9 @@ public:
   {
     if (adapted_)
       return;
+    dof_halo_exchange_.reset();
+    dof_halo_plan_.reset();
+    element_halo_partition_.reset();
     this->update_after_adapt();
     adapted_ = true;
   }
@@ -323,6 +330,45 @@ public:
     return *dof_communicator_;
   }
 
+  /**
+   * \brief Split of the elements into border and interior elements w.r.t. the exchange of DoFs with other ranks.
+   *
+   * \note Computed on first use (which requires communication, so all ranks have to call this) and after adapt().
+   */
+  const ElementHaloPartitionType& element_halo_partition() const
+  {
+    if (!element_halo_partition_)
+      element_halo_partition_ = std::make_shared<ElementHaloPartitionType>(grid_view());
+    return *element_halo_partition_;
+  }
+
+  /**
+   * \brief The DoF indices exchanged with each neighbouring rank, based on element_halo_partition().
+   *
+   * \note Computed on first use (which requires communication, so all ranks have to call this) and after adapt().
+   */
+  const DofHaloPlanType& dof_halo_plan() const
+  {
+    if (!dof_halo_plan_)
+      dof_halo_plan_ = std::make_shared<DofHaloPlanType>(*this, element_halo_partition());
+    return *dof_halo_plan_;
+  }
+
+  /**
+   * \brief Split-phase communication of DoF vectors of this space, based on dof_halo_plan().
+   *
+   * Use this instead of communicating a DiscreteFunctionDataHandle, e.g. via
+   * space.dof_halo_exchange().communicate(vector).
+   *
+   * \note Computed on first use (which requires communication, so all ranks have to call this) and after adapt().
+   */
+  DofHaloExchangeType& dof_halo_exchange() const
+  {
+    if (!dof_halo_exchange_)
+      dof_halo_exchange_ = std::make_shared<DofHaloExchangeType>(dof_halo_plan());
+    return *dof_halo_exchange_;
+  }
+
   /// \}
   /// \name These methods are provided for convenience.
   /// \{
@@ -366,6 +412,9 @@ protected:
 
 private:
   std::shared_ptr<DofCommunicatorType> dof_communicator_;
+  mutable std::shared_ptr<ElementHaloPartitionType> element_halo_partition_;
+  mutable std::shared_ptr<DofHaloPlanType> dof_halo_plan_;
+  mutable std::shared_ptr<DofHaloExchangeType> dof_halo_exchange_;
   bool adapted_;
 }; // class SpaceInterface
 
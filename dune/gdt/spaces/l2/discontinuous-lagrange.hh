@@ -75,9 +75,13 @@ private:
   using GlobalBasisImplementation = DefaultGlobalBasis<GridViewType, r, 1, R>;
 
 public:
-  DiscontinuousLagrangeSpace(GridViewType grd_vw, const int order = 1)
+  /// \param element_ordering Determines the numbering of the DoFs, see ElementOrdering.
+  DiscontinuousLagrangeSpace(GridViewType grd_vw,
+                             const int order = 1,
+                             const ElementOrdering element_ordering = ElementOrdering::grid)
     : grid_view_(grd_vw)
     , order_(order)
+    , element_ordering_(element_ordering)
     , local_finite_elements_(std::make_unique<const LocalLagrangeFiniteElementFamily<D, d, R, r>>())
     , mapper_(nullptr)
     , basis_(nullptr)
@@ -88,6 +92,7 @@ public:
   DiscontinuousLagrangeSpace(const ThisType& other)
     : grid_view_(other.grid_view_)
     , order_(other.order_)
+    , element_ordering_(other.element_ordering_)
     , local_finite_elements_(std::make_unique<const LocalLagrangeFiniteElementFamily<D, d, R, r>>())
     , mapper_(nullptr)
     , basis_(nullptr)
@@ -163,7 +168,7 @@ public:
     if (mapper_)
       mapper_->update_after_adapt();
     else
-      mapper_ = std::make_unique<MapperImplementation>(grid_view_, *local_finite_elements_, order_);
+      mapper_ = std::make_unique<MapperImplementation>(grid_view_, *local_finite_elements_, order_, element_ordering_);
     // ... and basis
     if (basis_)
       basis_->update_after_adapt();
@@ -175,6 +180,7 @@ public:
 private:
   const GridViewType grid_view_;
   const int order_;
+  const ElementOrdering element_ordering_;
   std::unique_ptr<const LocalLagrangeFiniteElementFamily<D, d, R, r>> local_finite_elements_;
   std::unique_ptr<MapperImplementation> mapper_;
   std::unique_ptr<GlobalBasisImplementation> basis_;
@@ -185,9 +191,10 @@ private:
  * \sa DiscontinuousLagrangeSpace
  */
 template <size_t r, class GV, class R = double>
-DiscontinuousLagrangeSpace<GV, r, R> make_discontinuous_lagrange_space(GV grid_view, const int order)
+DiscontinuousLagrangeSpace<GV, r, R> make_discontinuous_lagrange_space(
+    GV grid_view, const int order, const ElementOrdering element_ordering = ElementOrdering::grid)
 {
-  return DiscontinuousLagrangeSpace<GV, r, R>(grid_view, order);
+  return DiscontinuousLagrangeSpace<GV, r, R>(grid_view, order, element_ordering);
 }
 
 
@@ -195,9 +202,10 @@ DiscontinuousLagrangeSpace<GV, r, R> make_discontinuous_lagrange_space(GV grid_v
  * \sa DiscontinuousLagrangeSpace
  */
 template <class GV, class R = double>
-DiscontinuousLagrangeSpace<GV, 1, R> make_discontinuous_lagrange_space(GV grid_view, const int order)
+DiscontinuousLagrangeSpace<GV, 1, R> make_discontinuous_lagrange_space(
+    GV grid_view, const int order, const ElementOrdering element_ordering = ElementOrdering::grid)
 {
-  return DiscontinuousLagrangeSpace<GV, 1, R>(grid_view, order);
+  return DiscontinuousLagrangeSpace<GV, 1, R>(grid_view, order, element_ordering);
 }
 
 
@@ -11,7 +11,9 @@
 #ifndef DUNE_GDT_SPACES_MAPPER_CONTINUOUS_HH
 #define DUNE_GDT_SPACES_MAPPER_CONTINUOUS_HH
 
+#include <limits>
 #include <set>
+#include <vector>
 
 #include <dune/geometry/type.hh>
 
@@ -23,6 +25,7 @@
 #include <dune/gdt/type_traits.hh>
 #include <dune/gdt/local/finite-elements/interfaces.hh>
 
+#include "element-ordering.hh"
 #include "interfaces.hh"
 
 namespace Dune {
@@ -59,15 +62,22 @@ class ContinuousMapper : public MapperInterface<GV>
 public:
   using BaseType::d;
   using typename BaseType::D;
+  using typename BaseType::ElementSeedType;
   using typename BaseType::ElementType;
   using typename BaseType::GridViewType;
 
+  /**
+   * \param element_ordering If not ElementOrdering::grid, the DoFs are renumbered in the order in which they are first
+   *        encountered when visiting the elements in this order.
+   */
   ContinuousMapper(const GridViewType& grd_vw,
                    const LocalFiniteElementFamily& local_finite_elements,
-                   const int fe_order)
+                   const int fe_order,
+                   const ElementOrdering element_ordering = ElementOrdering::grid)
     : grid_view_(grd_vw)
     , local_finite_elements_(local_finite_elements)
     , fe_order_(fe_order)
+    , element_ordering_(element_ordering)
     , max_local_size_(0)
     , mapper_(grid_view_, [&](const auto& geometry_type, const auto /*grid_dim*/) {
       return (all_DoF_attached_geometry_types_.count(geometry_type) > 0) ? geometry_type_to_local_size_[geometry_type]
@@ -133,7 +143,7 @@ public:
       assert(element.geometry().type() == Dune::GeometryTypes::cube(d)
              && "Not implemented for this element, see comment above!");
 #endif
-    return mapper_.subIndex(element, local_key.subEntity(), local_key.codim()) + local_key.index();
+    return renumber(mapper_.subIndex(element, local_key.subEntity(), local_key.codim()) + local_key.index());
   } // ... mapToGlobal(...)
 
   using BaseType::global_indices;
@@ -147,10 +157,15 @@ public:
       indices.resize(local_sz, 0);
     for (size_t ii = 0; ii < local_sz; ++ii) {
       const auto& local_key = coeffs.local_key(ii);
-      indices[ii] = mapper_.subIndex(element, local_key.subEntity(), local_key.codim()) + local_key.index();
+      indices[ii] = renumber(mapper_.subIndex(element, local_key.subEntity(), local_key.codim()) + local_key.index());
     }
   } // ... globalIndices(...)
 
+  const std::vector<ElementSeedType>& element_order() const override final
+  {
+    return element_order_;
+  }
+
   void update_after_adapt() override final
   {
     // Probably due to non-conforming intersections.
@@ -181,17 +196,44 @@ public:
                   Exceptions::mapper_error,
                   "This must not happen, the finite elements report no DoFs attached to (sub)entities!");
     mapper_.update();
+    // renumber the DoFs in the order of their first occurrence
+    renumbering_.clear();
+    element_order_ = order_elements(grid_view_, element_ordering_);
+    if (element_order_.empty())
+      return;
+    renumbering_.resize(mapper_.size(), std::numeric_limits<size_t>::max());
+    size_t next_index = 0;
+    for (const auto& seed : element_order_) {
+      const auto element = grid_view_.grid().entity(seed);
+      const auto& coeffs = local_coefficients(element.geometry().type());
+      for (size_t ii = 0; ii < coeffs.size(); ++ii) {
+        const auto& local_key = coeffs.local_key(ii);
+        auto& index =
+            renumbering_[mapper_.subIndex(element, local_key.subEntity(), local_key.codim()) + local_key.index()];
+        if (index == std::numeric_limits<size_t>::max())
+          index = next_index++;
+      }
+    }
+    DUNE_THROW_IF(next_index != mapper_.size(), Exceptions::mapper_error, "Not all DoFs are attached to an element!");
   } // ... update_after_adapt(...)
 
 private:
+  size_t renumber(const size_t index) const
+  {
+    return renumbering_.empty() ? index : renumbering_[index];
+  }
+
   const GridViewType& grid_view_;
   const LocalFiniteElementFamily& local_finite_elements_;
   const int fe_order_;
+  const ElementOrdering element_ordering_;
   size_t global_size_;
   size_t max_local_size_;
   std::set<GeometryType> all_DoF_attached_geometry_types_;
   std::map<GeometryType, size_t> geometry_type_to_local_size_;
   Implementation mapper_;
+  std::vector<ElementSeedType> element_order_;
+  std::vector<size_t> renumbering_;
 }; // class ContinuousMapper
 
 
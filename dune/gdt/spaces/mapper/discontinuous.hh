@@ -21,6 +21,7 @@
 #include <dune/gdt/local/finite-elements/lagrange.hh>
 #include <dune/gdt/type_traits.hh>
 
+#include "element-ordering.hh"
 #include "interfaces.hh"
 
 namespace Dune {
@@ -42,15 +43,19 @@ private:
   using Implementation = MultipleCodimMultipleGeomTypeMapper<GV>;
 
 public:
+  using typename BaseType::ElementSeedType;
   using typename BaseType::ElementType;
   using typename BaseType::GridViewType;
 
+  /// \param element_ordering Determines the order in which the elements are numbered, see ElementOrdering.
   DiscontinuousMapper(const GridViewType& grd_vw,
                       const LocalFiniteElementFamily& local_finite_elements,
-                      const int order)
+                      const int order,
+                      const ElementOrdering element_ordering = ElementOrdering::grid)
     : grid_view_(grd_vw)
     , local_finite_elements_(local_finite_elements)
     , order_(order)
+    , element_ordering_(element_ordering)
     , mapper_(grid_view_, mcmgElementLayout())
     , offset_(mapper_.size())
   {
@@ -109,6 +114,16 @@ public:
       indices[ii] = offset + ii;
   } // ... global_indices(...)
 
+  bool element_indices_are_contiguous() const override final
+  {
+    return true;
+  }
+
+  const std::vector<ElementSeedType>& element_order() const override final
+  {
+    return element_order_;
+  }
+
   void update_after_adapt() override final
   {
     mapper_.update();
@@ -116,19 +131,29 @@ public:
     max_num_dofs_ = 0;
     if (offset_.size() != mapper_.size())
       offset_.resize(mapper_.size());
-    for (auto&& element : elements(grid_view_)) {
+    const auto number = [&](const ElementType& element) {
       offset_[mapper_.index(element)] = size_;
       const auto local_sz = this->local_size(element);
       size_ += local_sz;
       max_num_dofs_ = std::max(max_num_dofs_, local_sz);
+    };
+    element_order_ = order_elements(grid_view_, element_ordering_);
+    if (element_order_.empty()) {
+      for (auto&& element : elements(grid_view_))
+        number(element);
+    } else {
+      for (const auto& seed : element_order_)
+        number(grid_view_.grid().entity(seed));
     }
-  }
+  } // ... update_after_adapt(...)
 
 private:
   const GridViewType& grid_view_;
   const LocalFiniteElementFamily& local_finite_elements_;
   const int order_;
+  const ElementOrdering element_ordering_;
   Implementation mapper_;
+  std::vector<ElementSeedType> element_order_;
   std::vector<size_t> offset_;
   size_t max_num_dofs_;
   size_t size_;
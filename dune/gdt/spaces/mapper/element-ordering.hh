@@ -0,0 +1,233 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_SPACES_MAPPER_ELEMENT_ORDERING_HH
+#define DUNE_GDT_SPACES_MAPPER_ELEMENT_ORDERING_HH
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+
+#include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/common/rangegenerators.hh>
+
+#include <dune/xt/grid/type_traits.hh>
+
+#include <dune/gdt/exceptions.hh>
+
+namespace Dune {
+namespace GDT {
+
+
+/**
+ * \brief Determines in which order the mappers number the DoFs of the elements.
+ *
+ * - grid: in the iteration order of the grid view (the default);
+ * - space_filling_curve: along a Hilbert curve through the element centers, which keeps elements which are close in
+ *   space close in memory;
+ * - reverse_cuthill_mckee: in reverse Cuthill-McKee order of the face adjacency graph of the elements, which minimizes
+ *   the bandwidth of the resulting matrices.
+ *
+ * \sa order_elements
+ */
+enum class ElementOrdering
+{
+  grid,
+  space_filling_curve,
+  reverse_cuthill_mckee
+};
+
+
+namespace internal {
+
+
+/**
+ * \brief Position of the point with the given integer coordinates (each within [0, 2^bits)) along the Hilbert curve.
+ *
+ * Uses the transposition algorithm of J. Skilling, Programming the Hilbert curve, AIP Conf. Proc. 707 (2004).
+ */
+template <size_t d>
+std::uint64_t hilbert_index(std::array<std::uint32_t, d> X, const int bits)
+{
+  static_assert(d > 0, "");
+  const std::uint32_t M = std::uint32_t(1) << (bits - 1);
+  // inverse undo excess work
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1) {
+    const std::uint32_t P = Q - 1;
+    for (size_t ii = 0; ii < d; ++ii) {
+      if (X[ii] & Q)
+        X[0] ^= P;
+      else {
+        const std::uint32_t t = (X[0] ^ X[ii]) & P;
+        X[0] ^= t;
+        X[ii] ^= t;
+      }
+    }
+  }
+  // gray encode
+  for (size_t ii = 1; ii < d; ++ii)
+    X[ii] ^= X[ii - 1];
+  std::uint32_t t = 0;
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+    if (X[d - 1] & Q)
+      t ^= Q - 1;
+  for (size_t ii = 0; ii < d; ++ii)
+    X[ii] ^= t;
+  // interleave the transposed bits, most significant first
+  std::uint64_t index = 0;
+  for (int bb = bits - 1; bb >= 0; --bb)
+    for (size_t ii = 0; ii < d; ++ii)
+      index = (index << 1) | ((X[ii] >> bb) & 1);
+  return index;
+} // ... hilbert_index(...)
+
+
+/// \brief Returns a permutation of the element indices (see mapper), sorted along a Hilbert curve.
+template <class GV>
+std::vector<size_t> hilbert_curve_order(const GV& grid_view, const MultipleCodimMultipleGeomTypeMapper<GV>& mapper)
+{
+  static const constexpr size_t d = GV::dimension;
+  using D = typename GV::ctype;
+  const int bits = std::min(31, int(63 / d));
+  std::vector<FieldVector<D, d>> centers(mapper.size());
+  FieldVector<D, d> lower(std::numeric_limits<D>::max());
+  FieldVector<D, d> upper(std::numeric_limits<D>::lowest());
+  for (auto&& element : elements(grid_view)) {
+    const auto center = element.geometry().center();
+    centers[mapper.index(element)] = center;
+    for (size_t ii = 0; ii < d; ++ii) {
+      lower[ii] = std::min(lower[ii], center[ii]);
+      upper[ii] = std::max(upper[ii], center[ii]);
+    }
+  }
+  const D max_coordinate = D((std::uint64_t(1) << bits) - 1);
+  std::vector<std::uint64_t> keys(centers.size());
+  for (size_t kk = 0; kk < centers.size(); ++kk) {
+    std::array<std::uint32_t, d> coordinates;
+    for (size_t ii = 0; ii < d; ++ii) {
+      const D width = upper[ii] - lower[ii];
+      const D relative = width > 0 ? (centers[kk][ii] - lower[ii]) / width : D(0);
+      coordinates[ii] = std::uint32_t(relative * max_coordinate);
+    }
+    keys[kk] = hilbert_index<d>(coordinates, bits);
+  }
+  std::vector<size_t> order(keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](const auto& lhs, const auto& rhs) { return keys[lhs] < keys[rhs]; });
+  return order;
+} // ... hilbert_curve_order(...)
+
+
+/**
+ * \brief Returns a permutation of the element indices (see mapper) in reverse Cuthill-McKee order of the graph, where
+ *        two elements are adjacent if they share an intersection.
+ *
+ * Each connected component is started at a pseudo-peripheral element, found by one breadth-first search from the
+ * element of minimal degree (as proposed by George and Liu).
+ */
+template <class GV>
+std::vector<size_t> reverse_cuthill_mckee_order(const GV& grid_view,
+                                                const MultipleCodimMultipleGeomTypeMapper<GV>& mapper)
+{
+  const size_t num_elements = mapper.size();
+  std::vector<std::vector<size_t>> adjacency(num_elements);
+  for (auto&& element : elements(grid_view)) {
+    auto& neighbors = adjacency[mapper.index(element)];
+    for (auto&& intersection : intersections(grid_view, element))
+      if (intersection.neighbor())
+        neighbors.push_back(mapper.index(intersection.outside()));
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+  }
+  for (auto& neighbors : adjacency)
+    std::stable_sort(neighbors.begin(), neighbors.end(), [&](const auto& lhs, const auto& rhs) {
+      return adjacency[lhs].size() < adjacency[rhs].size();
+    });
+  std::vector<size_t> by_degree(num_elements);
+  std::iota(by_degree.begin(), by_degree.end(), 0);
+  std::stable_sort(by_degree.begin(), by_degree.end(), [&](const auto& lhs, const auto& rhs) {
+    return adjacency[lhs].size() < adjacency[rhs].size();
+  });
+  // appends the elements reachable from start to order (breadth-first), returns one of minimal degree in the last level
+  std::vector<size_t> level(num_elements, std::numeric_limits<size_t>::max());
+  const auto breadth_first_search = [&](const size_t start, std::vector<size_t>& order) {
+    const size_t first = order.size();
+    level[start] = 0;
+    order.push_back(start);
+    for (size_t kk = first; kk < order.size(); ++kk)
+      for (const auto& neighbor : adjacency[order[kk]])
+        if (level[neighbor] == std::numeric_limits<size_t>::max()) {
+          level[neighbor] = level[order[kk]] + 1;
+          order.push_back(neighbor);
+        }
+    size_t last_level_start = order.size() - 1;
+    while (last_level_start > first && level[order[last_level_start - 1]] == level[order.back()])
+      --last_level_start;
+    size_t peripheral = order[last_level_start];
+    for (size_t kk = last_level_start; kk < order.size(); ++kk)
+      if (adjacency[order[kk]].size() < adjacency[peripheral].size())
+        peripheral = order[kk];
+    return peripheral;
+  };
+  std::vector<size_t> order;
+  order.reserve(num_elements);
+  std::vector<size_t> component;
+  for (const auto& candidate : by_degree) {
+    if (level[candidate] != std::numeric_limits<size_t>::max())
+      continue;
+    // find a pseudo-peripheral start, ...
+    component.clear();
+    const size_t start = breadth_first_search(candidate, component);
+    for (const auto& index : component)
+      level[index] = std::numeric_limits<size_t>::max();
+    // ... and number the component from there
+    breadth_first_search(start, order);
+  }
+  DUNE_THROW_IF(order.size() != num_elements, Exceptions::mapper_error, "This must not happen!");
+  std::reverse(order.begin(), order.end());
+  return order;
+} // ... reverse_cuthill_mckee_order(...)
+
+
+} // namespace internal
+
+
+/**
+ * \brief Returns the elements of grid_view (as seeds) in the given order, empty for ElementOrdering::grid.
+ *
+ * The result only depends on the grid view, so all copies of a space compute the same numbering.
+ */
+template <class GV>
+std::vector<typename XT::Grid::extract_entity_t<GV>::EntitySeed> order_elements(const GV& grid_view,
+                                                                                 const ElementOrdering ordering)
+{
+  std::vector<typename XT::Grid::extract_entity_t<GV>::EntitySeed> seeds;
+  if (ordering == ElementOrdering::grid)
+    return seeds;
+  const MultipleCodimMultipleGeomTypeMapper<GV> mapper(grid_view, mcmgElementLayout());
+  const auto order = (ordering == ElementOrdering::space_filling_curve)
+                         ? internal::hilbert_curve_order(grid_view, mapper)
+                         : internal::reverse_cuthill_mckee_order(grid_view, mapper);
+  std::vector<typename XT::Grid::extract_entity_t<GV>::EntitySeed> seeds_by_index(mapper.size());
+  for (auto&& element : elements(grid_view))
+    seeds_by_index[mapper.index(element)] = element.seed();
+  seeds.reserve(order.size());
+  for (const auto& index : order)
+    seeds.push_back(seeds_by_index[index]);
+  return seeds;
+} // ... order_elements(...)
+
+
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_SPACES_MAPPER_ELEMENT_ORDERING_HH
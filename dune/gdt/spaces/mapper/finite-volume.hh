@@ -108,6 +108,11 @@ public:
       }
   } // ... global_indices(...)
 
+  bool element_indices_are_contiguous() const override final
+  {
+    return true;
+  }
+
   void update_after_adapt() override final
   {
     mapper_.update();
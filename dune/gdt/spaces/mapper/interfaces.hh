@@ -12,6 +12,8 @@
 #ifndef DUNE_GDT_SPACES_MAPPER_INTERFACES_HH
 #define DUNE_GDT_SPACES_MAPPER_INTERFACES_HH
 
+#include <vector>
+
 #include <dune/common/dynvector.hh>
 
 #include <dune/xt/grid/type_traits.hh>
@@ -32,6 +34,7 @@ public:
   using D = typename GV::ctype;
   static const constexpr size_t d = GV::dimension;
   using ElementType = XT::Grid::extract_entity_t<GridViewType>;
+  using ElementSeedType = typename ElementType::EntitySeed;
 
   virtual ~MapperInterface() = default;
 
@@ -57,6 +60,28 @@ public:
     return ret;
   }
 
+  /**
+   * \brief Returns true if the global indices of each element are consecutive, i.e., if global_index(element, ii) ==
+   *        global_index(element, 0) + ii, which allows to access the DoFs of an element without indirection (see
+   *        ConstLocalDofVector).
+   */
+  virtual bool element_indices_are_contiguous() const
+  {
+    return false;
+  }
+
+  /**
+   * \brief The elements in the order which was used to number the DoFs (see ElementOrdering), empty if the DoFs are
+   *        numbered in the iteration order of the grid view.
+   *
+   * Walking the grid in this order (see LocalizableDiscreteOperatorApplicator::assemble) accesses the DoFs in order.
+   */
+  virtual const std::vector<ElementSeedType>& element_order() const
+  {
+    static const std::vector<ElementSeedType> grid_order;
+    return grid_order;
+  }
+
   /// \name These methods are required for grid adaptation.
   /// \{
 
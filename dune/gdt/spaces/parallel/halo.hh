@@ -0,0 +1,506 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_SPACES_PARALLEL_HALO_HH
+#define DUNE_GDT_SPACES_PARALLEL_HALO_HH
+
+#include <algorithm>
+#include <climits>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include <dune/common/dynvector.hh>
+#include <dune/common/exceptions.hh>
+#if HAVE_MPI
+#  include <mpi.h>
+#  include <dune/common/parallel/mpicollectivecommunication.hh>
+#  include <dune/common/parallel/mpitraits.hh>
+#endif
+
+#include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/common/gridenums.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/common/rangegenerators.hh>
+
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/la/container/vector-interface.hh>
+
+#include <dune/gdt/exceptions.hh>
+
+namespace Dune {
+namespace GDT {
+
+
+template <class GridView, size_t r, size_t rC, class R>
+class SpaceInterface;
+
+
+namespace internal {
+
+
+/**
+ * \brief Sends the rank of the sender for each element, the receivers record the sender rank, id and index of the
+ *        element.
+ */
+template <class GV>
+class ElementRankDataHandle : public Dune::CommDataHandleIF<ElementRankDataHandle<GV>, int>
+{
+public:
+  using IdType = typename XT::Grid::extract_grid_t<GV>::GlobalIdSet::IdType;
+  using MapperType = MultipleCodimMultipleGeomTypeMapper<GV>;
+  using RecordType = std::tuple<int, IdType, size_t>;
+
+  ElementRankDataHandle(const GV& grid_view, const MapperType& mapper, std::vector<RecordType>& records)
+    : grid_view_(grid_view)
+    , mapper_(mapper)
+    , rank_(grid_view.comm().rank())
+    , records_(records)
+  {}
+
+  bool contains(int /*dim*/, int codim) const
+  {
+    return codim == 0;
+  }
+
+  bool fixedsize(int /*dim*/, int /*codim*/) const
+  {
+    return true;
+  }
+
+  template <class EntityType>
+  size_t size(const EntityType& /*entity*/) const
+  {
+    return 1;
+  }
+
+  template <class MessageBuffer, class EntityType>
+  void gather(MessageBuffer& buff, const EntityType& /*entity*/) const
+  {
+    buff.write(rank_);
+  }
+
+  template <class MessageBuffer, class EntityType>
+  void scatter(MessageBuffer& buff, const EntityType& entity, size_t /*n*/)
+  {
+    int rank;
+    buff.read(rank);
+    records_.emplace_back(rank, grid_view_.grid().globalIdSet().id(entity), mapper_.index(entity));
+  }
+
+private:
+  const GV& grid_view_;
+  const MapperType& mapper_;
+  const int rank_;
+  std::vector<RecordType>& records_;
+}; // class ElementRankDataHandle
+
+
+#if HAVE_MPI
+
+template <class CommunicatorType>
+MPI_Comm mpi_communicator(const CommunicatorType& /*comm*/)
+{
+  return MPI_COMM_SELF;
+}
+
+inline MPI_Comm mpi_communicator(const CollectiveCommunication<MPI_Comm>& comm)
+{
+  return comm;
+}
+
+#endif // HAVE_MPI
+
+
+} // namespace internal
+
+
+/**
+ * \brief Determines which elements are exchanged with which neighbouring rank, and which elements have to be computed
+ *        before the exchange can start.
+ *
+ * The DoFs of a discrete function are communicated element-wise, from the rank owning an element (where it is an
+ * interior element) to all ranks holding an overlap or ghost copy of it (as with Dune::InteriorBorder_All_Interface).
+ * For each neighbouring rank, send_elements() and receive_elements() contain the indices of the respective elements,
+ * sorted by their global id, so that both ranks agree on the order.
+ *
+ * An element is a border element, if its DoFs are sent or if it is a face neighbour of such an element (since
+ * intersection operators may contribute to both elements of an intersection). Computing all border elements first
+ * thus allows to send the results while the remaining (interior) elements are computed. This does not hold for
+ * continuous spaces, where elements sharing only a vertex or an edge with a sent element contribute to its DoFs as well
+ * (see LocalizableOperator::apply_and_communicate).
+ *
+ * \note The constructor requires communication and has to be called on all ranks.
+ */
+template <class GV>
+class ElementHaloPartition
+{
+  using ThisType = ElementHaloPartition;
+
+public:
+  using GridViewType = GV;
+  using ElementType = XT::Grid::extract_entity_t<GV>;
+  using MapperType = MultipleCodimMultipleGeomTypeMapper<GV>;
+  using ElementListsType = std::map<int, std::vector<size_t>>;
+
+  ElementHaloPartition(const GridViewType& grid_view)
+    : grid_view_(grid_view)
+    , mapper_(grid_view_, mcmgElementLayout())
+    , border_(mapper_.size(), false)
+    , num_border_elements_(0)
+  {
+    if (grid_view_.comm().size() == 1)
+      return;
+    // the owners send to all copies ...
+    compute_element_lists(Dune::ForwardCommunication, receive_elements_);
+    // ... and the copies answer, so the owners know whom to send to
+    compute_element_lists(Dune::BackwardCommunication, send_elements_);
+    std::vector<bool> sent(mapper_.size(), false);
+    for (const auto& rank_and_elements : send_elements_)
+      for (const auto& index : rank_and_elements.second)
+        sent[index] = true;
+    for (auto&& element : elements(grid_view_)) {
+      const auto index = mapper_.index(element);
+      bool border = sent[index];
+      for (auto&& intersection : intersections(grid_view_, element)) {
+        if (border)
+          break;
+        if (intersection.neighbor())
+          border = sent[mapper_.index(intersection.outside())];
+      }
+      if (border) {
+        border_[index] = true;
+        ++num_border_elements_;
+      }
+    }
+  } // ElementHaloPartition(...)
+
+  ElementHaloPartition(const ThisType&) = delete;
+  ElementHaloPartition(ThisType&&) = delete;
+
+  const GridViewType& grid_view() const
+  {
+    return grid_view_;
+  }
+
+  const MapperType& mapper() const
+  {
+    return mapper_;
+  }
+
+  template <class EntityType>
+  bool border(const EntityType& element) const
+  {
+    return border_[mapper_.index(element)];
+  }
+
+  size_t num_border_elements() const
+  {
+    return num_border_elements_;
+  }
+
+  /// \brief Indices (see mapper()) of the elements to send to each neighbouring rank.
+  const ElementListsType& send_elements() const
+  {
+    return send_elements_;
+  }
+
+  /// \brief Indices (see mapper()) of the elements to receive from each neighbouring rank.
+  const ElementListsType& receive_elements() const
+  {
+    return receive_elements_;
+  }
+
+private:
+  void compute_element_lists(const Dune::CommunicationDirection direction, ElementListsType& element_lists) const
+  {
+    using DataHandleType = internal::ElementRankDataHandle<GV>;
+    std::vector<typename DataHandleType::RecordType> records;
+    DataHandleType data_handle(grid_view_, mapper_, records);
+    grid_view_.communicate(data_handle, Dune::InteriorBorder_All_Interface, direction);
+    std::sort(records.begin(), records.end(), [](const auto& lhs, const auto& rhs) {
+      return std::get<0>(lhs) < std::get<0>(rhs)
+             || (std::get<0>(lhs) == std::get<0>(rhs) && std::get<1>(lhs) < std::get<1>(rhs));
+    });
+    for (const auto& record : records)
+      element_lists[std::get<0>(record)].push_back(std::get<2>(record));
+  } // ... compute_element_lists(...)
+
+  const GridViewType grid_view_;
+  const MapperType mapper_;
+  std::vector<bool> border_;
+  size_t num_border_elements_;
+  ElementListsType send_elements_;
+  ElementListsType receive_elements_;
+}; // class ElementHaloPartition
+
+
+/**
+ * \brief The DoF indices to send to and receive from each neighbouring rank, based on an ElementHaloPartition.
+ *
+ * For each neighbouring rank, the DoFs of all exchanged elements (in the order of the element lists of the partition,
+ * and of mapper().global_indices() per element) are stored in one flat index array, so that the DoFs of a vector can
+ * be packed into contiguous buffers without walking the grid (see DofHaloExchange).
+ *
+ * \note The constructor has to be called on all ranks.
+ */
+template <class GV>
+class DofHaloPlan
+{
+  using ThisType = DofHaloPlan;
+
+public:
+  using GridViewType = GV;
+  using CommunicatorType = typename GV::CollectiveCommunication;
+
+  template <size_t r, size_t rC, class R>
+  DofHaloPlan(const SpaceInterface<GV, r, rC, R>& space, const ElementHaloPartition<GV>& partition)
+    : communicator_(space.grid_view().comm())
+  {
+    if (communicator_.size() == 1)
+      return;
+#if !HAVE_MPI
+    DUNE_THROW(Dune::NotImplemented, "Communication between several ranks requires MPI!");
+#endif
+    // collect the DoFs of all exchanged elements
+    std::vector<bool> exchanged(partition.mapper().size(), false);
+    for (const auto* element_lists : {&partition.send_elements(), &partition.receive_elements()})
+      for (const auto& rank_and_elements : *element_lists)
+        for (const auto& index : rank_and_elements.second)
+          exchanged[index] = true;
+    std::map<size_t, DynamicVector<size_t>> element_dofs;
+    for (auto&& element : elements(space.grid_view())) {
+      const auto index = partition.mapper().index(element);
+      if (exchanged[index])
+        space.mapper().global_indices(element, element_dofs[index]);
+    }
+    // and flatten them in the order of the element lists
+    const auto flatten = [&](const auto& element_lists, auto& ranks, auto& indices) {
+      for (const auto& rank_and_elements : element_lists) {
+        ranks.push_back(rank_and_elements.first);
+        indices.emplace_back();
+        for (const auto& element_index : rank_and_elements.second) {
+          const auto& dofs = element_dofs[element_index];
+          indices.back().insert(indices.back().end(), dofs.begin(), dofs.end());
+        }
+        DUNE_THROW_IF(indices.back().size() > INT_MAX,
+                      Exceptions::space_error,
+                      "Messages with more than INT_MAX DoFs are not supported!");
+      }
+    };
+    flatten(partition.send_elements(), send_ranks_, send_indices_);
+    flatten(partition.receive_elements(), receive_ranks_, receive_indices_);
+  } // DofHaloPlan(...)
+
+  DofHaloPlan(const ThisType&) = delete;
+  DofHaloPlan(ThisType&&) = delete;
+
+  const CommunicatorType& communicator() const
+  {
+    return communicator_;
+  }
+
+  /// \brief Returns false if there is nothing to exchange (e.g., for sequential grids).
+  bool required() const
+  {
+    return communicator_.size() > 1;
+  }
+
+  const std::vector<int>& send_ranks() const
+  {
+    return send_ranks_;
+  }
+
+  const std::vector<int>& receive_ranks() const
+  {
+    return receive_ranks_;
+  }
+
+  /// \brief The DoFs to send to send_ranks()[kk] are send_indices()[kk].
+  const std::vector<std::vector<size_t>>& send_indices() const
+  {
+    return send_indices_;
+  }
+
+  /// \brief The DoFs to receive from receive_ranks()[kk] are receive_indices()[kk].
+  const std::vector<std::vector<size_t>>& receive_indices() const
+  {
+    return receive_indices_;
+  }
+
+private:
+  const CommunicatorType communicator_;
+  std::vector<int> send_ranks_;
+  std::vector<int> receive_ranks_;
+  std::vector<std::vector<size_t>> send_indices_;
+  std::vector<std::vector<size_t>> receive_indices_;
+}; // class DofHaloPlan
+
+
+/**
+ * \brief Split-phase communication of DoF vectors with entries of type T, based on a DofHaloPlan.
+ *
+ * begin() packs the DoFs to be sent into contiguous buffers and starts all sends and receives, finish() waits for the
+ * receives and unpacks the received DoFs into the vector. In between, the caller may modify all DoFs which are not
+ * exchanged. Calling begin() and finish() directly after each other is equivalent to communicating a
+ * DiscreteFunctionDataHandle with Dune::InteriorBorder_All_Interface and Dune::ForwardCommunication, without walking
+ * the grid or querying the mapper.
+ *
+ * The buffers and the persistent MPI requests (MPI_Send_init, MPI_Recv_init) are created once in the constructor, on a
+ * duplicate of the communicator of the plan. Messages of several exchanges (created from the same or different plans)
+ * and of other communication on the grid thus never match each other, so several exchanges may be in flight at the
+ * same time, but each exchange only once: begin() throws if the previous exchange has not been finished.
+ *
+ * \note The constructor duplicates the communicator and has to be called on all ranks.
+ */
+template <class GV, class T = double>
+class DofHaloExchange
+{
+  using ThisType = DofHaloExchange;
+
+public:
+  using GridViewType = GV;
+  using ScalarType = T;
+  using PlanType = DofHaloPlan<GV>;
+
+  DofHaloExchange(const PlanType& plan)
+    : plan_(plan)
+    , in_flight_(false)
+#if HAVE_MPI
+    , comm_(MPI_COMM_NULL)
+#endif
+  {
+    for (const auto& indices : plan_.send_indices())
+      send_buffers_.emplace_back(indices.size());
+    for (const auto& indices : plan_.receive_indices())
+      receive_buffers_.emplace_back(indices.size());
+#if HAVE_MPI
+    if (!required())
+      return;
+    MPI_Comm_dup(internal::mpi_communicator(plan_.communicator()), &comm_);
+    const auto data_type = MPITraits<T>::getType();
+    requests_.resize(receive_buffers_.size() + send_buffers_.size());
+    size_t request = 0;
+    for (size_t kk = 0; kk < receive_buffers_.size(); ++kk)
+      MPI_Recv_init(receive_buffers_[kk].data(),
+                    static_cast<int>(receive_buffers_[kk].size()),
+                    data_type,
+                    plan_.receive_ranks()[kk],
+                    tag_,
+                    comm_,
+                    &requests_[request++]);
+    for (size_t kk = 0; kk < send_buffers_.size(); ++kk)
+      MPI_Send_init(send_buffers_[kk].data(),
+                    static_cast<int>(send_buffers_[kk].size()),
+                    data_type,
+                    plan_.send_ranks()[kk],
+                    tag_,
+                    comm_,
+                    &requests_[request++]);
+#endif // HAVE_MPI
+  } // DofHaloExchange(...)
+
+  DofHaloExchange(const ThisType&) = delete;
+  DofHaloExchange(ThisType&&) = delete;
+
+  ~DofHaloExchange()
+  {
+#if HAVE_MPI
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (finalized)
+      return;
+    // the buffers have to outlive the messages of an unfinished exchange
+    if (in_flight_ && !requests_.empty())
+      MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+    for (auto& request : requests_)
+      MPI_Request_free(&request);
+    if (comm_ != MPI_COMM_NULL)
+      MPI_Comm_free(&comm_);
+#endif
+  }
+
+  const PlanType& plan() const
+  {
+    return plan_;
+  }
+
+  /// \brief Returns false if there is nothing to exchange (e.g., for sequential grids).
+  bool required() const
+  {
+    return plan_.required();
+  }
+
+  /// \brief Returns true between begin() and finish().
+  bool in_flight() const
+  {
+    return in_flight_;
+  }
+
+  /// \brief Packs the DoFs to be sent and starts all sends and receives, throws if the previous exchange is pending.
+  template <class V>
+  void begin(const XT::LA::VectorInterface<V>& vector)
+  {
+    DUNE_THROW_IF(in_flight_, Exceptions::space_error, "Call finish() before starting the next exchange!");
+    in_flight_ = true;
+    if (!required())
+      return;
+    for (size_t kk = 0; kk < send_buffers_.size(); ++kk) {
+      auto& buffer = send_buffers_[kk];
+      const auto& indices = plan_.send_indices()[kk];
+      for (size_t jj = 0; jj < indices.size(); ++jj)
+        buffer[jj] = vector.get_entry(indices[jj]);
+    }
+#if HAVE_MPI
+    MPI_Startall(static_cast<int>(requests_.size()), requests_.data());
+#endif
+  } // ... begin(...)
+
+  /// \brief Waits for all messages started in begin() and unpacks the received DoFs into vector.
+  template <class V>
+  void finish(XT::LA::VectorInterface<V>& vector)
+  {
+    DUNE_THROW_IF(!in_flight_, Exceptions::space_error, "Call begin() first!");
+    in_flight_ = false;
+    if (!required())
+      return;
+#if HAVE_MPI
+    MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+#endif
+    for (size_t kk = 0; kk < receive_buffers_.size(); ++kk) {
+      const auto& buffer = receive_buffers_[kk];
+      const auto& indices = plan_.receive_indices()[kk];
+      for (size_t jj = 0; jj < indices.size(); ++jj)
+        vector.set_entry(indices[jj], buffer[jj]);
+    }
+  } // ... finish(...)
+
+  template <class V>
+  void communicate(XT::LA::VectorInterface<V>& vector)
+  {
+    begin(vector);
+    finish(vector);
+  }
+
+private:
+  // no other messages are sent on comm_
+  static const constexpr int tag_ = 0;
+  const PlanType& plan_;
+  bool in_flight_;
+  std::vector<std::vector<T>> send_buffers_;
+  std::vector<std::vector<T>> receive_buffers_;
+#if HAVE_MPI
+  MPI_Comm comm_;
+  std::vector<MPI_Request> requests_;
+#endif
+}; // class DofHaloExchange
+
+
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_SPACES_PARALLEL_HALO_HH
@@ -25,6 +25,7 @@
 #include <dune/xt/la/container/istl.hh>
 
 #include "datahandles.hh"
+#include "halo.hh"
 
 namespace Dune {
 namespace GDT {
@@ -55,6 +56,7 @@ public:
     , rank_vector_(space.mapper().size(), rank_)
     , ghosts_(space.mapper().size(), false)
     , verbose_(verbose)
+    , element_dofs_only_(!space.continuous(0) && !space.continuous_normal_components())
   {
     auto view = space.grid_view();
 
@@ -63,15 +65,34 @@ public:
     _all_all_interface = All_All_Interface;
 
     if (view.comm().size() > 1) {
-      // find out about ghosts
-      GDT::GhostDataHandle<GV, r, rD, R, GhostVector> gdh(space, ghosts_, false);
-      space.grid_view().communicate(gdh, _interiorBorder_all_interface, Dune::ForwardCommunication);
-
-      // create disjoint DOF partitioning
-      //            SpaceTypeDataHandle<SpaceType,RankVector,DisjointPartitioningGatherScatter<RankIndex> >
-      //  ibdh(space_,rank_vector_,DisjointPartitioningGatherScatter<RankIndex>(rank_));
-      GDT::DisjointPartitioningDataHandle<GV, r, rD, R, RankVector> pdh(space, rank_vector_);
-      space.grid_view().communicate(pdh, _interiorBorder_all_interface, Dune::ForwardCommunication);
+      if (element_dofs_only_) {
+        // If all DoFs are attached to elements, the DoFs received in a forward communication on the
+        // InteriorBorder_All_Interface are exactly the DoFs of the overlap and ghost elements, each received from the
+        // (unique) rank the element is interior on. Thus the DoF halo plan gives the same result as communicating a
+        // GhostDataHandle and a DisjointPartitioningDataHandle.
+        const RankIndex unknown_rank = std::numeric_limits<RankIndex>::max();
+        const auto& plan = space.dof_halo_plan();
+        for (size_t kk = 0; kk < plan.receive_ranks().size(); ++kk) {
+          const RankIndex received_rank = plan.receive_ranks()[kk];
+          for (const auto& index : plan.receive_indices()[kk]) {
+            // find out about ghosts
+            ghosts_[index] = true;
+            // create disjoint DOF partitioning
+            const RankIndex current_rank = (rank_vector_[index] == rank_) ? unknown_rank : rank_vector_[index];
+            rank_vector_[index] = std::min(current_rank, received_rank);
+          }
+        }
+      } else {
+        // find out about ghosts
+        GDT::GhostDataHandle<GV, r, rD, R, GhostVector> gdh(space, ghosts_, false);
+        space.grid_view().communicate(gdh, _interiorBorder_all_interface, Dune::ForwardCommunication);
+
+        // create disjoint DOF partitioning
+        //            SpaceTypeDataHandle<SpaceType,RankVector,DisjointPartitioningGatherScatter<RankIndex> >
+        //  ibdh(space_,rank_vector_,DisjointPartitioningGatherScatter<RankIndex>(rank_));
+        GDT::DisjointPartitioningDataHandle<GV, r, rD, R, RankVector> pdh(space, rank_vector_);
+        space.grid_view().communicate(pdh, _interiorBorder_all_interface, Dune::ForwardCommunication);
+      }
     }
   }
 
@@ -82,6 +103,18 @@ public:
     return rank_;
   }
 
+  //! Returns the owner rank of each DoF (each DoF is owned by exactly one rank).
+  const RankVector& rank_vector() const
+  {
+    return rank_vector_;
+  }
+
+  //! Returns for each DoF if it is a ghost DoF, i.e., if it is not attached to an interior or border entity.
+  const GhostVector& ghosts() const
+  {
+    return ghosts_;
+  }
+
 #if HAVE_MPI
 
   /* \brief Sets up the parallel communication information for AMG.
@@ -112,6 +145,7 @@ private:
   RankVector rank_vector_; // vector to identify unique decomposition
   GhostVector ghosts_; // vector to identify ghost dofs
   int verbose_;
+  const bool element_dofs_only_; // whether all DoFs are attached to elements, see the ctor
 
   //! The actual communication interface used when algorithm requires InteriorBorder_All_Interface.
   InterfaceType _interiorBorder_all_interface;
@@ -172,10 +206,16 @@ void GenericParallelHelper<GV, r, rD, R>::setup_parallel_indexset(DofCommunicato
     }
   }
 
-  // Publish global indices for the shared DOFS to other processors.
+  // Publish global indices for the shared DOFS to other processors. If all DoFs are attached to elements, the received
+  // DoFs are not owned by us, so taking the minimum (as the MinDataHandle does) amounts to overwriting them.
   if (need_communication) {
-    GDT::MinDataHandle<GV, r, rD, R, GlobalIndexVector> data_handle(space_, scalarIndices);
-    view.communicate(data_handle, _interiorBorder_all_interface, Dune::ForwardCommunication);
+    if (element_dofs_only_) {
+      DofHaloExchange<GV, GlobalIndex> exchange(space_.dof_halo_plan());
+      exchange.communicate(scalarIndices);
+    } else {
+      GDT::MinDataHandle<GV, r, rD, R, GlobalIndexVector> data_handle(space_, scalarIndices);
+      view.communicate(data_handle, _interiorBorder_all_interface, Dune::ForwardCommunication);
+    }
   }
 
   // Setup the index set
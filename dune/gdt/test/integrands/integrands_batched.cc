@@ -0,0 +1,238 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <algorithm>
+#include <cmath>
+
+#include <dune/gdt/local/integrands/conversion.hh>
+#include <dune/gdt/local/integrands/div.hh>
+#include <dune/gdt/local/integrands/generic.hh>
+#include <dune/gdt/local/integrands/laplace.hh>
+#include <dune/gdt/local/integrands/product.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+
+#include <dune/gdt/test/integrands/integrands.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks that integrate() coincides with the sum of evaluate() over all quadrature points, both for the integrands
+ * which evaluate all quadrature points at once and for the default implementation of the interfaces. The bases of a
+ * discontinuous Lagrange space are also used, since they provide tabulated values and jacobians.
+ */
+template <class G>
+struct BatchedIntegrandTest : public IntegrandTest<G>
+{
+  using BaseType = IntegrandTest<G>;
+  using BaseType::d;
+  using typename BaseType::D;
+  using typename BaseType::DomainType;
+  using typename BaseType::E;
+  using typename BaseType::VectorJacobianType;
+  using GenericUnaryIntegrandType = GenericLocalUnaryElementIntegrand<E>;
+  using GenericBinaryIntegrandType = GenericLocalBinaryElementIntegrand<E>;
+
+  void SetUp() override
+  {
+    BaseType::SetUp();
+    scalar_function_ = std::make_shared<XT::Functions::GenericGridFunction<E, 1>>(
+        2, [](const E&) {}, [](const DomainType& x, const XT::Common::Parameter&) { return 1. + x[0] * x[1]; });
+    matrix_function_ = std::make_shared<XT::Functions::GenericGridFunction<E, d, d>>(
+        1, [](const E&) {}, [](const DomainType& x, const XT::Common::Parameter&) {
+          return VectorJacobianType{{1. + x[0], x[1]}, {0.5, 2.}};
+        });
+  }
+
+  /// The pointwise products of the values of both bases, weighted by 1 + x, integrated by the default implementation.
+  static GenericBinaryIntegrandType make_generic_binary_integrand()
+  {
+    return GenericBinaryIntegrandType(
+        [](const auto& test_basis, const auto& ansatz_basis, const auto& param) {
+          return test_basis.order(param) + ansatz_basis.order(param) + 1;
+        },
+        [](const auto& test_basis, const auto& ansatz_basis, const auto& x, auto& result, const auto& param) {
+          const auto test_values = test_basis.evaluate_set(x, param);
+          const auto ansatz_values = ansatz_basis.evaluate_set(x, param);
+          if (result.rows() < test_values.size() || result.cols() < ansatz_values.size())
+            result.resize(test_values.size(), ansatz_values.size());
+          for (size_t ii = 0; ii < test_values.size(); ++ii)
+            for (size_t jj = 0; jj < ansatz_values.size(); ++jj)
+              result[ii][jj] = (1. + x[0]) * test_values[ii][0] * ansatz_values[jj][0];
+        });
+  } // ... make_generic_binary_integrand(...)
+
+  /// The values of the basis, weighted by 1 + x, integrated by the default implementation.
+  static GenericUnaryIntegrandType make_generic_unary_integrand()
+  {
+    return GenericUnaryIntegrandType([](const auto& basis, const auto& param) { return basis.order(param) + 1; },
+                                     [](const auto& basis, const auto& x, auto& result, const auto& param) {
+                                       const auto values = basis.evaluate_set(x, param);
+                                       if (result.size() < values.size())
+                                         result.resize(values.size());
+                                       for (size_t ii = 0; ii < values.size(); ++ii)
+                                         result[ii] = (1. + x[0]) * values[ii][0];
+                                     });
+  } // ... make_generic_unary_integrand(...)
+
+  template <class IntegrandType, class TestBasisType, class AnsatzBasisType>
+  static void check_integrate(IntegrandType& integrand,
+                              const TestBasisType& test_basis,
+                              const AnsatzBasisType& ansatz_basis,
+                              const E& element)
+  {
+    integrand.bind(element);
+    const auto& geometry = element.geometry();
+    const size_t rows = test_basis.size();
+    const size_t cols = ansatz_basis.size();
+    // over-integrating changes the number of quadrature points
+    for (int over_integrate : {0, 2}) {
+      const auto& quadrature =
+          QuadratureRules<D, d>::rule(geometry.type(), integrand.order(test_basis, ansatz_basis) + over_integrate);
+      // integrate() adds to the result, thus start from a nonzero one
+      DynamicMatrix<D> expected(rows, cols, 1.);
+      DynamicMatrix<D> point_values(rows, cols, 0.);
+      for (const auto& quadrature_point : quadrature) {
+        const auto& x = quadrature_point.position();
+        const auto factor = geometry.integrationElement(x) * quadrature_point.weight();
+        integrand.evaluate(test_basis, ansatz_basis, x, point_values);
+        for (size_t ii = 0; ii < rows; ++ii)
+          for (size_t jj = 0; jj < cols; ++jj)
+            expected[ii][jj] += point_values[ii][jj] * factor;
+      }
+      DynamicMatrix<D> result(rows, cols, 1.);
+      integrand.integrate(test_basis, ansatz_basis, quadrature, result);
+      for (size_t ii = 0; ii < rows; ++ii)
+        for (size_t jj = 0; jj < cols; ++jj)
+          EXPECT_NEAR(expected[ii][jj], result[ii][jj], 1e-13 * std::max(1., std::abs(expected[ii][jj])))
+              << "over_integrate = " << over_integrate << ", ii = " << ii << ", jj = " << jj;
+    }
+  } // ... check_integrate(...)
+
+  template <class IntegrandType, class BasisType>
+  static void check_integrate(IntegrandType& integrand, const BasisType& basis, const E& element)
+  {
+    integrand.bind(element);
+    const auto& geometry = element.geometry();
+    const size_t size = basis.size();
+    for (int over_integrate : {0, 2}) {
+      const auto& quadrature = QuadratureRules<D, d>::rule(geometry.type(), integrand.order(basis) + over_integrate);
+      DynamicVector<D> expected(size, 1.);
+      DynamicVector<D> point_values(size, 0.);
+      for (const auto& quadrature_point : quadrature) {
+        const auto& x = quadrature_point.position();
+        const auto factor = geometry.integrationElement(x) * quadrature_point.weight();
+        integrand.evaluate(basis, x, point_values);
+        for (size_t ii = 0; ii < size; ++ii)
+          expected[ii] += point_values[ii] * factor;
+      }
+      DynamicVector<D> result(size, 1.);
+      integrand.integrate(basis, quadrature, result);
+      for (size_t ii = 0; ii < size; ++ii)
+        EXPECT_NEAR(expected[ii], result[ii], 1e-13 * std::max(1., std::abs(expected[ii])))
+            << "over_integrate = " << over_integrate << ", ii = " << ii;
+    }
+  } // ... check_integrate(...)
+
+  template <class ScalarTestBasisType,
+            class ScalarAnsatzBasisType,
+            class VectorTestBasisType,
+            class VectorAnsatzBasisType>
+  void check_all_integrands(const ScalarTestBasisType& scalar_test,
+                            const ScalarAnsatzBasisType& scalar_ansatz,
+                            const VectorTestBasisType& vector_test,
+                            const VectorAnsatzBasisType& vector_ansatz,
+                            const E& element)
+  {
+    LocalElementProductIntegrand<E, 1> scalar_product(*scalar_function_);
+    check_integrate(scalar_product, scalar_test, scalar_ansatz, element);
+    LocalElementProductIntegrand<E, d> vector_product(*matrix_function_);
+    check_integrate(vector_product, vector_test, vector_ansatz, element);
+    LocalLaplaceIntegrand<E, 1> scalar_laplace(*matrix_function_);
+    check_integrate(scalar_laplace, scalar_test, scalar_ansatz, element);
+    LocalLaplaceIntegrand<E, d> vector_laplace(*matrix_function_);
+    check_integrate(vector_laplace, vector_test, vector_ansatz, element);
+    LocalElementAnsatzValueTestDivProductIntegrand<E> test_div(*scalar_function_);
+    check_integrate(test_div, vector_test, scalar_ansatz, element);
+    LocalElementAnsatzDivTestValueProductIntegrand<E> ansatz_div(*scalar_function_);
+    check_integrate(ansatz_div, scalar_test, vector_ansatz, element);
+    auto generic_binary = make_generic_binary_integrand();
+    check_integrate(generic_binary, scalar_test, scalar_ansatz, element);
+    auto product_functional = local_binary_to_unary_element_integrand(scalar_product, *scalar_function_);
+    check_integrate(product_functional, scalar_ansatz, element);
+    auto generic_unary = make_generic_unary_integrand();
+    check_integrate(generic_unary, scalar_ansatz, element);
+  } // ... check_all_integrands(...)
+
+  void is_constructable() override final
+  {
+    auto generic_binary = make_generic_binary_integrand();
+    auto generic_unary = make_generic_unary_integrand();
+    DUNE_UNUSED_PARAMETER(generic_binary);
+    DUNE_UNUSED_PARAMETER(generic_unary);
+  }
+
+  void integrate_coincides_with_evaluate_for_generic_bases()
+  {
+    const auto grid_view = grid_provider_->leaf_view();
+    for (auto&& element : elements(grid_view))
+      check_all_integrands(*scalar_test_, *scalar_ansatz_, *vector_test_, *vector_ansatz_, element);
+  }
+
+  void integrate_coincides_with_evaluate_for_tabulated_bases()
+  {
+    const auto grid_view = grid_provider_->leaf_view();
+    for (int order : {1, 2}) {
+      const auto scalar_space = make_discontinuous_lagrange_space(grid_view, order);
+      const auto vector_space = make_discontinuous_lagrange_space<d>(grid_view, order);
+      auto scalar_basis = scalar_space.basis().localize();
+      auto vector_basis = vector_space.basis().localize();
+      for (auto&& element : elements(grid_view)) {
+        scalar_basis->bind(element);
+        vector_basis->bind(element);
+        check_all_integrands(*scalar_basis, *scalar_basis, *vector_basis, *vector_basis, element);
+      }
+    }
+  } // ... integrate_coincides_with_evaluate_for_tabulated_bases(...)
+
+  using BaseType::grid_provider_;
+  using BaseType::scalar_ansatz_;
+  using BaseType::scalar_test_;
+  using BaseType::vector_ansatz_;
+  using BaseType::vector_test_;
+  std::shared_ptr<XT::Functions::GenericGridFunction<E, 1>> scalar_function_;
+  std::shared_ptr<XT::Functions::GenericGridFunction<E, d, d>> matrix_function_;
+}; // struct BatchedIntegrandTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+
+template <class G>
+using BatchedIntegrandTest = Dune::GDT::Test::BatchedIntegrandTest<G>;
+TYPED_TEST_CASE(BatchedIntegrandTest, Grids2D);
+
+TYPED_TEST(BatchedIntegrandTest, is_constructable)
+{
+  this->is_constructable();
+}
+
+TYPED_TEST(BatchedIntegrandTest, integrate_coincides_with_evaluate_for_generic_bases)
+{
+  this->integrate_coincides_with_evaluate_for_generic_bases();
+}
+
+TYPED_TEST(BatchedIntegrandTest, integrate_coincides_with_evaluate_for_tabulated_bases)
+{
+  this->integrate_coincides_with_evaluate_for_tabulated_bases();
+}
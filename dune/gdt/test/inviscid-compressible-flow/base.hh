@@ -155,13 +155,7 @@ protected:
     auto& self = *this;
     const auto& euler_tools = this->access().euler_tools;
     const NumericalVijayasundaramFlux<I, d, m> numerical_flux(
-        self.flux(),
-        /*flux_eigen_decomposition=*/[&](const auto& /*local_f*/, const auto& w, const auto& n, const auto&
-                                         /*param*/) {
-          return std::make_tuple(euler_tools.eigenvalues_flux_jacobian(w, n),
-                                 euler_tools.eigenvectors_flux_jacobian(w, n),
-                                 euler_tools.eigenvectors_inv_flux_jacobian(w, n));
-        });
+        self.flux(), /*flux_eigen_decomposition=*/euler_tools.flux_eigen_decomposition());
     if (boundary_treatment.empty()) { // The periodic case
       if (self.space_type_ == "fv")
         return std::make_unique<AdvectionFvOperator<M, GV, m>>(space.grid_view(), numerical_flux, space, space);
@@ -0,0 +1,73 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_LEAF_VIEW_TEST_HH
+#define DUNE_GDT_TEST_LEAF_VIEW_TEST_HH
+
+#include <memory>
+
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/xt/la/container/istl.hh>
+
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/type_traits.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * \brief Base fixture for tests on the leaf view of a cube grid, to be instantiated over the usual grid lists.
+ *
+ * Creates a grid of the unit cube with num_elements_per_dim() elements in each direction in SetUp(), override
+ * make_grid() for other grids.
+ */
+template <class G>
+struct LeafViewTest : public ::testing::Test
+{
+  static_assert(XT::Grid::is_grid<G>::value, "");
+
+  using GV = typename G::LeafGridView;
+  using D = typename GV::ctype;
+  static const constexpr size_t d = GV::dimension;
+  using E = XT::Grid::extract_entity_t<GV>;
+  using I = XT::Grid::extract_intersection_t<GV>;
+  using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+  using V = XT::LA::IstlDenseVector<double>;
+
+  std::shared_ptr<XT::Grid::GridProvider<G>> grid_provider;
+
+  virtual unsigned int num_elements_per_dim() const
+  {
+    return 8u;
+  }
+
+  virtual std::shared_ptr<XT::Grid::GridProvider<G>> make_grid()
+  {
+    return std::make_shared<XT::Grid::GridProvider<G>>(XT::Grid::make_cube_grid<G>(0., 1., num_elements_per_dim()));
+  }
+
+  void SetUp() override
+  {
+    grid_provider = make_grid();
+  }
+
+  GV grid_view() const
+  {
+    return grid_provider->leaf_view();
+  }
+}; // struct LeafViewTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_LEAF_VIEW_TEST_HH
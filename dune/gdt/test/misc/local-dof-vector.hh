@@ -0,0 +1,144 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_MISC_LOCAL_DOF_VECTOR_HH
+#define DUNE_GDT_TEST_MISC_LOCAL_DOF_VECTOR_HH
+
+#include <algorithm>
+#include <cmath>
+
+#include <dune/xt/common/parallel/threadmanager.hh>
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/xt/la/container/common.hh>
+#include <dune/xt/la/container/istl.hh>
+
+#include <dune/xt/grid/walker.hh>
+
+#include <dune/gdt/discretefunction/default.hh>
+#include <dune/gdt/spaces/h1/continuous-lagrange.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/test/leaf-view-test.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks that the local DoF vectors access the right global DoFs, both directly in the storage of the global vector
+ * (discontinuous spaces) and indirectly via the global indices (continuous spaces), and that concurrent writes to the
+ * DoFs of neighbouring elements are not lost.
+ */
+template <class G>
+struct LocalDofVectorTest : public LeafViewTest<G>
+{
+  unsigned int num_elements_per_dim() const override
+  {
+    return 4u;
+  }
+
+  template <class V, class SpaceType>
+  static void check_access(const SpaceType& space)
+  {
+    auto discrete_function = make_discrete_function<V>(space);
+    auto& vector = discrete_function.dofs().vector();
+    for (size_t ii = 0; ii < vector.size(); ++ii)
+      vector[ii] = std::sin(1. + ii);
+    const V expected = vector;
+    auto local_function = discrete_function.local_discrete_function();
+    for (auto&& element : elements(space.grid_view())) {
+      local_function->bind(element);
+      const auto global_indices = space.mapper().global_indices(element);
+      auto& local_dofs = local_function->dofs();
+      ASSERT_EQ(global_indices.size(), local_dofs.size());
+      for (size_t ii = 0; ii < local_dofs.size(); ++ii) {
+        EXPECT_EQ(expected[global_indices[ii]], local_dofs[ii]);
+        EXPECT_EQ(expected[global_indices[ii]], local_dofs.get_entry(ii));
+      }
+      // writing to the local DoFs has to modify the global vector
+      for (size_t ii = 0; ii < local_dofs.size(); ++ii) {
+        local_dofs.set_entry(ii, 0.);
+        local_dofs.add_to_entry(ii, 1.);
+        local_dofs[ii] += 1.;
+        EXPECT_EQ(2., vector[global_indices[ii]]);
+      }
+    }
+    const auto const_discrete_function = make_discrete_function(space, expected);
+    auto const_local_function = const_discrete_function.local_discrete_function();
+    for (auto&& element : elements(space.grid_view())) {
+      const_local_function->bind(element);
+      const auto global_indices = space.mapper().global_indices(element);
+      const auto& local_dofs = const_local_function->dofs();
+      for (size_t ii = 0; ii < local_dofs.size(); ++ii)
+        EXPECT_EQ(expected[global_indices[ii]], local_dofs[ii]);
+    }
+  } // ... check_access(...)
+
+  /// Each element adds 1 to all DoFs of each of its neighbours, so each DoF ends up with the number of neighbours.
+  template <class V, class SpaceType>
+  static void check_concurrent_writes_to_neighbors(const SpaceType& space)
+  {
+    const auto& grid_view = space.grid_view();
+    auto discrete_function = make_discrete_function<V>(space);
+    auto& dofs = discrete_function.dofs();
+    const size_t max_threads = XT::Common::threadManager().max_threads();
+    XT::Common::threadManager().set_max_threads(std::max(max_threads, size_t(4)));
+    auto walker = XT::Grid::make_walker(grid_view);
+    walker.append([]() {},
+                  [&](const auto& element) {
+                    auto neighbor_dofs = dofs.localize();
+                    for (auto&& intersection : intersections(grid_view, element)) {
+                      if (!intersection.neighbor())
+                        continue;
+                      neighbor_dofs.bind(intersection.outside());
+                      for (size_t ii = 0; ii < neighbor_dofs.size(); ++ii)
+                        neighbor_dofs.add_to_entry(ii, 1.);
+                    }
+                  },
+                  []() {});
+    walker.walk(/*use_tbb=*/true);
+    XT::Common::threadManager().set_max_threads(max_threads);
+    const auto& vector = dofs.vector();
+    for (auto&& element : elements(grid_view)) {
+      double num_neighbors = 0.;
+      for (auto&& intersection : intersections(grid_view, element))
+        if (intersection.neighbor())
+          num_neighbors += 1.;
+      for (const auto& index : space.mapper().global_indices(element))
+        EXPECT_EQ(num_neighbors, vector[index]);
+    }
+  } // ... check_concurrent_writes_to_neighbors(...)
+
+  void access_coincides_with_global_indices()
+  {
+    const auto grid_view = this->grid_view();
+    const auto dg_space = make_discontinuous_lagrange_space(grid_view, 2);
+    EXPECT_TRUE(dg_space.mapper().element_indices_are_contiguous());
+    check_access<XT::LA::IstlDenseVector<double>>(dg_space);
+    check_access<XT::LA::CommonDenseVector<double>>(dg_space);
+    check_access<XT::LA::CommonSparseVector<double>>(dg_space);
+    const auto cg_space = make_continuous_lagrange_space(grid_view, 2);
+    EXPECT_FALSE(cg_space.mapper().element_indices_are_contiguous());
+    check_access<XT::LA::IstlDenseVector<double>>(cg_space);
+  } // ... access_coincides_with_global_indices(...)
+
+  void writes_to_neighbor_dofs_from_several_threads()
+  {
+    const auto dg_space = make_discontinuous_lagrange_space(this->grid_view(), 1);
+    check_concurrent_writes_to_neighbors<XT::LA::IstlDenseVector<double>>(dg_space);
+    check_concurrent_writes_to_neighbors<XT::LA::CommonDenseVector<double>>(dg_space);
+  }
+}; // struct LocalDofVectorTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_MISC_LOCAL_DOF_VECTOR_HH
+
@@ -0,0 +1,159 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_MISC_LOCAL_MASS_MATRIX_HH
+#define DUNE_GDT_TEST_MISC_LOCAL_MASS_MATRIX_HH
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+#include <dune/grid/common/gridfactory.hh>
+
+#include <dune/xt/common/fvector.hh>
+#include <dune/xt/common/parallel/threadmanager.hh>
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/xt/la/container/common.hh>
+#include <dune/xt/la/container/conversion.hh>
+#include <dune/xt/la/matrix-inverter.hh>
+
+#include <dune/xt/grid/walker.hh>
+
+#include <dune/gdt/local/bilinear-forms/integrals.hh>
+#include <dune/gdt/local/integrands/product.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/spaces/l2/finite-volume.hh>
+#include <dune/gdt/test/leaf-view-test.hh>
+#include <dune/gdt/tools/local-mass-matrix.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks that the local mass matrices (and their inverses) of LocalMassMatrixProvider, as obtained by a multi-threaded
+ * grid walk, coincide with a direct assembly and inversion on each element, and that the identity is only used for the
+ * (orthonormal) finite volume basis on affine cubes.
+ */
+template <class G>
+struct LocalMassMatrixProviderTest : public LeafViewTest<G>
+{
+  using BaseType = LeafViewTest<G>;
+  using typename BaseType::E;
+  using typename BaseType::GV;
+  using MatrixType = XT::LA::CommonDenseMatrix<double>;
+
+  template <class LocalMatrixType>
+  static void check_close(const MatrixType& expected, const LocalMatrixType& actual)
+  {
+    ASSERT_EQ(expected.rows(), actual.rows());
+    ASSERT_EQ(expected.cols(), actual.cols());
+    double max_entry = 0.;
+    for (size_t ii = 0; ii < expected.rows(); ++ii)
+      for (size_t jj = 0; jj < expected.cols(); ++jj)
+        max_entry = std::max(max_entry, std::abs(expected.get_entry(ii, jj)));
+    for (size_t ii = 0; ii < expected.rows(); ++ii)
+      for (size_t jj = 0; jj < expected.cols(); ++jj)
+        EXPECT_NEAR(expected.get_entry(ii, jj), actual.get_entry(ii, jj), 1e-10 * max_entry)
+            << "ii = " << ii << ", jj = " << jj;
+  } // ... check_close(...)
+
+  template <size_t r>
+  static void check(const GV& grid_view, const SpaceInterface<GV, r, 1, double>& space, const bool identity_on_cubes)
+  {
+    LocalMassMatrixProvider<GV, r, 1, double> provider(grid_view, space);
+    const size_t max_threads = XT::Common::threadManager().max_threads();
+    XT::Common::threadManager().set_max_threads(std::max(max_threads, size_t(4)));
+    auto walker = XT::Grid::make_walker(grid_view);
+    walker.append(provider);
+    walker.walk(/*use_tbb=*/true);
+    XT::Common::threadManager().set_max_threads(max_threads);
+    const LocalElementIntegralBilinearForm<E, r, 1, double, double> local_l2_bilinear_form(
+        LocalElementProductIntegrand<E, r, double, double>(1.));
+    auto local_basis = space.basis().localize();
+    for (auto&& element : elements(grid_view)) {
+      local_basis->bind(element);
+      const auto expected =
+          XT::LA::convert_to<MatrixType>(local_l2_bilinear_form.apply2(*local_basis, *local_basis));
+      const auto expected_inverse = XT::LA::invert_matrix(expected);
+      const auto local_mass_matrix = provider.local_mass_matrix(element);
+      const auto local_mass_matrix_inverse = provider.local_mass_matrix_inverse(element);
+      check_close(expected, local_mass_matrix);
+      check_close(expected_inverse, local_mass_matrix_inverse);
+      const bool identity_expected =
+          identity_on_cubes && element.geometry().type().isCube() && element.geometry().affine();
+      EXPECT_EQ(identity_expected, local_mass_matrix.is_scaled_identity());
+      EXPECT_EQ(identity_expected, local_mass_matrix_inverse.is_scaled_identity());
+    }
+  } // ... check(...)
+
+  static void check_all_spaces(const GV& grid_view)
+  {
+    check<1>(grid_view, make_finite_volume_space(grid_view), /*identity_on_cubes=*/true);
+    check<2>(grid_view, make_finite_volume_space<2>(grid_view), /*identity_on_cubes=*/true);
+    for (int order : {1, 2})
+      check<1>(grid_view, make_discontinuous_lagrange_space(grid_view, order), /*identity_on_cubes=*/false);
+    check<2>(grid_view, make_discontinuous_lagrange_space<2>(grid_view, 1), /*identity_on_cubes=*/false);
+  }
+
+  std::shared_ptr<XT::Grid::GridProvider<G>> make_grid() override
+  {
+    return std::make_shared<XT::Grid::GridProvider<G>>(XT::Grid::make_cube_grid<G>(-1., 1.5, 4u));
+  }
+
+  void coincides_with_direct_assembly()
+  {
+    check_all_spaces(this->grid_view());
+  }
+}; // struct LocalMassMatrixProviderTest
+
+
+/// Two non-affine quadrilaterals and an affine triangle, refined once.
+template <class G>
+struct LocalMassMatrixProviderOnNonAffineGridTest : public LocalMassMatrixProviderTest<G>
+{
+  static_assert(G::dimension == 2, "");
+
+  std::shared_ptr<XT::Grid::GridProvider<G>> make_grid() override final
+  {
+    GridFactory<G> factory;
+    for (auto&& vertex : {XT::Common::FieldVector<double, 2>({0., 0.}),
+                          XT::Common::FieldVector<double, 2>({1., 0.}),
+                          XT::Common::FieldVector<double, 2>({2., 0.}),
+                          XT::Common::FieldVector<double, 2>({0., 1.}),
+                          XT::Common::FieldVector<double, 2>({1.25, 1.5}),
+                          XT::Common::FieldVector<double, 2>({2., 1.}),
+                          XT::Common::FieldVector<double, 2>({0.5, 2.})}) {
+      factory.insertVertex(vertex);
+    }
+    factory.insertElement(GeometryTypes::cube(2), {0, 1, 3, 4});
+    factory.insertElement(GeometryTypes::cube(2), {1, 2, 4, 5});
+    factory.insertElement(GeometryTypes::simplex(2), {3, 4, 6});
+    auto grid_provider = std::make_shared<XT::Grid::GridProvider<G>>(factory.createGrid());
+    grid_provider->global_refine(1);
+    return grid_provider;
+  } // ... make_grid(...)
+
+  void coincides_with_direct_assembly()
+  {
+    const auto grid_view = this->grid_view();
+    size_t num_non_affine_elements = 0;
+    for (auto&& element : elements(grid_view))
+      num_non_affine_elements += element.geometry().affine() ? 0 : 1;
+    ASSERT_GT(num_non_affine_elements, 0);
+    this->check_all_spaces(grid_view);
+  }
+}; // struct LocalMassMatrixProviderOnNonAffineGridTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_MISC_LOCAL_MASS_MATRIX_HH
@@ -0,0 +1,37 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <dune/xt/grid/grids.hh>
+
+#include "local-dof-vector.hh"
+
+
+using Cubic2dGrids = ::testing::Types<YASP_2D_EQUIDISTANT_OFFSET
+#if HAVE_DUNE_ALUGRID
+                                      ,
+                                      ALU_2D_CUBE
+#endif
+#if HAVE_DUNE_UGGRID || HAVE_UG
+                                      ,
+                                      UG_2D
+#endif
+                                      >;
+
+
+template <class G>
+using LocalDofVectorTest = Dune::GDT::Test::LocalDofVectorTest<G>;
+TYPED_TEST_CASE(LocalDofVectorTest, Cubic2dGrids);
+TYPED_TEST(LocalDofVectorTest, access_coincides_with_global_indices)
+{
+  this->access_coincides_with_global_indices();
+}
+TYPED_TEST(LocalDofVectorTest, writes_to_neighbor_dofs_from_several_threads)
+{
+  this->writes_to_neighbor_dofs_from_several_threads();
+}
@@ -0,0 +1,170 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/gdt/local/finite-elements/lagrange.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+
+/**
+ * Checks that ThreadSafeDefaultLocalFiniteElementFamily serves the same finite element for the same geometry type and
+ * order, from the table of atomic pointers as well as from the locked map (for orders beyond the table), also when
+ * requested concurrently, and that these coincide with freshly created finite elements.
+ */
+template <size_t d>
+struct LocalFiniteElementFamilyTest : public ::testing::Test
+{
+  using FamilyType = ThreadSafeDefaultLocalFiniteElementFamily<double, d, double>;
+  using LocalFiniteElementType = typename FamilyType::LocalFiniteElementType;
+  using KeyType = std::tuple<GeometryType, int>;
+
+  static const constexpr int max_order = FamilyType::max_indexed_order + 2;
+
+  /// Creates Lagrange finite elements of order 1 or 2 for all orders, counting the calls.
+  FamilyType make_family()
+  {
+    return FamilyType([&](const GeometryType& geometry_type, const int& order) {
+      ++num_created;
+      return make_local_lagrange_finite_element<double, d, double>(geometry_type, requested_order(order));
+    });
+  }
+
+  static int requested_order(const int order)
+  {
+    return (order % 2 == 0) ? 2 : 1;
+  }
+
+  static std::vector<KeyType> keys()
+  {
+    std::vector<KeyType> ret;
+    for (int order = 0; order <= max_order; ++order)
+      for (const auto& geometry_type : {GeometryTypes::simplex(d), GeometryTypes::cube(d)})
+        ret.emplace_back(geometry_type, order);
+    return ret;
+  }
+
+  static void check_equal(const LocalFiniteElementType& expected, const LocalFiniteElementType& actual)
+  {
+    ASSERT_EQ(expected.geometry_type(), actual.geometry_type());
+    ASSERT_EQ(expected.order(), actual.order());
+    ASSERT_EQ(expected.size(), actual.size());
+    std::vector<typename LocalFiniteElementType::BasisType::RangeType> expected_values, actual_values;
+    std::vector<typename LocalFiniteElementType::BasisType::DerivativeRangeType> expected_jacobians, actual_jacobians;
+    for (const auto& quadrature_point : QuadratureRules<double, d>::rule(expected.geometry_type(), 3)) {
+      expected.basis().evaluate(quadrature_point.position(), expected_values);
+      actual.basis().evaluate(quadrature_point.position(), actual_values);
+      expected.basis().jacobian(quadrature_point.position(), expected_jacobians);
+      actual.basis().jacobian(quadrature_point.position(), actual_jacobians);
+      for (size_t ii = 0; ii < expected.size(); ++ii) {
+        EXPECT_EQ(expected_values[ii], actual_values[ii]);
+        EXPECT_EQ(expected_jacobians[ii], actual_jacobians[ii]);
+      }
+    }
+  } // ... check_equal(...)
+
+  void get_coincides_with_fresh_finite_elements()
+  {
+    const auto family = make_family();
+    for (const auto& key : keys()) {
+      const auto& geometry_type = std::get<0>(key);
+      const auto order = std::get<1>(key);
+      const auto& finite_element = family.get(geometry_type, order);
+      EXPECT_EQ(&finite_element, &family.get(geometry_type, order));
+      check_equal(*make_local_lagrange_finite_element<double, d, double>(geometry_type, requested_order(order)),
+                  finite_element);
+    }
+    EXPECT_EQ(keys().size(), size_t(num_created));
+  } // ... get_coincides_with_fresh_finite_elements(...)
+
+  void get_is_consistent_across_threads()
+  {
+    const auto family = make_family();
+    const auto all_keys = keys();
+    std::vector<std::vector<const LocalFiniteElementType*>> finite_elements(
+        8, std::vector<const LocalFiniteElementType*>(all_keys.size(), nullptr));
+    std::vector<std::thread> threads;
+    for (size_t tt = 0; tt < finite_elements.size(); ++tt)
+      threads.emplace_back([&, tt]() {
+        // each thread requests the keys in a different order, repeatedly
+        for (size_t rr = 0; rr < 10; ++rr)
+          for (size_t kk = 0; kk < all_keys.size(); ++kk) {
+            const size_t index = (kk * (2 * tt + 1) + rr) % all_keys.size();
+            finite_elements[tt][index] = &family.get(std::get<0>(all_keys[index]), std::get<1>(all_keys[index]));
+          }
+      });
+    for (auto& thread : threads)
+      thread.join();
+    // every finite element was created exactly once
+    EXPECT_EQ(all_keys.size(), size_t(num_created));
+    for (size_t kk = 0; kk < all_keys.size(); ++kk) {
+      const auto* expected = &family.get(std::get<0>(all_keys[kk]), std::get<1>(all_keys[kk]));
+      for (size_t tt = 0; tt < finite_elements.size(); ++tt)
+        EXPECT_EQ(expected, finite_elements[tt][kk]) << "kk = " << kk << ", tt = " << tt;
+    }
+  } // ... get_is_consistent_across_threads(...)
+
+  void copies_recreate_and_moves_keep_finite_elements()
+  {
+    auto family = make_family();
+    const auto all_keys = keys();
+    std::vector<const LocalFiniteElementType*> finite_elements;
+    for (const auto& key : all_keys)
+      finite_elements.push_back(&family.get(std::get<0>(key), std::get<1>(key)));
+    const FamilyType copied(family);
+    const FamilyType moved(std::move(family));
+    for (size_t kk = 0; kk < all_keys.size(); ++kk) {
+      const auto& copied_finite_element = copied.get(std::get<0>(all_keys[kk]), std::get<1>(all_keys[kk]));
+      EXPECT_NE(finite_elements[kk], &copied_finite_element);
+      check_equal(*finite_elements[kk], copied_finite_element);
+      EXPECT_EQ(finite_elements[kk], &moved.get(std::get<0>(all_keys[kk]), std::get<1>(all_keys[kk])));
+    }
+    EXPECT_EQ(2 * all_keys.size(), size_t(num_created));
+  } // ... copies_recreate_and_moves_keep_finite_elements(...)
+
+  std::atomic<size_t> num_created{0};
+}; // struct LocalFiniteElementFamilyTest
+
+
+using LocalFiniteElementFamilyTest2d = LocalFiniteElementFamilyTest<2>;
+using LocalFiniteElementFamilyTest3d = LocalFiniteElementFamilyTest<3>;
+
+TEST_F(LocalFiniteElementFamilyTest2d, get_coincides_with_fresh_finite_elements)
+{
+  this->get_coincides_with_fresh_finite_elements();
+}
+TEST_F(LocalFiniteElementFamilyTest2d, get_is_consistent_across_threads)
+{
+  this->get_is_consistent_across_threads();
+}
+TEST_F(LocalFiniteElementFamilyTest2d, copies_recreate_and_moves_keep_finite_elements)
+{
+  this->copies_recreate_and_moves_keep_finite_elements();
+}
+TEST_F(LocalFiniteElementFamilyTest3d, get_coincides_with_fresh_finite_elements)
+{
+  this->get_coincides_with_fresh_finite_elements();
+}
+TEST_F(LocalFiniteElementFamilyTest3d, get_is_consistent_across_threads)
+{
+  this->get_is_consistent_across_threads();
+}
+TEST_F(LocalFiniteElementFamilyTest3d, copies_recreate_and_moves_keep_finite_elements)
+{
+  this->copies_recreate_and_moves_keep_finite_elements();
+}
@@ -0,0 +1,29 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <dune/xt/grid/grids.hh>
+
+#include "local-mass-matrix.hh"
+
+#if HAVE_DUNE_UGGRID || HAVE_UG
+
+
+using NonAffine2dGrids = ::testing::Types<UG_2D>;
+
+
+template <class G>
+using LocalMassMatrixProviderOnNonAffineGridTest = Dune::GDT::Test::LocalMassMatrixProviderOnNonAffineGridTest<G>;
+TYPED_TEST_CASE(LocalMassMatrixProviderOnNonAffineGridTest, NonAffine2dGrids);
+TYPED_TEST(LocalMassMatrixProviderOnNonAffineGridTest, coincides_with_direct_assembly)
+{
+  this->coincides_with_direct_assembly();
+}
+
+
+#endif // HAVE_DUNE_UGGRID || HAVE_UG
@@ -0,0 +1,231 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_MISC_MATRIX_SCATTER_HH
+#define DUNE_GDT_TEST_MISC_MATRIX_SCATTER_HH
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include <dune/common/dynmatrix.hh>
+
+#include <dune/xt/common/parallel/threadmanager.hh>
+#include <dune/xt/common/string.hh>
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/xt/la/container/common.hh>
+#include <dune/xt/la/container/istl.hh>
+
+#include <dune/xt/grid/filters/intersection.hh>
+
+#include <dune/gdt/local/bilinear-forms/generic.hh>
+#include <dune/gdt/operators/matrix-based.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/tools/matrix-scatter.hh>
+#include <dune/gdt/tools/sparsity-pattern.hh>
+#include <dune/gdt/test/leaf-view-test.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks that assembling local element and intersection matrices by a MatrixOperator, which scatters them in row
+ * segments (immediately with one thread, bucketed after the grid walk with several threads), coincides with adding
+ * each entry by add_to_entry() in a sequential grid walk, for a matrix with contiguous values and a generic one. Also
+ * checks that reassembling with recorded offsets (see LocalMatrixOffsetMap) gives the same result, and that the offsets
+ * are discarded for a different sparsity pattern with the same number of entries.
+ */
+template <class G>
+struct MatrixScatterTest : public LeafViewTest<G>
+{
+  using BaseType = LeafViewTest<G>;
+  using typename BaseType::E;
+  using typename BaseType::GV;
+  using typename BaseType::I;
+
+  using ElementBilinearFormType = GenericLocalElementBilinearForm<E>;
+  using IntersectionBilinearFormType = GenericLocalIntersectionBilinearForm<I>;
+
+  /// Entries which depend on the position, so that misplaced contributions are detected.
+  static ElementBilinearFormType make_element_bilinear_form()
+  {
+    return ElementBilinearFormType([](const auto& test_basis,
+                                      const auto& ansatz_basis,
+                                      DynamicMatrix<double>& result,
+                                      const XT::Common::Parameter& param) {
+      const auto center = test_basis.element().geometry().center();
+      for (size_t ii = 0; ii < test_basis.size(param); ++ii)
+        for (size_t jj = 0; jj < ansatz_basis.size(param); ++jj)
+          result[ii][jj] = 1. + ii + 0.5 * jj + std::sin(10. * center[0]) + center[GV::dimension - 1];
+    });
+  } // ... make_element_bilinear_form(...)
+
+  static IntersectionBilinearFormType make_intersection_bilinear_form()
+  {
+    return IntersectionBilinearFormType([](const auto& intersection,
+                                           const auto& test_basis_inside,
+                                           const auto& ansatz_basis_inside,
+                                           const auto& test_basis_outside,
+                                           const auto& ansatz_basis_outside,
+                                           DynamicMatrix<double>& result_in_in,
+                                           DynamicMatrix<double>& result_in_out,
+                                           DynamicMatrix<double>& result_out_in,
+                                           DynamicMatrix<double>& result_out_out,
+                                           const XT::Common::Parameter& param) {
+      const auto center = intersection.geometry().center();
+      const double value = std::cos(7. * center[0]) + 2. * center[GV::dimension - 1];
+      const auto fill = [&](const auto& test_basis, const auto& ansatz_basis, auto& result, const double offset) {
+        if (result.rows() < test_basis.size(param) || result.cols() < ansatz_basis.size(param))
+          result.resize(test_basis.size(param), ansatz_basis.size(param));
+        for (size_t ii = 0; ii < test_basis.size(param); ++ii)
+          for (size_t jj = 0; jj < ansatz_basis.size(param); ++jj)
+            result[ii][jj] = value + offset + 0.25 * ii - 0.125 * jj;
+      };
+      fill(test_basis_inside, ansatz_basis_inside, result_in_in, 1.);
+      fill(test_basis_inside, ansatz_basis_outside, result_in_out, -1.);
+      fill(test_basis_outside, ansatz_basis_inside, result_out_in, -2.);
+      fill(test_basis_outside, ansatz_basis_outside, result_out_out, 2.);
+    });
+  } // ... make_intersection_bilinear_form(...)
+
+  template <class M, class SpaceType>
+  static M assemble_entrywise(const SpaceType& space, const XT::LA::SparsityPatternDefault& pattern)
+  {
+    M matrix(space.mapper().size(), space.mapper().size(), pattern);
+    const auto element_bilinear_form = make_element_bilinear_form();
+    const auto intersection_bilinear_form = make_intersection_bilinear_form();
+    auto basis_inside = space.basis().localize();
+    auto basis_outside = space.basis().localize();
+    DynamicMatrix<double> local_matrix, in_in, in_out, out_in, out_out;
+    const auto add = [&](const auto& rows, const auto& cols, const auto& local) {
+      for (size_t ii = 0; ii < rows.size(); ++ii)
+        for (size_t jj = 0; jj < cols.size(); ++jj)
+          matrix.add_to_entry(rows[ii], cols[jj], local[ii][jj]);
+    };
+    for (auto&& element : elements(space.grid_view())) {
+      basis_inside->bind(element);
+      const auto indices_inside = space.mapper().global_indices(element);
+      element_bilinear_form.apply2(*basis_inside, *basis_inside, local_matrix);
+      add(indices_inside, indices_inside, local_matrix);
+      for (auto&& intersection : intersections(space.grid_view(), element)) {
+        if (!intersection.neighbor())
+          continue;
+        const auto outside_element = intersection.outside();
+        basis_outside->bind(outside_element);
+        const auto indices_outside = space.mapper().global_indices(outside_element);
+        intersection_bilinear_form.apply2(
+            intersection, *basis_inside, *basis_inside, *basis_outside, *basis_outside, in_in, in_out, out_in, out_out);
+        add(indices_inside, indices_inside, in_in);
+        add(indices_inside, indices_outside, in_out);
+        add(indices_outside, indices_inside, out_in);
+        add(indices_outside, indices_outside, out_out);
+      }
+    }
+    return matrix;
+  } // ... assemble_entrywise(...)
+
+  template <class M>
+  static void check_equal(const M& expected, const M& actual, const std::string& msg)
+  {
+    double max_entry = 0.;
+    for (size_t ii = 0; ii < expected.rows(); ++ii)
+      for (size_t jj = 0; jj < expected.cols(); ++jj)
+        max_entry = std::max(max_entry, std::abs(expected.get_entry(ii, jj)));
+    for (size_t ii = 0; ii < expected.rows(); ++ii)
+      for (size_t jj = 0; jj < expected.cols(); ++jj)
+        EXPECT_NEAR(expected.get_entry(ii, jj), actual.get_entry(ii, jj), 1e-13 * max_entry)
+            << msg << ", ii = " << ii << ", jj = " << jj;
+  } // ... check_equal(...)
+
+  template <class OperatorType>
+  static void append_and_assemble(OperatorType& op)
+  {
+    op.append(make_element_bilinear_form());
+    op.append(make_intersection_bilinear_form(), {}, XT::Grid::ApplyOn::InnerIntersections<GV>());
+    op.assemble(/*use_tbb=*/true);
+  }
+
+  template <class M, class SpaceType>
+  static void check_scattering(const SpaceType& space)
+  {
+    const auto pattern = make_element_and_intersection_sparsity_pattern(space);
+    const auto expected = assemble_entrywise<M>(space, pattern);
+    const size_t max_threads = XT::Common::threadManager().max_threads();
+    for (size_t num_threads : {size_t(1), std::max(max_threads, size_t(4))}) {
+      XT::Common::threadManager().set_max_threads(num_threads);
+      auto op = make_matrix_operator<M>(space, pattern);
+      append_and_assemble(op);
+      XT::Common::threadManager().set_max_threads(max_threads);
+      check_equal(expected, op.matrix(), "num_threads = " + XT::Common::to_string(num_threads));
+    }
+  } // ... check_scattering(...)
+
+  template <class SpaceType>
+  static void check_offsets(const SpaceType& space)
+  {
+    using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+    const size_t last = space.mapper().size() - 1;
+    // two patterns with the same number of entries, the additional entry in the first row shifts all later offsets
+    auto pattern = make_element_and_intersection_sparsity_pattern(space);
+    pattern.insert(last, 0);
+    pattern.sort();
+    auto other_pattern = make_element_and_intersection_sparsity_pattern(space);
+    other_pattern.insert(0, last);
+    other_pattern.sort();
+    auto expected = assemble_entrywise<M>(space, pattern);
+    auto other_expected = assemble_entrywise<M>(space, other_pattern);
+    EXPECT_EQ(expected.nonzeroes(), other_expected.nonzeroes());
+    EXPECT_NE(internal::MatrixRowAccumulator<M>(expected).pattern_hash(),
+              internal::MatrixRowAccumulator<M>(other_expected).pattern_hash());
+    const size_t max_threads = XT::Common::threadManager().max_threads();
+    for (size_t num_threads : {size_t(1), std::max(max_threads, size_t(4))}) {
+      XT::Common::threadManager().set_max_threads(num_threads);
+      const std::string msg = "num_threads = " + XT::Common::to_string(num_threads);
+      auto op = make_matrix_operator<M>(space, pattern);
+      op.enable_offset_recording();
+      // records the offsets
+      append_and_assemble(op);
+      check_equal(expected, op.matrix(), msg + ", recording");
+      // uses the offsets
+      op.matrix() *= 0.;
+      op.clear();
+      append_and_assemble(op);
+      check_equal(expected, op.matrix(), msg + ", reusing");
+      // has to discard the offsets
+      auto other_op = make_matrix_operator<M>(space, other_pattern);
+      other_op.local_matrix_offsets() = op.local_matrix_offsets();
+      append_and_assemble(other_op);
+      check_equal(other_expected, other_op.matrix(), msg + ", other pattern");
+      XT::Common::threadManager().set_max_threads(max_threads);
+    }
+  } // ... check_offsets(...)
+
+  void scattering_coincides_with_add_to_entry()
+  {
+    for (int order : {0, 1}) {
+      const auto space = make_discontinuous_lagrange_space(this->grid_view(), order);
+      check_scattering<XT::LA::IstlRowMajorSparseMatrix<double>>(space);
+      check_scattering<XT::LA::CommonDenseMatrix<double>>(space);
+    }
+  } // ... scattering_coincides_with_add_to_entry(...)
+
+  void reassembly_with_offsets_coincides_with_assembly()
+  {
+    for (int order : {0, 1})
+      check_offsets(make_discontinuous_lagrange_space(this->grid_view(), order));
+  }
+}; // struct MatrixScatterTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_MISC_MATRIX_SCATTER_HH
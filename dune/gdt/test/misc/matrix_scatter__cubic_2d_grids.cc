@@ -0,0 +1,37 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <dune/xt/grid/grids.hh>
+
+#include "matrix-scatter.hh"
+
+
+using Cubic2dGrids = ::testing::Types<YASP_2D_EQUIDISTANT_OFFSET
+#if HAVE_DUNE_ALUGRID
+                                      ,
+                                      ALU_2D_CUBE
+#endif
+#if HAVE_DUNE_UGGRID || HAVE_UG
+                                      ,
+                                      UG_2D
+#endif
+                                      >;
+
+
+template <class G>
+using MatrixScatterTest = Dune::GDT::Test::MatrixScatterTest<G>;
+TYPED_TEST_CASE(MatrixScatterTest, Cubic2dGrids);
+TYPED_TEST(MatrixScatterTest, scattering_coincides_with_add_to_entry)
+{
+  this->scattering_coincides_with_add_to_entry();
+}
+TYPED_TEST(MatrixScatterTest, reassembly_with_offsets_coincides_with_assembly)
+{
+  this->reassembly_with_offsets_coincides_with_assembly();
+}
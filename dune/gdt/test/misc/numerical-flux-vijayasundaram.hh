@@ -0,0 +1,170 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_MISC_NUMERICAL_FLUX_VIJAYASUNDARAM_HH
+#define DUNE_GDT_TEST_MISC_NUMERICAL_FLUX_VIJAYASUNDARAM_HH
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/xt/common/fvector.hh>
+#include <dune/xt/common/parameter.hh>
+
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/local/numerical-fluxes/vijayasundaram.hh>
+#include <dune/gdt/test/leaf-view-test.hh>
+#include <dune/gdt/tools/euler.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks that NumericalVijayasundaramFlux gives the same results with the closed-form eigendecomposition of the Euler
+ * equations as with the numerical eigen solver, also when the matrices of the previous call are reused (same w and n),
+ * and that they are not reused for parametric fluxes.
+ */
+template <class G>
+struct NumericalVijayasundaramFluxTest : public LeafViewTest<G>
+{
+  using BaseType = LeafViewTest<G>;
+  using BaseType::d;
+  using typename BaseType::I;
+  static const constexpr size_t m = EulerTools<d>::m;
+  using NumericalFluxType = NumericalVijayasundaramFlux<I, d, m>;
+  using StateType = typename NumericalFluxType::StateType;
+  using PhysicalDomainType = typename NumericalFluxType::PhysicalDomainType;
+  using LocalIntersectionCoords = typename NumericalFluxType::LocalIntersectionCoords;
+
+  NumericalVijayasundaramFluxTest()
+    : euler_tools(1.4)
+  {}
+
+  unsigned int num_elements_per_dim() const override
+  {
+    return 2u;
+  }
+
+  static void check_close(const StateType& expected, const StateType& actual)
+  {
+    double max_entry = 1.;
+    for (size_t ii = 0; ii < m; ++ii)
+      max_entry = std::max(max_entry, std::abs(expected[ii]));
+    for (size_t ii = 0; ii < m; ++ii)
+      EXPECT_NEAR(expected[ii], actual[ii], 1e-10 * max_entry) << "ii = " << ii;
+  }
+
+  StateType state(const double density, const XT::Common::FieldVector<double, d>& velocity, const double pressure) const
+  {
+    return euler_tools.conservative(FieldVector<double, 1>(density), velocity, FieldVector<double, 1>(pressure));
+  }
+
+  const I& some_inner_intersection()
+  {
+    const auto grid_view = this->grid_view();
+    for (auto&& element : elements(grid_view))
+      for (auto&& intersection : intersections(grid_view, element))
+        if (intersection.neighbor()) {
+          intersection_ = std::make_unique<I>(intersection);
+          return *intersection_;
+        }
+    DUNE_THROW(InvalidStateException, "The grid has no inner intersection!");
+    return *intersection_;
+  }
+
+  void coincides_with_numerical_eigen_solver()
+  {
+    const XT::Functions::GenericFunction<m, d, m> flux(
+        euler_tools.flux_order(),
+        [&](const auto& u, const auto& /*param*/) { return euler_tools.flux(u); },
+        "euler_flux",
+        {},
+        [&](const auto& u, const auto& /*param*/) { return euler_tools.flux_jacobian(u); });
+    const auto& intersection = some_inner_intersection();
+    const LocalIntersectionCoords x(0.5);
+    const auto u_1 = state(1., XT::Common::FieldVector<double, d>(0.3), 1.);
+    const auto v_1 = state(1.2, XT::Common::FieldVector<double, d>(-0.2), 0.8);
+    const auto u_2 = state(0.8, XT::Common::FieldVector<double, d>(0.5), 0.6);
+    PhysicalDomainType n_1(0.);
+    n_1[0] = 1.;
+    PhysicalDomainType n_2(1. / std::sqrt(double(d)));
+    // consecutive calls with the same w and n (including swapped u and v) reuse the matrices of the previous call
+    const std::vector<std::tuple<StateType, StateType, PhysicalDomainType>> arguments{{u_1, v_1, n_1},
+                                                                                      {u_1, v_1, n_1},
+                                                                                      {v_1, u_1, n_1},
+                                                                                      {u_1, v_1, n_2},
+                                                                                      {u_2, v_1, n_2},
+                                                                                      {u_2, v_1, n_2},
+                                                                                      {u_1, v_1, n_1}};
+    NumericalFluxType numerical_flux(flux);
+    NumericalFluxType analytical_flux(flux, euler_tools.flux_eigen_decomposition());
+    numerical_flux.bind(intersection);
+    analytical_flux.bind(intersection);
+    for (const auto& args : arguments) {
+      const auto& u = std::get<0>(args);
+      const auto& v = std::get<1>(args);
+      const auto& n = std::get<2>(args);
+      // a fresh flux does not reuse anything
+      NumericalFluxType fresh_numerical_flux(flux);
+      fresh_numerical_flux.bind(intersection);
+      const auto expected = fresh_numerical_flux.apply(x, u, v, n);
+      check_close(expected, numerical_flux.apply(x, u, v, n));
+      check_close(expected, analytical_flux.apply(x, u, v, n));
+    }
+  } // ... coincides_with_numerical_eigen_solver(...)
+
+  void does_not_reuse_for_parametric_fluxes()
+  {
+    const XT::Functions::GenericFunction<m, d, m> flux(
+        euler_tools.flux_order(),
+        [&](const auto& u, const auto& param) {
+          auto ret = euler_tools.flux(u);
+          ret *= param.get("s").at(0);
+          return ret;
+        },
+        "scaled_euler_flux",
+        XT::Common::ParameterType("s", 1),
+        [&](const auto& u, const auto& param) {
+          auto ret = euler_tools.flux_jacobian(u);
+          for (size_t ss = 0; ss < d; ++ss)
+            ret[ss] *= param.get("s").at(0);
+          return ret;
+        });
+    const auto& intersection = some_inner_intersection();
+    const LocalIntersectionCoords x(0.5);
+    const auto u = state(1., XT::Common::FieldVector<double, d>(0.3), 1.);
+    const auto v = state(1.2, XT::Common::FieldVector<double, d>(-0.2), 0.8);
+    PhysicalDomainType n(0.);
+    n[0] = 1.;
+    NumericalFluxType numerical_flux(flux);
+    numerical_flux.bind(intersection);
+    const auto g_1 = numerical_flux.apply(x, u, v, n, XT::Common::Parameter("s", 1.));
+    const auto g_2 = numerical_flux.apply(x, u, v, n, XT::Common::Parameter("s", 2.));
+    // P_plus and P_minus scale with s > 0
+    check_close(2. * g_1, g_2);
+    NumericalFluxType fresh_numerical_flux(flux);
+    fresh_numerical_flux.bind(intersection);
+    check_close(fresh_numerical_flux.apply(x, u, v, n, XT::Common::Parameter("s", 2.)), g_2);
+  } // ... does_not_reuse_for_parametric_fluxes(...)
+
+  const EulerTools<d> euler_tools;
+  std::unique_ptr<I> intersection_;
+}; // struct NumericalVijayasundaramFluxTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_MISC_NUMERICAL_FLUX_VIJAYASUNDARAM_HH
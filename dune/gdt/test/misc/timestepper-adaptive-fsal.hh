@@ -0,0 +1,83 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_MISC_TIMESTEPPER_ADAPTIVE_FSAL_HH
+#define DUNE_GDT_TEST_MISC_TIMESTEPPER_ADAPTIVE_FSAL_HH
+
+#include <cmath>
+
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/gdt/discretefunction/default.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/test/leaf-view-test.hh>
+#include <dune/gdt/tools/timestepper/adaptive-rungekutta.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+// L(u) = u, counting the number of applications
+struct CountingIdentityOperator
+{
+  template <class VectorType>
+  void apply(const VectorType& source, VectorType& range, const double /*t*/) const
+  {
+    ++num_applications;
+    range = source;
+  }
+
+  mutable size_t num_applications = 0;
+};
+
+
+/**
+ * Checks that AdaptiveRungeKuttaTimeStepper solves u_t = -u and reuses the last stage for first-same-as-last methods.
+ */
+template <class G>
+struct AdaptiveRungeKuttaFsalTest : public LeafViewTest<G>
+{
+  template <TimeStepperMethods method>
+  void check_applications_per_step(const size_t expected_applications_per_step)
+  {
+    const auto space = make_discontinuous_lagrange_space(this->grid_view(), 0);
+    auto u = make_discrete_function(space);
+    for (size_t ii = 0; ii < u.dofs().vector().size(); ++ii)
+      u.dofs().vector()[ii] = 1. + 0.1 * ii;
+    const auto u_0 = u.dofs().vector();
+    const CountingIdentityOperator op;
+    AdaptiveRungeKuttaTimeStepper<CountingIdentityOperator, decltype(u), method> stepper(op, u, -1., 0., 1e-3);
+    double dt = stepper.step(1e-3, 1.);
+    for (size_t nn = 0; nn < 5; ++nn) {
+      const size_t applications_before = op.num_applications;
+      const double t_before = stepper.current_time();
+      // a smaller time step is always accepted for this problem
+      const double suggested_dt = stepper.step(0.5 * dt, 1.);
+      EXPECT_DOUBLE_EQ(t_before + 0.5 * dt, stepper.current_time());
+      EXPECT_EQ(expected_applications_per_step, op.num_applications - applications_before);
+      dt = suggested_dt;
+    }
+    const double t = stepper.current_time();
+    for (size_t ii = 0; ii < u_0.size(); ++ii)
+      EXPECT_NEAR(u_0[ii] * std::exp(-t), stepper.current_solution().dofs().vector()[ii], 1e-2 * u_0[ii]);
+  } // ... check_applications_per_step(...)
+
+  void reuses_last_stage()
+  {
+    check_applications_per_step<TimeStepperMethods::dormand_prince>(6);
+    check_applications_per_step<TimeStepperMethods::bogacki_shampine>(3);
+    check_applications_per_step<TimeStepperMethods::heun_euler>(2);
+  }
+}; // struct AdaptiveRungeKuttaFsalTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_MISC_TIMESTEPPER_ADAPTIVE_FSAL_HH
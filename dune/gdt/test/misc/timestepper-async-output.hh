@@ -0,0 +1,171 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_MISC_TIMESTEPPER_ASYNC_OUTPUT_HH
+#define DUNE_GDT_TEST_MISC_TIMESTEPPER_ASYNC_OUTPUT_HH
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/xt/common/parameter.hh>
+#include <dune/xt/common/string.hh>
+
+#include <dune/gdt/discretefunction/default.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/test/leaf-view-test.hh>
+#include <dune/gdt/tools/timestepper/explicit-rungekutta.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+// L(u, t)_i = cos(u_i) - t, applied entrywise
+struct CosineEntrywiseOperator
+{
+  template <class VectorType>
+  void apply(const VectorType& source, VectorType& range, const XT::Common::Parameter& param) const
+  {
+    for (size_t ii = 0; ii < source.size(); ++ii)
+      range[ii] = std::cos(source[ii]) - param.get("t")[0];
+  }
+};
+
+
+/**
+ * Checks that the output of TimeStepperInterface::solve written from the output thread coincides with the output
+ * written during the time stepping, for several queue depths, and checks the back-pressure and the destruction of the
+ * underlying BackgroundTaskQueue.
+ */
+template <class G>
+struct TimeStepperAsyncOutputTest : public LeafViewTest<G>
+{
+  static std::string read_file(const std::string& filename)
+  {
+    std::ifstream file(filename);
+    EXPECT_TRUE(file.good()) << filename;
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+  }
+
+  // writes the text output of num_save_steps + 1 time steps, returns the contents of the files
+  std::vector<std::string> solve(const std::string& prefix, const bool async_output, const size_t queue_depth)
+  {
+    const size_t num_save_steps = 8;
+    const auto space = make_discontinuous_lagrange_space(this->grid_view(), 1);
+    auto u = make_discrete_function(space);
+    for (size_t ii = 0; ii < u.dofs().vector().size(); ++ii)
+      u.dofs().vector()[ii] = std::sin(1. + ii);
+    using DiscreteFunctionType = decltype(u);
+    const CosineEntrywiseOperator op;
+    ExplicitRungeKuttaTimeStepper<CosineEntrywiseOperator, DiscreteFunctionType, TimeStepperMethods::explicit_euler>
+        stepper(op, u, -1.);
+    stepper.set_output_queue_depth(queue_depth);
+    stepper.solve(/*t_end=*/1.,
+                  /*initial_dt=*/0.125,
+                  num_save_steps,
+                  /*num_output_steps=*/0,
+                  /*save_solution=*/false,
+                  /*visualize=*/false,
+                  /*write_discrete=*/true,
+                  /*write_exact=*/false,
+                  prefix,
+                  stepper.default_visualizer(),
+                  stepper.vector_stringifier(),
+                  stepper.dummy_solution(),
+                  async_output);
+    std::vector<std::string> ret;
+    for (size_t step = 0; step <= num_save_steps; ++step) {
+      const std::string filename = prefix + "_" + XT::Common::to_string(step) + ".txt";
+      ret.push_back(read_file(filename));
+      std::remove(filename.c_str());
+    }
+    return ret;
+  } // ... solve(...)
+
+  void async_output_coincides_with_sync_output()
+  {
+    const auto expected = solve("timestepper_async_output_test_sync", false, 2);
+    // each save step writes a different solution, so misordered or overwritten snapshots are detected
+    for (size_t step = 1; step < expected.size(); ++step) {
+      EXPECT_FALSE(expected[step].empty()) << "step = " << step;
+      EXPECT_NE(expected[step - 1], expected[step]) << "step = " << step;
+    }
+    for (size_t queue_depth : {1, 2, 5}) {
+      const auto actual = solve("timestepper_async_output_test_async", true, queue_depth);
+      ASSERT_EQ(expected.size(), actual.size());
+      for (size_t step = 0; step < expected.size(); ++step)
+        EXPECT_EQ(expected[step], actual[step]) << "queue_depth = " << queue_depth << ", step = " << step;
+    }
+  } // ... async_output_coincides_with_sync_output(...)
+
+  void task_queue_blocks_when_full()
+  {
+    EXPECT_EQ(1u, internal::BackgroundTaskQueue(0).max_pending_tasks());
+    internal::BackgroundTaskQueue queue(2);
+    EXPECT_EQ(2u, queue.max_pending_tasks());
+    std::mutex order_mutex;
+    std::vector<size_t> order;
+    const auto record = [&](const size_t task) {
+      std::lock_guard<std::mutex> DUNE_UNUSED(guard)(order_mutex);
+      order.push_back(task);
+    };
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    // the first task blocks the thread, the second one waits, which fills the queue
+    queue.push([&, released]() {
+      released.wait();
+      record(0);
+    });
+    queue.push([&]() { record(1); });
+    std::atomic<bool> pushed(false);
+    std::thread pusher([&]() {
+      queue.push([&]() { record(2); });
+      pushed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(pushed);
+    release.set_value();
+    pusher.join();
+    EXPECT_TRUE(pushed);
+    queue.wait();
+    EXPECT_EQ(std::vector<size_t>({0, 1, 2}), order);
+  } // ... task_queue_blocks_when_full(...)
+
+  void task_queue_finishes_tasks_on_destruction()
+  {
+    std::atomic<size_t> num_done(0);
+    {
+      internal::BackgroundTaskQueue queue(8);
+      for (size_t ii = 0; ii < 4; ++ii)
+        queue.push([&]() {
+          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+          ++num_done;
+        });
+    }
+    EXPECT_EQ(4u, num_done.load());
+  } // ... task_queue_finishes_tasks_on_destruction(...)
+}; // struct TimeStepperAsyncOutputTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_MISC_TIMESTEPPER_ASYNC_OUTPUT_HH
@@ -0,0 +1,69 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_MISC_TIMESTEPPER_CHECKPOINT_HH
+#define DUNE_GDT_TEST_MISC_TIMESTEPPER_CHECKPOINT_HH
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/gdt/discretefunction/default.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/test/leaf-view-test.hh>
+#include <dune/gdt/tools/timestepper/checkpoint.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks that a discrete function written by write_checkpoint is restored exactly by read_checkpoint.
+ */
+template <class G>
+struct TimeStepperCheckpointTest : public LeafViewTest<G>
+{
+  void read_checkpoint_restores_written_function(const bool single_file, const bool background)
+  {
+    const auto grid_view = this->grid_view();
+    const auto space = make_discontinuous_lagrange_space(grid_view, 1);
+    auto expected = make_discrete_function(space);
+    for (size_t ii = 0; ii < expected.dofs().vector().size(); ++ii)
+      expected.dofs().vector()[ii] = std::sin(1. + ii);
+    const std::string prefix = "timestepper_checkpoint_test";
+    const double t = 0.125;
+    if (background) {
+      internal::BackgroundTaskQueue queue;
+      write_checkpoint(expected, t, prefix, 3, single_file, &queue);
+      queue.wait();
+    } else {
+      write_checkpoint(expected, t, prefix, 3, single_file);
+    }
+    auto actual = make_discrete_function(space);
+    EXPECT_EQ(t, read_checkpoint(actual, prefix, 3, single_file));
+    for (size_t ii = 0; ii < expected.dofs().vector().size(); ++ii)
+      EXPECT_EQ(expected.dofs().vector()[ii], actual.dofs().vector()[ii]);
+    std::remove(checkpoint_filename(prefix, 3, grid_view.comm().rank(), single_file).c_str());
+  } // ... read_checkpoint_restores_written_function(...)
+
+  void read_checkpoint_restores_written_function()
+  {
+    read_checkpoint_restores_written_function(/*single_file=*/false, /*background=*/false);
+    read_checkpoint_restores_written_function(/*single_file=*/false, /*background=*/true);
+    read_checkpoint_restores_written_function(/*single_file=*/true, /*background=*/false);
+  }
+}; // struct TimeStepperCheckpointTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_MISC_TIMESTEPPER_CHECKPOINT_HH
@@ -0,0 +1,84 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_MISC_TIMESTEPPER_LOW_STORAGE_SSP_HH
+#define DUNE_GDT_TEST_MISC_TIMESTEPPER_LOW_STORAGE_SSP_HH
+
+#include <algorithm>
+#include <cmath>
+
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/xt/common/parameter.hh>
+
+#include <dune/gdt/discretefunction/default.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/test/leaf-view-test.hh>
+#include <dune/gdt/tools/timestepper/explicit-rungekutta.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+// L(u, t)_i = sin(u_i) + t, applied entrywise
+struct NonlinearEntrywiseOperator
+{
+  template <class VectorType>
+  void apply(const VectorType& source, VectorType& range, const XT::Common::Parameter& param) const
+  {
+    for (size_t ii = 0; ii < source.size(); ++ii)
+      range[ii] = std::sin(source[ii]) + param.get("t")[0];
+  }
+};
+
+
+/**
+ * Checks that LowStorageSspRungeKuttaTimeStepper coincides with ExplicitRungeKuttaTimeStepper up to round-off.
+ */
+template <class G>
+struct LowStorageSspRungeKuttaTest : public LeafViewTest<G>
+{
+  template <TimeStepperMethods method>
+  void coincides_with_butcher_form()
+  {
+    const auto space = make_discontinuous_lagrange_space(this->grid_view(), 1);
+    auto u_butcher = make_discrete_function(space);
+    for (size_t ii = 0; ii < u_butcher.dofs().vector().size(); ++ii)
+      u_butcher.dofs().vector()[ii] = std::cos(1. + ii);
+    auto u_low_storage = u_butcher;
+    using DiscreteFunctionType = decltype(u_butcher);
+    const NonlinearEntrywiseOperator op;
+    ExplicitRungeKuttaTimeStepper<NonlinearEntrywiseOperator, DiscreteFunctionType, method> butcher_stepper(
+        op, u_butcher, -1.);
+    LowStorageSspRungeKuttaTimeStepper<NonlinearEntrywiseOperator, DiscreteFunctionType, method> low_storage_stepper(
+        op, u_low_storage, -1.);
+    for (size_t nn = 0; nn < 10; ++nn) {
+      butcher_stepper.step(0.05, 1.);
+      low_storage_stepper.step(0.05, 1.);
+    }
+    EXPECT_DOUBLE_EQ(butcher_stepper.current_time(), low_storage_stepper.current_time());
+    const auto& expected = butcher_stepper.current_solution().dofs().vector();
+    const auto& actual = low_storage_stepper.current_solution().dofs().vector();
+    for (size_t ii = 0; ii < expected.size(); ++ii)
+      EXPECT_NEAR(expected[ii], actual[ii], 1e-13 * std::max(1., std::abs(expected[ii])));
+  } // ... coincides_with_butcher_form(...)
+
+  void coincides_with_butcher_form()
+  {
+    coincides_with_butcher_form<TimeStepperMethods::explicit_euler>();
+    coincides_with_butcher_form<TimeStepperMethods::explicit_rungekutta_second_order_ssp>();
+    coincides_with_butcher_form<TimeStepperMethods::explicit_rungekutta_third_order_ssp>();
+  }
+}; // struct LowStorageSspRungeKuttaTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_MISC_TIMESTEPPER_LOW_STORAGE_SSP_HH
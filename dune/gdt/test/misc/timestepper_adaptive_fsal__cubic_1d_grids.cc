@@ -0,0 +1,24 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <dune/xt/grid/grids.hh>
+
+#include "timestepper-adaptive-fsal.hh"
+
+
+using Cubic1dGrids = ::testing::Types<ONED_1D, YASP_1D_EQUIDISTANT_OFFSET>;
+
+
+template <class G>
+using AdaptiveRungeKuttaFsalTest = Dune::GDT::Test::AdaptiveRungeKuttaFsalTest<G>;
+TYPED_TEST_CASE(AdaptiveRungeKuttaFsalTest, Cubic1dGrids);
+TYPED_TEST(AdaptiveRungeKuttaFsalTest, reuses_last_stage)
+{
+  this->reuses_last_stage();
+}
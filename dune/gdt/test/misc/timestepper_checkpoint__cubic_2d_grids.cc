@@ -0,0 +1,33 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <dune/xt/grid/grids.hh>
+
+#include "timestepper-checkpoint.hh"
+
+
+using Cubic2dGrids = ::testing::Types<YASP_2D_EQUIDISTANT_OFFSET
+#if HAVE_DUNE_ALUGRID
+                                      ,
+                                      ALU_2D_CUBE
+#endif
+#if HAVE_DUNE_UGGRID || HAVE_UG
+                                      ,
+                                      UG_2D
+#endif
+                                      >;
+
+
+template <class G>
+using TimeStepperCheckpointTest = Dune::GDT::Test::TimeStepperCheckpointTest<G>;
+TYPED_TEST_CASE(TimeStepperCheckpointTest, Cubic2dGrids);
+TYPED_TEST(TimeStepperCheckpointTest, read_checkpoint_restores_written_function)
+{
+  this->read_checkpoint_restores_written_function();
+}
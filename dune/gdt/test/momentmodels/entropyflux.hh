@@ -13,11 +13,19 @@
 #ifndef DUNE_GDT_LOCAL_FLUXES_ENTROPYBASED_HH
 #define DUNE_GDT_LOCAL_FLUXES_ENTROPYBASED_HH
 
-#include <list>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
 
+#include <boost/align/aligned_allocator.hpp>
+
+#include <dune/xt/common/exceptions.hh>
 #include <dune/xt/common/float_cmp.hh>
-#include <dune/xt/common/vector_less.hh>
 
 #include <dune/xt/functions/interfaces/flux-function.hh>
 
@@ -29,85 +37,216 @@ namespace GDT {
 
 
 // Caches a specified number of (u, alpha) pairs. If the cache is full and another pair is added, the oldest existing
-// pair is dropped.
+// pair is overwritten. The entries are stored in a flat ring buffer, which is allocated on the first insertion (there is
+// a cache for each entity, many of which are never used, e.g. if the entity caches are disabled) and never grows
+// afterwards. Each entry occupies its own cache lines to avoid false sharing between the caches of neighbouring
+// entities, which are usually accessed by different threads.
 template <class KeyVectorType, class ValueVectorType>
 class EntropyLocalCache
 {
 public:
-  using MapType = typename std::map<KeyVectorType, ValueVectorType, XT::Common::VectorLess>;
-  using IteratorType = typename MapType::iterator;
-  using ConstIteratorType = typename MapType::const_iterator;
   using RangeFieldType = typename XT::Common::VectorAbstraction<KeyVectorType>::ScalarType;
 
+  struct alignas(64) EntryType
+  {
+    KeyVectorType key;
+    ValueVectorType value;
+  };
+
   EntropyLocalCache(const size_t capacity = 0)
     : capacity_(capacity)
+    , size_(0)
+    , next_(0)
   {}
 
   void insert(const KeyVectorType& u, const ValueVectorType& alpha)
   {
-    cache_.insert(std::make_pair(u, alpha));
-    keys_.push_back(u);
-    if (cache_.size() > capacity_) {
-      cache_.erase(keys_.front());
-      keys_.pop_front();
+    if (capacity_ == 0)
+      return;
+    if (entries_.empty())
+      entries_.reserve(capacity_);
+    if (entries_.size() < capacity_) {
+      // not full yet, so next_ == entries_.size()
+      entries_.push_back(EntryType{u, alpha});
+    } else {
+      auto& entry = entries_[next_];
+      entry.key = u;
+      entry.value = alpha;
     }
+    next_ = (next_ + 1) % capacity_;
+    size_ = std::min(size_ + 1, capacity_);
   }
 
-  std::pair<RangeFieldType, ConstIteratorType> find_closest(const KeyVectorType& u) const
+  // Returns the (inf-norm) distance of u to the closest key and a pointer to the corresponding value, or
+  // (std::numeric_limits<RangeFieldType>::max(), nullptr) if the cache is empty. The entries are visited from newest to
+  // oldest (the newest are usually the closest during time stepping) and the search stops as soon as an entry with a
+  // distance of at most tolerance is found.
+  std::pair<RangeFieldType, const ValueVectorType*> find_closest(const KeyVectorType& u,
+                                                                 const RangeFieldType tolerance = 0.) const
   {
-    ConstIteratorType ret = cache_.begin();
-    if (ret == end())
-      return std::make_pair(std::numeric_limits<RangeFieldType>::max(), ret);
-    auto diff = u - ret->first;
-    // use infinity_norm as distance
-    RangeFieldType distance = infinity_norm(diff);
-    auto it = ret;
-    while (++it != end()) {
-      if (XT::Common::FloatCmp::eq(distance, 0.))
-        break;
-      diff = u - it->first;
-      RangeFieldType new_distance = infinity_norm(diff);
+    RangeFieldType distance = std::numeric_limits<RangeFieldType>::max();
+    const ValueVectorType* ret = nullptr;
+    for (size_t kk = 0; kk < size_; ++kk) {
+      const auto& entry = entries_[(next_ + capacity_ - 1 - kk) % capacity_];
+      const RangeFieldType new_distance = bounded_distance(u, entry.key, distance);
       if (new_distance < distance) {
         distance = new_distance;
-        ret = it;
+        ret = &entry.value;
+        if (distance <= tolerance || XT::Common::FloatCmp::eq(distance, 0.))
+          break;
       }
     }
     return std::make_pair(distance, ret);
   }
 
-  IteratorType begin()
+  size_t size() const
   {
-    return cache_.begin();
+    return size_;
   }
 
-  ConstIteratorType begin() const
+  size_t capacity() const
   {
-    return cache_.begin();
+    return capacity_;
   }
 
-  IteratorType end()
+private:
+  // Returns the inf-norm distance of u and key, or some value >= bound if the distance exceeds bound.
+  static RangeFieldType bounded_distance(const KeyVectorType& u, const KeyVectorType& key, const RangeFieldType bound)
   {
-    return cache_.end();
+    RangeFieldType ret = 0.;
+    for (size_t ii = 0; ii < u.size(); ++ii) {
+      ret = std::max(ret, std::abs(u[ii] - key[ii]));
+      if (ret >= bound)
+        break;
+    }
+    return ret;
   }
 
-  ConstIteratorType end() const
+  size_t capacity_;
+  size_t size_;
+  size_t next_;
+  std::vector<EntryType, boost::alignment::aligned_allocator<EntryType, 64>> entries_;
+};
+
+
+// Snapshot of the counters of the caches of an EntropyBasedFluxFunction, see
+// EntropyBasedFluxFunction::cache_statistics().
+struct EntropyCacheStatistics
+{
+  // number of searches for a starting point
+  size_t lookups = 0;
+  // number of lookups where a cached (or a given previous) alpha was used as solution without solving the optimization
+  // problem
+  size_t hits = 0;
+  // number of lookups where the optimization was started from a cached (or a given previous) alpha
+  size_t warm_starts = 0;
+  // number of optimization problems solved and the total time spent doing so
+  size_t solves = 0;
+  double solve_seconds = 0.;
+
+  double hit_rate() const
   {
-    return cache_.end();
+    return lookups > 0 ? static_cast<double>(hits) / lookups : 0.;
   }
 
-private:
-  static RangeFieldType infinity_norm(const KeyVectorType& vec)
+  // each hit avoided an optimization problem, estimate the time it would have taken by the mean solve time
+  double estimated_seconds_saved() const
+  {
+    return solves > 0 ? hits * solve_seconds / solves : 0.;
+  }
+}; // struct EntropyCacheStatistics
+
+
+namespace internal {
+
+
+// Counters shared by all local functions of an EntropyBasedFluxFunction, updated without locking.
+struct EntropyCacheCounters
+{
+  void add_lookup(const bool hit, const bool warm_start)
+  {
+    lookups.fetch_add(1, std::memory_order_relaxed);
+    if (hit)
+      hits.fetch_add(1, std::memory_order_relaxed);
+    if (warm_start)
+      warm_starts.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void add_solves(const size_t num_solves, const std::chrono::steady_clock::duration& time)
   {
-    RangeFieldType ret = std::abs(vec[0]);
-    for (size_t ii = 1; ii < vec.size(); ++ii)
-      ret = std::max(ret, std::abs(vec[ii]));
+    solves.fetch_add(num_solves, std::memory_order_relaxed);
+    solve_nanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count(),
+                                std::memory_order_relaxed);
+  }
+
+  EntropyCacheStatistics statistics() const
+  {
+    EntropyCacheStatistics ret;
+    ret.lookups = lookups.load(std::memory_order_relaxed);
+    ret.hits = hits.load(std::memory_order_relaxed);
+    ret.warm_starts = warm_starts.load(std::memory_order_relaxed);
+    ret.solves = solves.load(std::memory_order_relaxed);
+    ret.solve_seconds = 1e-9 * solve_nanoseconds.load(std::memory_order_relaxed);
     return ret;
   }
 
-  size_t capacity_;
-  MapType cache_;
-  std::list<KeyVectorType> keys_;
-};
+  void reset()
+  {
+    lookups = 0;
+    hits = 0;
+    warm_starts = 0;
+    solves = 0;
+    solve_nanoseconds = 0;
+  }
+
+  std::atomic<size_t> lookups{0};
+  std::atomic<size_t> hits{0};
+  std::atomic<size_t> warm_starts{0};
+  std::atomic<size_t> solves{0};
+  std::atomic<long long> solve_nanoseconds{0};
+}; // struct EntropyCacheCounters
+
+
+template <class ImplementationType, bool batched>
+struct EntropyBatchedSolver
+{
+  using AlphaReturnType = typename ImplementationType::AlphaReturnType;
+
+  template <class StateType, class VectorType>
+  static std::vector<std::unique_ptr<AlphaReturnType>> get_alphas(const ImplementationType& implementation,
+                                                                  const std::vector<StateType>& us,
+                                                                  const std::vector<VectorType>& alphas_start,
+                                                                  const bool regularize)
+  {
+    std::vector<std::unique_ptr<AlphaReturnType>> ret(us.size());
+    for (size_t bb = 0; bb < us.size(); ++bb)
+      ret[bb] = implementation.get_alpha(us[bb], alphas_start[bb], regularize);
+    return ret;
+  }
+}; // struct EntropyBatchedSolver<..., false>
+
+template <class ImplementationType>
+struct EntropyBatchedSolver<ImplementationType, true>
+{
+  using AlphaReturnType = typename ImplementationType::AlphaReturnType;
+  using ImplementationVectorType = typename ImplementationType::VectorType;
+
+  template <class StateType, class VectorType>
+  static std::vector<std::unique_ptr<AlphaReturnType>> get_alphas(const ImplementationType& implementation,
+                                                                  const std::vector<StateType>& us,
+                                                                  const std::vector<VectorType>& alphas_start,
+                                                                  const bool regularize)
+  {
+    const std::vector<ImplementationVectorType> implementation_us(us.begin(), us.end());
+    const std::vector<ImplementationVectorType> implementation_alphas_start(alphas_start.begin(), alphas_start.end());
+    std::vector<std::unique_ptr<AlphaReturnType>> ret;
+    implementation.get_alphas(implementation_us, implementation_alphas_start, regularize, ret);
+    return ret;
+  }
+}; // struct EntropyBatchedSolver<..., true>
+
+
+} // namespace internal
 
 
 // This flux function only does the caching, which is used for providing a good initial guess and to avoid solving the
@@ -160,6 +299,7 @@ public:
     : index_set_(grid_view.indexSet())
     , use_thread_cache_(true)
     , use_entity_cache_(true)
+    , cache_tolerance_(0.)
     , entity_caches_(index_set_.size(0), LocalCacheType(cache_size))
     , mutexes_(index_set_.size(0))
     , implementation_(std::make_shared<ImplementationType>(
@@ -186,6 +326,30 @@ public:
     use_entity_cache_ = false;
   }
 
+  // A cached alpha is used as solution for u if the (inf-norm) distance of u to the cached moment is at most
+  // tolerance. The default of 0 only reuses solutions for (numerically) identical moments, positive values trade
+  // accuracy for fewer optimization problems.
+  void set_cache_tolerance(const RangeFieldType tolerance)
+  {
+    DUNE_THROW_IF(tolerance < 0., XT::Common::Exceptions::wrong_input_given, "tolerance = " << tolerance);
+    cache_tolerance_ = tolerance;
+  }
+
+  RangeFieldType cache_tolerance() const
+  {
+    return cache_tolerance_;
+  }
+
+  EntropyCacheStatistics cache_statistics() const
+  {
+    return cache_counters_.statistics();
+  }
+
+  void reset_cache_statistics()
+  {
+    cache_counters_.reset();
+  }
+
   static const constexpr bool available = true;
 
   class Localfunction : public LocalFunctionType
@@ -201,14 +365,18 @@ public:
                   std::vector<LocalCacheType>& entity_caches,
                   const bool use_thread_cache,
                   const bool use_entity_cache,
+                  const RangeFieldType cache_tolerance,
                   std::vector<std::mutex>& mutexes,
+                  internal::EntropyCacheCounters& cache_counters,
                   const ImplementationType& implementation)
       : index_set_(index_set)
       , thread_cache_(cache_size)
       , entity_caches_(entity_caches)
       , use_thread_cache_(use_thread_cache)
       , use_entity_cache_(use_entity_cache)
+      , cache_tolerance_(cache_tolerance)
       , mutexes_(mutexes)
+      , cache_counters_(cache_counters)
       , implementation_(implementation)
     {}
 
@@ -226,45 +394,52 @@ public:
 
     std::unique_ptr<AlphaReturnType> get_alpha(const StateType& u, const bool regularize) const
     {
-      // find starting point. Candidates: alpha_iso and the entries in the two caches
-      std::lock_guard<std::mutex> DUNE_UNUSED(guard)(*mutex_);
-      const auto& basis_functions = implementation_.basis_functions();
-      static const auto u_iso = basis_functions.u_iso();
-      const auto density = basis_functions.density(u);
-      const auto alpha_iso = basis_functions.alpha_iso(density);
-      const auto u_iso_scaled = u_iso * density;
-      // calculate (inf-norm) distance to isotropic moment with same density
-      RangeFieldType distance = (u - u_iso_scaled).infinity_norm();
-      VectorType alpha_start = XT::Common::convert_to<VectorType>(alpha_iso);
-      if (!XT::Common::FloatCmp::eq(distance, 0.) && use_entity_cache_) {
-        // calculate distance to closest moment in entity_cache
-        const auto entity_cache_dist_and_it = entity_cache_->find_closest(u);
-        const auto& entity_cache_dist = entity_cache_dist_and_it.first;
-        if (entity_cache_dist < distance) {
-          distance = entity_cache_dist;
-          alpha_start = entity_cache_dist_and_it.second->second;
-        }
-        if (!XT::Common::FloatCmp::eq(distance, 0.) && use_thread_cache_) {
-          // calculate distance to closest moment in thread_cache
-          const auto thread_cache_dist_and_it = thread_cache_.find_closest(u);
-          const auto& thread_cache_dist = thread_cache_dist_and_it.first;
-          if (thread_cache_dist < distance) {
-            distance = thread_cache_dist;
-            alpha_start = thread_cache_dist_and_it.second->second;
-          }
-        }
-      }
-      // If alpha_start is already the solution, we are finished. Else start optimization.
-      if (XT::Common::FloatCmp::eq(distance, 0.)) {
-        return std::make_unique<AlphaReturnType>(std::make_pair(alpha_start, std::make_pair(u, 0.)));
-      } else {
-        auto ret = implementation_.get_alpha(u, alpha_start, regularize);
-        if (use_entity_cache_)
-          entity_cache_->insert(ret->second.first, ret->first);
-        if (use_thread_cache_)
-          thread_cache_.insert(ret->second.first, ret->first);
-        return ret;
-      }
+      return get_alpha_impl(u, nullptr, nullptr, regularize);
+    }
+
+    // Like get_alpha above, but additionally considers alpha_start (the solution for the moment u_start, e.g. from the
+    // last time step) as starting point.
+    std::unique_ptr<AlphaReturnType> get_alpha(const StateType& u,
+                                               const StateType& u_start,
+                                               const VectorType& alpha_start,
+                                               const bool regularize) const
+    {
+      return get_alpha_impl(u, &u_start, &alpha_start, regularize);
+    }
+
+    // Whether the starting point returned by find_starting_point may be used as solution, given its distance.
+    bool is_solution(const RangeFieldType distance) const
+    {
+      return distance <= cache_tolerance_ || XT::Common::FloatCmp::eq(distance, 0.);
+    }
+
+    // Returns the (inf-norm) distance of u to the moment of the best starting point for the optimization problem, and
+    // the starting point. Candidates are alpha_iso and the entries in the two caches. The caller has to lock mutex().
+    std::pair<RangeFieldType, VectorType> find_starting_point(const StateType& u) const
+    {
+      return find_starting_point_impl(u, nullptr, nullptr);
+    }
+
+    // Like find_starting_point above, but additionally considers alpha_start (the solution for the moment u_start).
+    std::pair<RangeFieldType, VectorType>
+    find_starting_point(const StateType& u, const StateType& u_start, const VectorType& alpha_start) const
+    {
+      return find_starting_point_impl(u, &u_start, &alpha_start);
+    }
+
+    // Stores the solution of an optimization problem in the caches. The caller has to lock mutex().
+    void store_in_caches(const AlphaReturnType& alpha_ret) const
+    {
+      if (use_entity_cache_)
+        entity_cache_->insert(alpha_ret.second.first, alpha_ret.first);
+      if (use_thread_cache_)
+        thread_cache_.insert(alpha_ret.second.first, alpha_ret.first);
+    }
+
+    // Guards the cache of the element this local function is bound to.
+    std::mutex& mutex() const
+    {
+      return *mutex_;
     }
 
     virtual RangeReturnType evaluate(const DomainType& /*point_in_reference_element*/,
@@ -285,12 +460,76 @@ public:
     } // ... jacobian(...)
 
   private:
+    std::unique_ptr<AlphaReturnType> get_alpha_impl(const StateType& u,
+                                                    const StateType* u_start,
+                                                    const VectorType* alpha_start,
+                                                    const bool regularize) const
+    {
+      std::lock_guard<std::mutex> DUNE_UNUSED(guard)(*mutex_);
+      const auto distance_and_alpha_start = find_starting_point_impl(u, u_start, alpha_start);
+      // If alpha_start is already the solution, we are finished. Else start optimization.
+      if (is_solution(distance_and_alpha_start.first)) {
+        return std::make_unique<AlphaReturnType>(
+            std::make_pair(distance_and_alpha_start.second, std::make_pair(u, 0.)));
+      } else {
+        const auto begin = std::chrono::steady_clock::now();
+        auto ret = implementation_.get_alpha(u, distance_and_alpha_start.second, regularize);
+        cache_counters_.add_solves(1, std::chrono::steady_clock::now() - begin);
+        store_in_caches(*ret);
+        return ret;
+      }
+    } // ... get_alpha_impl(...)
+
+    std::pair<RangeFieldType, VectorType>
+    find_starting_point_impl(const StateType& u, const StateType* u_start, const VectorType* alpha_start) const
+    {
+      const auto& basis_functions = implementation_.basis_functions();
+      static const auto u_iso = basis_functions.u_iso();
+      const auto density = basis_functions.density(u);
+      const auto alpha_iso = basis_functions.alpha_iso(density);
+      const auto u_iso_scaled = u_iso * density;
+      // calculate (inf-norm) distance to isotropic moment with same density
+      RangeFieldType distance = (u - u_iso_scaled).infinity_norm();
+      const VectorType* stored_alpha = nullptr;
+      if (u_start && !XT::Common::FloatCmp::eq(distance, 0.)) {
+        // calculate distance to the given starting point
+        const RangeFieldType start_dist = (u - *u_start).infinity_norm();
+        if (start_dist < distance) {
+          distance = start_dist;
+          stored_alpha = alpha_start;
+        }
+      }
+      if (!is_solution(distance) && use_entity_cache_) {
+        // calculate distance to closest moment in entity_cache
+        const auto entity_cache_dist_and_alpha = entity_cache_->find_closest(u, cache_tolerance_);
+        if (entity_cache_dist_and_alpha.first < distance) {
+          distance = entity_cache_dist_and_alpha.first;
+          stored_alpha = entity_cache_dist_and_alpha.second;
+        }
+        if (!is_solution(distance) && use_thread_cache_) {
+          // calculate distance to closest moment in thread_cache
+          const auto thread_cache_dist_and_alpha = thread_cache_.find_closest(u, cache_tolerance_);
+          if (thread_cache_dist_and_alpha.first < distance) {
+            distance = thread_cache_dist_and_alpha.first;
+            stored_alpha = thread_cache_dist_and_alpha.second;
+          }
+        }
+      }
+      const bool hit = stored_alpha && is_solution(distance);
+      cache_counters_.add_lookup(hit, stored_alpha && !hit);
+      if (stored_alpha)
+        return std::make_pair(distance, *stored_alpha);
+      return std::make_pair(distance, XT::Common::convert_to<VectorType>(alpha_iso));
+    } // ... find_starting_point_impl(...)
+
     const IndexSetType& index_set_;
     mutable LocalCacheType thread_cache_;
     std::vector<LocalCacheType>& entity_caches_;
     const bool use_thread_cache_;
     const bool use_entity_cache_;
+    const RangeFieldType cache_tolerance_;
     std::vector<std::mutex>& mutexes_;
+    internal::EntropyCacheCounters& cache_counters_;
     const ImplementationType& implementation_;
     LocalCacheType* entity_cache_;
     std::mutex* mutex_;
@@ -303,14 +542,26 @@ public:
 
   std::unique_ptr<LocalFunctionType> local_function() const override final
   {
-    return std::make_unique<Localfunction>(
-        index_set_, entity_caches_, use_thread_cache_, use_entity_cache_, mutexes_, *implementation_);
+    return std::make_unique<Localfunction>(index_set_,
+                                           entity_caches_,
+                                           use_thread_cache_,
+                                           use_entity_cache_,
+                                           cache_tolerance_,
+                                           mutexes_,
+                                           cache_counters_,
+                                           *implementation_);
   }
 
   virtual std::unique_ptr<Localfunction> derived_local_function() const
   {
-    return std::make_unique<Localfunction>(
-        index_set_, entity_caches_, use_thread_cache_, use_entity_cache_, mutexes_, *implementation_);
+    return std::make_unique<Localfunction>(index_set_,
+                                           entity_caches_,
+                                           use_thread_cache_,
+                                           use_entity_cache_,
+                                           cache_tolerance_,
+                                           mutexes_,
+                                           cache_counters_,
+                                           *implementation_);
   }
 
   StateType evaluate_kinetic_flux(const E& inside_entity,
@@ -329,6 +580,22 @@ public:
     return implementation_->evaluate_kinetic_flux_with_alphas(alpha_i, alpha_j, n_ij, dd);
   } // StateType evaluate_kinetic_flux(...)
 
+  // Solves the optimization problems for all us at once, starting from alphas_start. Only the unspecialized
+  // implementations solve them batched (see EntropyBasedFluxImplementationUnspecializedBase::get_alphas), for all
+  // others, get_alpha is called for each u.
+  std::vector<std::unique_ptr<AlphaReturnType>> get_alphas(const std::vector<StateType>& us,
+                                                           const std::vector<VectorType>& alphas_start,
+                                                           const bool regularize) const
+  {
+    const auto begin = std::chrono::steady_clock::now();
+    auto ret = internal::EntropyBatchedSolver<
+        ImplementationType,
+        std::is_base_of<EntropyBasedFluxImplementationUnspecializedBase<MomentBasis>, ImplementationType>::value>::
+        get_alphas(*implementation_, us, alphas_start, regularize);
+    cache_counters_.add_solves(us.size(), std::chrono::steady_clock::now() - begin);
+    return ret;
+  }
+
   // Returns alpha(u), starting from alpha_iso. To get better performance when calculating several alphas, use
   // Localfunction's get_alpha
   std::unique_ptr<AlphaReturnType> get_alpha(const StateType& u, const bool regularize) const
@@ -347,8 +614,10 @@ public:
   const IndexSetType& index_set_;
   bool use_thread_cache_;
   bool use_entity_cache_;
+  RangeFieldType cache_tolerance_;
   mutable std::vector<LocalCacheType> entity_caches_;
   mutable std::vector<std::mutex> mutexes_;
+  mutable internal::EntropyCacheCounters cache_counters_;
   std::shared_ptr<ImplementationType> implementation_;
 };
 
@@ -17,6 +17,7 @@
 #include <cmath>
 #include <list>
 #include <memory>
+#include <vector>
 
 #include <boost/align/aligned_allocator.hpp>
 
@@ -266,6 +267,176 @@ public:
     return get_alpha(u, *get_isotropic_alpha(u), true);
   }
 
+  // Solves the minimum entropy optimization problems for several u at once, starting from alphas_in, by a plain
+  // backtracking Newton method (without change of basis). In each Newton iteration, the scalar products of all
+  // multipliers with the basis are computed in one matrix-matrix product (instead of one matrix-vector product per
+  // problem) and the exponential is evaluated for all of them in one call, problems which have converged are masked
+  // out. Only the first stage of the regularization sequence is solved batched. Problems which do not converge in this
+  // stage, or for which the Cholesky decomposition or the line search fails, are solved by get_alpha, starting from
+  // the last batched iterate. Since get_alpha iterates differently (with the adaptive change of basis, the default) or
+  // restarts its iteration count, the results of both only coincide up to the stopping criteria, which are the same.
+  virtual void get_alphas(const std::vector<VectorType>& us,
+                          const std::vector<VectorType>& alphas_in,
+                          const bool regularize,
+                          std::vector<std::unique_ptr<AlphaReturnType>>& rets) const
+  {
+    const size_t num_problems = us.size();
+    rets.clear();
+    rets.resize(num_problems);
+    static const auto alpha_one = basis_functions_.alpha_one();
+    constexpr bool rescale = (entropy == EntropyType::MaxwellBoltzmann);
+    const RangeFieldType rr = regularize ? r_sequence_.front() : 0.;
+    const RangeFieldType r_max = regularize ? r_sequence_.back() : 0.;
+    const size_t max_iterations = rr < r_max ? std::min(k_0_ + 1, k_max_) : k_max_;
+    const RangeFieldType dim_factor = is_full_moment_basis<MomentBasis>::value ? 1. : std::sqrt(dimFlux);
+    std::vector<RangeFieldType> densities(num_problems), tau_primes(num_problems), f_k(num_problems),
+        zeta_k(num_problems);
+    std::vector<VectorType> v(num_problems), alpha_k(num_problems), alpha_prime(num_problems), g_k(num_problems),
+        d_k(num_problems);
+    std::vector<size_t> active;
+    std::vector<bool> batched(num_problems, false);
+    for (size_t bb = 0; bb < num_problems; ++bb) {
+      densities[bb] = basis_functions_.density(us[bb]);
+      // leave invalid densities and regularized first stages to get_alpha
+      if (!(densities[bb] > 0.) || std::isinf(densities[bb]) || rr > 0)
+        continue;
+      v[bb] = us[bb];
+      alpha_k[bb] = alphas_in[bb];
+      if (rescale) {
+        v[bb] /= densities[bb];
+        alpha_k[bb] -= alpha_one * std::log(densities[bb]);
+      }
+      tau_primes[bb] =
+          rescale ? std::min(tau_ / ((1 + dim_factor * v[bb].two_norm()) * densities[bb] + dim_factor * tau_), tau_)
+                  : tau_;
+      active.push_back(bb);
+      batched[bb] = true;
+    }
+    thread_local auto H = XT::Common::make_unique<MatrixType>(0.);
+    QuadratureWeightsType exp_vals, eta_ast_prime_vals, eta_ast_twoprime_vals;
+    std::vector<VectorType> betas, us_beta;
+    std::vector<RangeFieldType> f_betas;
+    std::vector<size_t> candidates, candidate_positions, searching, trying, accepted;
+    const auto gather_betas = [&](const std::vector<size_t>& indices, const std::vector<VectorType>& source) {
+      betas.resize(indices.size());
+      for (size_t jj = 0; jj < indices.size(); ++jj)
+        betas[jj] = source[indices[jj]];
+    };
+    // calculate f_0
+    gather_betas(active, alpha_k);
+    get_eta_ast_integrated(betas, M_, f_betas);
+    for (size_t jj = 0; jj < active.size(); ++jj)
+      f_k[active[jj]] = f_betas[jj] - alpha_k[active[jj]] * v[active[jj]];
+    VectorType tmp_vec, u_eps_diff;
+    for (size_t kk = 0; kk < max_iterations && !active.empty(); ++kk) {
+      const size_t num_active = active.size();
+      // evaluate exp(alpha_k^T b(v_i)) for all active problems at once
+      gather_betas(active, alpha_k);
+      calculate_scalar_products(betas, M_, exp_vals);
+      apply_exponential(exp_vals);
+      eta_ast_prime_vals = exp_vals;
+      evaluate_eta_ast_prime(eta_ast_prime_vals);
+      eta_ast_twoprime_vals = exp_vals;
+      evaluate_eta_ast_twoprime(eta_ast_twoprime_vals);
+      calculate_u(eta_ast_prime_vals, num_active, us_beta);
+      // calculate gradients and descent directions, problems failing here are left to get_alpha
+      candidates.clear();
+      candidate_positions.clear();
+      for (size_t jj = 0; jj < num_active; ++jj) {
+        const size_t bb = active[jj];
+        g_k[bb] = us_beta[jj] - v[bb];
+        calculate_hessian(eta_ast_twoprime_vals, num_active, jj, M_, *H);
+        d_k[bb] = g_k[bb];
+        d_k[bb] *= -1;
+        try {
+          XT::LA::cholesky(*H);
+          XT::LA::solve_lower_triangular(*H, tmp_vec, d_k[bb]);
+          XT::LA::solve_lower_triangular_transposed(*H, d_k[bb], tmp_vec);
+        } catch (const Dune::MathError&) {
+          continue;
+        }
+        const auto density_tilde = basis_functions_.density(us_beta[jj]);
+        if (!(density_tilde > 0.) || std::isinf(density_tilde))
+          continue;
+        alpha_prime[bb] = alpha_k[bb];
+        if (rescale)
+          alpha_prime[bb] -= alpha_one * std::log(density_tilde);
+        // store the second stopping criterion in zeta_k until the line search
+        zeta_k[bb] = std::exp(-(rescale ? d_k[bb].one_norm() + std::abs(std::log(density_tilde)) : d_k[bb].one_norm()));
+        candidates.push_back(bb);
+        candidate_positions.push_back(jj);
+      } // jj
+      // check stopping criteria
+      if (rescale) {
+        gather_betas(candidates, alpha_prime);
+        calculate_scalar_products(betas, M_, exp_vals);
+        apply_exponential(exp_vals);
+        evaluate_eta_ast_prime(exp_vals);
+        calculate_u(exp_vals, candidates.size(), us_beta);
+      }
+      searching.clear();
+      for (size_t cc = 0; cc < candidates.size(); ++cc) {
+        const size_t bb = candidates[cc];
+        u_eps_diff = rescale ? us_beta[cc] : g_k[bb] + v[bb];
+        u_eps_diff *= -(1 - epsilon_gamma_);
+        u_eps_diff += v[bb];
+        if (g_k[bb].two_norm() < tau_primes[bb] && 1 - epsilon_gamma_ < zeta_k[bb]
+            && (entropy == EntropyType::MaxwellBoltzmann
+                || all_positive(eta_ast_prime_vals, num_active, candidate_positions[cc]))
+            && (disable_realizability_check_
+                || realizability_helper_.is_realizable(u_eps_diff, kk == static_cast<size_t>(0.8 * k_0_)))) {
+          rets[bb] = std::make_unique<AlphaReturnType>();
+          rets[bb]->first = rescale ? alpha_prime[bb] + alpha_one * std::log(densities[bb]) : alpha_prime[bb];
+          rets[bb]->second = std::make_pair(rescale ? v[bb] * densities[bb] : v[bb], rr);
+        } else {
+          zeta_k[bb] = 1;
+          searching.push_back(bb);
+        }
+      } // cc
+      // backtracking line search for all problems which have not converged, problems failing here are left to get_alpha
+      accepted.clear();
+      while (!searching.empty()) {
+        trying.clear();
+        for (const auto& bb : searching)
+          if (zeta_k[bb] > epsilon_ * alpha_k[bb].two_norm() / d_k[bb].two_norm())
+            trying.push_back(bb);
+        if (trying.empty())
+          break;
+        betas.resize(trying.size());
+        for (size_t tt = 0; tt < trying.size(); ++tt) {
+          betas[tt] = d_k[trying[tt]];
+          betas[tt] *= zeta_k[trying[tt]];
+          betas[tt] += alpha_k[trying[tt]];
+        }
+        get_eta_ast_integrated(betas, M_, f_betas);
+        searching.clear();
+        for (size_t tt = 0; tt < trying.size(); ++tt) {
+          const size_t bb = trying[tt];
+          const RangeFieldType f_new = f_betas[tt] - betas[tt] * v[bb];
+          if (XT::Common::FloatCmp::le(f_new, f_k[bb] + xi_ * zeta_k[bb] * (g_k[bb] * d_k[bb]))) {
+            alpha_k[bb] = betas[tt];
+            f_k[bb] = f_new;
+            accepted.push_back(bb);
+          } else {
+            zeta_k[bb] *= chi_;
+            searching.push_back(bb);
+          }
+        } // tt
+      } // backtracking linesearch while
+      std::sort(accepted.begin(), accepted.end());
+      active = accepted;
+    } // k loop (Newton iterations)
+    // keep the progress of the batched iterations for the remaining problems
+    for (size_t bb = 0; bb < num_problems; ++bb) {
+      if (rets[bb])
+        continue;
+      auto alpha_start = batched[bb] ? alpha_k[bb] : alphas_in[bb];
+      if (batched[bb] && rescale)
+        alpha_start += alpha_one * std::log(densities[bb]);
+      rets[bb] = get_alpha(us[bb], alpha_start, regularize);
+    }
+  } // ... get_alphas(...)
+
   // returns density rho = < eta_ast_prime(beta_in * b(v)) >
   RangeFieldType get_rho(const DomainType& beta_in, const BasisValuesMatrixType& M) const
   {
@@ -711,6 +882,123 @@ public:
     XT::Common::Mkl::exp(static_cast<int>(values.size()), values.data(), values.data());
   }
 
+  // ============================================================================================
+  // ======================= Batched evaluations for several multipliers ========================
+  // ============================================================================================
+
+  // The values for num_betas multipliers beta_bb are stored as a structure of arrays, i.e. vals[ll * num_betas + bb]
+  // contains the value for beta_bb in the quadrature point v_ll, which allows to vectorize over the multipliers.
+
+  // calculates beta_bb^T b(v_ll) for all quadrature points v_ll and all multipliers beta_bb
+  void calculate_scalar_products(const std::vector<VectorType>& betas,
+                                 const BasisValuesMatrixType& M,
+                                 QuadratureWeightsType& scalar_products) const
+  {
+    const size_t num_betas = betas.size();
+    const size_t num_quad_points = quad_points_.size();
+    scalar_products.resize(num_quad_points * num_betas);
+#if HAVE_MKL
+    thread_local QuadratureWeightsType betas_data;
+    betas_data.resize(num_betas * basis_dimRange);
+    for (size_t bb = 0; bb < num_betas; ++bb)
+      std::copy_n(betas[bb].begin(), basis_dimRange, betas_data.begin() + bb * basis_dimRange);
+    XT::Common::Cblas::dgemm(XT::Common::Cblas::row_major(),
+                             XT::Common::Cblas::no_trans(),
+                             XT::Common::Cblas::trans(),
+                             static_cast<int>(num_quad_points),
+                             static_cast<int>(num_betas),
+                             basis_dimRange,
+                             1.,
+                             M.data(),
+                             matrix_num_cols,
+                             betas_data.data(),
+                             basis_dimRange,
+                             0.,
+                             scalar_products.data(),
+                             static_cast<int>(num_betas));
+#else
+    for (size_t ll = 0; ll < num_quad_points; ++ll) {
+      const auto* basis_ll = &(M.get_entry_ref(ll, 0.));
+      auto* scalar_products_ll = &(scalar_products[ll * num_betas]);
+      for (size_t bb = 0; bb < num_betas; ++bb)
+        scalar_products_ll[bb] = std::inner_product(betas[bb].begin(), betas[bb].end(), basis_ll, 0.);
+    }
+#endif
+  }
+
+  // returns < eta_ast(beta_bb * b(v)) > for all multipliers beta_bb
+  void get_eta_ast_integrated(const std::vector<VectorType>& betas,
+                              const BasisValuesMatrixType& M,
+                              std::vector<RangeFieldType>& ret) const
+  {
+    thread_local QuadratureWeightsType eta_ast_vals;
+    calculate_scalar_products(betas, M, eta_ast_vals);
+    apply_exponential(eta_ast_vals);
+    evaluate_eta_ast(eta_ast_vals);
+    const size_t num_betas = betas.size();
+    ret.assign(num_betas, 0.);
+    const size_t num_quad_points = quad_weights_.size();
+    for (size_t ll = 0; ll < num_quad_points; ++ll) {
+      const auto weight_ll = quad_weights_[ll];
+      const auto* vals_ll = &(eta_ast_vals[ll * num_betas]);
+      for (size_t bb = 0; bb < num_betas; ++bb)
+        ret[bb] += vals_ll[bb] * weight_ll;
+    } // ll
+  }
+
+  // calculate ret_bb = < b eta_ast_prime_vals_bb > for all num_betas multipliers
+  void calculate_u(const QuadratureWeightsType& eta_ast_prime_vals,
+                   const size_t num_betas,
+                   std::vector<VectorType>& ret) const
+  {
+    ret.resize(num_betas);
+    for (auto& ret_bb : ret)
+      std::fill(ret_bb.begin(), ret_bb.end(), 0.);
+    const size_t num_quad_points = quad_weights_.size();
+    for (size_t ll = 0; ll < num_quad_points; ++ll) {
+      const auto* basis_ll = &(M_.get_entry_ref(ll, 0.));
+      for (size_t bb = 0; bb < num_betas; ++bb) {
+        const auto factor_ll = eta_ast_prime_vals[ll * num_betas + bb] * quad_weights_[ll];
+        auto& ret_bb = ret[bb];
+        for (size_t ii = 0; ii < basis_dimRange; ++ii)
+          ret_bb[ii] += basis_ll[ii] * factor_ll;
+      } // bb
+    } // ll
+  }
+
+  // calculates the hessian for the bb-th of num_betas multipliers
+  void calculate_hessian(const QuadratureWeightsType& eta_ast_twoprime_vals,
+                         const size_t num_betas,
+                         const size_t bb,
+                         const BasisValuesMatrixType& M,
+                         MatrixType& H) const
+  {
+    std::fill(H.begin(), H.end(), 0.);
+    const size_t num_quad_points = quad_weights_.size();
+    // matrix is symmetric, we only use lower triangular part
+    for (size_t ll = 0; ll < num_quad_points; ++ll) {
+      auto factor_ll = eta_ast_twoprime_vals[ll * num_betas + bb] * quad_weights_[ll];
+      const auto* basis_ll = &(M.get_entry_ref(ll, 0.));
+      for (size_t ii = 0; ii < basis_dimRange; ++ii) {
+        auto* H_row = &(H[ii][0]);
+        const auto factor_ll_ii = basis_ll[ii] * factor_ll;
+        for (size_t kk = 0; kk <= ii; ++kk) {
+          H_row[kk] += basis_ll[kk] * factor_ll_ii;
+        } // kk
+      } // ii
+    } // ll
+  } // void calculate_hessian(...)
+
+  bool all_positive(const QuadratureWeightsType& vals, const size_t num_betas, const size_t bb) const
+  {
+    for (size_t ll = 0; ll < quad_points_.size(); ++ll) {
+      const auto val = vals[ll * num_betas + bb];
+      if (val < 0. || std::isinf(val) || std::isnan(val))
+        return false;
+    }
+    return true;
+  }
+
   const MomentBasis& basis_functions() const
   {
     return basis_functions_;
@@ -1152,6 +1440,7 @@ public:
   using typename BaseType::DomainType;
   using typename BaseType::MatrixType;
   using typename BaseType::MomentBasis;
+  using typename BaseType::QuadratureWeightsType;
   using typename BaseType::RangeFieldType;
   using typename BaseType::VectorType;
 
@@ -10,10 +10,16 @@
 #ifndef DUNE_GDT_MOMENTMODELS_ENTROPYSOLVER_HH
 #define DUNE_GDT_MOMENTMODELS_ENTROPYSOLVER_HH
 
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <dune/xt/grid/functors/interfaces.hh>
 #include <dune/xt/common/parameter.hh>
+#include <dune/xt/common/string.hh>
 
 #include <dune/gdt/discretefunction/default.hh>
 #include <dune/gdt/test/momentmodels/entropyflux.hh>
@@ -22,8 +28,73 @@
 
 namespace Dune {
 namespace GDT {
+namespace internal {
 
 
+// Appends records of 2 + dimFlux + dimRange values (t, center, s, u) to the regularization log, in the text or binary
+// format described at LocalEntropySolver. All records of one call are written in one piece.
+template <size_t dimFlux, size_t dimRange, class RangeFieldType>
+void append_regularization_log(const std::string& filename,
+                               const bool binary,
+                               const std::vector<RangeFieldType>& records)
+{
+  if (records.empty())
+    return;
+  static std::mutex outfile_lock;
+  std::lock_guard<std::mutex> DUNE_UNUSED(guard)(outfile_lock);
+  static const size_t record_size = 2 + dimFlux + dimRange;
+  if (binary) {
+    std::ofstream outfile(filename, std::ios_base::app | std::ios_base::binary);
+    outfile.seekp(0, std::ios_base::end);
+    if (outfile.tellp() == 0) {
+      const std::uint64_t dims[2] = {dimFlux, dimRange};
+      outfile.write("GDTREGLG", 8);
+      outfile.write(reinterpret_cast<const char*>(dims), sizeof(dims));
+    }
+    const std::vector<double> double_records(records.begin(), records.end());
+    outfile.write(reinterpret_cast<const char*>(double_records.data()),
+                  static_cast<std::streamsize>(double_records.size() * sizeof(double)));
+  } else {
+    std::ofstream outfile(filename, std::ios_base::app);
+    // t, the center and s are written with the default precision, u with 15 digits (as XT::Common::to_string(u, 15))
+    const auto default_precision = outfile.precision();
+    for (size_t rr = 0; rr < records.size(); rr += record_size) {
+      const auto* record = records.data() + rr;
+      outfile.precision(default_precision);
+      outfile << record[0];
+      for (size_t ii = 1; ii < 1 + dimFlux; ++ii)
+        outfile << " " << record[ii];
+      outfile << " " << record[1 + dimFlux] << " ";
+      outfile.precision(15);
+      outfile << "[" << record[2 + dimFlux];
+      for (size_t ii = 3 + dimFlux; ii < record_size; ++ii)
+        outfile << " " << record[ii];
+      outfile << "]\n";
+    }
+  }
+} // ... append_regularization_log(...)
+
+
+} // namespace internal
+
+
+/**
+ * Solves the dual entropy optimization problem in each cell. If batch_size > 1, the moment vectors of batch_size cells
+ * are collected and the optimization problems are solved together (see EntropyBasedFluxFunction::get_alphas), which
+ * replaces the matrix-vector products with the basis values by matrix-matrix products.
+ *
+ * If alphas_dofs is given, the alpha of each cell is stored there. If, additionally, use_alphas_as_start is true,
+ * alphas_dofs and range_dofs have to contain the alphas and the regularized moments of a previous solve on entry,
+ * which are then used as an additional starting point for the optimization in each cell.
+ *
+ * If filename is not empty, the time, the cell center, the regularization parameter and the moment vector are logged
+ * for each regularized cell. The records are collected in a buffer private to each thread and appended to
+ * filename_regularization.txt (or, if binary_log is true, to filename_regularization.bin) once per thread at the end of
+ * the grid walk. With several MPI ranks, each rank writes its own file filename_rank_<rank>_regularization.txt (or .bin),
+ * since appending to a common file is not synchronized between the ranks. The binary file starts with the 8 characters "GDTREGLG" and the dimensions dimFlux and dimRange as
+ * 64 bit unsigned integers, followed by records of 2 + dimFlux + dimRange doubles (t, center, s, u) in native byte
+ * order. See python/scripts/read_regularization_log.py for a reader.
+ */
 template <class SpaceType, class VectorType, class MomentBasis>
 class LocalEntropySolver : public XT::Grid::ElementFunctor<typename SpaceType::GridViewType>
 {
@@ -34,8 +105,11 @@ class LocalEntropySolver : public XT::Grid::ElementFunctor<typename SpaceType::G
   using EntropyFluxType = EntropyBasedFluxFunction<GridViewType, MomentBasis>;
   using RangeFieldType = typename EntropyFluxType::RangeFieldType;
   using LocalVectorType = typename EntropyFluxType::VectorType;
+  using StateType = typename EntropyFluxType::StateType;
+  using AlphaReturnType = typename EntropyFluxType::AlphaReturnType;
   static const size_t dimFlux = EntropyFluxType::dimFlux;
   static const size_t dimRange = EntropyFluxType::basis_dimRange;
+  using MomentVectorType = XT::Common::FieldVector<RangeFieldType, dimRange>;
   using DiscreteFunctionType = DiscreteFunction<VectorType, GridViewType, dimRange, 1, RangeFieldType>;
   using ConstDiscreteFunctionType = ConstDiscreteFunction<VectorType, GridViewType, dimRange, 1, RangeFieldType>;
 
@@ -46,7 +120,11 @@ public:
                               const EntropyFluxType& analytical_flux,
                               const RangeFieldType min_acceptable_density,
                               const XT::Common::Parameter& param,
-                              const std::string filename = "")
+                              const std::string filename = "",
+                              const size_t batch_size = 1,
+                              const bool binary_log = false,
+                              VectorType* alphas_dofs = nullptr,
+                              const bool use_alphas_as_start = false)
     : space_(space)
     , source_(space_, source_dofs, "source")
     , local_source_(source_.local_discrete_function())
@@ -56,8 +134,13 @@ public:
     , local_flux_(analytical_flux_.derived_local_function())
     , min_acceptable_density_(min_acceptable_density)
     , param_(param)
-    , filename_(filename.empty() ? "" : (filename + "_regularization.txt"))
+    , binary_log_(binary_log)
+    , filename_(log_filename(space_, filename, binary_log_))
     , index_set_(space_.grid_view().indexSet())
+    , batch_size_(batch_size)
+    , alphas_(alphas_dofs ? std::make_unique<DiscreteFunctionType>(space_, *alphas_dofs, "alphas") : nullptr)
+    , local_alphas_(alphas_ ? alphas_->local_discrete_function() : nullptr)
+    , use_alphas_as_start_(alphas_ && use_alphas_as_start)
   {}
 
   explicit LocalEntropySolver(LocalEntropySolver& other)
@@ -71,8 +154,14 @@ public:
     , local_flux_(analytical_flux_.derived_local_function())
     , min_acceptable_density_(other.min_acceptable_density_)
     , param_(other.param_)
+    , binary_log_(other.binary_log_)
     , filename_(other.filename_)
     , index_set_(space_.grid_view().indexSet())
+    , batch_size_(other.batch_size_)
+    , alphas_(other.alphas_ ? std::make_unique<DiscreteFunctionType>(space_, other.alphas_->dofs().vector(), "alphas")
+                            : nullptr)
+    , local_alphas_(alphas_ ? alphas_->local_discrete_function() : nullptr)
+    , use_alphas_as_start_(other.use_alphas_as_start_)
   {}
 
   XT::Grid::ElementFunctor<GridViewType>* copy() override final
@@ -83,32 +172,133 @@ public:
   void apply_local(const EntityType& entity) override final
   {
     local_source_->bind(entity);
-    local_range_->bind(entity);
-    XT::Common::FieldVector<RangeFieldType, dimRange> u;
+    MomentVectorType u;
     for (size_t ii = 0; ii < dimRange; ++ii)
       u[ii] = local_source_->dofs().get_entry(ii);
     const auto& basis_functions = analytical_flux_.basis_functions();
     basis_functions.ensure_min_density(u, min_acceptable_density_);
-    local_flux_->bind(entity);
-    const auto alpha_ret = local_flux_->get_alpha(u, true);
-    const auto regularization_params = alpha_ret->second;
+    if (batch_size_ > 1) {
+      entities_.push_back(entity);
+      us_.push_back(u);
+      if (entities_.size() >= batch_size_)
+        solve_batch();
+    } else {
+      local_flux_->bind(entity);
+      std::unique_ptr<AlphaReturnType> alpha_ret;
+      if (use_alphas_as_start_) {
+        const auto previous = previous_solution(entity);
+        alpha_ret = local_flux_->get_alpha(u, previous.first, previous.second, true);
+      } else {
+        alpha_ret = local_flux_->get_alpha(u, true);
+      }
+      store_result(entity, u, *alpha_ret);
+    }
+  } // void apply_local(...)
+
+  void finalize() override final
+  {
+    if (!entities_.empty())
+      solve_batch();
+    flush_regularization_log();
+  }
+
+private:
+  void solve_batch()
+  {
+    const size_t num_cells = entities_.size();
+    std::vector<std::unique_ptr<AlphaReturnType>> alpha_rets(num_cells);
+    std::vector<size_t> cells_to_solve;
+    std::vector<StateType> us_to_solve;
+    std::vector<LocalVectorType> alphas_start;
+    for (size_t bb = 0; bb < num_cells; ++bb) {
+      local_flux_->bind(entities_[bb]);
+      std::unique_lock<std::mutex> guard(local_flux_->mutex(), std::defer_lock);
+      std::pair<RangeFieldType, LocalVectorType> distance_and_alpha_start;
+      if (use_alphas_as_start_) {
+        const auto previous = previous_solution(entities_[bb]);
+        guard.lock();
+        distance_and_alpha_start = local_flux_->find_starting_point(us_[bb], previous.first, previous.second);
+      } else {
+        guard.lock();
+        distance_and_alpha_start = local_flux_->find_starting_point(us_[bb]);
+      }
+      if (local_flux_->is_solution(distance_and_alpha_start.first)) {
+        alpha_rets[bb] = std::make_unique<AlphaReturnType>(
+            std::make_pair(distance_and_alpha_start.second, std::make_pair(us_[bb], 0.)));
+      } else {
+        cells_to_solve.push_back(bb);
+        us_to_solve.push_back(us_[bb]);
+        alphas_start.push_back(distance_and_alpha_start.second);
+      }
+    } // bb
+    auto solved_alpha_rets = analytical_flux_.get_alphas(us_to_solve, alphas_start, true);
+    for (size_t jj = 0; jj < cells_to_solve.size(); ++jj) {
+      const size_t bb = cells_to_solve[jj];
+      local_flux_->bind(entities_[bb]);
+      std::lock_guard<std::mutex> DUNE_UNUSED(guard)(local_flux_->mutex());
+      local_flux_->store_in_caches(*solved_alpha_rets[jj]);
+      alpha_rets[bb] = std::move(solved_alpha_rets[jj]);
+    } // jj
+    for (size_t bb = 0; bb < num_cells; ++bb)
+      store_result(entities_[bb], us_[bb], *alpha_rets[bb]);
+    entities_.clear();
+    us_.clear();
+  } // void solve_batch(...)
+
+  // Returns the regularized moment and the alpha stored in range_ and alphas_ by a previous solve.
+  std::pair<StateType, LocalVectorType> previous_solution(const EntityType& entity) const
+  {
+    local_range_->bind(entity);
+    local_alphas_->bind(entity);
+    StateType u;
+    MomentVectorType alpha;
+    for (size_t ii = 0; ii < dimRange; ++ii) {
+      u[ii] = local_range_->dofs().get_entry(ii);
+      alpha[ii] = local_alphas_->dofs().get_entry(ii);
+    }
+    return std::make_pair(u, XT::Common::convert_to<LocalVectorType>(alpha));
+  }
+
+  void store_result(const EntityType& entity, const MomentVectorType& u, const AlphaReturnType& alpha_ret)
+  {
+    local_range_->bind(entity);
+    const auto& regularization_params = alpha_ret.second;
     for (size_t ii = 0; ii < dimRange; ++ii)
       local_range_->dofs().set_entry(ii, regularization_params.first[ii]);
+    if (alphas_) {
+      local_alphas_->bind(entity);
+      const auto alpha = XT::Common::convert_to<MomentVectorType>(alpha_ret.first);
+      for (size_t ii = 0; ii < dimRange; ++ii)
+        local_alphas_->dofs().set_entry(ii, alpha[ii]);
+    }
     const auto s = regularization_params.second;
-    if (s > 0.) {
-      if (!filename_.empty()) {
-        static std::mutex outfile_lock;
-        outfile_lock.lock();
-        std::ofstream outfile(filename_, std::ios_base::app);
-        outfile << param_.get("t")[0];
-        for (size_t ii = 0; ii < dimFlux; ++ii)
-          outfile << " " << entity.geometry().center()[ii];
-        outfile << " " << s << " ";
-        outfile << XT::Common::to_string(u, 15) << std::endl;
-        outfile_lock.unlock();
-      }
+    if (s > 0. && !filename_.empty()) {
+      regularization_log_.push_back(param_.get("t")[0]);
+      const auto center = entity.geometry().center();
+      for (size_t ii = 0; ii < dimFlux; ++ii)
+        regularization_log_.push_back(center[ii]);
+      regularization_log_.push_back(s);
+      for (size_t ii = 0; ii < dimRange; ++ii)
+        regularization_log_.push_back(u[ii]);
     }
-  } // void apply_local(...)
+  } // void store_result(...)
+
+  static std::string log_filename(const SpaceType& space, const std::string& filename, const bool binary_log)
+  {
+    if (filename.empty())
+      return "";
+    const auto& comm = space.grid_view().comm();
+    const std::string rank_suffix = comm.size() > 1 ? "_rank_" + XT::Common::to_string(comm.rank()) : "";
+    return filename + rank_suffix + (binary_log ? "_regularization.bin" : "_regularization.txt");
+  }
+
+  // Appends the records collected by this thread to the log file, so the file is opened once per thread and walk
+  // instead of once per regularized cell.
+  void flush_regularization_log()
+  {
+    internal::append_regularization_log<dimFlux, dimRange>(filename_, binary_log_, regularization_log_);
+    regularization_log_.clear();
+  }
 
 private:
   const SpaceType& space_;
@@ -120,8 +310,16 @@ private:
   std::unique_ptr<typename EntropyFluxType::Localfunction> local_flux_;
   const RangeFieldType min_acceptable_density_;
   const XT::Common::Parameter& param_;
+  const bool binary_log_;
   const std::string filename_;
   const typename SpaceType::GridViewType::IndexSet& index_set_;
+  const size_t batch_size_;
+  std::vector<EntityType> entities_;
+  std::vector<MomentVectorType> us_;
+  std::unique_ptr<DiscreteFunctionType> alphas_;
+  std::unique_ptr<typename DiscreteFunctionType::LocalDiscreteFunctionType> local_alphas_;
+  const bool use_alphas_as_start_;
+  std::vector<RangeFieldType> regularization_log_;
 }; // class LocalEntropySolver<...>
 
 
@@ -141,15 +339,21 @@ public:
   using EntropyFluxType = EntropyBasedFluxFunction<typename SpaceType::GridViewType, MomentBasis>;
   using RangeFieldType = typename MomentBasis::RangeFieldType;
   using LocalVectorType = typename EntropyFluxType::VectorType;
+  using DiscreteFunctionType =
+      DiscreteFunction<VectorType, typename SpaceType::GridViewType, MomentBasis::dimRange, 1, RangeFieldType>;
 
   EntropySolver(const EntropyFluxType& analytical_flux,
                 const SpaceType& space,
                 const RangeFieldType min_acceptable_density,
-                const std::string filename = "")
+                const std::string filename = "",
+                const size_t batch_size = 1,
+                const bool binary_log = false)
     : analytical_flux_(analytical_flux)
     , space_(space)
     , min_acceptable_density_(min_acceptable_density)
     , filename_(filename)
+    , batch_size_(batch_size)
+    , binary_log_(binary_log)
   {}
 
   bool linear() const override final
@@ -170,17 +374,53 @@ public:
   void apply(const VectorType& source, VectorType& range, const XT::Common::Parameter& param) const override final
   {
     LocalEntropySolver<SpaceType, VectorType, MomentBasis> local_entropy_solver(
-        space_, source, range, analytical_flux_, min_acceptable_density_, param, filename_);
+        space_, source, range, analytical_flux_, min_acceptable_density_, param, filename_, batch_size_, binary_log_);
     auto walker = XT::Grid::Walker<typename SpaceType::GridViewType>(space_.grid_view());
     walker.append(local_entropy_solver);
     walker.walk(true);
   } // void apply(...)
 
+  /**
+   * \brief Like apply, but additionally stores the alpha of each cell in alphas.
+   *
+   * If use_alphas_as_start is true, range and alphas have to contain the result of a previous call on entry and the
+   * alphas are used as an additional starting point for the optimization in each cell. Since the moments usually
+   * change only slightly between Runge-Kutta stages and time steps, this reduces the number of Newton iterations.
+   * Afterwards, range and alphas are communicated, such that all ranks agree on the starting points of the next call.
+   */
+  void apply_with_warm_start(const VectorType& source,
+                             VectorType& range,
+                             VectorType& alphas,
+                             const bool use_alphas_as_start,
+                             const XT::Common::Parameter& param) const
+  {
+    LocalEntropySolver<SpaceType, VectorType, MomentBasis> local_entropy_solver(space_,
+                                                                                source,
+                                                                                range,
+                                                                                analytical_flux_,
+                                                                                min_acceptable_density_,
+                                                                                param,
+                                                                                filename_,
+                                                                                batch_size_,
+                                                                                binary_log_,
+                                                                                &alphas,
+                                                                                use_alphas_as_start);
+    auto walker = XT::Grid::Walker<typename SpaceType::GridViewType>(space_.grid_view());
+    walker.append(local_entropy_solver);
+    walker.walk(true);
+    if (space_.grid_view().comm().size() > 1) {
+      space_.dof_halo_exchange().communicate(range);
+      space_.dof_halo_exchange().communicate(alphas);
+    }
+  } // void apply_with_warm_start(...)
+
 private:
   const EntropyFluxType& analytical_flux_;
   const SpaceType& space_;
   const RangeFieldType min_acceptable_density_;
   const std::string filename_;
+  const size_t batch_size_;
+  const bool binary_log_;
 }; // class EntropySolver<...>
 
 
@@ -0,0 +1,100 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+// This one has to come first (includes the config.h)!
+#include <dune/xt/test/main.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/gdt/test/momentmodels/basisfunctions.hh>
+#include <dune/gdt/test/momentmodels/entropyflux_implementations.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks that solving the entropy minimization problems of several cells batched (see
+ * EntropyBasedFluxImplementationUnspecializedBase::get_alphas) yields the same multipliers as solving them one by one,
+ * in the default configuration (i.e., with the adaptive change of basis for the unbatched solves).
+ */
+template <class MomentBasis>
+struct EntropyFluxBatchedTest : public ::testing::Test
+{
+  using ImplementationType = EntropyBasedFluxImplementation<MomentBasis>;
+  using VectorType = typename ImplementationType::VectorType;
+  using AlphaReturnType = typename ImplementationType::AlphaReturnType;
+
+  void get_alphas_coincides_with_get_alpha()
+  {
+    const MomentBasis basis_functions;
+    const ImplementationType implementation(basis_functions,
+                                            /*tau=*/1e-9,
+                                            /*disable_realizability_check=*/true,
+                                            /*epsilon_gamma=*/0.01,
+                                            /*chi=*/0.5,
+                                            /*xi=*/1e-3,
+                                            /*r_sequence=*/{0, 1e-8, 1e-6, 1e-4, 1e-3, 1e-2, 5e-2, 0.1, 0.5, 1},
+                                            /*k_0=*/500,
+                                            /*k_max=*/1000,
+                                            /*epsilon=*/std::pow(2, -52));
+    // realizable moments of ansatz densities (with alpha^T b < 0, as required for the Bose-Einstein entropy)
+    const size_t num_problems = 12;
+    std::vector<VectorType> us(num_problems), alphas_start(num_problems);
+    for (size_t bb = 0; bb < num_problems; ++bb) {
+      VectorType alpha(0.);
+      alpha[0] = -2. - 0.1 * bb;
+      for (size_t ii = 1; ii < alpha.size(); ++ii)
+        alpha[ii] = 0.3 * std::sin(1. + ii + bb) / (ii + 1.);
+      us[bb] = implementation.get_u(alpha);
+      alphas_start[bb] = *implementation.get_isotropic_alpha(us[bb]);
+    }
+    std::vector<std::unique_ptr<AlphaReturnType>> rets;
+    implementation.get_alphas(us, alphas_start, true, rets);
+    ASSERT_EQ(num_problems, rets.size());
+    for (size_t bb = 0; bb < num_problems; ++bb) {
+      const auto expected = implementation.get_alpha(us[bb], alphas_start[bb], true);
+      ASSERT_NE(nullptr, rets[bb]);
+      EXPECT_EQ(expected->second.second, rets[bb]->second.second) << "bb = " << bb;
+      // both solves satisfy the same stopping criteria, but iterate differently with the adaptive change of basis
+      auto moment_difference = implementation.get_u(rets[bb]->first);
+      moment_difference -= rets[bb]->second.first;
+      EXPECT_LT(moment_difference.two_norm(), 1e-7 * us[bb].two_norm()) << "bb = " << bb;
+      auto alpha_difference = rets[bb]->first;
+      alpha_difference -= expected->first;
+      EXPECT_LT(alpha_difference.two_norm(), 1e-4 * std::max(1., expected->first.two_norm())) << "bb = " << bb;
+    }
+    // problems with invalid densities are handed to get_alpha, which throws
+    us.back() *= -1.;
+    EXPECT_THROW(implementation.get_alphas(us, alphas_start, true, rets), Dune::MathError);
+  } // ... get_alphas_coincides_with_get_alpha(...)
+}; // struct EntropyFluxBatchedTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+
+using MomentBases =
+    ::testing::Types<Dune::GDT::LegendreMomentBasis<double, double, 7>,
+                     Dune::GDT::LegendreMomentBasis<double, double, 7, 1, Dune::GDT::EntropyType::BoseEinstein>>;
+
+
+template <class MomentBasis>
+using EntropyFluxBatchedTest = Dune::GDT::Test::EntropyFluxBatchedTest<MomentBasis>;
+TYPED_TEST_CASE(EntropyFluxBatchedTest, MomentBases);
+TYPED_TEST(EntropyFluxBatchedTest, get_alphas_coincides_with_get_alpha)
+{
+  this->get_alphas_coincides_with_get_alpha();
+}
@@ -0,0 +1,211 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+// This one has to come first (includes the config.h)!
+#include <dune/xt/test/main.hxx>
+
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include <dune/grid/yaspgrid.hh>
+
+#include <dune/xt/common/float_cmp.hh>
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/xt/grid/gridprovider/cube.hh>
+
+#include <dune/gdt/test/momentmodels/basisfunctions.hh>
+#include <dune/gdt/test/momentmodels/entropyflux.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks the ring buffer of EntropyLocalCache (search order, early termination within the tolerance, eviction of the
+ * oldest entries) and the counters of the caches of EntropyBasedFluxFunction (see EntropyCacheStatistics).
+ */
+template <class MomentBasis>
+struct EntropyFluxCacheTest : public ::testing::Test
+{
+  using G = YaspGrid<1, EquidistantOffsetCoordinates<double, 1>>;
+  using GV = typename G::LeafGridView;
+  using FluxType = EntropyBasedFluxFunction<GV, MomentBasis>;
+  using ImplementationType = typename FluxType::ImplementationType;
+  using StateType = typename FluxType::StateType;
+  using VectorType = typename FluxType::VectorType;
+  using CacheType = EntropyLocalCache<StateType, VectorType>;
+
+  static StateType key(const double value)
+  {
+    StateType ret(0.);
+    ret[0] = value;
+    return ret;
+  }
+
+  static VectorType value(const double val)
+  {
+    VectorType ret(0.);
+    ret[0] = val;
+    return ret;
+  }
+
+  static void check_found(const CacheType& cache,
+                          const double u,
+                          const double tolerance,
+                          const double expected_distance,
+                          const double expected_value)
+  {
+    const auto distance_and_value = cache.find_closest(key(u), tolerance);
+    ASSERT_NE(nullptr, distance_and_value.second) << "u = " << u << ", tolerance = " << tolerance;
+    EXPECT_NEAR(expected_distance, distance_and_value.first, 1e-14) << "u = " << u << ", tolerance = " << tolerance;
+    EXPECT_EQ(expected_value, (*distance_and_value.second)[0]) << "u = " << u << ", tolerance = " << tolerance;
+  }
+
+  void local_cache_evicts_oldest_entries()
+  {
+    // no capacity, nothing is stored
+    CacheType disabled_cache(0);
+    disabled_cache.insert(key(1.), value(1.));
+    EXPECT_EQ(0u, disabled_cache.size());
+    EXPECT_EQ(nullptr, disabled_cache.find_closest(key(1.)).second);
+    EXPECT_EQ(std::numeric_limits<double>::max(), disabled_cache.find_closest(key(1.)).first);
+    CacheType cache(3);
+    EXPECT_EQ(0u, cache.size());
+    EXPECT_EQ(nullptr, cache.find_closest(key(0.)).second);
+    for (size_t ii = 0; ii < 3; ++ii)
+      cache.insert(key(ii), value(ii));
+    EXPECT_EQ(3u, cache.size());
+    check_found(cache, 0., 0., 0., 0.);
+    // overwrites the oldest entry (key 0)
+    cache.insert(key(3.), value(3.));
+    EXPECT_EQ(3u, cache.size());
+    EXPECT_EQ(3u, cache.capacity());
+    check_found(cache, 0., 0., 1., 1.);
+    check_found(cache, 3., 0., 0., 3.);
+    // overwrites key 1, then key 2
+    cache.insert(key(4.), value(4.));
+    check_found(cache, 0., 0., 2., 2.);
+    cache.insert(key(5.), value(5.));
+    check_found(cache, 0., 0., 3., 3.);
+    check_found(cache, 5., 0., 0., 5.);
+  } // ... local_cache_evicts_oldest_entries(...)
+
+  void local_cache_stops_within_tolerance()
+  {
+    CacheType cache(4);
+    cache.insert(key(1.), value(1.));
+    cache.insert(key(1.25), value(2.));
+    cache.insert(key(3.), value(3.));
+    // without tolerance, the closest entry is found
+    check_found(cache, 1., 0., 0., 1.);
+    // the entries are searched from newest to oldest and the search stops at the first one within the tolerance
+    check_found(cache, 1., 0.5, 0.25, 2.);
+    // the newer entries are not within the tolerance, so the search continues
+    check_found(cache, 1.05, 0.1, 0.05, 1.);
+  } // ... local_cache_stops_within_tolerance(...)
+
+  void statistics_count_lookups_hits_and_solves()
+  {
+    const MomentBasis basis_functions;
+    const ImplementationType implementation(basis_functions,
+                                            /*tau=*/1e-9,
+                                            /*disable_realizability_check=*/true,
+                                            /*epsilon_gamma=*/0.01,
+                                            /*chi=*/0.5,
+                                            /*xi=*/1e-3,
+                                            /*r_sequence=*/{0, 1e-8, 1e-6, 1e-4, 1e-3, 1e-2, 5e-2, 0.1, 0.5, 1},
+                                            /*k_0=*/500,
+                                            /*k_max=*/1000,
+                                            /*epsilon=*/std::pow(2, -52));
+    const auto grid = XT::Grid::make_cube_grid<G>(-1., 1., 4u);
+    const auto grid_view = grid.leaf_view();
+    FluxType flux(grid_view, basis_functions, /*tau=*/1e-9, /*disable_realizability_check=*/true);
+    const auto element = *grid_view.template begin<0>();
+    // moments of an anisotropic ansatz density and of a slightly perturbed one
+    VectorType alpha(0.);
+    alpha[0] = -2.;
+    for (size_t ii = 1; ii < alpha.size(); ++ii)
+      alpha[ii] = 0.3 * std::sin(1. + ii) / (ii + 1.);
+    const auto u = XT::Common::convert_to<StateType>(implementation.get_u(alpha));
+    alpha[1] += 1e-3;
+    const auto u_perturbed = XT::Common::convert_to<StateType>(implementation.get_u(alpha));
+    alpha[1] += 1e-3;
+    const auto u_perturbed_twice = XT::Common::convert_to<StateType>(implementation.get_u(alpha));
+    const auto check_statistics = [&](const size_t lookups,
+                                      const size_t hits,
+                                      const size_t warm_starts,
+                                      const size_t solves,
+                                      const std::string& msg) {
+      const auto statistics = flux.cache_statistics();
+      EXPECT_EQ(lookups, statistics.lookups) << msg;
+      EXPECT_EQ(hits, statistics.hits) << msg;
+      EXPECT_EQ(warm_starts, statistics.warm_starts) << msg;
+      EXPECT_EQ(solves, statistics.solves) << msg;
+      EXPECT_GE(statistics.solve_seconds, 0.) << msg;
+      EXPECT_DOUBLE_EQ(lookups > 0 ? double(hits) / lookups : 0., statistics.hit_rate()) << msg;
+      EXPECT_DOUBLE_EQ(solves > 0 ? hits * statistics.solve_seconds / solves : 0., statistics.estimated_seconds_saved())
+          << msg;
+    };
+    check_statistics(0, 0, 0, 0, "initial");
+    auto local_flux = flux.derived_local_function();
+    local_flux->bind(element);
+    // empty caches, starts from alpha_iso
+    const auto alpha_u = local_flux->get_alpha(u, true)->first;
+    check_statistics(1, 0, 0, 1, "first solve");
+    // the same moment is found in the cache
+    const auto cached_alpha_u = local_flux->get_alpha(u, true)->first;
+    check_statistics(2, 1, 0, 1, "same moment");
+    for (size_t ii = 0; ii < alpha_u.size(); ++ii)
+      EXPECT_EQ(alpha_u[ii], cached_alpha_u[ii]) << "ii = " << ii;
+    // a close moment is solved, starting from the cached alpha
+    local_flux->get_alpha(u_perturbed, true);
+    check_statistics(3, 1, 1, 2, "close moment");
+    // with a positive cache tolerance, the close moment is accepted as solution (the tolerance has to be smaller than
+    // the distance to the isotropic moment, else alpha_iso is used without looking into the caches)
+    const double tolerance = 2. * (u_perturbed_twice - u_perturbed).infinity_norm();
+    const auto u_iso = basis_functions.u_iso() * basis_functions.density(u_perturbed_twice);
+    ASSERT_LT(tolerance, (u_perturbed_twice - u_iso).infinity_norm());
+    flux.set_cache_tolerance(tolerance);
+    local_flux = flux.derived_local_function();
+    local_flux->bind(element);
+    local_flux->get_alpha(u_perturbed_twice, true);
+    check_statistics(4, 2, 1, 2, "within cache tolerance");
+    // the batched solves are counted, but are no lookups
+    flux.get_alphas({u, u_perturbed}, {alpha_u, alpha_u}, true);
+    check_statistics(4, 2, 1, 4, "batched");
+    flux.reset_cache_statistics();
+    check_statistics(0, 0, 0, 0, "reset");
+  } // ... statistics_count_lookups_hits_and_solves(...)
+}; // struct EntropyFluxCacheTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+
+using MomentBases = ::testing::Types<Dune::GDT::LegendreMomentBasis<double, double, 7>>;
+
+
+template <class MomentBasis>
+using EntropyFluxCacheTest = Dune::GDT::Test::EntropyFluxCacheTest<MomentBasis>;
+TYPED_TEST_CASE(EntropyFluxCacheTest, MomentBases);
+TYPED_TEST(EntropyFluxCacheTest, local_cache_evicts_oldest_entries)
+{
+  this->local_cache_evicts_oldest_entries();
+}
+TYPED_TEST(EntropyFluxCacheTest, local_cache_stops_within_tolerance)
+{
+  this->local_cache_stops_within_tolerance();
+}
+TYPED_TEST(EntropyFluxCacheTest, statistics_count_lookups_hits_and_solves)
+{
+  this->statistics_count_lookups_hits_and_solves();
+}
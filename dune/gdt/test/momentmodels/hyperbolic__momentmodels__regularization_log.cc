@@ -0,0 +1,165 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+// This one has to come first (includes the config.h)!
+#include <dune/xt/test/main.hxx>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/gdt/test/momentmodels/entropysolver.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks that the records of several threads, each appended to the regularization log in one piece (as
+ * LocalEntropySolver does in finalize), can be read back from the binary log in the format read by
+ * python/scripts/read_regularization_log.py, and that the text log contains the same records.
+ */
+struct RegularizationLogTest : public ::testing::Test
+{
+  static const constexpr size_t dimFlux = 2;
+  static const constexpr size_t dimRange = 3;
+  static const constexpr size_t record_size = 2 + dimFlux + dimRange;
+  static const constexpr size_t num_threads = 4;
+  static const constexpr size_t num_records_per_thread = 5;
+
+  // t identifies the record, u has more digits than the default stream precision
+  static std::vector<double> make_records(const size_t thread)
+  {
+    std::vector<double> ret;
+    for (size_t rr = 0; rr < num_records_per_thread; ++rr) {
+      ret.push_back(0.25 * (thread * num_records_per_thread + rr));
+      ret.push_back(0.125 * thread);
+      ret.push_back(0.5 * rr);
+      ret.push_back(1e-3 * (rr + 1));
+      for (size_t ii = 0; ii < dimRange; ++ii)
+        ret.push_back(std::sin(1. + ii + thread + 10. * rr));
+    }
+    return ret;
+  }
+
+  template <bool binary>
+  static void write_from_threads(const std::string& filename)
+  {
+    std::remove(filename.c_str());
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < num_threads; ++thread)
+      threads.emplace_back([=]() {
+        internal::append_regularization_log<dimFlux, dimRange>(filename, binary, make_records(thread));
+      });
+    for (auto& thread : threads)
+      thread.join();
+  }
+
+  // returns the records by t
+  static std::map<double, std::vector<double>> read_binary(const std::string& filename)
+  {
+    std::map<double, std::vector<double>> ret;
+    std::ifstream file(filename, std::ios_base::binary);
+    char magic[8];
+    file.read(magic, 8);
+    EXPECT_EQ("GDTREGLG", std::string(magic, 8));
+    std::uint64_t dims[2];
+    file.read(reinterpret_cast<char*>(dims), sizeof(dims));
+    EXPECT_EQ(std::uint64_t(dimFlux), dims[0]);
+    EXPECT_EQ(std::uint64_t(dimRange), dims[1]);
+    std::vector<double> record(record_size);
+    size_t previous_thread = num_threads;
+    size_t num_records_of_thread = 0;
+    while (file.read(reinterpret_cast<char*>(record.data()), record_size * sizeof(double))) {
+      // the records of each thread are contiguous
+      const size_t thread = static_cast<size_t>(std::lround(record[0] / 0.25)) / num_records_per_thread;
+      if (thread != previous_thread) {
+        EXPECT_TRUE(num_records_of_thread == 0 || num_records_of_thread == num_records_per_thread);
+        num_records_of_thread = 0;
+        previous_thread = thread;
+      }
+      ++num_records_of_thread;
+      ret[record[0]] = record;
+    }
+    EXPECT_EQ(size_t(num_records_per_thread), num_records_of_thread);
+    EXPECT_EQ(0, file.gcount()) << "truncated record";
+    return ret;
+  } // ... read_binary(...)
+
+  static std::map<double, std::vector<double>> read_text(const std::string& filename)
+  {
+    std::map<double, std::vector<double>> ret;
+    std::ifstream file(filename);
+    std::string line;
+    while (std::getline(file, line)) {
+      for (auto& character : line)
+        if (character == '[' || character == ']')
+          character = ' ';
+      std::istringstream line_stream(line);
+      std::vector<double> record;
+      double value;
+      while (line_stream >> value)
+        record.push_back(value);
+      EXPECT_EQ(size_t(record_size), record.size()) << line;
+      if (!record.empty())
+        ret[record[0]] = record;
+    }
+    return ret;
+  } // ... read_text(...)
+
+  void binary_and_text_logs_contain_all_records()
+  {
+    const std::string prefix = "regularization_log_test";
+    write_from_threads<true>(prefix + "_regularization.bin");
+    write_from_threads<false>(prefix + "_regularization.txt");
+    const auto binary_records = read_binary(prefix + "_regularization.bin");
+    const auto text_records = read_text(prefix + "_regularization.txt");
+    ASSERT_EQ(num_threads * num_records_per_thread, binary_records.size());
+    ASSERT_EQ(num_threads * num_records_per_thread, text_records.size());
+    for (size_t thread = 0; thread < num_threads; ++thread) {
+      const auto expected = make_records(thread);
+      for (size_t rr = 0; rr < num_records_per_thread; ++rr) {
+        const double t = expected[rr * record_size];
+        ASSERT_EQ(1u, binary_records.count(t)) << "t = " << t;
+        ASSERT_EQ(1u, text_records.count(t)) << "t = " << t;
+        const auto& binary_record = binary_records.at(t);
+        const auto& text_record = text_records.at(t);
+        for (size_t ii = 0; ii < record_size; ++ii) {
+          const double expected_value = expected[rr * record_size + ii];
+          EXPECT_EQ(expected_value, binary_record[ii]) << "t = " << t << ", ii = " << ii;
+          // t, the center and s are written with the default precision of 6 digits, u with 15
+          const double tolerance = ii < 2 + dimFlux ? 1e-5 : 1e-14;
+          EXPECT_NEAR(expected_value, text_record[ii], tolerance * std::abs(expected_value))
+              << "t = " << t << ", ii = " << ii;
+        }
+      }
+    }
+    std::remove((prefix + "_regularization.bin").c_str());
+    std::remove((prefix + "_regularization.txt").c_str());
+  } // ... binary_and_text_logs_contain_all_records(...)
+}; // struct RegularizationLogTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+
+using RegularizationLogTest = Dune::GDT::Test::RegularizationLogTest;
+TEST_F(RegularizationLogTest, binary_and_text_logs_contain_all_records)
+{
+  this->binary_and_text_logs_contain_all_records();
+}
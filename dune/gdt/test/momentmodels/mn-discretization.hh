@@ -47,7 +47,9 @@ struct HyperbolicMnDiscretization
                                                           size_t overlap_size = 2,
                                                           double t_end = 0.,
                                                           std::string filename = "",
-                                                          bool disable_thread_cache = false)
+                                                          bool disable_thread_cache = false,
+                                                          size_t entropy_solver_batch_size = 1,
+                                                          bool warm_start = false)
   {
     using namespace Dune;
     using namespace Dune::GDT;
@@ -181,10 +183,12 @@ struct HyperbolicMnDiscretization
     EntropySolverType entropy_solver(*(dynamic_cast<EntropyFluxType*>(analytical_flux.get())),
                                      fv_space,
                                      problem.psi_vac() * basis_functions->unit_ball_volume() / 10,
-                                     filename);
+                                     filename,
+                                     entropy_solver_batch_size);
     FvOperatorType fv_operator(
         FvOperatorChooser<TestCaseType::reconstruction>::choose(advection_operator, reconstruction_advection_operator),
-        entropy_solver);
+        entropy_solver,
+        warm_start);
 
     // ******************************** do the time steps ***********************************************************
     const auto sigma_a = problem.sigma_a();
@@ -260,6 +264,30 @@ struct HyperbolicMnTest
     EXPECT_NEAR(ResultsType::l2norm, l2norm, ResultsType::l2norm * tol);
     EXPECT_NEAR(ResultsType::linfnorm, linfnorm, ResultsType::linfnorm * tol);
   }
+
+  // warm starting the entropy solver from the solution of the last stage must not change the results
+  void run_warm_start(const double tol = TestCaseType::ExpectedResultsType::tol)
+  {
+    const auto run_with = [](const bool warm_start) {
+      return HyperbolicMnDiscretization<TestCaseType>::run(
+                 1,
+                 0,
+                 TestCaseType::quad_order,
+                 TestCaseType::quad_refinements,
+                 "",
+                 2,
+                 TestCaseType::t_end,
+                 "test",
+                 Dune::GDT::is_full_moment_basis<typename TestCaseType::MomentBasis>::value,
+                 1,
+                 warm_start)
+          .first;
+    };
+    const auto cold_norms = run_with(false);
+    const auto warm_norms = run_with(true);
+    for (size_t ii = 0; ii < 3; ++ii)
+      EXPECT_NEAR(cold_norms[ii], warm_norms[ii], cold_norms[ii] * tol) << "ii = " << ii;
+  }
 };
 
 #endif // DUNE_GDT_TEST_HYPERBOLIC_MN_DISCRETIZATION_HH
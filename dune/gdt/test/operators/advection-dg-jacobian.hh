@@ -0,0 +1,87 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_OPERATORS_ADVECTION_DG_JACOBIAN_HH
+#define DUNE_GDT_TEST_OPERATORS_ADVECTION_DG_JACOBIAN_HH
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/local/numerical-fluxes/lax-friedrichs.hh>
+#include <dune/gdt/operators/advection-dg.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/test/leaf-view-test.hh>
+#include <dune/gdt/tools/sparsity-pattern.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks that the analytic jacobian of the DG discretization of Burgers' equation coincides with the one obtained by
+ * finite differences.
+ */
+template <class G>
+struct AdvectionDgJacobianTest : public LeafViewTest<G>
+{
+  using BaseType = LeafViewTest<G>;
+  using BaseType::d;
+  using typename BaseType::I;
+  using typename BaseType::M;
+  using typename BaseType::V;
+
+  static_assert(d == 1, "The flux below is only implemented in 1d!");
+
+  void analytic_jacobian_coincides_with_finite_differences(const int order)
+  {
+    const auto grid_view = this->grid_view();
+    const XT::Functions::GenericFunction<1, d, 1> flux(
+        2,
+        [](const auto& u, const auto& /*param*/) { return 0.5 * u * u; },
+        "burgers",
+        {},
+        [](const auto& u, const auto& /*param*/) { return u; });
+    const NumericalLaxFriedrichsFlux<I, d, 1> numerical_flux(flux, /*lambda=*/1.);
+    const auto space = make_discontinuous_lagrange_space(grid_view, order);
+    const auto op = make_advection_dg_operator<M>(grid_view, numerical_flux, space, space);
+    // the analytic jacobians have to be requested explicitly
+    EXPECT_EQ("finite-differences", op.jacobian_options().at(0));
+    V source(space.mapper().size());
+    for (size_t ii = 0; ii < source.size(); ++ii)
+      source[ii] = 1. + 0.5 * std::sin(1. + ii);
+    using MatrixOperatorType = typename std::decay_t<decltype(op)>::MatrixOperatorType;
+    const auto pattern = make_element_and_intersection_sparsity_pattern(space, space, grid_view);
+    MatrixOperatorType analytic_jacobian(grid_view, space, space, pattern);
+    op.jacobian(source, analytic_jacobian, "analytic");
+    analytic_jacobian.walk(/*use_tbb=*/true);
+    MatrixOperatorType fd_jacobian(grid_view, space, space, pattern);
+    op.jacobian(source, fd_jacobian, "finite-differences");
+    fd_jacobian.walk(/*use_tbb=*/true);
+    auto difference = analytic_jacobian.matrix().copy();
+    difference.axpy(-1., fd_jacobian.matrix());
+    EXPECT_LT(difference.sup_norm(), 1e-5 * std::max(1., fd_jacobian.matrix().sup_norm())) << "order = " << order;
+  } // ... analytic_jacobian_coincides_with_finite_differences(...)
+
+  void analytic_jacobian_coincides_with_finite_differences()
+  {
+    for (int order : {0, 1, 2})
+      analytic_jacobian_coincides_with_finite_differences(order);
+  }
+}; // struct AdvectionDgJacobianTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_OPERATORS_ADVECTION_DG_JACOBIAN_HH
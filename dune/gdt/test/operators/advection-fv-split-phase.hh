@@ -0,0 +1,131 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_OPERATORS_ADVECTION_FV_SPLIT_PHASE_HH
+#define DUNE_GDT_TEST_OPERATORS_ADVECTION_FV_SPLIT_PHASE_HH
+
+#include <cmath>
+
+#include <dune/common/fvector.hh>
+
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/discretefunction/default.hh>
+#include <dune/gdt/local/numerical-fluxes/lax-friedrichs.hh>
+#include <dune/gdt/local/operators/generic.hh>
+#include <dune/gdt/operators/advection-fv.hh>
+#include <dune/gdt/operators/localizable-operator.hh>
+#include <dune/gdt/spaces/h1/continuous-lagrange.hh>
+#include <dune/gdt/spaces/l2/finite-volume.hh>
+#include <dune/gdt/test/leaf-view-test.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks that the split-phase apply_and_communicate coincides with apply followed by a blocking communication. Meant to
+ * be run with several MPI ranks (see the CMakeLists.txt), where it checks that the split path is actually taken.
+ */
+template <class G>
+struct AdvectionFvSplitPhaseTest : public LeafViewTest<G>
+{
+  using BaseType = LeafViewTest<G>;
+  using BaseType::d;
+  using typename BaseType::GV;
+  using typename BaseType::I;
+  using typename BaseType::M;
+  using typename BaseType::V;
+
+  unsigned int num_elements_per_dim() const override
+  {
+    return 16u;
+  }
+
+  void apply_and_communicate_coincides_with_apply()
+  {
+    const auto grid_view = this->grid_view();
+    const XT::Functions::GenericFunction<1, d, 1> flux(
+        2,
+        [](const auto& u, const auto& /*param*/) {
+          FieldVector<double, d> ret(0.5 * u[0] * u[0]);
+          return ret;
+        },
+        "burgers");
+    const NumericalLaxFriedrichsFlux<I, d, 1> numerical_flux(flux, /*lambda=*/1.);
+    const auto space = make_finite_volume_space<1>(grid_view);
+    auto op = make_advection_fv_operator<M>(grid_view, numerical_flux, space, space);
+    const auto rank = grid_view.comm().rank();
+    V source(space.mapper().size());
+    for (size_t ii = 0; ii < source.size(); ++ii)
+      source[ii] = std::sin(1. + ii) + rank;
+    auto expected = make_discrete_function<V>(space);
+    op.apply(source, expected.dofs().vector());
+    const V uncommunicated = expected.dofs().vector().copy();
+    DiscreteFunctionDataHandle<decltype(expected)> handle(expected);
+    grid_view.communicate(handle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+    V actual(space.mapper().size());
+    op.apply_and_communicate(source, actual);
+    for (size_t ii = 0; ii < actual.size(); ++ii)
+      EXPECT_NEAR(expected.dofs().vector()[ii], actual[ii], 1e-13);
+    // as used by the time steppers and the operators wrapping an advection operator
+    V forwarded(space.mapper().size());
+    internal::apply_and_communicate(op, source, forwarded, space, {});
+    for (size_t ii = 0; ii < forwarded.size(); ++ii)
+      EXPECT_NEAR(expected.dofs().vector()[ii], forwarded[ii], 1e-13);
+    const auto& partition = space.element_halo_partition();
+    if (grid_view.comm().size() == 1) {
+      EXPECT_EQ(0u, partition.num_border_elements());
+      EXPECT_TRUE(partition.send_elements().empty());
+    } else {
+      // the split path is taken and the communication changes the result
+      EXPECT_TRUE(space.dof_halo_exchange().required());
+      EXPECT_LT(0u, partition.num_border_elements());
+      EXPECT_FALSE(partition.send_elements().empty());
+      size_t num_received = 0;
+      for (size_t ii = 0; ii < actual.size(); ++ii)
+        if (actual[ii] != uncommunicated[ii])
+          ++num_received;
+      EXPECT_LT(size_t(0), num_received);
+    }
+  } // ... apply_and_communicate_coincides_with_apply(...)
+
+  /// For continuous range spaces, apply_and_communicate falls back to apply followed by a blocking communication.
+  void apply_and_communicate_coincides_with_apply_for_continuous_range()
+  {
+    const auto grid_view = this->grid_view();
+    const auto space = make_continuous_lagrange_space(grid_view, 1);
+    LocalizableOperator<M, GV, 1> op(grid_view, space, space);
+    // counts the elements sharing each DoF, which requires all of them to be computed before the exchange
+    op.append(GenericLocalElementOperator<V, GV, 1>([](const auto& /*source*/,
+                                                       const auto& /*local_sources*/,
+                                                       auto& local_range,
+                                                       const auto& /*param*/) {
+      for (size_t ii = 0; ii < local_range.dofs().size(); ++ii)
+        local_range.dofs()[ii] += 1.;
+    }));
+    const V source(space.mapper().size(), 1.);
+    auto expected = make_discrete_function<V>(space);
+    op.apply(source, expected.dofs().vector());
+    DiscreteFunctionDataHandle<decltype(expected)> handle(expected);
+    grid_view.communicate(handle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+    V actual(space.mapper().size());
+    op.apply_and_communicate(source, actual);
+    for (size_t ii = 0; ii < actual.size(); ++ii)
+      EXPECT_EQ(expected.dofs().vector()[ii], actual[ii]);
+  } // ... apply_and_communicate_coincides_with_apply_for_continuous_range(...)
+}; // struct AdvectionFvSplitPhaseTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_OPERATORS_ADVECTION_FV_SPLIT_PHASE_HH
@@ -0,0 +1,84 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_OPERATORS_ADVECTION_FV_WAVE_SPEEDS_HH
+#define DUNE_GDT_TEST_OPERATORS_ADVECTION_FV_WAVE_SPEEDS_HH
+
+#include <algorithm>
+#include <cmath>
+
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/local/numerical-fluxes/lax-friedrichs.hh>
+#include <dune/gdt/operators/advection-fv.hh>
+#include <dune/gdt/spaces/l2/finite-volume.hh>
+#include <dune/gdt/test/leaf-view-test.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks that the wave speeds collected by AdvectionFvOperator for Burgers' equation give the expected CFL estimate.
+ */
+template <class G>
+struct AdvectionFvWaveSpeedsTest : public LeafViewTest<G>
+{
+  using BaseType = LeafViewTest<G>;
+  using BaseType::d;
+  using typename BaseType::I;
+  using typename BaseType::M;
+  using typename BaseType::V;
+
+  static_assert(d == 1, "The flux and the expected time step below are only implemented in 1d!");
+
+  unsigned int num_elements_per_dim() const override
+  {
+    return 16u;
+  }
+
+  void estimate_dt_is_cfl_condition()
+  {
+    const double num_elements = this->num_elements_per_dim();
+    const auto grid_view = this->grid_view();
+    const XT::Functions::GenericFunction<1, d, 1> flux(
+        2,
+        [](const auto& u, const auto& /*param*/) { return 0.5 * u * u; },
+        "burgers",
+        {},
+        [](const auto& u, const auto& /*param*/) { return u; });
+    const NumericalLaxFriedrichsFlux<I, d, 1> numerical_flux(flux, /*lambda=*/1.);
+    const auto space = make_finite_volume_space<1>(grid_view);
+    auto op = make_advection_fv_operator<M>(grid_view, numerical_flux, space, space);
+    V source(space.mapper().size());
+    double max_speed = 0.;
+    for (size_t ii = 0; ii < source.size(); ++ii) {
+      source[ii] = 1. + 0.5 * std::sin(1. + ii);
+      max_speed = std::max(max_speed, std::abs(source[ii]));
+    }
+    V range(space.mapper().size());
+    op.collect_wave_speeds();
+    op.apply(source, range);
+    // each element has two faces of volume 1
+    const double expected_dt = 0.5 / (2. * num_elements * max_speed);
+    EXPECT_DOUBLE_EQ(expected_dt, op.estimate_dt(0.5));
+    // the accumulator is reset in each apply
+    source *= 0.5;
+    op.apply(source, range);
+    EXPECT_DOUBLE_EQ(2. * expected_dt, op.estimate_dt(0.5));
+  } // ... estimate_dt_is_cfl_condition(...)
+}; // struct AdvectionFvWaveSpeedsTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_OPERATORS_ADVECTION_FV_WAVE_SPEEDS_HH
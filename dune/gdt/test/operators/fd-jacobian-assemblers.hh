@@ -0,0 +1,143 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_OPERATORS_FD_JACOBIAN_ASSEMBLERS_HH
+#define DUNE_GDT_TEST_OPERATORS_FD_JACOBIAN_ASSEMBLERS_HH
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#include <dune/xt/common/parallel/threadmanager.hh>
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/exceptions.hh>
+#include <dune/gdt/local/assembler/operator-fd-jacobian-assemblers.hh>
+#include <dune/gdt/local/numerical-fluxes/lax-friedrichs.hh>
+#include <dune/gdt/operators/advection-dg.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/test/leaf-view-test.hh>
+#include <dune/gdt/tools/sparsity-pattern.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks internal::LocallyPerturbedVector and that the finite-difference jacobian of the DG discretization of Burgers'
+ * equation, assembled element- and intersection-wise with locally perturbed sources, coincides with the difference
+ * quotients of the globally applied operator (column by column, perturbing a copy of the source), for several threads.
+ * See AdvectionDgJacobianTest for the comparison with the analytic jacobian in 1d.
+ */
+template <class G>
+struct FiniteDifferenceJacobianAssemblersTest : public LeafViewTest<G>
+{
+  using BaseType = LeafViewTest<G>;
+  using BaseType::d;
+  using typename BaseType::I;
+  using typename BaseType::M;
+  using typename BaseType::V;
+
+  unsigned int num_elements_per_dim() const override
+  {
+    return 4u;
+  }
+
+  void locally_perturbed_vector_overlays_one_entry()
+  {
+    V vector(10);
+    for (size_t ii = 0; ii < vector.size(); ++ii)
+      vector[ii] = std::sin(1. + ii);
+    const V expected = vector;
+    internal::LocallyPerturbedVector<V> perturbed_vector(vector);
+    EXPECT_EQ(vector.size(), perturbed_vector.size());
+    perturbed_vector.perturb(3, 0.5);
+    for (size_t ii = 0; ii < vector.size(); ++ii) {
+      const double expected_entry = expected[ii] + (ii == 3 ? 0.5 : 0.);
+      EXPECT_EQ(expected_entry, perturbed_vector.get_entry(ii)) << "ii = " << ii;
+      EXPECT_EQ(expected_entry, static_cast<const internal::LocallyPerturbedVector<V>&>(perturbed_vector)[ii])
+          << "ii = " << ii;
+      // the underlying vector is not touched
+      EXPECT_EQ(expected[ii], vector[ii]) << "ii = " << ii;
+    }
+    // a new perturbation replaces the previous one
+    perturbed_vector.perturb(7, -0.25);
+    EXPECT_EQ(expected[3], perturbed_vector.get_entry(3));
+    EXPECT_EQ(expected[7] - 0.25, perturbed_vector.get_entry(7));
+    perturbed_vector.restore();
+    for (size_t ii = 0; ii < vector.size(); ++ii)
+      EXPECT_EQ(expected[ii], perturbed_vector.get_entry(ii)) << "ii = " << ii;
+    EXPECT_THROW(perturbed_vector.set_entry(0, 1.), Exceptions::operator_error);
+    EXPECT_THROW(perturbed_vector.add_to_entry(0, 1.), Exceptions::operator_error);
+  } // ... locally_perturbed_vector_overlays_one_entry(...)
+
+  void finite_differences_coincide_with_global_difference_quotients(const int order)
+  {
+    const auto grid_view = this->grid_view();
+    const XT::Functions::GenericFunction<1, d, 1> flux(
+        2,
+        [](const auto& u, const auto& /*param*/) {
+          FieldVector<double, d> ret(0.5 * u[0] * u[0]);
+          return ret;
+        },
+        "burgers");
+    const NumericalLaxFriedrichsFlux<I, d, 1> numerical_flux(flux, /*lambda=*/1.);
+    const auto space = make_discontinuous_lagrange_space(grid_view, order);
+    const auto op = make_advection_dg_operator<M>(grid_view, numerical_flux, space, space);
+    V source(space.mapper().size());
+    for (size_t ii = 0; ii < source.size(); ++ii)
+      source[ii] = 1. + 0.5 * std::sin(1. + ii);
+    const V unchanged_source = source;
+    const auto pattern = make_element_and_intersection_sparsity_pattern(space, space, grid_view);
+    const size_t max_threads = XT::Common::threadManager().max_threads();
+    XT::Common::threadManager().set_max_threads(std::max(max_threads, size_t(4)));
+    using MatrixOperatorType = typename std::decay_t<decltype(op)>::MatrixOperatorType;
+    MatrixOperatorType fd_jacobian(grid_view, space, space, pattern);
+    op.jacobian(source, fd_jacobian, "finite-differences");
+    fd_jacobian.walk(/*use_tbb=*/true);
+    XT::Common::threadManager().set_max_threads(max_threads);
+    const auto& actual = fd_jacobian.matrix();
+    // reference: one global application per source DoF, with the default eps of the jacobian options and the same
+    // perturbation as in LocalElementOperatorFiniteDifferenceJacobianAssembler
+    const double eps = 1e-7;
+    V range(space.mapper().size());
+    op.apply(source, range);
+    V perturbed_source = source;
+    V perturbed_range(space.mapper().size());
+    for (size_t jj = 0; jj < source.size(); ++jj) {
+      const double eps_jj = eps * (1. + std::abs(source[jj]));
+      perturbed_source[jj] = source[jj] + eps_jj;
+      perturbed_range.set_all(0.);
+      op.apply(perturbed_source, perturbed_range);
+      perturbed_source[jj] = source[jj];
+      for (size_t ii = 0; ii < range.size(); ++ii) {
+        const double expected = (perturbed_range[ii] - range[ii]) / eps_jj;
+        EXPECT_NEAR(expected, actual.get_entry(ii, jj), 1e-5 * std::max(1., std::abs(expected)))
+            << "order = " << order << ", ii = " << ii << ", jj = " << jj;
+      }
+    }
+    // the source is only perturbed locally
+    for (size_t ii = 0; ii < source.size(); ++ii)
+      EXPECT_EQ(unchanged_source[ii], source[ii]) << "order = " << order << ", ii = " << ii;
+  } // ... finite_differences_coincide_with_global_difference_quotients(...)
+
+  void finite_differences_coincide_with_global_difference_quotients()
+  {
+    for (int order : {0, 1})
+      finite_differences_coincide_with_global_difference_quotients(order);
+  }
+}; // struct FiniteDifferenceJacobianAssemblersTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_OPERATORS_FD_JACOBIAN_ASSEMBLERS_HH
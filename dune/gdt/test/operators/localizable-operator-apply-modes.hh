@@ -0,0 +1,99 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_OPERATORS_LOCALIZABLE_OPERATOR_APPLY_MODES_HH
+#define DUNE_GDT_TEST_OPERATORS_LOCALIZABLE_OPERATOR_APPLY_MODES_HH
+
+#include <algorithm>
+#include <cmath>
+
+#include <dune/xt/common/parallel/threadmanager.hh>
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/local/numerical-fluxes/lax-friedrichs.hh>
+#include <dune/gdt/operators/advection-dg.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/test/leaf-view-test.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks that all apply modes of LocalizableOperator coincide for the DG discretization of Burgers' equation (which
+ * contains intersection operators) and that the "deterministic" one does not depend on the number of threads. The
+ * default "direct" mode is only race-free in a sequential grid walk here.
+ */
+template <class G>
+struct LocalizableOperatorApplyModesTest : public LeafViewTest<G>
+{
+  using BaseType = LeafViewTest<G>;
+  using BaseType::d;
+  using typename BaseType::I;
+  using typename BaseType::M;
+  using typename BaseType::V;
+
+  void apply_modes_coincide(const int order)
+  {
+    const auto grid_view = this->grid_view();
+    const XT::Functions::GenericFunction<1, d, 1> flux(
+        2,
+        [](const auto& u, const auto& /*param*/) {
+          FieldVector<double, d> ret(0.5 * u[0] * u[0]);
+          return ret;
+        },
+        "burgers");
+    const NumericalLaxFriedrichsFlux<I, d, 1> numerical_flux(flux, /*lambda=*/1.);
+    const auto space = make_discontinuous_lagrange_space(grid_view, order);
+    auto op = make_advection_dg_operator<M>(grid_view, numerical_flux, space, space);
+    V source(space.mapper().size());
+    for (size_t ii = 0; ii < source.size(); ++ii)
+      source[ii] = 1. + 0.5 * std::sin(1. + ii);
+    EXPECT_EQ("direct", op.apply_mode());
+    const auto max_threads = XT::Common::threadManager().max_threads();
+    // reference: sequential
+    XT::Common::threadManager().set_max_threads(1);
+    V direct(space.mapper().size());
+    op.apply(source, direct);
+    V expected(space.mapper().size());
+    op.apply_mode("deterministic").apply(source, expected);
+    XT::Common::threadManager().set_max_threads(std::max(max_threads, size_t(4)));
+    V deterministic(space.mapper().size());
+    op.apply_mode("deterministic").apply(source, deterministic);
+    V buffered(space.mapper().size());
+    op.apply_mode("buffered").apply(source, buffered);
+    V automatic(space.mapper().size());
+    op.apply_mode("automatic").apply(source, automatic);
+    // each application uses its own thread-private ranges
+    V repeated(space.mapper().size());
+    op.apply_mode("buffered").apply(source, repeated);
+    XT::Common::threadManager().set_max_threads(max_threads);
+    for (size_t ii = 0; ii < expected.size(); ++ii) {
+      EXPECT_NEAR(expected[ii], direct[ii], 1e-13 * std::max(1., std::abs(expected[ii])));
+      EXPECT_EQ(expected[ii], deterministic[ii]) << "order = " << order << ", ii = " << ii;
+      EXPECT_NEAR(expected[ii], buffered[ii], 1e-13 * std::max(1., std::abs(expected[ii])));
+      EXPECT_NEAR(expected[ii], automatic[ii], 1e-13 * std::max(1., std::abs(expected[ii])));
+      EXPECT_NEAR(expected[ii], repeated[ii], 1e-13 * std::max(1., std::abs(expected[ii])));
+    }
+  } // ... apply_modes_coincide(...)
+
+  void apply_modes_coincide()
+  {
+    for (int order : {0, 1})
+      apply_modes_coincide(order);
+  }
+}; // struct LocalizableOperatorApplyModesTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_OPERATORS_LOCALIZABLE_OPERATOR_APPLY_MODES_HH
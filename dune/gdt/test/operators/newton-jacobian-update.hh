@@ -0,0 +1,99 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_OPERATORS_NEWTON_JACOBIAN_UPDATE_HH
+#define DUNE_GDT_TEST_OPERATORS_NEWTON_JACOBIAN_UPDATE_HH
+
+#include <algorithm>
+#include <cmath>
+
+#include <dune/xt/common/string.hh>
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/local/numerical-fluxes/lax-friedrichs.hh>
+#include <dune/gdt/operators/advection-dg.hh>
+#include <dune/gdt/operators/identity.hh>
+#include <dune/gdt/operators/lincomb.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/test/leaf-view-test.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks that the Newton scheme of OperatorInterface::apply_inverse converges to the same solution if the jacobian is
+ * frozen (jacobian_update_frequency 0) or only reassembled every few iterations, as with the default of reassembling
+ * it in each iteration. The nonlinear system is one implicit Euler step of the DG discretization of Burgers' equation.
+ */
+template <class G>
+struct NewtonJacobianUpdateTest : public LeafViewTest<G>
+{
+  using BaseType = LeafViewTest<G>;
+  using BaseType::d;
+  using typename BaseType::I;
+  using typename BaseType::M;
+  using typename BaseType::V;
+
+  void jacobian_update_frequencies_coincide(const int order)
+  {
+    const auto grid_view = this->grid_view();
+    const XT::Functions::GenericFunction<1, d, 1> flux(
+        2,
+        [](const auto& u, const auto& /*param*/) {
+          FieldVector<double, d> ret(0.5 * u[0] * u[0]);
+          return ret;
+        },
+        "burgers");
+    const NumericalLaxFriedrichsFlux<I, d, 1> numerical_flux(flux, /*lambda=*/1.);
+    const auto space = make_discontinuous_lagrange_space(grid_view, order);
+    const auto op = make_advection_dg_operator<M>(grid_view, numerical_flux, space, space);
+    V u_n(space.mapper().size());
+    for (size_t ii = 0; ii < u_n.size(); ++ii)
+      u_n[ii] = 1. + 0.5 * std::sin(1. + ii);
+    // a large time step, such that several Newton iterations are required
+    const double dt = 0.5;
+    const auto id = make_identity_operator(op);
+    const auto residual_op = (id - u_n) / dt + op;
+    const V zero(space.mapper().size(), 0.);
+    const double precision = 1e-10;
+    V expected;
+    for (size_t frequency : {1, 0, 2, 3}) {
+      auto opts = residual_op.invert_options("newton");
+      opts.set("precision", precision, /*overwrite=*/true);
+      opts.set("jacobian_update_frequency", frequency, /*overwrite=*/true);
+      auto solution = u_n.copy();
+      residual_op.apply_inverse(zero, solution, opts);
+      V residual(space.mapper().size());
+      residual_op.apply(solution, residual);
+      EXPECT_LT(residual.l2_norm(), precision) << "order = " << order << ", frequency = " << frequency;
+      if (frequency == 1) {
+        expected = solution;
+        continue;
+      }
+      auto difference = solution - expected;
+      EXPECT_LT(difference.sup_norm(), 1e-8 * std::max(1., expected.sup_norm()))
+          << "order = " << order << ", frequency = " << frequency;
+    }
+  } // ... jacobian_update_frequencies_coincide(...)
+
+  void jacobian_update_frequencies_coincide()
+  {
+    for (int order : {0, 1})
+      jacobian_update_frequencies_coincide(order);
+  }
+}; // struct NewtonJacobianUpdateTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_OPERATORS_NEWTON_JACOBIAN_UPDATE_HH
@@ -0,0 +1,28 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <dune/xt/grid/grids.hh>
+
+#include "advection-fv-split-phase.hh"
+
+
+using ParallelGrids = ::testing::Types<YASP_2D_EQUIDISTANT_OFFSET, YASP_3D_EQUIDISTANT_OFFSET>;
+
+
+template <class G>
+using AdvectionFvSplitPhaseTest = Dune::GDT::Test::AdvectionFvSplitPhaseTest<G>;
+TYPED_TEST_CASE(AdvectionFvSplitPhaseTest, ParallelGrids);
+TYPED_TEST(AdvectionFvSplitPhaseTest, apply_and_communicate_coincides_with_apply)
+{
+  this->apply_and_communicate_coincides_with_apply();
+}
+TYPED_TEST(AdvectionFvSplitPhaseTest, apply_and_communicate_coincides_with_apply_for_continuous_range)
+{
+  this->apply_and_communicate_coincides_with_apply_for_continuous_range();
+}
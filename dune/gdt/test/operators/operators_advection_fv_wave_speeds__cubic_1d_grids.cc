@@ -0,0 +1,24 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <dune/xt/grid/grids.hh>
+
+#include "advection-fv-wave-speeds.hh"
+
+
+using Cubic1dGrids = ::testing::Types<ONED_1D, YASP_1D_EQUIDISTANT_OFFSET>;
+
+
+template <class G>
+using AdvectionFvWaveSpeedsTest = Dune::GDT::Test::AdvectionFvWaveSpeedsTest<G>;
+TYPED_TEST_CASE(AdvectionFvWaveSpeedsTest, Cubic1dGrids);
+TYPED_TEST(AdvectionFvWaveSpeedsTest, estimate_dt_is_cfl_condition)
+{
+  this->estimate_dt_is_cfl_condition();
+}
@@ -0,0 +1,39 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <dune/xt/grid/grids.hh>
+
+#include "fd-jacobian-assemblers.hh"
+
+
+using Simplicial2dGrids = ::testing::Types<
+#if HAVE_DUNE_ALUGRID
+    ALU_2D_SIMPLEX_CONFORMING,
+    ALU_2D_SIMPLEX_NONCONFORMING
+#endif
+#if HAVE_DUNE_ALUGRID && (HAVE_DUNE_UGGRID || HAVE_UG)
+    ,
+#endif
+#if HAVE_DUNE_UGGRID || HAVE_UG
+    UG_2D
+#endif
+    >;
+
+
+template <class G>
+using FiniteDifferenceJacobianAssemblersTest = Dune::GDT::Test::FiniteDifferenceJacobianAssemblersTest<G>;
+TYPED_TEST_CASE(FiniteDifferenceJacobianAssemblersTest, Simplicial2dGrids);
+TYPED_TEST(FiniteDifferenceJacobianAssemblersTest, locally_perturbed_vector_overlays_one_entry)
+{
+  this->locally_perturbed_vector_overlays_one_entry();
+}
+TYPED_TEST(FiniteDifferenceJacobianAssemblersTest, finite_differences_coincide_with_global_difference_quotients)
+{
+  this->finite_differences_coincide_with_global_difference_quotients();
+}
@@ -0,0 +1,110 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_OPERATORS_SUM_FACTORIZED_HH
+#define DUNE_GDT_TEST_OPERATORS_SUM_FACTORIZED_HH
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+
+#include <dune/xt/common/fvector.hh>
+#include <dune/xt/common/string.hh>
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/xt/functions/generic/grid-function.hh>
+
+#include <dune/gdt/local/bilinear-forms/integrals.hh>
+#include <dune/gdt/local/integrands/laplace.hh>
+#include <dune/gdt/local/integrands/product.hh>
+#include <dune/gdt/local/operators/sum-factorized.hh>
+#include <dune/gdt/operators/localizable-operator.hh>
+#include <dune/gdt/operators/matrix-based.hh>
+#include <dune/gdt/spaces/h1/continuous-lagrange.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/test/leaf-view-test.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks that the matrix-free sum-factorized operators coincide with the application of the respective assembled
+ * matrix operators.
+ */
+template <class G>
+struct SumFactorizedOperatorTest : public LeafViewTest<G>
+{
+  using BaseType = LeafViewTest<G>;
+  using typename BaseType::D;
+  using BaseType::d;
+  using typename BaseType::E;
+  using typename BaseType::GV;
+  using typename BaseType::M;
+  using typename BaseType::V;
+  using DomainType = FieldVector<D, d>;
+
+  std::shared_ptr<XT::Grid::GridProvider<G>> make_grid() override
+  {
+    return std::make_shared<XT::Grid::GridProvider<G>>(
+        XT::Grid::make_cube_grid<G>(XT::Common::from_string<FieldVector<double, d>>("[0 0 0 0]"),
+                                    XT::Common::from_string<FieldVector<double, d>>("[3 1 1 1]"),
+                                    XT::Common::from_string<std::array<unsigned int, d>>("[3 2 2 2]")));
+  }
+
+  template <class SpaceType>
+  void coincides_with_matrix_operator(const SpaceType& space)
+  {
+    const auto grid_view = this->grid_view();
+    const XT::Functions::GenericGridFunction<E, 1> weight(
+        2, [](const E&) {}, [](const DomainType& x, const XT::Common::Parameter&) { return 1. + x[0] * x[0]; });
+    const XT::Functions::GenericGridFunction<E, d, d> diffusion(
+        1, [](const E&) {}, [](const DomainType& x, const XT::Common::Parameter&) {
+          auto ret = XT::LA::eye_matrix<FieldMatrix<double, d, d>>(d, d);
+          ret *= 2. + x[0];
+          ret[0][d - 1] += 0.5;
+          return ret;
+        });
+    auto matrix_operator = make_matrix_operator<M>(grid_view, space, space, Stencil::element);
+    matrix_operator.append(LocalElementIntegralBilinearForm<E>(LocalLaplaceIntegrand<E>(diffusion)));
+    matrix_operator.append(LocalElementIntegralBilinearForm<E>(LocalElementProductIntegrand<E>(weight)));
+    matrix_operator.assemble(/*use_tbb=*/true);
+    LocalizableOperator<M, GV> localizable_operator(grid_view, space, space);
+    localizable_operator.append(LocalSumFactorizedLaplaceOperator<V, GV>(diffusion));
+    localizable_operator.append(LocalSumFactorizedProductOperator<V, GV>(weight));
+    V source(space.mapper().size());
+    for (size_t ii = 0; ii < source.size(); ++ii)
+      source[ii] = std::sin(1. + ii);
+    V expected(space.mapper().size());
+    V actual(space.mapper().size());
+    matrix_operator.apply(source, expected);
+    localizable_operator.apply(source, actual);
+    for (size_t ii = 0; ii < expected.size(); ++ii)
+      EXPECT_NEAR(expected[ii], actual[ii], 1e-12 * std::max(1., std::abs(expected[ii])));
+  } // ... coincides_with_matrix_operator(...)
+
+  void coincides_with_matrix_operator_for_discontinuous_spaces()
+  {
+    for (int order : {0, 1, 2, 3})
+      coincides_with_matrix_operator(make_discontinuous_lagrange_space(this->grid_view(), order));
+  }
+
+  void coincides_with_matrix_operator_for_continuous_spaces()
+  {
+    for (int order : {1, 2})
+      coincides_with_matrix_operator(make_continuous_lagrange_space(this->grid_view(), order));
+  }
+}; // struct SumFactorizedOperatorTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_OPERATORS_SUM_FACTORIZED_HH
@@ -0,0 +1,127 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_SPACES_BASIS_TABULATION_HH
+#define DUNE_GDT_TEST_SPACES_BASIS_TABULATION_HH
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dune/geometry/quadraturerules.hh>
+
+#include <dune/xt/common/string.hh>
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/test/leaf-view-test.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks that the values and jacobians of the bases of discontinuous Lagrange spaces, which are tabulated once per
+ * geometry type and quadrature and shared by all localized bases, coincide with evaluating the basis in each point.
+ * Besides element quadratures, the face quadratures of all intersections are mapped into the element: these have the
+ * same order and size, but different points.
+ */
+template <class G>
+struct BasisTabulationTest : public LeafViewTest<G>
+{
+  using BaseType = LeafViewTest<G>;
+  using BaseType::d;
+  using typename BaseType::D;
+
+  /// Returns the number of mismatches instead of failing directly, to be usable in several threads.
+  template <class LocalBasisType>
+  static size_t count_mismatches(const LocalBasisType& basis, const QuadratureRule<D, d>& quadrature)
+  {
+    size_t mismatches = 0;
+    const auto& values = basis.evaluate_at_quadrature(quadrature);
+    const auto& jacobians = basis.jacobians_at_quadrature(quadrature);
+    if (values.size() != quadrature.size() || jacobians.size() != quadrature.size())
+      return 1;
+    std::vector<typename LocalBasisType::RangeType> expected_values;
+    std::vector<typename LocalBasisType::DerivativeRangeType> expected_jacobians;
+    for (size_t qq = 0; qq < quadrature.size(); ++qq) {
+      basis.evaluate(quadrature[qq].position(), expected_values);
+      basis.jacobians(quadrature[qq].position(), expected_jacobians);
+      if (values[qq].size() < basis.size() || jacobians[qq].size() < basis.size())
+        return 1;
+      for (size_t ii = 0; ii < basis.size(); ++ii) {
+        auto value_difference = values[qq][ii];
+        value_difference -= expected_values[ii];
+        if (value_difference.infinity_norm() > 1e-13 * std::max(1., expected_values[ii].infinity_norm()))
+          ++mismatches;
+        auto jacobian_difference = jacobians[qq][ii];
+        jacobian_difference -= expected_jacobians[ii];
+        if (jacobian_difference.infinity_norm() > 1e-13 * std::max(1., expected_jacobians[ii].infinity_norm()))
+          ++mismatches;
+      }
+    }
+    return mismatches;
+  } // ... count_mismatches(...)
+
+  template <class SpaceType>
+  static size_t count_mismatches(const SpaceType& space)
+  {
+    size_t mismatches = 0;
+    auto basis = space.basis().localize();
+    for (auto&& element : elements(space.grid_view())) {
+      basis->bind(element);
+      for (int order = 0; order <= 2 * space.max_polorder(); ++order)
+        mismatches += count_mismatches(*basis, QuadratureRules<D, d>::rule(element.geometry().type(), order));
+      for (auto&& intersection : intersections(space.grid_view(), element)) {
+        const auto face_geometry = intersection.geometryInInside();
+        QuadratureRule<D, d> face_quadrature;
+        for (const auto& quadrature_point :
+             QuadratureRules<D, d - 1>::rule(intersection.geometry().type(), 2 * space.max_polorder()))
+          face_quadrature.push_back(
+              QuadraturePoint<D, d>(face_geometry.global(quadrature_point.position()), quadrature_point.weight()));
+        mismatches += count_mismatches(*basis, face_quadrature);
+      }
+    }
+    return mismatches;
+  } // ... count_mismatches(...)
+
+  template <class SpaceType>
+  static void check_tabulation(const SpaceType& space, const std::string& msg)
+  {
+    EXPECT_EQ(size_t(0), count_mismatches(space)) << msg;
+    // the localized bases of all threads share the tabulations of the global basis
+    std::vector<size_t> mismatches(4, 0);
+    std::vector<std::thread> threads;
+    for (size_t tt = 0; tt < mismatches.size(); ++tt)
+      threads.emplace_back([&, tt]() { mismatches[tt] = count_mismatches(space); });
+    for (auto& thread : threads)
+      thread.join();
+    for (size_t tt = 0; tt < mismatches.size(); ++tt)
+      EXPECT_EQ(size_t(0), mismatches[tt]) << msg << ", thread " << tt;
+  } // ... check_tabulation(...)
+
+  void tabulated_values_coincide_with_pointwise_evaluation()
+  {
+    const auto grid_view = this->grid_view();
+    for (int order : {0, 1, 2}) {
+      check_tabulation(make_discontinuous_lagrange_space(grid_view, order),
+                       "scalar, order " + XT::Common::to_string(order));
+      check_tabulation(make_discontinuous_lagrange_space<d>(grid_view, order),
+                       "vector valued, order " + XT::Common::to_string(order));
+    }
+  } // ... tabulated_values_coincide_with_pointwise_evaluation(...)
+}; // struct BasisTabulationTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_SPACES_BASIS_TABULATION_HH
@@ -0,0 +1,154 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_SPACES_DOF_HALO_EXCHANGE_HH
+#define DUNE_GDT_TEST_SPACES_DOF_HALO_EXCHANGE_HH
+
+#include <cmath>
+#include <cstdint>
+
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/xt/la/container/istl.hh>
+
+#include <dune/gdt/discretefunction/default.hh>
+#include <dune/gdt/exceptions.hh>
+#include <dune/gdt/spaces/h1/continuous-lagrange.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/spaces/parallel/halo.hh>
+#include <dune/gdt/spaces/parallel/helper.hh>
+#include <dune/gdt/test/leaf-view-test.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks that communicating a vector via the DofHaloExchange of a space coincides with communicating a
+ * DiscreteFunctionDataHandle, and that the ghost DoFs and the disjoint DoF partitioning of the GenericParallelHelper
+ * coincide with the ones obtained by communicating a GhostDataHandle and a DisjointPartitioningDataHandle. Meant to be
+ * run with several MPI ranks (see the CMakeLists.txt), where it checks that DoFs are actually exchanged.
+ */
+template <class G>
+struct DofHaloExchangeTest : public LeafViewTest<G>
+{
+  using BaseType = LeafViewTest<G>;
+  using typename BaseType::GV;
+  using typename BaseType::V;
+
+  template <class SpaceType>
+  static V make_rank_dependent_vector(const SpaceType& space)
+  {
+    V vector(space.mapper().size());
+    const auto rank = space.grid_view().comm().rank();
+    for (size_t ii = 0; ii < vector.size(); ++ii)
+      vector[ii] = std::sin(1. + ii) + rank;
+    return vector;
+  }
+
+  /// The DoFs each rank obtains from its neighbours via a DiscreteFunctionDataHandle.
+  template <class SpaceType>
+  static V communicate_via_data_handle(const SpaceType& space)
+  {
+    auto expected = make_discrete_function(space, make_rank_dependent_vector(space));
+    DiscreteFunctionDataHandle<decltype(expected)> handle(expected);
+    space.grid_view().communicate(handle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+    return expected.dofs().vector();
+  }
+
+  void communicate_coincides_with_data_handle()
+  {
+    const auto space = make_discontinuous_lagrange_space(this->grid_view(), 1);
+    const auto expected = communicate_via_data_handle(space);
+    const auto initial = make_rank_dependent_vector(space);
+    auto actual = initial;
+    // twice, to check that the persistent requests may be reused
+    space.dof_halo_exchange().communicate(actual);
+    space.dof_halo_exchange().communicate(actual);
+    size_t num_received = 0;
+    for (size_t ii = 0; ii < actual.size(); ++ii) {
+      EXPECT_EQ(expected[ii], actual[ii]);
+      if (actual[ii] != initial[ii])
+        ++num_received;
+    }
+    if (space.grid_view().comm().size() > 1) {
+      EXPECT_TRUE(space.dof_halo_exchange().required());
+      EXPECT_FALSE(space.dof_halo_plan().receive_ranks().empty());
+      EXPECT_GT(num_received, size_t(0));
+    }
+  } // ... communicate_coincides_with_data_handle(...)
+
+  /// Several exchanges (of one plan) in flight at the same time must not receive each other's messages.
+  void simultaneous_exchanges_do_not_interfere()
+  {
+    const auto space = make_discontinuous_lagrange_space(this->grid_view(), 1);
+    const auto expected = communicate_via_data_handle(space);
+    const auto initial = make_rank_dependent_vector(space);
+    auto first = initial;
+    V second(initial.size());
+    for (size_t ii = 0; ii < second.size(); ++ii)
+      second[ii] = -initial[ii];
+    DofHaloExchange<GV, double> other_exchange(space.dof_halo_plan());
+    space.dof_halo_exchange().begin(first);
+    other_exchange.begin(second);
+    other_exchange.finish(second);
+    space.dof_halo_exchange().finish(first);
+    for (size_t ii = 0; ii < first.size(); ++ii) {
+      EXPECT_EQ(expected[ii], first[ii]);
+      EXPECT_EQ(-expected[ii], second[ii]);
+    }
+  } // ... simultaneous_exchanges_do_not_interfere(...)
+
+  void begin_throws_while_pending()
+  {
+    const auto space = make_discontinuous_lagrange_space(this->grid_view(), 1);
+    auto vector = make_rank_dependent_vector(space);
+    auto& exchange = space.dof_halo_exchange();
+    EXPECT_THROW(exchange.finish(vector), Exceptions::space_error);
+    exchange.begin(vector);
+    EXPECT_TRUE(exchange.in_flight());
+    EXPECT_THROW(exchange.begin(vector), Exceptions::space_error);
+    exchange.finish(vector);
+    EXPECT_FALSE(exchange.in_flight());
+  } // ... begin_throws_while_pending(...)
+
+  template <class GV, size_t r, size_t rC, class R>
+  static void check_parallel_helper(const SpaceInterface<GV, r, rC, R>& space)
+  {
+    const auto& grid_view = space.grid_view();
+    XT::LA::IstlDenseVector<int> expected_rank_vector(space.mapper().size(), grid_view.comm().rank());
+    XT::LA::IstlDenseVector<uint_fast8_t> expected_ghosts(space.mapper().size(), false);
+    if (grid_view.comm().size() > 1) {
+      GhostDataHandle<GV, r, rC, R, XT::LA::IstlDenseVector<uint_fast8_t>> ghost_handle(space, expected_ghosts, false);
+      grid_view.communicate(ghost_handle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+      DisjointPartitioningDataHandle<GV, r, rC, R, XT::LA::IstlDenseVector<int>> partitioning_handle(
+          space, expected_rank_vector);
+      grid_view.communicate(partitioning_handle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+    }
+    const GenericParallelHelper<GV, r, rC, R> helper(space);
+    for (size_t ii = 0; ii < space.mapper().size(); ++ii) {
+      EXPECT_EQ(int(expected_ghosts[ii]), int(helper.ghosts()[ii])) << "ii = " << ii;
+      EXPECT_EQ(expected_rank_vector[ii], helper.rank_vector()[ii]) << "ii = " << ii;
+    }
+  } // ... check_parallel_helper(...)
+
+  void parallel_helper_coincides_with_data_handles()
+  {
+    const auto grid_view = this->grid_view();
+    check_parallel_helper(make_discontinuous_lagrange_space(grid_view, 1));
+    check_parallel_helper(make_continuous_lagrange_space(grid_view, 1));
+    check_parallel_helper(make_continuous_lagrange_space(grid_view, 2));
+  } // ... parallel_helper_coincides_with_data_handles(...)
+}; // struct DofHaloExchangeTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_SPACES_DOF_HALO_EXCHANGE_HH
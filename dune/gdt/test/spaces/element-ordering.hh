@@ -0,0 +1,112 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TEST_SPACES_ELEMENT_ORDERING_HH
+#define DUNE_GDT_TEST_SPACES_ELEMENT_ORDERING_HH
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <dune/xt/common/parallel/threadmanager.hh>
+#include <dune/xt/test/gtest/gtest.h>
+
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/local/numerical-fluxes/lax-friedrichs.hh>
+#include <dune/gdt/operators/advection-dg.hh>
+#include <dune/gdt/spaces/h1/continuous-lagrange.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/test/leaf-view-test.hh>
+
+namespace Dune {
+namespace GDT {
+namespace Test {
+
+
+/**
+ * Checks that the mappers of renumbered spaces are bijective and that applying an operator commutes with the
+ * renumbering, both for the parallel walk in grid order and the sequential walk in DoF order.
+ */
+template <class G>
+struct ElementOrderingTest : public LeafViewTest<G>
+{
+  using BaseType = LeafViewTest<G>;
+  using BaseType::d;
+  using typename BaseType::I;
+  using typename BaseType::M;
+  using typename BaseType::V;
+
+  template <class SpaceType>
+  static void check_bijective(const SpaceType& space)
+  {
+    std::vector<bool> visited(space.mapper().size(), false);
+    for (auto&& element : elements(space.grid_view()))
+      for (const auto& index : space.mapper().global_indices(element)) {
+        ASSERT_LT(index, visited.size());
+        visited[index] = true;
+      }
+    EXPECT_TRUE(std::all_of(visited.begin(), visited.end(), [](const bool value) { return value; }));
+    if (space.mapper().element_order().size() > 0)
+      EXPECT_EQ(size_t(space.grid_view().size(0)), space.mapper().element_order().size());
+  } // ... check_bijective(...)
+
+  void renumbering_commutes_with_apply()
+  {
+    const auto grid_view = this->grid_view();
+    const XT::Functions::GenericFunction<1, d, 1> flux(
+        2,
+        [](const auto& u, const auto& /*param*/) {
+          FieldVector<double, d> ret(0.5 * u[0] * u[0]);
+          return ret;
+        },
+        "burgers");
+    const NumericalLaxFriedrichsFlux<I, d, 1> numerical_flux(flux, /*lambda=*/1.);
+    const auto reference_space = make_discontinuous_lagrange_space(grid_view, 1);
+    auto reference_op = make_advection_dg_operator<M>(grid_view, numerical_flux, reference_space, reference_space);
+    V reference_source(reference_space.mapper().size());
+    for (size_t ii = 0; ii < reference_source.size(); ++ii)
+      reference_source[ii] = 1. + 0.5 * std::sin(1. + ii);
+    V reference_range(reference_space.mapper().size());
+    reference_op.apply(reference_source, reference_range);
+    const auto max_threads = XT::Common::threadManager().max_threads();
+    for (auto ordering : {ElementOrdering::space_filling_curve, ElementOrdering::reverse_cuthill_mckee}) {
+      check_bijective(make_continuous_lagrange_space(grid_view, 2, ordering));
+      const auto space = make_discontinuous_lagrange_space(grid_view, 1, ordering);
+      check_bijective(space);
+      auto op = make_advection_dg_operator<M>(grid_view, numerical_flux, space, space);
+      V source(space.mapper().size());
+      for (auto&& element : elements(grid_view)) {
+        const auto indices = space.mapper().global_indices(element);
+        const auto reference_indices = reference_space.mapper().global_indices(element);
+        for (size_t ii = 0; ii < indices.size(); ++ii)
+          source[indices[ii]] = reference_source[reference_indices[ii]];
+      }
+      for (size_t num_threads : {size_t(1), std::max(max_threads, size_t(2))}) {
+        XT::Common::threadManager().set_max_threads(num_threads);
+        V range(space.mapper().size());
+        op.apply(source, range);
+        for (auto&& element : elements(grid_view)) {
+          const auto indices = space.mapper().global_indices(element);
+          const auto reference_indices = reference_space.mapper().global_indices(element);
+          for (size_t ii = 0; ii < indices.size(); ++ii)
+            EXPECT_NEAR(reference_range[reference_indices[ii]],
+                        range[indices[ii]],
+                        1e-13 * std::max(1., std::abs(reference_range[reference_indices[ii]])));
+        }
+      }
+      XT::Common::threadManager().set_max_threads(max_threads);
+    }
+  } // ... renumbering_commutes_with_apply(...)
+}; // struct ElementOrderingTest
+
+
+} // namespace Test
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TEST_SPACES_ELEMENT_ORDERING_HH
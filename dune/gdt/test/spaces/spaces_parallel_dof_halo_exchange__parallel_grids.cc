@@ -0,0 +1,36 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <dune/xt/grid/grids.hh>
+
+#include "dof-halo-exchange.hh"
+
+
+using ParallelGrids = ::testing::Types<YASP_2D_EQUIDISTANT_OFFSET, YASP_3D_EQUIDISTANT_OFFSET>;
+
+
+template <class G>
+using DofHaloExchangeTest = Dune::GDT::Test::DofHaloExchangeTest<G>;
+TYPED_TEST_CASE(DofHaloExchangeTest, ParallelGrids);
+TYPED_TEST(DofHaloExchangeTest, communicate_coincides_with_data_handle)
+{
+  this->communicate_coincides_with_data_handle();
+}
+TYPED_TEST(DofHaloExchangeTest, simultaneous_exchanges_do_not_interfere)
+{
+  this->simultaneous_exchanges_do_not_interfere();
+}
+TYPED_TEST(DofHaloExchangeTest, begin_throws_while_pending)
+{
+  this->begin_throws_while_pending();
+}
+TYPED_TEST(DofHaloExchangeTest, parallel_helper_coincides_with_data_handles)
+{
+  this->parallel_helper_coincides_with_data_handles();
+}
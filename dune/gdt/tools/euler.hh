@@ -13,9 +13,12 @@
 #define DUNE_GDT_TOOLS_EULER_HH
 
 #include <cmath>
+#include <tuple>
+#include <vector>
 
 #include <dune/xt/common/fvector.hh>
 #include <dune/xt/common/fmatrix.hh>
+#include <dune/xt/common/parameter.hh>
 #include <dune/xt/la/container/vector-interface.hh>
 #include <dune/xt/grid/type_traits.hh>
 #include <dune/xt/functions/interfaces/grid-function.hh>
@@ -463,6 +466,24 @@ public:
     return eigenvectors_inv;
   } // ... eigenvectors_inv_flux_jacobian(...)
 
+  /**
+   * \brief Returns the above eigendecomposition as a function object, to be used as flux_eigen_decomposition in
+   *        NumericalVijayasundaramFlux (instead of the numerical eigen solver).
+   */
+  auto flux_eigen_decomposition() const
+  {
+    const auto self = *this;
+    return [self](const auto& /*local_flux*/,
+                  const FieldVector<R, m>& w,
+                  const FieldVector<double, d>& n,
+                  const XT::Common::Parameter& /*param*/) {
+      const auto eigenvalues = self.eigenvalues_flux_jacobian(w, n);
+      return std::make_tuple(std::vector<R>(eigenvalues.begin(), eigenvalues.end()),
+                             self.eigenvectors_flux_jacobian(w, n),
+                             self.eigenvectors_inv_flux_jacobian(w, n));
+    };
+  } // ... flux_eigen_decomposition(...)
+
   /// \}
 
   template <class E, class GL>
@@ -23,12 +23,20 @@
 #include <dune/xt/functions/interfaces/grid-function.hh>
 #include <dune/xt/functions/interfaces/function.hh>
 
+#include <dune/gdt/tools/wave-speeds.hh>
+
 namespace Dune {
 namespace GDT {
 
 
 /**
  * \brief Estimates dt via [Cockburn, Coquel, LeFloch, 1995]
+ *
+ * The data range and the geometry are reduced over all ranks, so all ranks obtain the same dt.
+ *
+ * \note This requires two additional grid walks. To estimate dt during the time stepping, use
+ *       AdvectionFvOperator::collect_wave_speeds and AdvectionFvOperator::estimate_dt instead (see
+ *       WaveSpeedAccumulator).
  */
 template <class GV,
           size_t m_as_size_t,
@@ -60,6 +68,8 @@ double estimate_dt_for_hyperbolic_system(
       }
     }
   }
+  grid_view.comm().min(&(data_minimum[0]), int(m));
+  grid_view.comm().max(&(data_maximum[0]), int(m));
   // ensure distinct minima/maxima (otherwise the grid creation below will fail)
   for (size_t ii = 0; ii < m; ++ii)
     if (!(data_minimum[ii] < data_maximum[ii]))
@@ -81,6 +91,7 @@ double estimate_dt_for_hyperbolic_system(
       perimeter += intersection.geometry().volume();
     perimeter_over_volume = std::max(perimeter_over_volume, perimeter / element.geometry().volume());
   }
+  perimeter_over_volume = grid_view.comm().max(perimeter_over_volume);
   const auto dt = 1. / (perimeter_over_volume * max_flux_derivative);
   return dt;
 } // ... estimate_dt_for_hyperbolic_system(...)
@@ -10,9 +10,15 @@
 #ifndef DUNE_GDT_TOOLS_local_mass_matrices_HH
 #define DUNE_GDT_TOOLS_local_mass_matrices_HH
 
-#include <mutex>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <utility>
 #include <vector>
 
+#include <dune/geometry/referenceelements.hh>
+#include <dune/geometry/type.hh>
+
 #include <dune/xt/common/parallel/threadstorage.hh>
 #include <dune/xt/la/container/common.hh>
 #include <dune/xt/la/container/conversion.hh>
@@ -30,29 +36,160 @@ namespace Dune {
 namespace GDT {
 
 
+/**
+ * \brief A local mass matrix (or its inverse) as provided by LocalMassMatrixProvider, i.e. factor * M, where M is a
+ *        stored square matrix (in row-major order) or the identity (if data is a nullptr).
+ */
+template <class F>
+class LocalMassMatrixView
+{
+public:
+  LocalMassMatrixView(const F* data, const size_t size, const F& factor)
+    : data_(data)
+    , size_(size)
+    , factor_(factor)
+  {}
+
+  size_t rows() const
+  {
+    return size_;
+  }
+
+  size_t cols() const
+  {
+    return size_;
+  }
+
+  /// \brief True if M is the identity, i.e. if no matrix is stored.
+  bool is_scaled_identity() const
+  {
+    return data_ == nullptr;
+  }
+
+  F get_entry(const size_t ii, const size_t jj) const
+  {
+    if (data_)
+      return factor_ * data_[ii * size_ + jj];
+    return ii == jj ? factor_ : F(0);
+  }
+
+  /// \brief Returns (*this) * vector, VectorType has to be copyable and provide operator[] (e.g., DynamicVector).
+  template <class VectorType>
+  VectorType operator*(const VectorType& vector) const
+  {
+    VectorType ret(vector);
+    if (!data_) {
+      for (size_t ii = 0; ii < size_; ++ii)
+        ret[ii] *= factor_;
+      return ret;
+    }
+    for (size_t ii = 0; ii < size_; ++ii) {
+      const F* row = data_ + ii * size_;
+      F sum(0);
+      for (size_t jj = 0; jj < size_; ++jj)
+        sum += row[jj] * vector[jj];
+      ret[ii] = factor_ * sum;
+    }
+    return ret;
+  } // ... operator*(...)
+
+  XT::LA::CommonDenseMatrix<F> matrix() const
+  {
+    XT::LA::CommonDenseMatrix<F> ret(size_, size_, 0.);
+    for (size_t ii = 0; ii < size_; ++ii)
+      for (size_t jj = 0; jj < size_; ++jj)
+        ret.set_entry(ii, jj, get_entry(ii, jj));
+    return ret;
+  }
+
+private:
+  const F* data_;
+  size_t size_;
+  F factor_;
+}; // class LocalMassMatrixView
+
+
+namespace internal {
+
+
+/// \brief The thread-local results of LocalMassMatrixProvider, merged after the grid walk.
+template <class F>
+struct LocalMassMatrixData
+{
+  using KeyType = std::pair<GeometryType, size_t>;
+
+  struct ElementRecord
+  {
+    size_t element_index;
+    KeyType key;
+    // |det J| for affine elements (which use the reference matrices of key), 1 otherwise
+    F scaling;
+    // mass matrix and its inverse (row-major, one after the other) for non-affine elements, empty otherwise
+    std::vector<F> data;
+  };
+
+  std::vector<ElementRecord> elements;
+  // mass matrices (and their inverses) of the reference element, empty if the identity
+  std::map<KeyType, std::vector<F>> references;
+}; // struct LocalMassMatrixData
+
+
+template <class F>
+struct merge_local_mass_matrix_data
+{
+  LocalMassMatrixData<F> operator()(const LocalMassMatrixData<F>& a, const LocalMassMatrixData<F>& b)
+  {
+    LocalMassMatrixData<F> result = a;
+    result.elements.insert(result.elements.end(), b.elements.begin(), b.elements.end());
+    result.references.insert(b.references.begin(), b.references.end());
+    return result;
+  }
+};
+
+
+} // namespace internal
+
+
+/**
+ * \brief Assembles the local mass matrices (and their inverses) of all elements in a grid walk.
+ *
+ * All matrices are stored contiguously in one array and addressed by the element index. For affine elements (and
+ * spaces with a basis given by the pullback of a reference basis), the local mass matrix is |det J| times the mass
+ * matrix on the reference element, so only the latter (and its inverse) is stored once per geometry type and scaled on
+ * the fly. If the reference mass matrix is the identity (as for orthonormal bases, see
+ * local/finite-elements/orthonormal.hh), nothing is stored at all.
+ *
+ * \note The reference matrices are identified by the geometry type and the size of the local basis, which presumes
+ *       that the space uses one local finite element per geometry type and size (true for the Lagrange and finite
+ *       volume spaces, for which the compression is enabled).
+ *
+ * \note local_mass_matrix() and local_mass_matrix_inverse() return light-weight views into the storage, which are only
+ *       valid as long as the provider exists and is not walked again.
+ */
 template <class GV, size_t r = 1, size_t rC = 1, class F = double, class AGV = GV>
 class LocalMassMatrixProvider
   : public XT::Grid::ElementFunctor<GV>
-  , public XT::Common::ThreadResultPropagator<
-        LocalMassMatrixProvider<GV, r, rC, F>,
-        std::map<size_t, std::pair<XT::LA::CommonDenseMatrix<F>, XT::LA::CommonDenseMatrix<F>>>,
-        XT::Common::concatenate_container<
-            std::map<size_t, std::pair<XT::LA::CommonDenseMatrix<F>, XT::LA::CommonDenseMatrix<F>>>>>
+  , public XT::Common::ThreadResultPropagator<LocalMassMatrixProvider<GV, r, rC, F>,
+                                              internal::LocalMassMatrixData<F>,
+                                              internal::merge_local_mass_matrix_data<F>>
 {
   static_assert(XT::Grid::is_view<AGV>::value, "");
 
   using ThisType = LocalMassMatrixProvider;
   using BaseType = XT::Grid::ElementFunctor<GV>;
-  using Propagator = XT::Common::ThreadResultPropagator<
-      LocalMassMatrixProvider<GV, r, rC, F>,
-      std::map<size_t, std::pair<XT::LA::CommonDenseMatrix<F>, XT::LA::CommonDenseMatrix<F>>>,
-      XT::Common::concatenate_container<
-          std::map<size_t, std::pair<XT::LA::CommonDenseMatrix<F>, XT::LA::CommonDenseMatrix<F>>>>>;
+  using DataType = internal::LocalMassMatrixData<F>;
+  using Propagator =
+      XT::Common::ThreadResultPropagator<ThisType, DataType, internal::merge_local_mass_matrix_data<F>>;
   friend Propagator;
 
+  using D = typename GV::ctype;
+  static const constexpr size_t d = GV::dimension;
+  static const constexpr size_t identity = std::numeric_limits<size_t>::max();
+
 public:
   using AssemblyGridView = AGV;
   using SpaceType = SpaceInterface<GV, r, rC, F>;
+  using LocalMatrixType = LocalMassMatrixView<F>;
   using typename BaseType::E;
   using typename BaseType::ElementType;
 
@@ -64,6 +201,9 @@ public:
     , element_mapper_(grid_view_)
     , instance_counter_(0)
     , local_basis_(space_->basis().localize())
+    , compress_affine_elements_(space_->type() == GDT::SpaceType::discontinuous_lagrange
+                                || space_->type() == GDT::SpaceType::finite_volume
+                                || space_->type() == GDT::SpaceType::continuous_lagrange)
   {}
 
   LocalMassMatrixProvider(const ThisType& other)
@@ -74,18 +214,30 @@ public:
     , element_mapper_(grid_view_)
     , instance_counter_(other.instance_counter_ + 1)
     , local_basis_(space_->basis().localize())
+    , compress_affine_elements_(other.compress_affine_elements_)
   {}
 
   void apply_local(const ElementType& element) override
   {
+    const auto& geometry = element.geometry();
     local_basis_->bind(element);
-    const size_t id = element_mapper_.global_index(element, 0);
-    const LocalElementIntegralBilinearForm<E, r, rC, F, F> local_l2_bilinear_form(
-        LocalElementProductIntegrand<E, r, F, F>(1.));
-    auto matrix =
-        XT::LA::convert_to<XT::LA::CommonDenseMatrix<F>>(local_l2_bilinear_form.apply2(*local_basis_, *local_basis_));
-    auto inverse = XT::LA::invert_matrix(matrix);
-    local_mass_matrices_.insert(std::make_pair(id, std::make_pair(std::move(matrix), std::move(inverse))));
+    const size_t size = local_basis_->size();
+    typename DataType::ElementRecord record{element_mapper_.global_index(element, 0),
+                                            std::make_pair(geometry.type(), size),
+                                            F(1),
+                                            std::vector<F>()};
+    const bool affine = compress_affine_elements_ && geometry.affine();
+    if (affine) {
+      // the integration element is constant for affine geometries
+      const auto& reference_element = ReferenceElements<D, d>::general(geometry.type());
+      record.scaling = geometry.integrationElement(reference_element.position(0, 0));
+      // the first affine element of each kind (in this thread) provides the reference matrices
+      if (data_.references.count(record.key) == 0)
+        data_.references.emplace(record.key, reference_data(assemble_local_mass_matrix(), record.scaling));
+    } else {
+      record.data = to_data(assemble_local_mass_matrix());
+    }
+    data_.elements.emplace_back(std::move(record));
   } // ... apply_local(...)
 
   BaseType* copy() override final
@@ -96,47 +248,128 @@ public:
   void finalize() override final
   {
     this->finalize_imp();
+    // only the original instance holds the merged results of all threads
+    if (instance_counter_ == 0)
+      build_storage();
   }
 
   /**
    * \note This is only used to merge the thread-local results after the grid walk, you are probably interested in
    *       local_mass_matrix() and local_mass_matrix_inverse().
    */
-  std::map<size_t, std::pair<XT::LA::CommonDenseMatrix<F>, XT::LA::CommonDenseMatrix<F>>> result() const
+  DataType result() const
   {
-    return local_mass_matrices_;
+    return data_;
   }
 
-  void set_result(std::map<size_t, std::pair<XT::LA::CommonDenseMatrix<F>, XT::LA::CommonDenseMatrix<F>>> res)
+  void set_result(DataType res)
   {
-    local_mass_matrices_ = res;
+    data_ = std::move(res);
   }
 
-  const XT::LA::CommonDenseMatrix<F>& local_mass_matrix(const ElementType& element) const
+  LocalMatrixType local_mass_matrix(const ElementType& element) const
   {
-    const size_t id = element_mapper_.global_index(element, 0);
-    DUNE_THROW_IF(local_mass_matrices_.count(id) == 0,
-                  XT::Common::Exceptions::this_should_not_happen,
-                  "Missing local mass matrix for id " << id << "!");
-    return local_mass_matrices_.at(id).first;
+    const size_t id = checked_index(element);
+    const size_t size = sizes_[id];
+    return LocalMatrixType(offsets_[id] == identity ? nullptr : storage_.data() + offsets_[id], size, scalings_[id]);
+  }
+
+  LocalMatrixType local_mass_matrix_inverse(const ElementType& element) const
+  {
+    const size_t id = checked_index(element);
+    const size_t size = sizes_[id];
+    return LocalMatrixType(offsets_[id] == identity ? nullptr : storage_.data() + offsets_[id] + size * size,
+                           size,
+                           F(1) / scalings_[id]);
+  }
+
+private:
+  XT::LA::CommonDenseMatrix<F> assemble_local_mass_matrix() const
+  {
+    const LocalElementIntegralBilinearForm<E, r, rC, F, F> local_l2_bilinear_form(
+        LocalElementProductIntegrand<E, r, F, F>(1.));
+    return XT::LA::convert_to<XT::LA::CommonDenseMatrix<F>>(
+        local_l2_bilinear_form.apply2(*local_basis_, *local_basis_));
   }
 
-  const XT::LA::CommonDenseMatrix<F>& local_mass_matrix_inverse(const ElementType& element) const
+  /// \brief The matrix and its inverse (row-major, one after the other).
+  static std::vector<F> to_data(const XT::LA::CommonDenseMatrix<F>& matrix)
+  {
+    const size_t size = matrix.rows();
+    const auto inverse = XT::LA::invert_matrix(matrix);
+    std::vector<F> data(2 * size * size);
+    for (size_t ii = 0; ii < size; ++ii)
+      for (size_t jj = 0; jj < size; ++jj) {
+        data[ii * size + jj] = matrix.get_entry(ii, jj);
+        data[(size + ii) * size + jj] = inverse.get_entry(ii, jj);
+      }
+    return data;
+  } // ... to_data(...)
+
+  /// \brief The data of the reference mass matrix matrix / scaling, empty if this is the identity.
+  static std::vector<F> reference_data(XT::LA::CommonDenseMatrix<F> matrix, const F& scaling)
+  {
+    const size_t size = matrix.rows();
+    matrix *= F(1) / scaling;
+    bool is_identity = true;
+    for (size_t ii = 0; ii < size && is_identity; ++ii)
+      for (size_t jj = 0; jj < size && is_identity; ++jj)
+        is_identity = std::abs(matrix.get_entry(ii, jj) - (ii == jj ? F(1) : F(0))) < 1e-12;
+    return is_identity ? std::vector<F>() : to_data(matrix);
+  }
+
+  /// \brief Moves the merged thread-local results into the contiguous storage.
+  void build_storage()
+  {
+    const size_t num_elements = element_mapper_.size();
+    offsets_.assign(num_elements, size_t(identity));
+    sizes_.assign(num_elements, 0);
+    scalings_.assign(num_elements, F(1));
+    size_t storage_size = 0;
+    for (const auto& key_and_data : data_.references)
+      storage_size += key_and_data.second.size();
+    for (const auto& record : data_.elements)
+      storage_size += record.data.size();
+    storage_.clear();
+    storage_.reserve(storage_size);
+    std::map<typename DataType::KeyType, size_t> reference_offsets;
+    for (const auto& key_and_data : data_.references) {
+      reference_offsets[key_and_data.first] = key_and_data.second.empty() ? size_t(identity) : storage_.size();
+      storage_.insert(storage_.end(), key_and_data.second.begin(), key_and_data.second.end());
+    }
+    for (const auto& record : data_.elements) {
+      sizes_[record.element_index] = record.key.second;
+      scalings_[record.element_index] = record.scaling;
+      if (record.data.empty()) {
+        offsets_[record.element_index] = reference_offsets.at(record.key);
+      } else {
+        offsets_[record.element_index] = storage_.size();
+        storage_.insert(storage_.end(), record.data.begin(), record.data.end());
+      }
+    }
+    data_ = DataType();
+  } // ... build_storage(...)
+
+  size_t checked_index(const ElementType& element) const
   {
     const size_t id = element_mapper_.global_index(element, 0);
-    DUNE_THROW_IF(local_mass_matrices_.count(id) == 0,
+    DUNE_THROW_IF(id >= sizes_.size() || sizes_[id] == 0,
                   XT::Common::Exceptions::this_should_not_happen,
                   "Missing local mass matrix for id " << id << "!");
-    return local_mass_matrices_.at(id).second;
+    return id;
   }
 
-private:
   const AssemblyGridView grid_view_;
   std::unique_ptr<const SpaceType> space_;
   const FiniteVolumeMapper<GV> element_mapper_;
   size_t instance_counter_;
   std::unique_ptr<typename SpaceType::GlobalBasisType::LocalizedType> local_basis_;
-  std::map<size_t, std::pair<XT::LA::CommonDenseMatrix<F>, XT::LA::CommonDenseMatrix<F>>> local_mass_matrices_;
+  const bool compress_affine_elements_;
+  DataType data_;
+  std::vector<F> storage_;
+  std::vector<size_t> offsets_;
+  std::vector<size_t> sizes_;
+  std::vector<F> scalings_;
 }; // class LocalMassMatrixProvider
 
 
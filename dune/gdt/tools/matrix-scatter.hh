@@ -0,0 +1,660 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TOOLS_MATRIX_SCATTER_HH
+#define DUNE_GDT_TOOLS_MATRIX_SCATTER_HH
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+#if HAVE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
+
+#include <dune/xt/common/parallel/threadmanager.hh>
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/la/container/matrix-interface.hh>
+#if HAVE_DUNE_ISTL
+#  include <dune/xt/la/container/istl.hh>
+#endif
+
+#include <dune/gdt/exceptions.hh>
+#include <dune/gdt/spaces/mapper/finite-volume.hh>
+
+namespace Dune {
+namespace GDT {
+namespace internal {
+
+
+/**
+ * \brief Adds a row segment with sorted column indices to a global matrix.
+ *
+ * This generic variant simply calls add_to_entry() for each entry, see the specializations below for backends which
+ * allow to resolve the positions of all entries of a row segment at once.
+ *
+ * If has_flat_values is true, the backend may store all values in one contiguous array (as in CSR). If flat_values()
+ * confirms this for the given matrix, locate_row() provides the offsets of the entries of a row segment in this array
+ * (see LocalMatrixOffsetMap).
+ */
+template <class M>
+class MatrixRowAccumulator
+{
+public:
+  using MatrixType = M;
+  using FieldType = typename MatrixType::ScalarType;
+
+  static const constexpr bool has_flat_values = false;
+
+  MatrixRowAccumulator(MatrixType& matrix)
+    : matrix_(matrix)
+  {}
+
+  void add_to_row(const size_t ii, const size_t* sorted_cols, const FieldType* values, const size_t size)
+  {
+    for (size_t jj = 0; jj < size; ++jj)
+      matrix_.add_to_entry(ii, sorted_cols[jj], values[jj]);
+  }
+
+  bool flat_values() const
+  {
+    return false;
+  }
+
+  size_t num_values() const
+  {
+    return 0;
+  }
+
+  size_t pattern_hash() const
+  {
+    return 0;
+  }
+
+  FieldType* values()
+  {
+    DUNE_THROW(Exceptions::assembler_error, "This matrix does not provide access to its values!");
+    return nullptr;
+  }
+
+  void locate_row(const size_t /*ii*/, const size_t* /*sorted_cols*/, const size_t /*size*/, size_t* /*offsets*/)
+  {
+    DUNE_THROW(Exceptions::assembler_error, "This matrix does not provide access to its values!");
+  }
+
+private:
+  MatrixType& matrix_;
+}; // class MatrixRowAccumulator
+
+
+#if HAVE_DUNE_ISTL
+
+
+/**
+ * \brief Locates the first column of the segment by a binary search and walks the row of the BCRSMatrix from there.
+ *
+ * The 1x1 blocks of a compressed BCRSMatrix are stored row after row in one array, which the constructor checks. Only
+ * if so, flat_values() is true and values() and locate_row() may be used.
+ *
+ * \note This bypasses the locking of IstlRowMajorSparseMatrix::add_to_entry(), the caller has to ensure that no two
+ *       threads touch the same row at the same time (and that the matrix is not modified otherwise meanwhile).
+ */
+template <class S>
+class MatrixRowAccumulator<XT::LA::IstlRowMajorSparseMatrix<S>>
+{
+public:
+  using MatrixType = XT::LA::IstlRowMajorSparseMatrix<S>;
+  using FieldType = typename MatrixType::ScalarType;
+
+  static const constexpr bool has_flat_values = true;
+
+  MatrixRowAccumulator(MatrixType& matrix)
+    : backend_(matrix.backend())
+    , values_(nullptr)
+  {
+    static_assert(sizeof(typename MatrixType::BackendType::block_type) == sizeof(FieldType), "");
+    // find the beginning of the array of all blocks and check that each row continues where the last one ended
+    FieldType* row_begin = nullptr;
+    for (size_t ii = 0; ii < backend_.N(); ++ii) {
+      auto& row = backend_[ii];
+      if (row.size() == 0)
+        continue;
+      FieldType* first = &((*row.begin())[0][0]);
+      if (!values_)
+        values_ = first;
+      else if (first != row_begin) {
+        values_ = nullptr;
+        return;
+      }
+      row_begin = first + row.size();
+    }
+  } // MatrixRowAccumulator(...)
+
+  void add_to_row(const size_t ii, const size_t* sorted_cols, const FieldType* values, const size_t size)
+  {
+    for_each_entry(ii, sorted_cols, size, [&](const size_t jj, FieldType& entry) { entry += values[jj]; });
+  }
+
+  bool flat_values() const
+  {
+    return values_ != nullptr;
+  }
+
+  size_t num_values() const
+  {
+    return flat_values() ? backend_.nonzeroes() : 0;
+  }
+
+  /// \brief Hash of the sparsity pattern (the column indices of all rows), 0 if !flat_values().
+  size_t pattern_hash() const
+  {
+    if (!flat_values())
+      return 0;
+    size_t hash = 0;
+    const auto combine = [&](const size_t value) {
+      hash ^= std::hash<size_t>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    };
+    combine(backend_.N());
+    combine(backend_.M());
+    for (size_t ii = 0; ii < backend_.N(); ++ii) {
+      const auto& row = backend_[ii];
+      combine(row.size());
+      for (auto it = row.begin(); it != row.end(); ++it)
+        combine(it.index());
+    }
+    return hash;
+  } // ... pattern_hash(...)
+
+  FieldType* values()
+  {
+    DUNE_THROW_IF(!flat_values(), Exceptions::assembler_error, "The values of this matrix are not contiguous!");
+    return values_;
+  }
+
+  void locate_row(const size_t ii, const size_t* sorted_cols, const size_t size, size_t* offsets)
+  {
+    DUNE_THROW_IF(!flat_values(), Exceptions::assembler_error, "The values of this matrix are not contiguous!");
+    for_each_entry(ii, sorted_cols, size, [&](const size_t jj, FieldType& entry) { offsets[jj] = &entry - values_; });
+  }
+
+private:
+  template <class Functor>
+  void for_each_entry(const size_t ii, const size_t* sorted_cols, const size_t size, Functor functor)
+  {
+    if (size == 0)
+      return;
+    auto& row = backend_[ii];
+    const auto row_end = row.end();
+    auto it = row.find(sorted_cols[0]);
+    for (size_t jj = 0; jj < size; ++jj) {
+      while (it != row_end && it.index() < sorted_cols[jj])
+        ++it;
+      DUNE_THROW_IF(it == row_end || it.index() != sorted_cols[jj],
+                    Exceptions::assembler_error,
+                    "entry (" << ii << ", " << sorted_cols[jj] << ") is not contained in the sparsity pattern!");
+      functor(jj, (*it)[0][0]);
+    }
+  } // ... for_each_entry(...)
+
+  typename MatrixType::BackendType& backend_;
+  FieldType* values_;
+}; // class MatrixRowAccumulator<IstlRowMajorSparseMatrix<...>>
+
+
+#endif // HAVE_DUNE_ISTL
+
+
+/**
+ * \brief Thread-local storage of local matrices, bucketed by ranges of global rows.
+ *
+ * Rows of different buckets are disjoint, so all buffers of all threads can be scattered in parallel over the buckets
+ * without two threads ever touching the same row.
+ */
+template <class F>
+class LocalMatrixScatterBuffer
+{
+  struct RowSegment
+  {
+    size_t row;
+    size_t indices_offset;
+    size_t values_offset;
+    size_t size;
+    bool flat;
+  };
+
+public:
+  LocalMatrixScatterBuffer(const size_t num_global_rows, const size_t num_buckets)
+    : num_global_rows_(num_global_rows)
+    , segments_(std::max(num_buckets, size_t(1)))
+  {}
+
+  size_t num_buckets() const
+  {
+    return segments_.size();
+  }
+
+  /// \brief Stores a row segment given by the global column indices.
+  void add(const size_t row, const std::vector<size_t>& sorted_cols, const F* values)
+  {
+    // the columns of all rows of a local matrix coincide, only store them once
+    const bool same_cols_as_last_row =
+        (last_cols_offset_ != std::numeric_limits<size_t>::max())
+        && (indices_.size() - last_cols_offset_ == sorted_cols.size())
+        && std::equal(sorted_cols.begin(), sorted_cols.end(), indices_.begin() + last_cols_offset_);
+    if (!same_cols_as_last_row) {
+      last_cols_offset_ = indices_.size();
+      indices_.insert(indices_.end(), sorted_cols.begin(), sorted_cols.end());
+    }
+    segments_[bucket(row)].push_back({row, last_cols_offset_, values_.size(), sorted_cols.size(), false});
+    values_.insert(values_.end(), values, values + sorted_cols.size());
+  } // ... add(...)
+
+  /// \brief Stores a row segment given by the offsets of its entries in the values of the global matrix.
+  void add_flat(const size_t row, const size_t* offsets, const F* values, const size_t size)
+  {
+    segments_[bucket(row)].push_back({row, indices_.size(), values_.size(), size, true});
+    indices_.insert(indices_.end(), offsets, offsets + size);
+    values_.insert(values_.end(), values, values + size);
+    last_cols_offset_ = std::numeric_limits<size_t>::max();
+  }
+
+  template <class M>
+  void scatter(const size_t bucket, MatrixRowAccumulator<M>& accumulator) const
+  {
+    F* global_values = nullptr;
+    for (const auto& segment : segments_[bucket]) {
+      const size_t* indices = indices_.data() + segment.indices_offset;
+      const F* values = values_.data() + segment.values_offset;
+      if (segment.flat) {
+        if (!global_values)
+          global_values = accumulator.values();
+        for (size_t jj = 0; jj < segment.size; ++jj)
+          global_values[indices[jj]] += values[jj];
+      } else
+        accumulator.add_to_row(segment.row, indices, values, segment.size);
+    }
+  } // ... scatter(...)
+
+  void clear()
+  {
+    for (auto& bucket_segments : segments_)
+      std::vector<RowSegment>().swap(bucket_segments);
+    std::vector<size_t>().swap(indices_);
+    std::vector<F>().swap(values_);
+    last_cols_offset_ = std::numeric_limits<size_t>::max();
+  }
+
+private:
+  size_t bucket(const size_t row) const
+  {
+    return std::min(row * segments_.size() / std::max(num_global_rows_, size_t(1)), segments_.size() - 1);
+  }
+
+  const size_t num_global_rows_;
+  std::vector<std::vector<RowSegment>> segments_;
+  std::vector<size_t> indices_;
+  std::vector<F> values_;
+  size_t last_cols_offset_ = std::numeric_limits<size_t>::max();
+}; // class LocalMatrixScatterBuffer
+
+
+} // namespace internal
+
+
+/**
+ * \brief Offsets of the entries of local matrices in the values of a global matrix, per element and per intersection.
+ *
+ * Filled by LocalMatrixScatterer during the first assembly, each subsequent assembly may then add the local matrices
+ * directly to the values of the global matrix, without searching the sparse rows again. This is only supported for
+ * matrices which store their values contiguously, see internal::MatrixRowAccumulator::has_flat_values.
+ *
+ * Intersections are identified by the inside element, their index therein and the outside element, each of which may
+ * hold the offsets of up to four local matrices (inside/inside, inside/outside, outside/inside, outside/outside).
+ *
+ * \note The offsets are only valid as long as the grid and the sparsity pattern do not change. They are discarded
+ *       automatically if the sparsity pattern changes (see validate()), call clear() if the grid changes.
+ */
+template <class GV>
+class LocalMatrixOffsetMap
+{
+  static_assert(XT::Grid::is_view<GV>::value, "");
+
+public:
+  using GridViewType = GV;
+  using ElementType = XT::Grid::extract_entity_t<GV>;
+  using IntersectionType = XT::Grid::extract_intersection_t<GV>;
+  using OffsetsType = std::vector<size_t>;
+
+private:
+  struct IntersectionOffsets
+  {
+    size_t index_in_inside;
+    size_t outside_index;
+    std::array<OffsetsType, 4> offsets;
+  };
+
+public:
+  LocalMatrixOffsetMap(const GridViewType& grid_view)
+    : grid_view_(grid_view)
+    , element_mapper_(grid_view_)
+    , pattern_hash_(0)
+    , element_offsets_(element_mapper_.size())
+    , intersection_offsets_(element_mapper_.size())
+  {}
+
+  LocalMatrixOffsetMap(const LocalMatrixOffsetMap&) = delete;
+
+  /**
+   * \brief Discards all offsets if they were recorded for a different sparsity pattern, as identified by
+   *        internal::MatrixRowAccumulator::pattern_hash().
+   */
+  void validate(const size_t pattern_hash)
+  {
+    if (pattern_hash != pattern_hash_) {
+      clear();
+      pattern_hash_ = pattern_hash;
+    }
+  }
+
+  void clear()
+  {
+    for (auto& offsets : element_offsets_)
+      OffsetsType().swap(offsets);
+    for (auto& offsets : intersection_offsets_)
+      std::vector<IntersectionOffsets>().swap(offsets);
+  }
+
+  /// \note Only to be called by the thread walking this element.
+  OffsetsType& element_offsets(const ElementType& element)
+  {
+    return element_offsets_[element_mapper_.global_index(element, 0)];
+  }
+
+  /// \note Only to be called by the thread walking the inside element, block is one of 0, 1, 2, 3.
+  OffsetsType& intersection_offsets(const IntersectionType& intersection,
+                                    const ElementType& inside_element,
+                                    const ElementType& outside_element,
+                                    const size_t block)
+  {
+    auto& offsets_of_inside = intersection_offsets_[element_mapper_.global_index(inside_element, 0)];
+    const size_t index_in_inside = intersection.indexInInside();
+    const size_t outside_index = element_mapper_.global_index(outside_element, 0);
+    for (auto& intersection_offsets : offsets_of_inside)
+      if (intersection_offsets.index_in_inside == index_in_inside
+          && intersection_offsets.outside_index == outside_index)
+        return intersection_offsets.offsets[block];
+    offsets_of_inside.push_back({index_in_inside, outside_index, {}});
+    return offsets_of_inside.back().offsets[block];
+  } // ... intersection_offsets(...)
+
+private:
+  const GridViewType grid_view_;
+  const FiniteVolumeMapper<GridViewType> element_mapper_;
+  size_t pattern_hash_;
+  std::vector<OffsetsType> element_offsets_;
+  std::vector<std::vector<IntersectionOffsets>> intersection_offsets_;
+}; // class LocalMatrixOffsetMap
+
+
+/**
+ * \brief Adds local matrices to a global matrix, to be used in local assemblers.
+ *
+ * The column indices of each local matrix are sorted once, which allows to resolve the positions of all entries of a
+ * row at once (see internal::MatrixRowAccumulator), instead of searching for every single entry.
+ *
+ * If more than one thread is available, the local matrices are not added immediately. Instead, each thread-local copy
+ * (obtained by the copy ctor, as in the copy() of a grid functor) collects its local matrices in a row-bucketed buffer,
+ * which are all scattered into the global matrix by scatter_buffers() after the grid walk. Since every bucket is
+ * handled by exactly one thread, the result is race-free without any locking.
+ *
+ * If offsets are given to add_local_matrix() (see LocalMatrixOffsetMap), they are filled on first use and afterwards
+ * used to add the local matrix directly to the values of the global matrix. They are ignored if the values of the
+ * global matrix turn out not to be contiguous (see internal::MatrixRowAccumulator::flat_values).
+ *
+ * \note The global matrix is accessed directly, bypassing the locking of its add_to_entry() (if supported, see
+ *       internal::MatrixRowAccumulator), so it must not be modified by anyone else during the grid walk.
+ *
+ * \note prepare() and scatter_buffers() are only allowed to be called on the original scatterer, usually from within
+ *       prepare() and finalize() of the grid functor holding it.
+ */
+template <class M>
+class LocalMatrixScatterer
+{
+  static_assert(XT::LA::is_matrix<M>::value, "");
+
+  using ThisType = LocalMatrixScatterer;
+
+public:
+  using MatrixType = M;
+  using FieldType = typename MatrixType::ScalarType;
+
+private:
+  using AccumulatorType = internal::MatrixRowAccumulator<MatrixType>;
+  using BufferType = internal::LocalMatrixScatterBuffer<FieldType>;
+
+  // all buffers have to use the same buckets, so that each row is scattered by exactly one thread
+  struct BufferRegistry
+  {
+    BufferRegistry(const size_t nb)
+      : num_buckets(nb)
+    {}
+
+    const size_t num_buckets;
+    std::mutex mutex;
+    std::vector<std::shared_ptr<BufferType>> buffers;
+  };
+
+public:
+  using OffsetsType = std::vector<size_t>;
+
+  static const constexpr bool supports_offsets = AccumulatorType::has_flat_values;
+
+  LocalMatrixScatterer(MatrixType& global_matrix, const size_t max_local_cols)
+    : global_matrix_(global_matrix)
+    , is_original_(true)
+    , deferred_(false)
+    , registry_(std::make_shared<BufferRegistry>(4 * XT::Common::threadManager().max_threads()))
+    , buffer_(nullptr)
+    , permutation_(max_local_cols)
+    , sorted_cols_(max_local_cols)
+    , sorted_values_(max_local_cols)
+    , located_offsets_(max_local_cols)
+    , flat_values_(false)
+  {
+    flat_values_ = supports_offsets && accumulator().flat_values();
+  }
+
+  LocalMatrixScatterer(const ThisType& other)
+    : global_matrix_(other.global_matrix_)
+    , is_original_(false)
+    , deferred_(true)
+    , registry_(other.registry_)
+    , buffer_(nullptr)
+    , permutation_(other.permutation_.size())
+    , sorted_cols_(other.sorted_cols_.size())
+    , sorted_values_(other.sorted_values_.size())
+    , located_offsets_(other.located_offsets_.size())
+    , flat_values_(other.flat_values_)
+  {
+    buffer_ = register_buffer();
+  }
+
+  LocalMatrixScatterer(ThisType&& source) = default;
+
+  /**
+   * \brief Decides if local matrices are added immediately (single thread) or deferred to scatter_buffers().
+   */
+  void prepare()
+  {
+    if (!is_original_)
+      return;
+    deferred_ = XT::Common::threadManager().current_threads() > 1;
+    if (deferred_ && !buffer_)
+      buffer_ = register_buffer();
+  }
+
+  /// \brief The number of values of the global matrix, if supports_offsets, 0 otherwise.
+  size_t num_values()
+  {
+    return accumulator().num_values();
+  }
+
+  template <class LocalIndicesType, class LocalMatrixType>
+  void add_local_matrix(const LocalIndicesType& global_rows,
+                        const size_t num_rows,
+                        const LocalIndicesType& global_cols,
+                        const size_t num_cols,
+                        const LocalMatrixType& local_matrix,
+                        const FieldType& scaling = FieldType(1),
+                        OffsetsType* offsets = nullptr)
+  {
+    if (num_rows == 0 || num_cols == 0)
+      return;
+    if (flat_values_ && offsets != nullptr) {
+      if (offsets->size() != num_rows * num_cols)
+        locate(global_rows, num_rows, global_cols, num_cols, *offsets);
+      FieldType* global_values = deferred_ ? nullptr : accumulator().values();
+      sorted_values_.resize(num_cols);
+      for (size_t ii = 0; ii < num_rows; ++ii) {
+        const size_t* row_offsets = offsets->data() + ii * num_cols;
+        if (deferred_) {
+          for (size_t jj = 0; jj < num_cols; ++jj)
+            sorted_values_[jj] = scaling * local_matrix[ii][jj];
+          buffer_->add_flat(global_rows[ii], row_offsets, sorted_values_.data(), num_cols);
+        } else {
+          for (size_t jj = 0; jj < num_cols; ++jj)
+            global_values[row_offsets[jj]] += scaling * local_matrix[ii][jj];
+        }
+      }
+      return;
+    }
+    sort_cols(global_cols, num_cols);
+    for (size_t ii = 0; ii < num_rows; ++ii) {
+      for (size_t jj = 0; jj < num_cols; ++jj)
+        sorted_values_[jj] = scaling * local_matrix[ii][permutation_[jj]];
+      if (deferred_)
+        buffer_->add(global_rows[ii], sorted_cols_, sorted_values_.data());
+      else
+        accumulator().add_to_row(global_rows[ii], sorted_cols_.data(), sorted_values_.data(), num_cols);
+    }
+  } // ... add_local_matrix(...)
+
+  /**
+   * \brief Adds the buffered local matrices of all copies to the global matrix, in parallel over the row buckets.
+   */
+  void scatter_buffers()
+  {
+    if (!is_original_)
+      return;
+    std::vector<std::shared_ptr<BufferType>> buffers;
+    {
+      std::lock_guard<std::mutex> guard(registry_->mutex);
+      buffers = registry_->buffers;
+    }
+    if (buffers.empty())
+      return;
+    const size_t num_buckets = registry_->num_buckets;
+    for (const auto& buffer : buffers)
+      DUNE_THROW_IF(buffer->num_buckets() != num_buckets,
+                    Exceptions::assembler_error,
+                    "buffer->num_buckets() = " << buffer->num_buckets() << "\n   num_buckets = " << num_buckets);
+    // obtain the accumulator (and thus the backend) outside of the threads, the buckets are disjoint, so its unlocked
+    // access to the rows is race-free
+    auto& accumulator = this->accumulator();
+    const auto scatter_buckets = [&](const size_t first_bucket, const size_t past_last_bucket) {
+      for (size_t bb = first_bucket; bb < past_last_bucket; ++bb)
+        for (const auto& buffer : buffers)
+          buffer->scatter(bb, accumulator);
+    };
+#if HAVE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_buckets),
+                      [&](const tbb::blocked_range<size_t>& range) { scatter_buckets(range.begin(), range.end()); });
+#else
+    scatter_buckets(0, num_buckets);
+#endif
+    for (auto& buffer : buffers)
+      buffer->clear();
+    buffers.clear();
+    // drop the buffers of copies which do not exist any more
+    std::lock_guard<std::mutex> guard(registry_->mutex);
+    registry_->buffers.erase(std::remove_if(registry_->buffers.begin(),
+                                            registry_->buffers.end(),
+                                            [](const auto& buffer) { return buffer.use_count() == 1; }),
+                             registry_->buffers.end());
+  } // ... scatter_buffers(...)
+
+private:
+  AccumulatorType& accumulator()
+  {
+    if (!accumulator_)
+      accumulator_ = std::make_unique<AccumulatorType>(global_matrix_);
+    return *accumulator_;
+  }
+
+  template <class LocalIndicesType>
+  void sort_cols(const LocalIndicesType& global_cols, const size_t num_cols)
+  {
+    sorted_cols_.resize(num_cols);
+    sorted_values_.resize(num_cols);
+    permutation_.resize(num_cols);
+    std::iota(permutation_.begin(), permutation_.end(), 0);
+    std::sort(permutation_.begin(), permutation_.end(), [&](const size_t& a, const size_t& b) {
+      return global_cols[a] < global_cols[b];
+    });
+    for (size_t jj = 0; jj < num_cols; ++jj)
+      sorted_cols_[jj] = global_cols[permutation_[jj]];
+  } // ... sort_cols(...)
+
+  template <class LocalIndicesType>
+  void locate(const LocalIndicesType& global_rows,
+              const size_t num_rows,
+              const LocalIndicesType& global_cols,
+              const size_t num_cols,
+              OffsetsType& offsets)
+  {
+    sort_cols(global_cols, num_cols);
+    located_offsets_.resize(num_cols);
+    offsets.resize(num_rows * num_cols);
+    for (size_t ii = 0; ii < num_rows; ++ii) {
+      accumulator().locate_row(global_rows[ii], sorted_cols_.data(), num_cols, located_offsets_.data());
+      for (size_t jj = 0; jj < num_cols; ++jj)
+        offsets[ii * num_cols + permutation_[jj]] = located_offsets_[jj];
+    }
+  } // ... locate(...)
+
+  std::shared_ptr<BufferType> register_buffer()
+  {
+    auto buffer = std::make_shared<BufferType>(global_matrix_.rows(), registry_->num_buckets);
+    std::lock_guard<std::mutex> guard(registry_->mutex);
+    registry_->buffers.push_back(buffer);
+    return buffer;
+  }
+
+  MatrixType& global_matrix_;
+  const bool is_original_;
+  bool deferred_;
+  std::shared_ptr<BufferRegistry> registry_;
+  std::shared_ptr<BufferType> buffer_;
+  std::unique_ptr<AccumulatorType> accumulator_;
+  std::vector<size_t> permutation_;
+  std::vector<size_t> sorted_cols_;
+  std::vector<FieldType> sorted_values_;
+  std::vector<size_t> located_offsets_;
+  bool flat_values_;
+}; // class LocalMatrixScatterer
+
+
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TOOLS_MATRIX_SCATTER_HH
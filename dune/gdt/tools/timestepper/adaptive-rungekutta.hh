@@ -12,7 +12,16 @@
 #ifndef DUNE_GDT_TIMESTEPPER_ADAPTIVE_RUNGEKUTTA_HH
 #define DUNE_GDT_TIMESTEPPER_ADAPTIVE_RUNGEKUTTA_HH
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <utility>
+#include <vector>
+
+#if HAVE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_reduce.h>
+#endif
 
 #include <dune/gdt/operators/interfaces.hh>
 
@@ -29,6 +38,70 @@ namespace GDT {
 namespace internal {
 
 
+/**
+ * \brief Computes the candidate solution result = u_n + \sum_j weights[j] * (*stages[j]) and the error estimate
+ *        \sum_j error_weights[j] * (*stages[j]) in one pass over the entries.
+ *
+ * The error estimate is not stored, only its sup norm (scaled by |result| where |result| > 0.01) is returned. A NaN
+ * in the error estimate yields an infinite error. The local buffers are processed in parallel if TBB is available. All
+ * vectors have to be dense vectors with contiguous storage, result must not coincide with u_n or any of stages.
+ */
+template <class VectorType, class ScalarType>
+ScalarType embedded_solution_and_error(VectorType& result,
+                                       const VectorType& u_n,
+                                       const std::vector<const VectorType*>& stages,
+                                       const std::vector<ScalarType>& weights,
+                                       const std::vector<ScalarType>& error_weights)
+{
+  assert(stages.size() == weights.size() && stages.size() == error_weights.size());
+  const size_t size = result.size();
+  if (size == 0)
+    return 0.;
+  static const constexpr size_t chunk_size = 256;
+  ScalarType* result_data = &(result[0]);
+  const ScalarType* u_n_data = &(u_n[0]);
+  const auto process = [&](const size_t begin, const size_t end) {
+    ScalarType error[chunk_size];
+    ScalarType max_error = 0.;
+    for (size_t chunk_begin = begin; chunk_begin < end; chunk_begin += chunk_size) {
+      const size_t num_entries = std::min(chunk_begin + chunk_size, end) - chunk_begin;
+      ScalarType* result_chunk = result_data + chunk_begin;
+      std::copy(u_n_data + chunk_begin, u_n_data + chunk_begin + num_entries, result_chunk);
+      std::fill(error, error + num_entries, ScalarType(0.));
+      for (size_t jj = 0; jj < stages.size(); ++jj) {
+        const ScalarType weight = weights[jj];
+        const ScalarType error_weight = error_weights[jj];
+        const ScalarType* data = &((*stages[jj])[0]) + chunk_begin;
+        for (size_t ii = 0; ii < num_entries; ++ii) {
+          result_chunk[ii] += weight * data[ii];
+          error[ii] += error_weight * data[ii];
+        }
+      }
+      for (size_t ii = 0; ii < num_entries; ++ii) {
+        // use absolute error if the solution is less than 0.01 and relative error else
+        const ScalarType abs_value = std::abs(result_chunk[ii]);
+        const ScalarType scaled_error = std::abs(error[ii]) / (abs_value > 0.01 ? abs_value : ScalarType(1.));
+        if (std::isnan(scaled_error))
+          return std::numeric_limits<ScalarType>::infinity();
+        max_error = std::max(max_error, scaled_error);
+      }
+    }
+    return max_error;
+  };
+#if HAVE_TBB
+  return tbb::parallel_reduce(
+      tbb::blocked_range<size_t>(0, size, 16 * chunk_size),
+      ScalarType(0.),
+      [&](const tbb::blocked_range<size_t>& range, const ScalarType init) {
+        return std::max(init, process(range.begin(), range.end()));
+      },
+      [](const ScalarType& a, const ScalarType& b) { return std::max(a, b); });
+#else
+  return process(0, size);
+#endif
+} // ... embedded_solution_and_error(...)
+
+
 // unspecialized
 template <class RangeFieldType, TimeStepperMethods method>
 struct AdaptiveButcherArrayProvider
@@ -93,12 +166,12 @@ public:
   {
     return Dune::XT::Common::from_string<Dune::DynamicVector<RangeFieldType>>(
         "[" + Dune::XT::Common::to_string(7.0 / 24.0, 15) + " " + Dune::XT::Common::to_string(1.0 / 4.0, 15) + " "
-        + Dune::XT::Common::to_string(1.0 / 3.0, 15) + " " + Dune::XT::Common::to_string(1.0 / 8.0, 15) + " 0]");
+        + Dune::XT::Common::to_string(1.0 / 3.0, 15) + " " + Dune::XT::Common::to_string(1.0 / 8.0, 15) + "]");
   }
 
   static Dune::DynamicVector<RangeFieldType> c()
   {
-    return Dune::XT::Common::from_string<Dune::DynamicVector<RangeFieldType>>("[0.5 0.75 1 0]");
+    return Dune::XT::Common::from_string<Dune::DynamicVector<RangeFieldType>>("[0 0.5 0.75 1]");
   }
 };
 
@@ -148,6 +221,32 @@ public:
   }
 }; // Dormand-Prince (RK45)
 
+// Heun-Euler (adaptive RK12), only two stages, so the cheapest pair in terms of memory
+template <class RangeFieldType>
+class AdaptiveButcherArrayProvider<RangeFieldType, TimeStepperMethods::heun_euler>
+{
+public:
+  static Dune::DynamicMatrix<RangeFieldType> A()
+  {
+    return Dune::XT::Common::from_string<Dune::DynamicMatrix<RangeFieldType>>("[0 0; 1 0]");
+  }
+
+  static Dune::DynamicVector<RangeFieldType> b_1()
+  {
+    return Dune::XT::Common::from_string<Dune::DynamicVector<RangeFieldType>>("[0.5 0.5]");
+  }
+
+  static Dune::DynamicVector<RangeFieldType> b_2()
+  {
+    return Dune::XT::Common::from_string<Dune::DynamicVector<RangeFieldType>>("[1 0]");
+  }
+
+  static Dune::DynamicVector<RangeFieldType> c()
+  {
+    return Dune::XT::Common::from_string<Dune::DynamicVector<RangeFieldType>>("[0 1]");
+  }
+}; // Heun-Euler (RK12)
+
 
 } // namespace internal
 
@@ -166,6 +265,11 @@ public:
  * b_2. If the estimated error is higher than a specified tolerance tol, the calculation is repeated with a smaller
  * time step. The tolerance tol and the error estimate are also used to estimate the optimal time step length for the
  * next time step via dt_new = dt_old*min(max(0.9*(tol/error)^(1/5), scale_factor_min), scale_factor_max_);
+ * If the method has the first-same-as-last property (the last row of A coincides with b_1, c_0 = 0 and c_{s-1} = 1,
+ * e.g. Dormand-Prince and Bogacki-Shampine), the last stage of an accepted step is reused as first stage of the next
+ * step. The first stage is also reused if a step is rejected. The candidate solution and the error estimate are
+ * computed in one pass, and u^n is only overwritten once the step has been accepted. The error is reduced over all MPI
+ * ranks, so all ranks use the same time step length. Apart from u^n, s + 1 vectors are stored.
  *
  * Notation: For an s-stage method,
  * \mathbf{u}^{n+1} = \mathbf{u}^n + dt \sum_{i=0}^{s-1} b_i \mathbf{k}_i
@@ -231,6 +335,8 @@ public:
     , c_(c)
     , b_diff_(b_2_ - b_1_)
     , num_stages_(A_.rows())
+    , is_fsal_(num_stages_ > 1)
+    , first_stage_available_(false)
   {
     assert(Dune::XT::Common::FloatCmp::gt(tol_, 0.0));
     assert(Dune::XT::Common::FloatCmp::le(scale_factor_min_, 1.0));
@@ -250,7 +356,17 @@ public:
     // store as many discrete functions as needed for intermediate stages
     for (size_t ii = 0; ii < num_stages_; ++ii) {
       stages_k_.emplace_back(current_solution());
+      stage_indices_.push_back(ii);
     }
+    // check for the first-same-as-last property
+    is_fsal_ = is_fsal_ && Dune::XT::Common::FloatCmp::eq(c_[0], 0.0)
+               && Dune::XT::Common::FloatCmp::eq(c_[num_stages_ - 1], 1.0);
+    for (size_t jj = 0; jj < num_stages_; ++jj)
+      is_fsal_ = is_fsal_ && Dune::XT::Common::FloatCmp::eq(A_[num_stages_ - 1][jj], b_1_[jj]);
+    terms_.reserve(num_stages_);
+    stage_ptrs_.reserve(num_stages_);
+    weights_.reserve(num_stages_);
+    error_weights_.reserve(num_stages_);
   } // constructor AdaptiveRungeKuttaTimeStepper
 
   using BaseType::current_solution;
@@ -269,7 +385,8 @@ public:
                                typename BaseType::DiscreteSolutionType& sol,
                                const typename BaseType::VisualizerType& visualizer,
                                const typename BaseType::StringifierType& stringifier,
-                               const typename BaseType::GridFunctionType& exact_solution) override final
+                               const typename BaseType::GridFunctionType& exact_solution,
+                               const bool async_output = false) override final
   {
     const auto ret = BaseType::solve(t_end,
                                      initial_dt,
@@ -283,9 +400,10 @@ public:
                                      sol,
                                      visualizer,
                                      stringifier,
-                                     exact_solution);
-    // in a fractional step scheme, we cannot use last_stage_of_previous_step
-    last_stage_of_previous_step_ = nullptr;
+                                     exact_solution,
+                                     async_output);
+    // in a fractional step scheme, we cannot reuse the last stage of the previous step
+    first_stage_available_ = false;
     return ret;
   }
 
@@ -298,68 +416,82 @@ public:
     auto& t = current_time();
     auto& u_n = current_solution();
 
+    // if c_0 = 0, k_0 = L(u_n, t) does not depend on dt, so it is computed at most once per step
+    bool first_stage_computed = first_stage_available_;
     while (Dune::XT::Common::FloatCmp::gt(mixed_error, tol_)) {
-      bool skip_error_computation = false;
+      bool stage_failed = false;
       actual_dt *= time_step_scale_factor;
-      size_t first_stage_to_compute = 0;
-      if (last_stage_of_previous_step_) {
-        stages_k_[0].dofs().vector() = last_stage_of_previous_step_->dofs().vector();
-        first_stage_to_compute = 1;
-      }
 
-      for (size_t ii = first_stage_to_compute; ii < num_stages_; ++ii) {
-        std::fill(stages_k_[ii].dofs().vector().begin(), stages_k_[ii].dofs().vector().end(), RangeFieldType(0.));
-        u_tmp_.dofs().vector() = u_n.dofs().vector();
-        for (size_t jj = 0; jj < ii; ++jj)
-          u_tmp_.dofs().vector() += stages_k_[jj].dofs().vector() * (actual_dt * r_ * (A_[ii][jj]));
+      for (size_t ii = first_stage_computed ? 1 : 0; ii < num_stages_; ++ii) {
+        auto& k_ii = stage(ii).dofs().vector();
+        std::fill(k_ii.begin(), k_ii.end(), RangeFieldType(0.));
+        // u_tmp = u_n + \sum_j dt r a_{ij} k_j in one pass, skipping zero coefficients
+        terms_.clear();
+        terms_.emplace_back(1., &u_n.dofs().vector());
+        for (size_t jj = 0; jj < ii; ++jj) {
+          if (A_[ii][jj] != 0.)
+            terms_.emplace_back(actual_dt * r_ * A_[ii][jj], &stage(jj).dofs().vector());
+        }
+        const bool stage_is_u_n = (terms_.size() == 1);
+        if (!stage_is_u_n)
+          internal::linear_combination(u_tmp_.dofs().vector(), terms_);
         try {
-          op_.apply(u_tmp_.dofs().vector(), stages_k_[ii].dofs().vector(), t + actual_dt * c_[ii]);
+          op_.apply(stage_is_u_n ? u_n.dofs().vector() : u_tmp_.dofs().vector(), k_ii, t + actual_dt * c_[ii]);
         } catch (const Dune::MathError& e) {
-          mixed_error = 1e10;
-          skip_error_computation = true;
-          time_step_scale_factor = 0.5;
+          stage_failed = true;
           break;
 #if HAVE_TBB
         } catch (const tbb::captured_exception& e) {
-          mixed_error = 1e10;
-          skip_error_computation = true;
-          time_step_scale_factor = 0.5;
+          stage_failed = true;
           break;
 #endif
         }
+        if (ii == 0 && Dune::XT::Common::FloatCmp::eq(c_[0], 0.0))
+          first_stage_computed = true;
       }
 
-      if (!skip_error_computation) {
-        // compute error vector
-        u_tmp_.dofs().vector() = stages_k_[0].dofs().vector() * b_diff_[0];
-        for (size_t ii = 1; ii < num_stages_; ++ii)
-          u_tmp_.dofs().vector() += stages_k_[ii].dofs().vector() * b_diff_[ii];
-        u_tmp_.dofs().vector() *= actual_dt * r_;
-
-        // calculate u at timestep n+1
-        for (size_t ii = 0; ii < num_stages_; ++ii)
-          u_n.dofs().vector() += stages_k_[ii].dofs().vector() * (actual_dt * r_ * b_1_[ii]);
-
-        // scale error, use absolute error if norm is less than 0.01 and relative error else
-        auto& diff_vector = u_tmp_.dofs().vector();
-        for (size_t ii = 0; ii < diff_vector.size(); ++ii) {
-          if (std::abs(u_n.dofs().vector()[ii]) > 0.01)
-            diff_vector[ii] /= std::abs(u_n.dofs().vector()[ii]);
+      // compute the candidate for u at timestep n+1 (in u_tmp) and the scaled error in one pass
+      RangeFieldType local_error = 0.;
+      if (!stage_failed) {
+        stage_ptrs_.clear();
+        weights_.clear();
+        error_weights_.clear();
+        for (size_t jj = 0; jj < num_stages_; ++jj) {
+          if (b_1_[jj] != 0. || b_diff_[jj] != 0.) {
+            stage_ptrs_.push_back(&stage(jj).dofs().vector());
+            weights_.push_back(actual_dt * r_ * b_1_[jj]);
+            error_weights_.push_back(actual_dt * r_ * b_diff_[jj]);
+          }
         }
-        mixed_error = diff_vector.sup_norm();
+        local_error = internal::embedded_solution_and_error(
+            u_tmp_.dofs().vector(), u_n.dofs().vector(), stage_ptrs_, weights_, error_weights_);
+      }
+      // all ranks have to take the same decision (and apply the operator equally often in the next attempt), even if a
+      // stage failed on some of them only, so the failure flags are reduced along with the error in every attempt
+      RangeFieldType error_and_failures[3] = {local_error,
+                                              stage_failed ? RangeFieldType(1.) : RangeFieldType(0.),
+                                              first_stage_computed ? RangeFieldType(0.) : RangeFieldType(1.)};
+      u_n.space().grid_view().comm().max(error_and_failures, 3);
+      if (error_and_failures[2] > 0.)
+        first_stage_computed = false;
+      if (error_and_failures[1] > 0.) {
+        mixed_error = 1e10;
+        time_step_scale_factor = 0.5;
+      } else {
+        mixed_error = error_and_failures[0];
         // scale dt to get the estimated optimal time step length, TODO: adapt formula
         time_step_scale_factor =
             std::min(std::max(0.9 * std::pow(tol_ / mixed_error, 1.0 / 5.0), scale_factor_min_), scale_factor_max_);
 
-        if (mixed_error > tol_) { // go back from u at timestep n+1 to timestep n
-          for (size_t ii = 0; ii < num_stages_; ++ii)
-            u_n.dofs().vector() += stages_k_[ii].dofs().vector() * (-1.0 * r_ * actual_dt * b_1_[ii]);
-        }
+        // accept the step
+        if (!Dune::XT::Common::FloatCmp::gt(mixed_error, tol_))
+          u_n.dofs().vector() = u_tmp_.dofs().vector();
       }
     } // while (mixed_error > tol_)
-    if (!last_stage_of_previous_step_)
-      last_stage_of_previous_step_ = Dune::XT::Common::make_unique<DiscreteFunctionType>(u_n);
-    last_stage_of_previous_step_->dofs().vector() = stages_k_[num_stages_ - 1].dofs().vector();
+    // reuse the last stage as first stage of the next step
+    if (is_fsal_)
+      std::swap(stage_indices_[0], stage_indices_[num_stages_ - 1]);
+    first_stage_available_ = is_fsal_;
 
 #if 0
     const auto u_local_func = u_n.local_discrete_function();
@@ -376,7 +508,7 @@ public:
 //            std::cout << u_local_func->dofs().get_entry(jj) << " ";
 //          }
 //          std::cout << std::endl;
-          last_stage_of_previous_step_ = nullptr;
+          first_stage_available_ = false;
 //          u_local_func->dofs().set_entry(ii, min_val);
           std::cout << "Replacing " << entry_ii << " by " << std::copysign(max_val, entry_ii) << std::endl;
           u_local_func->dofs().set_entry(ii, std::copysign(max_val, entry_ii));
@@ -391,6 +523,14 @@ public:
   } // ... step(...)
 
 private:
+  // the stages are permuted instead of copied for the first-same-as-last property
+  DiscreteFunctionType& stage(const size_t ii)
+  {
+    return stages_k_[stage_indices_[ii]];
+  }
+
+  using DofVectorType = typename DiscreteFunctionType::VectorType;
+
   const OperatorType& op_;
   const RangeFieldType r_;
   const RangeFieldType tol_;
@@ -404,7 +544,13 @@ private:
   const VectorType b_diff_;
   std::vector<DiscreteFunctionType> stages_k_;
   const size_t num_stages_;
-  std::unique_ptr<DiscreteFunctionType> last_stage_of_previous_step_;
+  std::vector<size_t> stage_indices_;
+  bool is_fsal_;
+  bool first_stage_available_;
+  std::vector<std::pair<RangeFieldType, const DofVectorType*>> terms_;
+  std::vector<const DofVectorType*> stage_ptrs_;
+  std::vector<RangeFieldType> weights_;
+  std::vector<RangeFieldType> error_weights_;
 }; // class AdaptiveRungeKuttaTimeStepper
 
 
@@ -0,0 +1,407 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TIMESTEPPER_CHECKPOINT_HH
+#define DUNE_GDT_TIMESTEPPER_CHECKPOINT_HH
+
+#include <algorithm>
+#include <climits>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#if HAVE_MPI
+#  include <mpi.h>
+#  include <dune/common/parallel/mpicollectivecommunication.hh>
+#endif
+
+#include <dune/xt/common/string.hh>
+
+#include <dune/grid/common/gridenums.hh>
+#include <dune/grid/common/rangegenerators.hh>
+
+#include <dune/gdt/exceptions.hh>
+
+namespace Dune {
+namespace GDT {
+namespace internal {
+
+
+/**
+ * \brief Runs tasks in the order they were pushed on a single background thread.
+ *
+ * At most max_pending_tasks tasks (including the running one) are kept, push blocks until there is space again. This
+ * bounds the memory used by the data the tasks hold.
+ *
+ * Exceptions thrown by a task are rethrown by the next call to wait().
+ */
+class BackgroundTaskQueue
+{
+public:
+  BackgroundTaskQueue(const size_t max_pending_tasks = std::numeric_limits<size_t>::max())
+    : max_pending_tasks_(std::max(max_pending_tasks, size_t(1)))
+    , busy_(false)
+    , stop_(false)
+    , thread_(&BackgroundTaskQueue::run, this)
+  {}
+
+  BackgroundTaskQueue(const BackgroundTaskQueue&) = delete;
+  BackgroundTaskQueue& operator=(const BackgroundTaskQueue&) = delete;
+
+  ~BackgroundTaskQueue()
+  {
+    {
+      std::lock_guard<std::mutex> DUNE_UNUSED(guard)(mutex_);
+      stop_ = true;
+    }
+    task_available_.notify_one();
+    thread_.join();
+  }
+
+  void push(std::function<void()> task)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      space_available_.wait(lock, [this] { return tasks_.size() + (busy_ ? 1 : 0) < max_pending_tasks_; });
+      tasks_.push_back(std::move(task));
+    }
+    task_available_.notify_one();
+  }
+
+  size_t max_pending_tasks() const
+  {
+    return max_pending_tasks_;
+  }
+
+  //! \brief Blocks until all pushed tasks are finished.
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    all_done_.wait(lock, [this] { return tasks_.empty() && !busy_; });
+    if (error_) {
+      auto error = error_;
+      error_ = nullptr;
+      std::rethrow_exception(error);
+    }
+  }
+
+private:
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      task_available_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty())
+        return; // stop_ is set and there is nothing left to do
+      auto task = std::move(tasks_.front());
+      tasks_.pop_front();
+      busy_ = true;
+      lock.unlock();
+      std::exception_ptr error;
+      try {
+        task();
+      } catch (...) {
+        error = std::current_exception();
+      }
+      lock.lock();
+      busy_ = false;
+      if (error && !error_)
+        error_ = error;
+      space_available_.notify_all();
+      if (tasks_.empty())
+        all_done_.notify_all();
+    }
+  } // ... run(...)
+
+  const size_t max_pending_tasks_;
+  std::mutex mutex_;
+  std::condition_variable task_available_;
+  std::condition_variable all_done_;
+  std::condition_variable space_available_;
+  std::deque<std::function<void()>> tasks_;
+  bool busy_;
+  bool stop_;
+  std::exception_ptr error_;
+  std::thread thread_;
+}; // class BackgroundTaskQueue
+
+
+static const constexpr char checkpoint_rank_file_magic[] = "GDTCKPTR";
+static const constexpr char checkpoint_single_file_magic[] = "GDTCKPTS";
+static const constexpr std::uint64_t checkpoint_version = 1;
+
+
+template <class T>
+void append_bytes(std::vector<char>& buffer, const T& value)
+{
+  const auto* bytes = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <class T>
+T read_bytes(const std::vector<char>& buffer, size_t& position)
+{
+  DUNE_THROW_IF(position + sizeof(T) > buffer.size(), Dune::IOError, "Checkpoint data is truncated!");
+  T ret;
+  std::memcpy(&ret, buffer.data() + position, sizeof(T));
+  position += sizeof(T);
+  return ret;
+}
+
+template <class K, int r>
+void append_values(std::vector<char>& buffer, const FieldVector<K, r>& value)
+{
+  for (int ii = 0; ii < r; ++ii)
+    append_bytes(buffer, static_cast<double>(value[ii]));
+}
+
+template <class K, int r, int rC>
+void append_values(std::vector<char>& buffer, const FieldMatrix<K, r, rC>& value)
+{
+  for (int ii = 0; ii < r; ++ii)
+    for (int jj = 0; jj < rC; ++jj)
+      append_bytes(buffer, static_cast<double>(value[ii][jj]));
+}
+
+inline void write_file(const std::string& filename, const std::vector<char>& header, const std::vector<char>& data)
+{
+  std::ofstream file(filename, std::ios_base::binary | std::ios_base::trunc);
+  file.write(header.data(), static_cast<std::streamsize>(header.size()));
+  file.write(data.data(), static_cast<std::streamsize>(data.size()));
+  DUNE_THROW_IF(!file, Dune::IOError, "Could not write '" << filename << "'!");
+}
+
+// Writes header (on rank 0) followed by the data of all ranks at the given offsets to a single file. For other than MPI
+// communicators, only one rank may be present.
+template <class CommunicatorType>
+void write_single_file(const CommunicatorType& comm,
+                       const std::string& filename,
+                       const std::vector<char>& header,
+                       const std::vector<char>& data,
+                       const size_t /*offset*/)
+{
+  DUNE_THROW_IF(comm.size() != 1, Dune::NotImplemented, "Parallel single file checkpoints require MPI!");
+  write_file(filename, header, data);
+}
+
+#if HAVE_MPI
+inline void write_single_file(const CollectiveCommunication<MPI_Comm>& comm,
+                              const std::string& filename,
+                              const std::vector<char>& header,
+                              const std::vector<char>& data,
+                              const size_t offset)
+{
+  DUNE_THROW_IF(header.size() > INT_MAX || data.size() > INT_MAX,
+                Dune::NotImplemented,
+                "Blocks larger than INT_MAX bytes are not supported, use one file per rank!");
+  MPI_File file;
+  const auto mpi_comm = static_cast<MPI_Comm>(comm);
+  const int error =
+      MPI_File_open(mpi_comm, filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file);
+  DUNE_THROW_IF(error != MPI_SUCCESS, Dune::IOError, "Could not open '" << filename << "'!");
+  MPI_File_set_size(file, 0);
+  if (comm.rank() == 0)
+    MPI_File_write_at(
+        file, 0, const_cast<char*>(header.data()), static_cast<int>(header.size()), MPI_BYTE, MPI_STATUS_IGNORE);
+  MPI_File_write_at_all(file,
+                        static_cast<MPI_Offset>(offset),
+                        const_cast<char*>(data.data()),
+                        static_cast<int>(data.size()),
+                        MPI_BYTE,
+                        MPI_STATUS_IGNORE);
+  MPI_File_close(&file);
+} // ... write_single_file(...)
+#endif // HAVE_MPI
+
+
+} // namespace internal
+
+
+/**
+ * \brief Name of the file the checkpoint of the given rank and step is written to.
+ *
+ * If single_file is true, all ranks share one file and rank is ignored.
+ */
+inline std::string
+checkpoint_filename(const std::string& prefix, const size_t step, const int rank, const bool single_file = false)
+{
+  if (single_file)
+    return prefix + "_" + XT::Common::to_string(step) + ".bin";
+  return prefix + "_rank_" + XT::Common::to_string(rank) + "_" + XT::Common::to_string(step) + ".bin";
+}
+
+
+/**
+ * \brief Writes a binary checkpoint of discrete_function at time t.
+ *
+ * The data of each rank consists of t, the dimensions (dimDomain, size of the range, number of interior and border
+ * elements, number of DoFs) as 64 bit unsigned integers, the center and the value in the center of each interior or
+ * border element as doubles (the same data the text output contains) and the local DoF vector (including all
+ * partitions) as doubles, all in native byte order.
+ *
+ * If single_file is false, each rank writes its data (preceded by "GDTCKPTR" and the format version) to its own file,
+ * see checkpoint_filename. If a queue is given, the data is collected in this thread and written in the background, so
+ * the caller may continue computing (call queue->wait() to make sure the file is complete).
+ *
+ * If single_file is true, all ranks collectively write one file (using MPI-IO if available), which starts with
+ * "GDTCKPTS", the format version, the number of ranks and the byte offset and size of the data of each rank. Since the
+ * MPI implementation is not guaranteed to support MPI calls from several threads, this is always done synchronously.
+ *
+ * \sa read_checkpoint
+ */
+template <class DiscreteFunctionType>
+void write_checkpoint(const DiscreteFunctionType& discrete_function,
+                      const double t,
+                      const std::string& prefix,
+                      const size_t step,
+                      const bool single_file = false,
+                      internal::BackgroundTaskQueue* queue = nullptr)
+{
+  const auto& grid_view = discrete_function.space().grid_view();
+  static const constexpr size_t d = DiscreteFunctionType::d;
+  static const constexpr size_t value_size = DiscreteFunctionType::r * DiscreteFunctionType::rC;
+  const auto& dofs = discrete_function.dofs().vector();
+  std::vector<char> data;
+  data.reserve(5 * 8 + 8 * (grid_view.size(0) * (d + value_size) + dofs.size()));
+  internal::append_bytes(data, t);
+  internal::append_bytes(data, std::uint64_t(d));
+  internal::append_bytes(data, std::uint64_t(value_size));
+  const size_t num_elements_position = data.size();
+  internal::append_bytes(data, std::uint64_t(0));
+  internal::append_bytes(data, std::uint64_t(dofs.size()));
+  std::uint64_t num_elements = 0;
+  const auto local_function = discrete_function.local_function();
+  for (auto&& element : elements(grid_view, Partitions::interiorBorder)) {
+    local_function->bind(element);
+    const auto center = element.geometry().center();
+    internal::append_values(data, center);
+    internal::append_values(data, local_function->evaluate(element.geometry().local(center), {"t", t}));
+    ++num_elements;
+  }
+  std::memcpy(data.data() + num_elements_position, &num_elements, sizeof(num_elements));
+  for (size_t ii = 0; ii < dofs.size(); ++ii)
+    internal::append_bytes(data, static_cast<double>(dofs.get_entry(ii)));
+  const auto& comm = grid_view.comm();
+  std::vector<char> header;
+  if (!single_file) {
+    header.insert(header.end(), internal::checkpoint_rank_file_magic, internal::checkpoint_rank_file_magic + 8);
+    internal::append_bytes(header, internal::checkpoint_version);
+    const auto filename = checkpoint_filename(prefix, step, comm.rank());
+    if (queue)
+      queue->push([filename, header, data = std::move(data)]() { internal::write_file(filename, header, data); });
+    else
+      internal::write_file(filename, header, data);
+  } else {
+    std::vector<unsigned long> sizes(comm.size());
+    unsigned long size = data.size();
+    comm.allgather(&size, 1, sizes.data());
+    header.insert(header.end(), internal::checkpoint_single_file_magic, internal::checkpoint_single_file_magic + 8);
+    internal::append_bytes(header, internal::checkpoint_version);
+    internal::append_bytes(header, std::uint64_t(comm.size()));
+    size_t offset = 8 + 8 + 8 + 16 * sizes.size();
+    size_t my_offset = 0;
+    for (int rank = 0; rank < comm.size(); ++rank) {
+      internal::append_bytes(header, std::uint64_t(offset));
+      internal::append_bytes(header, std::uint64_t(sizes[rank]));
+      if (rank == comm.rank())
+        my_offset = offset;
+      offset += sizes[rank];
+    }
+    internal::write_single_file(comm, checkpoint_filename(prefix, step, 0, true), header, data, my_offset);
+  }
+} // ... write_checkpoint(...)
+
+
+/**
+ * \brief Reads the DoFs written by write_checkpoint into discrete_function and returns the time of the checkpoint.
+ *
+ * The grid (and its distribution) and the space have to coincide with the ones used for writing.
+ */
+template <class DiscreteFunctionType>
+double read_checkpoint(DiscreteFunctionType& discrete_function,
+                       const std::string& prefix,
+                       const size_t step,
+                       const bool single_file = false)
+{
+  const auto& grid_view = discrete_function.space().grid_view();
+  const auto& comm = grid_view.comm();
+  const auto filename = checkpoint_filename(prefix, step, comm.rank(), single_file);
+  std::ifstream file(filename, std::ios_base::binary);
+  DUNE_THROW_IF(!file, Dune::IOError, "Could not open '" << filename << "'!");
+  // check header
+  std::vector<char> buffer(single_file ? 24 : 16);
+  file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  DUNE_THROW_IF(!file
+                    || std::memcmp(buffer.data(),
+                                   single_file ? internal::checkpoint_single_file_magic
+                                               : internal::checkpoint_rank_file_magic,
+                                   8)
+                           != 0,
+                Dune::IOError,
+                "'" << filename << "' is not a checkpoint!");
+  size_t position = 8;
+  const auto version = internal::read_bytes<std::uint64_t>(buffer, position);
+  DUNE_THROW_IF(version != internal::checkpoint_version,
+                Dune::IOError,
+                "'" << filename << "' has format version " << version << ", expected "
+                    << internal::checkpoint_version << "!");
+  // read the data of this rank
+  if (single_file) {
+    const auto num_ranks = internal::read_bytes<std::uint64_t>(buffer, position);
+    DUNE_THROW_IF(num_ranks != std::uint64_t(comm.size()),
+                  Exceptions::discrete_function_error,
+                  "'" << filename << "' was written by " << num_ranks << " ranks, but there are " << comm.size()
+                      << "!");
+    file.seekg(static_cast<std::streamoff>(24 + 16 * comm.rank()));
+    file.read(buffer.data(), 16);
+    position = 0;
+    const auto offset = internal::read_bytes<std::uint64_t>(buffer, position);
+    const auto size = internal::read_bytes<std::uint64_t>(buffer, position);
+    file.seekg(static_cast<std::streamoff>(offset));
+    buffer.resize(size);
+  } else {
+    const auto begin = file.tellg();
+    file.seekg(0, std::ios_base::end);
+    buffer.resize(static_cast<size_t>(file.tellg() - begin));
+    file.seekg(begin);
+  }
+  file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  DUNE_THROW_IF(!file, Dune::IOError, "Could not read '" << filename << "'!");
+  position = 0;
+  const auto t = internal::read_bytes<double>(buffer, position);
+  const auto dim_domain = internal::read_bytes<std::uint64_t>(buffer, position);
+  const auto value_size = internal::read_bytes<std::uint64_t>(buffer, position);
+  const auto num_elements = internal::read_bytes<std::uint64_t>(buffer, position);
+  const auto num_dofs = internal::read_bytes<std::uint64_t>(buffer, position);
+  auto& dofs = discrete_function.dofs().vector();
+  DUNE_THROW_IF(dim_domain != DiscreteFunctionType::d
+                    || value_size != DiscreteFunctionType::r * DiscreteFunctionType::rC || num_dofs != dofs.size(),
+                Exceptions::discrete_function_error,
+                "'" << filename << "' does not match the discrete function!");
+  position += 8 * num_elements * (dim_domain + value_size);
+  for (size_t ii = 0; ii < num_dofs; ++ii)
+    dofs.set_entry(ii, internal::read_bytes<double>(buffer, position));
+  return t;
+} // ... read_checkpoint(...)
+
+
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TIMESTEPPER_CHECKPOINT_HH
@@ -29,7 +29,8 @@ enum class TimeStepperMethods
   implicit_midpoint,
   trapezoidal_rule,
   diagonally_implicit_other,
-  matrix_exponential
+  matrix_exponential,
+  heun_euler
 };
 
 enum class TimeStepperSplittingMethods
@@ -38,6 +39,14 @@ enum class TimeStepperSplittingMethods
   strang
 };
 
+//! \brief File format of the discrete solution written by TimeStepperInterface::solve, see write_checkpoint.
+enum class TimeStepperOutputFormats
+{
+  text,
+  binary,
+  binary_single_file
+};
+
 
 } // namespace GDT
 } // namespace Dune
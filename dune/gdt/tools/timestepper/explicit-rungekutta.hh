@@ -13,6 +13,7 @@
 #define DUNE_GDT_TIMESTEPPER_EXPLICIT_RUNGEKUTTA_HH
 
 #include <utility>
+#include <vector>
 
 #include "enums.hh"
 #include "interface.hh"
@@ -173,7 +174,6 @@ class ExplicitRungeKuttaTimeStepper : public TimeStepperInterface<DiscreteFuncti
   using ButcherArrayProviderType = typename internal::ButcherArrayProvider<typename BaseType::RangeFieldType, method>;
 
 public:
-  using typename BaseType::DataHandleType;
   using typename BaseType::DiscreteFunctionType;
   using typename BaseType::DiscreteSolutionType;
   using typename BaseType::DomainFieldType;
@@ -227,6 +227,7 @@ public:
     for (size_t ii = 0; ii < num_stages_; ++ii) {
       stages_k_.emplace_back(current_solution());
     }
+    terms_.reserve(num_stages_ + 1);
   } // constructor
 
   /**
@@ -245,24 +246,26 @@ public:
     const RangeFieldType actual_dt = std::min(dt, max_dt);
     auto& t = current_time();
     auto& u_n = current_solution();
-    // calculate stages
+    // TODO: provide actual_dt to op_. This leads to spurious oscillations in the Lax-Friedrichs flux
+    // because actual_dt/dx may become very small.
+    XT::Common::Parameter param({{"t", {t}}, {"dt", {dt}}});
+    // calculate stages, u_i = u_n + \sum_j dt r a_{ij} k_j is computed in one pass, skipping zero coefficients
     for (size_t ii = 0; ii < num_stages_; ++ii) {
-      u_i_.dofs().vector() = u_n.dofs().vector();
-      for (size_t jj = 0; jj < ii; ++jj)
-        u_i_.dofs().vector() += stages_k_[jj].dofs().vector() * (actual_dt * r_ * (A_[ii][jj]));
-      // TODO: provide actual_dt to op_. This leads to spurious oscillations in the Lax-Friedrichs flux
-      // because actual_dt/dx may become very small.
-      op_.apply(u_i_.dofs().vector(),
-                stages_k_[ii].dofs().vector(),
-                XT::Common::Parameter({{"t", {t + actual_dt * c_[ii]}}, {"dt", {dt}}}));
-      DataHandleType stages_k_ii_handle(stages_k_[ii]);
-      stages_k_[ii].space().grid_view().template communicate<DataHandleType>(
-          stages_k_ii_handle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+      set_terms(u_n, A_[ii], ii, actual_dt);
+      const bool stage_is_u_n = (terms_.size() == 1);
+      if (!stage_is_u_n)
+        internal::linear_combination(u_i_.dofs().vector(), terms_);
+      param.set("t", {t + actual_dt * c_[ii]}, true);
+      internal::apply_and_communicate(op_,
+                                      stage_is_u_n ? u_n.dofs().vector() : u_i_.dofs().vector(),
+                                      stages_k_[ii].dofs().vector(),
+                                      stages_k_[ii].space(),
+                                      param);
     }
 
-    // calculate value of u at next time step
-    for (size_t ii = 0; ii < num_stages_; ++ii)
-      u_n.dofs().vector() += stages_k_[ii].dofs().vector() * (r_ * actual_dt * b_[ii]);
+    // calculate value of u at next time step, again in one pass
+    set_terms(u_n, b_, num_stages_, actual_dt);
+    internal::linear_combination(u_n.dofs().vector(), terms_);
 
     // augment time
     t += actual_dt;
@@ -320,6 +323,22 @@ public:
   }
 
 private:
+  // fills terms_ with u_n and the stages k_j, j < num_coeffs, scaled by dt r coeffs[j] (if this is non-zero)
+  template <class CoefficientVectorType>
+  void set_terms(const DiscreteFunctionType& u_n,
+                 const CoefficientVectorType& coeffs,
+                 const size_t num_coeffs,
+                 const RangeFieldType actual_dt)
+  {
+    terms_.clear();
+    terms_.emplace_back(1., &u_n.dofs().vector());
+    for (size_t jj = 0; jj < num_coeffs; ++jj) {
+      const RangeFieldType coeff = actual_dt * r_ * coeffs[jj];
+      if (coeff != 0.)
+        terms_.emplace_back(coeff, &stages_k_[jj].dofs().vector());
+    }
+  } // ... set_terms(...)
+
   const OperatorType& op_;
   const RangeFieldType r_;
   DiscreteFunctionType u_i_;
@@ -328,8 +347,179 @@ private:
   const VectorType c_;
   std::vector<DiscreteFunctionType> stages_k_;
   const size_t num_stages_;
+  std::vector<std::pair<RangeFieldType, const typename DiscreteFunctionType::VectorType*>> terms_;
+};
+
+
+namespace internal {
+
+
+// unspecialized
+template <class RangeFieldType, TimeStepperMethods method>
+struct ShuOsherCoefficientsProvider
+{
+  static_assert(AlwaysFalse<RangeFieldType>::value,
+                "You cannot use LowStorageSspRungeKuttaTimeStepper with this value of TimeStepperMethods!");
 };
 
+// Euler
+template <class RangeFieldType>
+struct ShuOsherCoefficientsProvider<RangeFieldType, TimeStepperMethods::explicit_euler>
+{
+  static std::vector<RangeFieldType> alpha()
+  {
+    return {1.};
+  }
+
+  static std::vector<RangeFieldType> beta()
+  {
+    return {1.};
+  }
+
+  static std::vector<RangeFieldType> c()
+  {
+    return {0.};
+  }
+};
+
+// Second order SSP
+template <class RangeFieldType>
+struct ShuOsherCoefficientsProvider<RangeFieldType, TimeStepperMethods::explicit_rungekutta_second_order_ssp>
+{
+  static std::vector<RangeFieldType> alpha()
+  {
+    return {1., 0.5};
+  }
+
+  static std::vector<RangeFieldType> beta()
+  {
+    return {1., 0.5};
+  }
+
+  static std::vector<RangeFieldType> c()
+  {
+    return {0., 1.};
+  }
+};
+
+// Third order SSP
+template <class RangeFieldType>
+struct ShuOsherCoefficientsProvider<RangeFieldType, TimeStepperMethods::explicit_rungekutta_third_order_ssp>
+{
+  static std::vector<RangeFieldType> alpha()
+  {
+    return {1., 0.75, 1. / 3.};
+  }
+
+  static std::vector<RangeFieldType> beta()
+  {
+    return {1., 0.25, 2. / 3.};
+  }
+
+  static std::vector<RangeFieldType> c()
+  {
+    return {0., 1., 0.5};
+  }
+};
+
+
+} // namespace internal
+
+
+/** \brief Low-storage time stepper for the strong stability preserving explicit Runge Kutta methods
+ *
+ * Solves the same problem as ExplicitRungeKuttaTimeStepper, but uses the Shu-Osher form of the SSP methods
+ * \mathbf{u}_0 = \mathbf{u}^n,
+ * \mathbf{u}_{i+1} = \alpha_i \mathbf{u}^n + (1 - \alpha_i) \mathbf{u}_i + \beta_i dt L(\mathbf{u}_i, t^n + dt c_i),
+ * \mathbf{u}^{n+1} = \mathbf{u}_s,
+ * which only depends on \mathbf{u}^n and the latest stage. Thus, independent of the number of stages, only one stage
+ * vector and one vector for L(\mathbf{u}_i) are stored in addition to the solution (3N storage instead of (s+2)N for
+ * the Butcher form). Each stage update is done in one pass over the vectors. Results coincide with the ones of
+ * ExplicitRungeKuttaTimeStepper up to round-off.
+ *
+ * \tparam OperatorImp Type of operator L
+ * \tparam DiscreteFunctionImp Type of initial values
+ * \tparam method One of explicit_euler, explicit_rungekutta_second_order_ssp, explicit_rungekutta_third_order_ssp
+ */
+template <class OperatorImp, class DiscreteFunctionImp, TimeStepperMethods method = TimeStepperMethods::explicit_euler>
+class LowStorageSspRungeKuttaTimeStepper : public TimeStepperInterface<DiscreteFunctionImp>
+{
+  using BaseType = TimeStepperInterface<DiscreteFunctionImp>;
+  using CoefficientsProviderType = typename internal::ShuOsherCoefficientsProvider<typename BaseType::RangeFieldType,
+                                                                                    method>;
+
+public:
+  using typename BaseType::DiscreteFunctionType;
+  using typename BaseType::DiscreteSolutionType;
+  using typename BaseType::DomainFieldType;
+  using typename BaseType::RangeFieldType;
+
+  using OperatorType = OperatorImp;
+
+  using BaseType::current_solution;
+  using BaseType::current_time;
+
+  /**
+   * \brief Constructor for the low-storage SSP Runge Kutta time stepper
+   * \param op Operator L
+   * \param initial_values Discrete function containing initial values for u at time t_0.
+   * \param r Scalar factor (see ExplicitRungeKuttaTimeStepper, default is 1)
+   * \param t_0 Initial time (default is 0)
+   */
+  LowStorageSspRungeKuttaTimeStepper(const OperatorType& op,
+                                     DiscreteFunctionType& initial_values,
+                                     const RangeFieldType r = 1.0,
+                                     const double t_0 = 0.0)
+    : BaseType(t_0, initial_values)
+    , op_(op)
+    , r_(r)
+    , u_i_(BaseType::current_solution())
+    , k_(BaseType::current_solution())
+    , alpha_(CoefficientsProviderType::alpha())
+    , beta_(CoefficientsProviderType::beta())
+    , c_(CoefficientsProviderType::c())
+    , num_stages_(alpha_.size())
+  {
+    terms_.reserve(3);
+  }
+
+  RangeFieldType step(const RangeFieldType dt, const RangeFieldType max_dt) override final
+  {
+    const RangeFieldType actual_dt = std::min(dt, max_dt);
+    auto& t = current_time();
+    auto& u_n = current_solution();
+    XT::Common::Parameter param({{"t", {t}}, {"dt", {dt}}});
+    for (size_t ii = 0; ii < num_stages_; ++ii) {
+      // u_0 = u_n, so we do not have to copy
+      const auto& u_i = (ii == 0) ? u_n : u_i_;
+      param.set("t", {t + actual_dt * c_[ii]}, true);
+      internal::apply_and_communicate(op_, u_i.dofs().vector(), k_.dofs().vector(), k_.space(), param);
+      // the last stage is written directly to u_n
+      auto& u_next = (ii == num_stages_ - 1) ? u_n : u_i_;
+      terms_.clear();
+      if (alpha_[ii] != 0.)
+        terms_.emplace_back(alpha_[ii], &u_n.dofs().vector());
+      if (ii > 0 && alpha_[ii] != 1.)
+        terms_.emplace_back(1. - alpha_[ii], &u_i.dofs().vector());
+      terms_.emplace_back(beta_[ii] * r_ * actual_dt, &k_.dofs().vector());
+      internal::linear_combination(u_next.dofs().vector(), terms_);
+    }
+    t += actual_dt;
+    return dt;
+  } // ... step(...)
+
+private:
+  const OperatorType& op_;
+  const RangeFieldType r_;
+  DiscreteFunctionType u_i_;
+  DiscreteFunctionType k_;
+  const std::vector<RangeFieldType> alpha_;
+  const std::vector<RangeFieldType> beta_;
+  const std::vector<RangeFieldType> c_;
+  const size_t num_stages_;
+  std::vector<std::pair<RangeFieldType, const typename DiscreteFunctionType::VectorType*>> terms_;
+}; // class LowStorageSspRungeKuttaTimeStepper
+
 
 } // namespace GDT
 } // namespace Dune
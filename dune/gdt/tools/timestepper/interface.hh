@@ -12,8 +12,17 @@
 #ifndef DUNE_GDT_TIMESTEPPER_INTERFACE_HH
 #define DUNE_GDT_TIMESTEPPER_INTERFACE_HH
 
+#include <algorithm>
 #include <cstdio>
+#include <functional>
+#include <memory>
 #include <utility>
+#include <vector>
+
+#if HAVE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
 
 #include <dune/xt/common/memory.hh>
 #include <dune/xt/common/string.hh>
@@ -28,6 +37,7 @@
 #include <dune/gdt/operators/interfaces.hh>
 #include <dune/gdt/discretefunction/default.hh>
 
+#include "checkpoint.hh"
 #include "enums.hh"
 
 namespace Dune {
@@ -45,6 +55,53 @@ struct FloatCmpLt
 };
 
 
+/**
+ * \brief Computes result = \sum_j terms[j].first * (*terms[j].second) in one pass over the entries, without
+ *        temporaries.
+ *
+ * The entries are processed in chunks which are accumulated in a local buffer, so result may coincide with any of the
+ * vectors in terms. If TBB is available, the chunks are processed in parallel. All vectors have to be dense vectors
+ * with contiguous storage (which all dense XT::LA vectors are).
+ */
+template <class VectorType, class ScalarType>
+void linear_combination(VectorType& result, const std::vector<std::pair<ScalarType, const VectorType*>>& terms)
+{
+  const size_t size = result.size();
+  if (size == 0)
+    return;
+  if (terms.empty()) {
+    result *= 0.;
+    return;
+  }
+  static const constexpr size_t chunk_size = 256;
+  ScalarType* result_data = &(result[0]);
+  const auto process = [&](const size_t begin, const size_t end) {
+    ScalarType buffer[chunk_size];
+    for (size_t chunk_begin = begin; chunk_begin < end; chunk_begin += chunk_size) {
+      const size_t chunk_end = std::min(chunk_begin + chunk_size, end);
+      const size_t num_entries = chunk_end - chunk_begin;
+      const ScalarType coeff_0 = terms[0].first;
+      const ScalarType* data_0 = &((*terms[0].second)[0]) + chunk_begin;
+      for (size_t ii = 0; ii < num_entries; ++ii)
+        buffer[ii] = coeff_0 * data_0[ii];
+      for (size_t jj = 1; jj < terms.size(); ++jj) {
+        const ScalarType coeff = terms[jj].first;
+        const ScalarType* data = &((*terms[jj].second)[0]) + chunk_begin;
+        for (size_t ii = 0; ii < num_entries; ++ii)
+          buffer[ii] += coeff * data[ii];
+      }
+      std::copy(buffer, buffer + num_entries, result_data + chunk_begin);
+    }
+  };
+#if HAVE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, size, 16 * chunk_size),
+                    [&](const tbb::blocked_range<size_t>& range) { process(range.begin(), range.end()); });
+#else
+  process(0, size);
+#endif
+} // ... linear_combination(...)
+
+
 } // namespace internal
 
 
@@ -84,6 +141,8 @@ protected:
     , t_(t_0)
     , u_n_(&CurrentSolutionStorageProviderType::access())
     , solution_(&SolutionStorageProviderType::access())
+    , output_format_(TimeStepperOutputFormats::text)
+    , output_queue_depth_(2)
   {}
 
 public:
@@ -148,6 +207,56 @@ public:
     solution_ = &solution_ref;
   }
 
+  /**
+   * \brief Selects the format solve uses if write_discrete is true.
+   *
+   * For TimeStepperOutputFormats::binary, each rank writes a binary checkpoint (see write_checkpoint) from a
+   * background thread while the time stepping continues. For TimeStepperOutputFormats::binary_single_file, all ranks
+   * collectively write one file. Binary checkpoints can be read back by restart().
+   */
+  void set_output_format(const TimeStepperOutputFormats format)
+  {
+    output_format_ = format;
+  }
+
+  TimeStepperOutputFormats output_format() const
+  {
+    return output_format_;
+  }
+
+  /**
+   * \brief Sets the maximal number of outputs which may be pending in the output thread (see solve), each of which
+   *        holds a copy of the solution. If the limit is reached, the time stepping waits for the output thread.
+   */
+  void set_output_queue_depth(const size_t depth)
+  {
+    if (output_queue_)
+      output_queue_->wait();
+    output_queue_ = nullptr;
+    output_queue_depth_ = depth;
+  }
+
+  /**
+   * \brief Sets a function which returns an upper bound for the stable time step length, e.g.
+   *        [&op]() { return op.estimate_dt(0.9); } for an AdvectionFvOperator op which collects wave speeds (the
+   *        estimate then refers to the last stage computed). After each step in solve, the suggested next time step
+   *        length is limited by it. Pass an empty function to disable.
+   */
+  void set_dt_limiter(std::function<RangeFieldType()> dt_limiter)
+  {
+    dt_limiter_ = dt_limiter;
+  }
+
+  /**
+   * \brief Reads the binary checkpoint written by solve in step (see set_output_format) into current_solution() and
+   *        sets current_time() accordingly.
+   */
+  void restart(const std::string& prefix, const size_t step)
+  {
+    current_time() = read_checkpoint(
+        current_solution(), prefix, step, output_format_ == TimeStepperOutputFormats::binary_single_file);
+  }
+
   static const GridFunctionType& dummy_solution()
   {
     static auto dummy_sol = XT::Functions::GenericGridFunction<EntityType, dimRange, dimRangeCols, RangeFieldType>(0);
@@ -175,6 +284,9 @@ public:
    * \param stringifier Function object that determines how RangeType is converted to string before writing to .txt
    * files.
    * \param exact_solution Exact solution function.
+   * \param async_output If true, the solution is copied at each save point and visualized/written by a separate thread
+   * while the time stepping continues (see set_output_queue_depth). Only used for a single MPI rank, since the output
+   * involves collective communication otherwise.
    * \return estimated optimal time step length for next step
    * \note If num_save_steps is specified (i.e. if it is not size_t(-1), the solution will be stored/visualized at
    * exactly num_save_steps + 1 equidistant time points (including the initial time and t_end), even if the time step
@@ -192,7 +304,8 @@ public:
                                DiscreteSolutionType& sol,
                                const VisualizerType& visualizer,
                                const StringifierType& stringifier,
-                               const GridFunctionType& exact_solution)
+                               const GridFunctionType& exact_solution,
+                               const bool async_output = false)
   {
     RangeFieldType dt = initial_dt;
     RangeFieldType t = current_time();
@@ -209,16 +322,17 @@ public:
     // save/visualize initial solution
     if (save_solution)
       sol.insert(std::make_pair(t, current_solution()));
-    write_files(visualize,
-                write_discrete,
-                write_exact,
-                current_solution(),
-                exact_solution,
-                prefix,
-                0,
-                t,
-                stringifier,
-                visualizer);
+    write_output(visualize,
+                 write_discrete,
+                 write_exact,
+                 current_solution(),
+                 exact_solution,
+                 prefix,
+                 0,
+                 t,
+                 stringifier,
+                 visualizer,
+                 async_output);
 
     while (Dune::XT::Common::FloatCmp::lt(t, t_end)) {
       RangeFieldType max_dt = dt;
@@ -230,6 +344,8 @@ public:
 
       // do a timestep
       dt = step(dt, max_dt);
+      if (dt_limiter_)
+        dt = std::min(dt, dt_limiter_());
       t = current_time();
 
       // augment time step counter
@@ -239,16 +355,17 @@ public:
       if (Dune::XT::Common::FloatCmp::ge(t, next_save_time) || num_save_steps == size_t(-1)) {
         if (save_solution)
           sol.insert(sol.end(), std::make_pair(t, current_solution()));
-        write_files(visualize,
-                    write_discrete,
-                    write_exact,
-                    current_solution(),
-                    exact_solution,
-                    prefix,
-                    save_step_counter,
-                    t,
-                    stringifier,
-                    visualizer);
+        write_output(visualize,
+                     write_discrete,
+                     write_exact,
+                     current_solution(),
+                     exact_solution,
+                     prefix,
+                     save_step_counter,
+                     t,
+                     stringifier,
+                     visualizer,
+                     async_output);
         next_save_time += save_interval;
         ++save_step_counter;
       }
@@ -259,6 +376,10 @@ public:
       }
     } // while (t < t_end)
 
+    // make sure all files are complete
+    if (output_queue_)
+      output_queue_->wait();
+
     return dt;
   } // ... solve(...)
 
@@ -274,7 +395,8 @@ public:
                                const std::string prefix = "solution",
                                const VisualizerType& visualizer = default_visualizer(),
                                const StringifierType& stringifier = vector_stringifier(),
-                               const GridFunctionType& exact_solution = dummy_solution())
+                               const GridFunctionType& exact_solution = dummy_solution(),
+                               const bool async_output = false)
   {
     return solve(t_end,
                  initial_dt,
@@ -288,7 +410,8 @@ public:
                  *solution_,
                  visualizer,
                  stringifier,
-                 exact_solution);
+                 exact_solution,
+                 async_output);
   }
 
   // solve and store in sol, no (file) output
@@ -458,9 +581,57 @@ public:
   }
 
 private:
+  // Like write_files, but writes the discrete solution in the format chosen by set_output_format and, if async is
+  // true, writes from the output thread.
+  void write_output(const bool visualize,
+                    const bool write_discrete,
+                    const bool write_exact,
+                    const DiscreteFunctionType& discrete_sol,
+                    const GridFunctionType& exact_sol,
+                    const std::string& prefix,
+                    const size_t step,
+                    const RangeFieldType t,
+                    const StringifierType& stringifier,
+                    const VisualizerType& visualizer,
+                    const bool async)
+  {
+    const bool write_text = write_discrete && output_format_ == TimeStepperOutputFormats::text;
+    // Writing vtk or text files in parallel involves collective communication, which must not happen in the output
+    // thread (it would interleave with the communication of the time stepping).
+    if (async && discrete_sol.space().grid_view().comm().size() == 1) {
+      if (visualize || write_text || write_exact) {
+        // The snapshot decouples the output from the time stepping. The exact solution, stringifier and visualizer are
+        // owned by the caller of solve, which waits for the output thread before returning.
+        const auto snapshot = std::make_shared<const DiscreteFunctionType>(discrete_sol);
+        output_queue().push([=, &exact_sol, &stringifier, &visualizer]() {
+          write_files(
+              visualize, write_text, write_exact, *snapshot, exact_sol, prefix, step, t, stringifier, visualizer);
+        });
+      }
+    } else {
+      write_files(
+          visualize, write_text, write_exact, discrete_sol, exact_sol, prefix, step, t, stringifier, visualizer);
+    }
+    if (write_discrete && output_format_ == TimeStepperOutputFormats::binary)
+      write_checkpoint(discrete_sol, t, prefix, step, false, &output_queue());
+    else if (write_discrete && output_format_ == TimeStepperOutputFormats::binary_single_file)
+      write_checkpoint(discrete_sol, t, prefix, step, true);
+  } // ... write_output(...)
+
+  internal::BackgroundTaskQueue& output_queue()
+  {
+    if (!output_queue_)
+      output_queue_ = std::make_unique<internal::BackgroundTaskQueue>(output_queue_depth_);
+    return *output_queue_;
+  }
+
   RangeFieldType t_;
   DiscreteFunctionType* u_n_;
   DiscreteSolutionType* solution_;
+  TimeStepperOutputFormats output_format_;
+  size_t output_queue_depth_;
+  std::unique_ptr<internal::BackgroundTaskQueue> output_queue_;
+  std::function<RangeFieldType()> dt_limiter_;
 }; // class TimeStepperInterface
 
 
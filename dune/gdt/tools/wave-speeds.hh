@@ -0,0 +1,90 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_GDT_TOOLS_WAVE_SPEEDS_HH
+#define DUNE_GDT_TOOLS_WAVE_SPEEDS_HH
+
+#include <atomic>
+#include <limits>
+
+#include <dune/xt/common/exceptions.hh>
+
+namespace Dune {
+namespace GDT {
+
+
+/**
+ * \brief Collects the maximal wave speeds on the intersections visited during the application of an advection
+ *        operator, to estimate a stable time step length without an additional grid walk.
+ *
+ * For an intersection F of an element K with maximal wave speed a_F, the local operators call add(a_F, |F|, |K|,
+ * number of faces of K), which records the rate a_F |F| n_K / |K|. Since \sum_{F \subset \partial K} a_F |F| / |K| is
+ * bounded by this rate, estimate_dt() returns a CFL-stable time step length for an explicit Euler finite volume scheme
+ * (cfl / max rate, which coincides with estimate_dt_for_hyperbolic_system on uniform grids). For DG schemes of order p,
+ * choose cfl <= 1 / (2p + 1).
+ *
+ * add() may be called concurrently by several threads. The estimate is reduced over all ranks of the given
+ * communicator, so all ranks obtain the same time step length.
+ */
+template <class R = double>
+class WaveSpeedAccumulator
+{
+public:
+  WaveSpeedAccumulator()
+    : enabled_(false)
+    , max_rate_(0.)
+  {}
+
+  void enable(const bool value = true)
+  {
+    enabled_ = value;
+  }
+
+  bool enabled() const
+  {
+    return enabled_;
+  }
+
+  void reset()
+  {
+    max_rate_.store(0., std::memory_order_relaxed);
+  }
+
+  void add(const R& wave_speed, const R& intersection_volume, const R& element_volume, const size_t num_faces)
+  {
+    const R rate = wave_speed * intersection_volume * num_faces / element_volume;
+    R current = max_rate_.load(std::memory_order_relaxed);
+    // only write if the rate increases, which is rare after the first few intersections
+    while (rate > current && !max_rate_.compare_exchange_weak(current, rate, std::memory_order_relaxed))
+      ;
+  }
+
+  /// \brief The maximal rate on this rank.
+  R max_rate() const
+  {
+    return max_rate_.load(std::memory_order_relaxed);
+  }
+
+  /// \brief Returns cfl / (maximal rate over all ranks), which requires one allreduce.
+  template <class CommunicationType>
+  R estimate_dt(const CommunicationType& comm, const R& cfl = 1.) const
+  {
+    DUNE_THROW_IF(!enabled_, XT::Common::Exceptions::wrong_input_given, "Collecting wave speeds is not enabled!");
+    const R rate = comm.max(max_rate());
+    return rate > 0. ? cfl / rate : std::numeric_limits<R>::max();
+  }
+
+private:
+  bool enabled_;
+  std::atomic<R> max_rate_;
+}; // class WaveSpeedAccumulator
+
+
+} // namespace GDT
+} // namespace Dune
+
+#endif // DUNE_GDT_TOOLS_WAVE_SPEEDS_HH
@@ -0,0 +1,124 @@
+// This file is part of the dune-gdt project:
+//   https://github.com/dune-community/dune-gdt
+// Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#define DUNE_XT_COMMON_TEST_MAIN_CATCH_EXCEPTIONS 1
+
+#include <dune/xt/test/main.hxx> // <- this one has to come first (includes the config.h)!
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <dune/common/timer.hh>
+
+#include <dune/xt/common/parallel/threadmanager.hh>
+#include <dune/xt/la/container/istl.hh>
+#include <dune/xt/grid/grids.hh>
+#include <dune/xt/grid/gridprovider/cube.hh>
+#include <dune/xt/grid/type_traits.hh>
+#include <dune/xt/functions/generic/function.hh>
+
+#include <dune/gdt/local/numerical-fluxes/lax-friedrichs.hh>
+#include <dune/gdt/operators/advection-dg.hh>
+#include <dune/gdt/spaces/l2/discontinuous-lagrange.hh>
+#include <dune/gdt/tools/sparsity-pattern.hh>
+
+using namespace Dune;
+using namespace Dune::GDT;
+
+using V = XT::LA::IstlDenseVector<double>;
+using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+
+#if HAVE_DUNE_ALUGRID
+using G = ALU_2D_SIMPLEX_CONFORMING;
+#else
+using G = YASP_2D_EQUIDISTANT_OFFSET;
+#endif
+using GV = typename G::LeafGridView;
+using I = XT::Grid::extract_intersection_t<GV>;
+
+
+std::string ordering_name(const ElementOrdering ordering)
+{
+  if (ordering == ElementOrdering::space_filling_curve)
+    return "space_filling_curve";
+  if (ordering == ElementOrdering::reverse_cuthill_mckee)
+    return "reverse_cuthill_mckee";
+  return "grid";
+}
+
+
+/// \brief The maximal distance of two coupled DoFs (on the same or neighbouring elements).
+template <class SpaceType>
+size_t bandwidth(const SpaceType& space)
+{
+  size_t ret = 0;
+  for (auto&& element : elements(space.grid_view())) {
+    const auto indices = space.mapper().global_indices(element);
+    for (auto&& intersection : intersections(space.grid_view(), element)) {
+      if (!intersection.neighbor())
+        continue;
+      const auto neighbour_indices = space.mapper().global_indices(intersection.outside());
+      for (const auto& ii : indices)
+        for (const auto& jj : neighbour_indices)
+          ret = std::max(ret, ii > jj ? ii - jj : jj - ii);
+    }
+  }
+  return ret;
+} // ... bandwidth(...)
+
+
+/**
+ * Compares the throughput of sparse matrix-vector products (with the element and intersection sparsity pattern) and of
+ * the application of a DG advection operator (walking the grid sequentially in DoF order for renumbered spaces), for
+ * all element orderings. Set num_elements, order and repetitions in the config to change the problem size.
+ */
+GTEST_TEST(ElementOrderingBenchmark, spmv_and_apply)
+{
+  auto grid_provider = XT::Grid::make_cube_grid<G>(0., 1., DXTC_CONFIG_GET("num_elements", 256u));
+  const auto grid_view = grid_provider.leaf_view();
+  const int order = DXTC_CONFIG_GET("order", 1);
+  const size_t repetitions = DXTC_CONFIG_GET("repetitions", 10u);
+  const XT::Functions::GenericFunction<1, 2, 1> flux(
+      2,
+      [](const auto& u, const auto& /*param*/) {
+        FieldVector<double, 2> ret(0.5 * u[0] * u[0]);
+        return ret;
+      },
+      "burgers");
+  const NumericalLaxFriedrichsFlux<I, 2, 1> numerical_flux(flux, /*lambda=*/1.);
+  const auto max_threads = XT::Common::threadManager().max_threads();
+  XT::Common::threadManager().set_max_threads(1);
+  std::cout << std::setw(24) << "ordering" << std::setw(12) << "bandwidth" << std::setw(16) << "SpMV (MDoF/s)"
+            << std::setw(16) << "apply (MDoF/s)" << std::endl;
+  for (auto ordering :
+       {ElementOrdering::grid, ElementOrdering::space_filling_curve, ElementOrdering::reverse_cuthill_mckee}) {
+    const auto space = make_discontinuous_lagrange_space(grid_view, order, ordering);
+    const size_t size = space.mapper().size();
+    V source(size);
+    for (size_t ii = 0; ii < size; ++ii)
+      source[ii] = 1. + 0.5 * std::sin(1. + ii);
+    V range(size);
+    // the values of the matrix do not influence the throughput
+    M matrix(size, size, make_element_and_intersection_sparsity_pattern(space));
+    Timer timer;
+    for (size_t rr = 0; rr < repetitions; ++rr)
+      matrix.mv(source, range);
+    const double spmv_throughput = 1e-6 * size * repetitions / timer.elapsed();
+    auto op = make_advection_dg_operator<M>(grid_view, numerical_flux, space, space);
+    op.apply(source, range);
+    timer.reset();
+    for (size_t rr = 0; rr < repetitions; ++rr)
+      op.apply(source, range);
+    const double apply_throughput = 1e-6 * size * repetitions / timer.elapsed();
+    std::cout << std::setw(24) << ordering_name(ordering) << std::setw(12) << bandwidth(space) << std::setw(16)
+              << spmv_throughput << std::setw(16) << apply_throughput << std::endl;
+  }
+  XT::Common::threadManager().set_max_threads(max_threads);
+} // GTEST_TEST(ElementOrderingBenchmark, spmv_and_apply)
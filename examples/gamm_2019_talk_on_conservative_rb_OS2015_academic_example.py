@@ -37,6 +37,7 @@ def gamma(mu, mu_bar):
 from dune.gdt.gamm_2019_talk_on_conservative_rb import (
     DiscontinuousLagrangeSpace,
     GridProvider,
+    LocalMatrixOffsetMap,
     RaviartThomasSpace,
     assemble_energy_semi_product_matrix,
     assemble_DG_product_matrix,
@@ -64,9 +65,11 @@ def discretize(num_refinements):
     grid.refine(num_refinements)
     dg_space = DiscontinuousLagrangeSpace(grid, 1)
 
-    lhs_op = LincombOperator(
-        [make_marix_operator(assemble_SWIPDG_matrix(dg_space, diff), 'PRESSURE') for diff in diffusion['functions']],
-        diffusion['coefficients'])
+    offsets = LocalMatrixOffsetMap(dg_space)    # shared by all affine components, only searched for once
+    lhs_op = LincombOperator([
+        make_marix_operator(assemble_SWIPDG_matrix(dg_space, diff, offsets=offsets), 'PRESSURE')
+        for diff in diffusion['functions']
+    ], diffusion['coefficients'])
     rhs_func = VectorFunctional(lhs_op.range.make_array((assemble_L2_vector(dg_space, f),)))
     dg_product = make_marix_operator(assemble_DG_product_matrix(dg_space), 'PRESSURE')
 
@@ -157,6 +157,7 @@ def gamma(mu, mu_bar):
 from dune.gdt.gamm_2019_talk_on_conservative_rb import (
     DiscontinuousLagrangeSpace,
     GridProvider,
+    LocalMatrixOffsetMap,
     RaviartThomasSpace,
     assemble_energy_semi_product_matrix,
     assemble_DG_product_matrix,
@@ -184,8 +185,9 @@ def discretize(num_refinements, polorder=1):
     grid.refine(num_refinements)
     dg_space = DiscontinuousLagrangeSpace(grid, polorder)
 
+    offsets = LocalMatrixOffsetMap(dg_space)    # shared by all affine components, only searched for once
     lhs_op = LincombOperator([
-        make_marix_operator(assemble_SWIPDG_matrix(dg_space, diff, diffusion_tensor), 'PRESSURE')
+        make_marix_operator(assemble_SWIPDG_matrix(dg_space, diff, diffusion_tensor, offsets=offsets), 'PRESSURE')
         for diff in diffusion_factor['functions']
     ], diffusion_factor['coefficients'])
     rhs_func = VectorFunctional(lhs_op.range.make_array((assemble_L2_vector(dg_space, f),)))
@@ -68,16 +68,23 @@ using V = XT::LA::IstlDenseVector<double>;
 
 using DG = DiscontinuousLagrangeSpace<GV>;
 using RTN = RaviartThomasSpace<GV>;
+using OffsetMap = LocalMatrixOffsetMap<GV>;
 using ScalarDF = DiscreteFunction<V, GV>;
 using VectorDF = DiscreteFunction<V, GV, d>;
 
 
+/**
+ * \note If offsets are given, they are recorded during the first call and reused by all subsequent calls with the same
+ *       space (e.g. for each parameter value), which then skip searching the sparse rows.
+ */
 std::unique_ptr<M> assemble_SWIPDG_matrix(const DG& space,
                                           const XT::Functions::GridFunctionInterface<E>& diffusion_factor,
                                           const XT::Functions::GridFunctionInterface<E, d, d>& diffusion_tensor,
-                                          const bool parallel)
+                                          const bool parallel,
+                                          std::shared_ptr<OffsetMap> offsets = nullptr)
 {
   auto op = make_matrix_operator<M>(space, Stencil::element_and_intersection);
+  op.local_matrix_offsets() = offsets;
   op.append(LocalElementIntegralBilinearForm<E>(LocalEllipticIntegrand<E>(diffusion_factor, diffusion_tensor)));
   op.append(
       LocalIntersectionIntegralBilinearForm<I>(
@@ -370,6 +377,13 @@ PYBIND11_MODULE(gamm_2019_talk_on_conservative_rb, m)
   rtn_space.def_property_readonly("dimDomain", [](RTN& /*self*/) { return d; });
   rtn_space.def_property_readonly("num_DoFs", [](RTN& self) { return self.mapper().size(); });
 
+  py::class_<OffsetMap, std::shared_ptr<OffsetMap>> offset_map(
+      m,
+      "LocalMatrixOffsetMap",
+      "Positions of the local matrices in the assembled matrix, to be passed to repeated calls of "
+      "assemble_SWIPDG_matrix with the same space (not to concurrent ones).");
+  offset_map.def(py::init([](DG& space) { return std::make_shared<OffsetMap>(space.grid_view()); }), "dg_space"_a);
+
   m.def("make_discrete_function",
         [](DG& dg_space, V& vec, const std::string& name) { return ScalarDF(dg_space, vec, name); },
         "dg_space"_a,
@@ -401,28 +415,37 @@ PYBIND11_MODULE(gamm_2019_talk_on_conservative_rb, m)
         "fine_rtn_space"_a);
 
   m.def("assemble_SWIPDG_matrix",
-        [](DG& space, XT::Functions::FunctionInterface<d>& diffusion_factor, const bool parallel) {
+        [](DG& space,
+           XT::Functions::FunctionInterface<d>& diffusion_factor,
+           const bool parallel,
+           std::shared_ptr<OffsetMap> offsets) {
           const XT::Functions::ConstantFunction<d, d, d> diffusion_tensor(
               XT::Common::FieldMatrix<double, 2, d>({{1., 0.}, {0., 1.}}));
-          return std::move(assemble_SWIPDG_matrix(
-              space, diffusion_factor.as_grid_function<E>(), diffusion_tensor.as_grid_function<E>(), parallel));
+          return std::move(assemble_SWIPDG_matrix(space,
+                                                  diffusion_factor.as_grid_function<E>(),
+                                                  diffusion_tensor.as_grid_function<E>(),
+                                                  parallel,
+                                                  offsets));
         },
         py::call_guard<py::gil_scoped_release>(),
         "dg_space"_a,
         "diffusion_factor"_a,
-        "parallel"_a = true);
+        "parallel"_a = true,
+        "offsets"_a = nullptr);
   m.def("assemble_SWIPDG_matrix",
         [](DG& space,
            XT::Functions::GridFunctionInterface<E>& diffusion_factor,
            XT::Functions::GridFunctionInterface<E, d, d>& diffusion_tensor,
-           const bool parallel) {
-          return std::move(assemble_SWIPDG_matrix(space, diffusion_factor, diffusion_tensor, parallel));
+           const bool parallel,
+           std::shared_ptr<OffsetMap> offsets) {
+          return std::move(assemble_SWIPDG_matrix(space, diffusion_factor, diffusion_tensor, parallel, offsets));
         },
         py::call_guard<py::gil_scoped_release>(),
         "dg_space"_a,
         "diffusion_factor"_a,
         "diffusion_tensor"_a,
-        "parallel"_a = true);
+        "parallel"_a = true,
+        "offsets"_a = nullptr);
 
   m.def("assemble_L2_vector",
         [](DG& space, XT::Functions::FunctionInterface<d>& force, const bool parallel) {
@@ -0,0 +1,47 @@
+# ~~~
+# This file is part of the dune-gdt project:
+#   https://github.com/dune-community/dune-gdt
+# Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+# License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+#      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+#          with "runtime exception" (http://www.dune-project.org/license.html)
+# ~~~
+"""Reads the binary regularization log written by LocalEntropySolver (see dune/gdt/test/momentmodels/entropysolver.hh).
+
+Usage: python read_regularization_log.py FILENAME_regularization.bin [--text]
+"""
+
+import sys
+
+import numpy as np
+
+MAGIC = b'GDTREGLG'
+
+
+def read_regularization_log(filename):
+    """Returns the arrays t, centers, s and u, with one entry (or row) per regularized cell."""
+    with open(filename, 'rb') as f:
+        if f.read(len(MAGIC)) != MAGIC:
+            raise ValueError('{} is not a regularization log'.format(filename))
+        dim_flux, dim_range = (int(dd) for dd in np.fromfile(f, dtype=np.uint64, count=2))
+        records = np.fromfile(f, dtype=np.float64)
+    record_size = 2 + dim_flux + dim_range
+    if records.size % record_size != 0:
+        raise ValueError('{} is truncated'.format(filename))
+    records = records.reshape(-1, record_size)
+    return records[:, 0], records[:, 1:1 + dim_flux], records[:, 1 + dim_flux], records[:, 2 + dim_flux:]
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+    t, centers, s, u = read_regularization_log(sys.argv[1])
+    if '--text' in sys.argv[2:]:
+        # same format as the text log: t, the center and s with the default stream precision (as '%g'), u with 15 digits
+        for ii in range(len(t)):
+            print(' '.join(['{:g}'.format(t[ii])] + ['{:g}'.format(x) for x in centers[ii]] +
+                           ['{:g}'.format(s[ii]), '[' + ' '.join('{:.15g}'.format(x) for x in u[ii]) + ']']))
+    else:
+        print('{} regularized cells, {} distinct times, max s = {}'.format(
+            len(t), len(np.unique(t)), s.max() if len(s) else 0.))
@@ -0,0 +1,44 @@
+# ~~~
+# This file is part of the dune-gdt project:
+#   https://github.com/dune-community/dune-gdt
+# Copyright 2010-2018 dune-gdt developers and contributors. All rights reserved.
+# License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+#      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+#          with "runtime exception" (http://www.dune-project.org/license.html)
+# ~~~
+
+import os
+import sys
+
+import numpy as np
+import pytest
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'scripts'))
+from read_regularization_log import MAGIC, read_regularization_log  # noqa: E402
+
+
+def _write_log(filename, dim_flux, dim_range, records):
+    # same layout as internal::append_regularization_log in dune/gdt/test/momentmodels/entropysolver.hh
+    with open(filename, 'wb') as f:
+        f.write(MAGIC)
+        np.array([dim_flux, dim_range], dtype=np.uint64).tofile(f)
+        np.asarray(records, dtype=np.float64).tofile(f)
+
+
+def test_read_regularization_log(tmpdir):
+    dim_flux, dim_range = 2, 3
+    records = np.arange(4 * (2 + dim_flux + dim_range), dtype=np.float64).reshape(4, -1)
+    filename = str(tmpdir.join('test_regularization.bin'))
+    _write_log(filename, dim_flux, dim_range, records)
+    t, centers, s, u = read_regularization_log(filename)
+    assert np.array_equal(t, records[:, 0])
+    assert np.array_equal(centers, records[:, 1:3])
+    assert np.array_equal(s, records[:, 3])
+    assert np.array_equal(u, records[:, 4:])
+
+
+def test_read_truncated_regularization_log(tmpdir):
+    filename = str(tmpdir.join('test_regularization.bin'))
+    _write_log(filename, 1, 2, np.ones(5 + 2))
+    with pytest.raises(ValueError):
+        read_regularization_log(filename)